@@ -189,6 +189,16 @@ assertPipelineDoesNotUseAggregation({
     expectedStages: ["COLLSCAN", "PROJECTION_SIMPLE"],
     expectedResult: [{x: 20}]
 });
+assertPipelineDoesNotUseAggregation({
+    pipeline: [{$match: {x: 40}}, {$project: {a: 0, _id: 0}}],
+    expectedStages: ["COLLSCAN", "PROJECTION_SIMPLE"],
+    expectedResult: [{x: 40}]
+});
+assertPipelineDoesNotUseAggregation({
+    pipeline: [{$match: {x: 40}}, {$project: {"a.b": 0, _id: 0}}],
+    expectedStages: ["COLLSCAN", "PROJECTION_DEFAULT"],
+    expectedResult: [{x: 40, a: {}}]
+});
 assertPipelineDoesNotUseAggregation({
     pipeline: [{$project: {x: 1, "a.b": 1, _id: 0}}],
     expectedStages: ["COLLSCAN", "PROJECTION_DEFAULT"],
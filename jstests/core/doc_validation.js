@@ -177,6 +177,15 @@ function runCollationValidationTest(validator) {
 runCollationValidationTest({a: "xyz"});
 runCollationValidationTest({$jsonSchema: {properties: {a: {enum: ["xyz"]}}}});
 
+// An in-place update that changes a validated value is checked against the validator, and a
+// failing one leaves the document unchanged.
+coll.drop();
+assert.commandWorked(db.createCollection(collName, {validator: {a: {$lt: 10}}}));
+assert.commandWorked(coll.insert({_id: 1, a: NumberInt(8)}));
+assert.commandWorked(coll.update({_id: 1}, {$inc: {a: NumberInt(1)}}));
+assertFailsValidation(coll.update({_id: 1}, {$inc: {a: NumberInt(1)}}));
+assert.eq(9, coll.findOne({_id: 1}).a);
+
 // The validator is allowed to contain $expr.
 coll.drop();
 assert.commandWorked(db.createCollection(collName, {validator: {$expr: {$eq: ["$a", 5]}}}));
@@ -105,5 +105,17 @@ assert.commandFailedWithCode(
 assert.eq(kNumDocsExceedingMemLimit,
           identityView.find().sort({sequenceNumber: -1}).allowDiskUse().itcount());
 
+// With a small memory limit the sort spills many runs. Bounding the merge fan-in makes it merge
+// them in several passes, and every document must still be returned in order.
+assert.commandWorked(testDb.adminCommand(
+    {setParameter: 1, internalQueryMaxBlockingSortMemoryUsageBytes: 10 * 1024}));
+assert.commandWorked(testDb.adminCommand({setParameter: 1, internalQueryMaxSpillFanIn: 2}));
+const sortedDocs = collection.find({}, {_id: 0, sequenceNumber: 1})
+                       .sort({sequenceNumber: -1})
+                       .allowDiskUse()
+                       .toArray();
+assert.eq(kNumDocsExceedingMemLimit, sortedDocs.length);
+sortedDocs.forEach((doc, i) => assert.eq(kNumDocsExceedingMemLimit - 1 - i, doc.sequenceNumber));
+
 MongoRunner.stopMongod(conn);
 }());
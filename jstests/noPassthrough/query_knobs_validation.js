@@ -28,6 +28,7 @@ const expectedParamDefaults = {
     internalQueryPlanOrChildrenIndependently: true,
     internalQueryMaxScansToExplode: 200,
     internalQueryMaxBlockingSortMemoryUsageBytes: 100 * 1024 * 1024,
+    internalQueryMaxSpillFanIn: 0,
     internalQueryExecYieldIterations: 1000,
     internalQueryExecYieldPeriodMS: 10,
     internalQueryFacetBufferSizeBytes: 100 * 1024 * 1024,
@@ -122,6 +123,10 @@ assertSetParameterSucceeds("internalQueryMaxBlockingSortMemoryUsageBytes", 11);
 assertSetParameterSucceeds("internalQueryMaxBlockingSortMemoryUsageBytes", 0);
 assertSetParameterFails("internalQueryMaxBlockingSortMemoryUsageBytes", -1);
 
+assertSetParameterSucceeds("internalQueryMaxSpillFanIn", 16);
+assertSetParameterSucceeds("internalQueryMaxSpillFanIn", 0);
+assertSetParameterFails("internalQueryMaxSpillFanIn", -1);
+
 assertSetParameterSucceeds("internalQueryExecYieldIterations", 10);
 assertSetParameterSucceeds("internalQueryExecYieldIterations", 0);
 assertSetParameterSucceeds("internalQueryExecYieldIterations", -1);
@@ -0,0 +1,40 @@
+/**
+ * Tests the serverStatus metrics counting secondary reads served at the last applied timestamp
+ * and reads that had to wait for oplog batch application.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+const dbName = "test";
+const collName = jsTestName();
+
+assert.commandWorked(
+    primary.getDB(dbName)[collName].insert({_id: 0}, {writeConcern: {w: "majority"}}));
+
+function getSecondaryReadsMetrics() {
+    return assert.commandWorked(secondary.adminCommand({serverStatus: 1}))
+        .metrics.repl.secondaryReads;
+}
+
+const before = getSecondaryReadsMetrics();
+assert.gte(before.batchApplicationWaits, 0, tojson(before));
+assert.gte(before.batchApplicationWaitMicros, 0, tojson(before));
+
+secondary.setSlaveOk();
+for (let i = 0; i < 10; ++i) {
+    assert.eq(1, secondary.getDB(dbName)[collName].find().itcount());
+}
+
+const after = getSecondaryReadsMetrics();
+assert.gte(after.atLastApplied, before.atLastApplied + 10, tojson(after));
+
+rst.stopSet();
+})();
@@ -359,6 +359,28 @@ verifyServerStatusChange(
 verifyServerStatusChange(
     serverStatus.opReadConcernCounters, newStatus.opReadConcernCounters, "none", 0);
 
+// Reads that wait for an afterClusterTime are counted in 'opTimeWaits' for their level.
+const clusterTime = assert.commandWorked(testDB.runCommand({ping: 1})).operationTime;
+serverStatus = getServerStatus(testDB);
+assert.commandWorked(testDB.runCommand(
+    {find: collName, readConcern: {level: "local", afterClusterTime: clusterTime}}));
+assert.commandWorked(testDB.runCommand(
+    {find: collName, readConcern: {level: "majority", afterClusterTime: clusterTime}}));
+assert.commandWorked(testDB.runCommand({find: collName, readConcern: {level: "local"}}));
+newStatus = getServerStatus(testDB);
+verifyServerStatusChange(serverStatus.opReadConcernCounters.opTimeWaits.local,
+                         newStatus.opReadConcernCounters.opTimeWaits.local,
+                         "count",
+                         1);
+verifyServerStatusChange(serverStatus.opReadConcernCounters.opTimeWaits.majority,
+                         newStatus.opReadConcernCounters.opTimeWaits.majority,
+                         "count",
+                         1);
+verifyServerStatusChange(serverStatus.opReadConcernCounters.opTimeWaits.snapshot,
+                         newStatus.opReadConcernCounters.opTimeWaits.snapshot,
+                         "count",
+                         0);
+
 session.endSession();
 rst.stopSet();
 }());
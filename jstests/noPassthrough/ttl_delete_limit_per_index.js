@@ -0,0 +1,34 @@
+// Test that the TTL monitor deletes at most 'ttlMonitorDeleteLimitPerIndex' documents through a
+// TTL index in each pass, and deletes the rest in later passes.
+(function() {
+"use strict";
+const kDeleteLimit = 3;
+const kNumDocs = 10;
+
+const runner = MongoRunner.runMongod(
+    {setParameter: {ttlMonitorSleepSecs: 1, ttlMonitorDeleteLimitPerIndex: kDeleteLimit}});
+const db = runner.getDB("test");
+const coll = db.ttl_delete_limit_per_index;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 0}));
+
+const ttlPassesBefore = db.serverStatus().metrics.ttl.passes;
+
+const now = new Date();
+const docs = [];
+for (let i = 0; i < kNumDocs; i++) {
+    docs.push({x: now});
+}
+assert.commandWorked(coll.insert(docs));
+
+assert.soon(function() {
+    return coll.find().itcount() === 0;
+}, "TTL monitor didn't delete all the expired documents");
+
+// Each pass deletes at most 'kDeleteLimit' documents, so it must have taken enough passes.
+const ttlPasses = db.serverStatus().metrics.ttl.passes - ttlPassesBefore;
+assert.gte(ttlPasses, Math.ceil(kNumDocs / kDeleteLimit), "Too few TTL passes: " + ttlPasses);
+
+MongoRunner.stopMongod(runner);
+})();
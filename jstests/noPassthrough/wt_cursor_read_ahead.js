@@ -0,0 +1,56 @@
+// Tests that collection scans return complete results while WiredTiger reads records ahead of the
+// scan, including across yields, concurrent deletes and a collection drop.
+// @tags: [requires_wiredtiger, requires_persistence]
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        wiredTigerCursorReadAheadRecords: 64,
+        // Yield often so that scans reposition their cursors while read-ahead is in progress.
+        internalQueryExecYieldIterations: 10,
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.wt_cursor_read_ahead;
+
+const nDocs = 5000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; i++) {
+    bulk.insert({_id: i, x: i % 10, s: "x".repeat(100)});
+}
+assert.commandWorked(bulk.execute());
+
+function checkFullScan(expectedCount) {
+    const results = coll.find({}, {s: 0}).hint({$natural: 1}).batchSize(100).toArray();
+    assert.eq(expectedCount, results.length);
+    assert.eq(expectedCount, coll.find({x: {$gte: 0}}).hint({$natural: 1}).itcount());
+}
+
+checkFullScan(nDocs);
+
+// Short scans and scans which stop early are unaffected.
+assert.eq(1, coll.find().hint({$natural: 1}).limit(1).itcount());
+
+// Read-ahead can be changed at runtime, including disabled.
+for (let records of [1, 1000, 0]) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, wiredTigerCursorReadAheadRecords: records}));
+    checkFullScan(nDocs);
+}
+assert.commandWorked(db.adminCommand({setParameter: 1, wiredTigerCursorReadAheadRecords: 64}));
+
+// Records removed while the scan is suspended are not returned.
+const cursor = coll.find({}, {_id: 1}).hint({$natural: 1}).batchSize(10);
+assert(cursor.hasNext());
+assert.commandWorked(coll.remove({_id: {$gte: nDocs / 2}}));
+assert.eq(nDocs / 2, cursor.itcount());
+checkFullScan(nDocs / 2);
+
+// The collection can be dropped after being scanned with read-ahead.
+assert(coll.drop());
+assert.eq(0, coll.find().itcount());
+
+MongoRunner.stopMongod(conn);
+})();
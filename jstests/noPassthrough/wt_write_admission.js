@@ -0,0 +1,57 @@
+// Tests that WiredTiger write admission throttling samples the cache while writes run, reports its
+// decisions in serverStatus and can be enabled and disabled at runtime.
+// @tags: [requires_wiredtiger]
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    wiredTigerCacheSizeGB: 0.25,
+    // Treat any dirty data in the cache as pressure, so that the heavy writer is throttled.
+    setParameter: {wiredTigerWriteAdmissionDirtyTriggerPercent: 1},
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+function getWriteAdmissionStats() {
+    return assert.commandWorked(db.serverStatus()).wiredTiger.writeAdmission;
+}
+
+let stats = getWriteAdmissionStats();
+assert(stats.enabled, tojson(stats));
+
+// Keep writing to a bulk-load collection, with an occasional write to a second collection, until
+// the cache has been sampled a few times.
+const bulkColl = db.bulk_load;
+const oltpColl = db.oltp;
+const payload = "x".repeat(10 * 1024);
+const startSamples = stats.samples;
+assert.soon(() => {
+    const bulk = bulkColl.initializeUnorderedBulkOp();
+    for (let i = 0; i < 100; i++) {
+        bulk.insert({payload: payload});
+    }
+    assert.commandWorked(bulk.execute());
+    assert.commandWorked(oltpColl.insert({ts: new Date()}));
+    return getWriteAdmissionStats().samples >= startSamples + 3;
+});
+
+stats = getWriteAdmissionStats();
+jsTestLog("Write admission stats: " + tojson(stats));
+assert.gt(stats.bytesWrittenLastInterval, 0, tojson(stats));
+assert.gte(stats.throttledWrites, 0, tojson(stats));
+assert.gte(stats.totalDelayMillis, 0, tojson(stats));
+assert.gt(oltpColl.find().itcount(), 0);
+
+// Disabling write admission stops throttling and sampling.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, wiredTigerWriteAdmissionDirtyTriggerPercent: 0}));
+stats = getWriteAdmissionStats();
+assert(!stats.enabled, tojson(stats));
+const samplesWhenDisabled = stats.samples;
+assert.commandWorked(bulkColl.insert({payload: payload}));
+sleep(1500);
+assert.commandWorked(bulkColl.insert({payload: payload}));
+assert.eq(samplesWhenDisabled, getWriteAdmissionStats().samples);
+
+MongoRunner.stopMongod(conn);
+})();
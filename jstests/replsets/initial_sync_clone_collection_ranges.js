@@ -0,0 +1,56 @@
+/**
+ * Test that initial sync can clone a collection in parallel _id ranges, including a collection
+ * whose _id values have mixed types.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/check_log.js");
+
+const replTest = new ReplSetTest({nodes: 1});
+replTest.startSet();
+replTest.initiate();
+
+const dbName = jsTest.name();
+const collName = "test";
+const numDocs = 2000;
+
+const primary = replTest.getPrimary();
+const primaryColl = primary.getDB(dbName)[collName];
+
+jsTestLog("Inserting documents with numeric, string and ObjectId _id values.");
+const bulk = primaryColl.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; ++i) {
+    let id = i;
+    if (i % 3 === 1) {
+        id = "str" + i;
+    } else if (i % 3 === 2) {
+        id = ObjectId();
+    }
+    bulk.insert({_id: id, x: i});
+}
+assert.commandWorked(bulk.execute());
+
+jsTestLog("Adding a secondary node that clones collections in ranges.");
+const secondary = replTest.add({
+    setParameter: {
+        collectionClonerNumRanges: 4,
+        collectionClonerRangeMinDocuments: 100,
+        collectionClonerBatchSize: 50,
+    }
+});
+replTest.reInitiate();
+
+jsTestLog("Waiting until initial sync completes.");
+replTest.awaitSecondaryNodes();
+replTest.awaitReplication();
+
+checkLog.containsJson(secondary, 5100017, {numRanges: 4});
+
+const secondaryColl = secondary.getDB(dbName)[collName];
+assert.eq(numDocs, secondaryColl.find().itcount());
+assert.eq(primaryColl.find().sort({_id: 1}).toArray(),
+          secondaryColl.find().sort({_id: 1}).toArray());
+
+replTest.stopSet();
+})();
@@ -31,7 +31,9 @@
 
 #include <benchmark/benchmark.h>
 
+#include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
 
 namespace mongo {
 
@@ -63,7 +65,113 @@ void BM_arrayLookup(benchmark::State& state) {
     state.SetItemsProcessed(totalLen);
 }
 
+// Validates a flat document with 'state.range(0)' fields of common scalar and string types.
+void BM_validateFlat(benchmark::State& state) {
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    for (auto j = 0; j < state.range(0); j++) {
+        auto fieldName = std::to_string(j);
+        switch (j % 4) {
+            case 0:
+                builder.append(fieldName, j);
+                break;
+            case 1:
+                builder.append(fieldName, static_cast<double>(j));
+                break;
+            case 2:
+                builder.append(fieldName, "a short string value");
+                break;
+            case 3:
+                builder.append(fieldName, Date_t::fromMillisSinceEpoch(j));
+                break;
+        }
+    }
+    BSONObj obj = builder.obj();
+
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+        totalBytes += obj.objsize();
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
+// Validates a document whose objects are nested 'state.range(0)' levels deep.
+void BM_validateNested(benchmark::State& state) {
+    BSONObj obj = BSON("x" << 1 << "y"
+                           << "value");
+    for (auto j = 0; j < state.range(0); j++) {
+        obj = BSON("x" << j << "sub" << obj);
+    }
+
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+        totalBytes += obj.objsize();
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
+// Parses a JSON document with 'state.range(0)' fields of strings, numbers and Extended JSON.
+void BM_fromjson(benchmark::State& state) {
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    for (auto j = 0; j < state.range(0); j++) {
+        auto fieldName = "field" + std::to_string(j);
+        switch (j % 4) {
+            case 0:
+                builder.append(fieldName, j);
+                break;
+            case 1:
+                builder.append(fieldName, static_cast<double>(j) / 3);
+                break;
+            case 2:
+                builder.append(fieldName, "a somewhat longer string value with \"escapes\"");
+                break;
+            case 3:
+                builder.append(fieldName, Date_t::fromMillisSinceEpoch(j));
+                break;
+        }
+    }
+    std::string json = builder.obj().jsonString(ExtendedCanonicalV2_0_0);
+
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fromjson(json));
+        totalBytes += json.size();
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
+// Builds an array of 'state.range(0)' small documents into a buffer that starts at the default
+// size, or that is pre-sized from the previous iteration when 'state.range(1)' is set.
+void BM_batchBuilder(benchmark::State& state) {
+    const BSONObj doc = BSON("_id" << OID::gen() << "x" << 1 << "s"
+                                   << "a short string value");
+    const bool presize = state.range(1);
+    int lastLen = 0;
+    for (auto _ : state) {
+        BufBuilder buf;
+        if (presize) {
+            buf.reserveBytes(lastLen);
+            buf.claimReservedBytes(lastLen);
+        }
+        BSONArrayBuilder array(buf);
+        for (auto j = 0; j < state.range(0); j++) {
+            array.append(doc);
+        }
+        array.done();
+        lastLen = buf.len();
+        benchmark::DoNotOptimize(buf.buf());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
+BENCHMARK(BM_validateFlat)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateNested)->Ranges({{{1}, {64}}});
+BENCHMARK(BM_fromjson)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_batchBuilder)->Ranges({{{1}, {10'000}}, {{0}, {1}}});
 
 }  // namespace mongo
@@ -1339,7 +1339,16 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
             }
             ++q;
         } else {
-            result->push_back(*q++);
+            // Copy the whole run of plain characters up to the next terminal, escape or control
+            // character with a single append, rather than growing the result byte by byte.
+            const char* runStart = q++;
+            if (allowedSet == nullptr) {
+                while (q < _input_end && *q != '\\' && !(0x00 <= *q && *q <= 0x1F) &&
+                       !match(*q, terminalSet)) {
+                    ++q;
+                }
+            }
+            result->append(runStart, q);
         }
     }
     if (q < _input_end) {
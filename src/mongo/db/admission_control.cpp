@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/admission_control.h"
+
+#include <algorithm>
+
+#include "mongo/db/admission_control_gen.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/rpc/metadata/client_metadata_ismaster.h"
+
+namespace mongo {
+namespace {
+
+TicketHolder& lowPriorityTickets() {
+    // Not built before the first operation is admitted, once startup parameters are set.
+    static TicketHolder tickets(gLowPriorityConcurrentOperations);
+    return tickets;
+}
+
+bool isLowPriority(OperationContext* opCtx, const Command& command, const OpMsgRequest& request) {
+    if (gLowPriorityAppNames.empty() || !command.requiresAuth() ||
+        opCtx->getClient()->isInDirectClient()) {
+        return false;
+    }
+
+    if (request.body.hasField("autocommit"_sd)) {
+        return false;
+    }
+
+    const auto& clientMetadata =
+        ClientMetadataIsMasterState::get(opCtx->getClient()).getClientMetadata();
+    if (!clientMetadata) {
+        return false;
+    }
+
+    const auto appName = clientMetadata->getApplicationName();
+    return std::find(gLowPriorityAppNames.begin(), gLowPriorityAppNames.end(), appName) !=
+        gLowPriorityAppNames.end();
+}
+
+class AdmissionControlSection final : public ServerStatusSection {
+public:
+    AdmissionControlSection() : ServerStatusSection("admissionControl") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement&) const override {
+        BSONObjBuilder section;
+        {
+            BSONObjBuilder lowPriority(section.subobjStart("lowPriority"));
+            if (!gLowPriorityAppNames.empty()) {
+                auto& tickets = lowPriorityTickets();
+                lowPriority.append("out", tickets.used());
+                lowPriority.append("available", tickets.available());
+                lowPriority.append("totalTickets", tickets.outof());
+            }
+            lowPriority.append("admitted", admitted.loadRelaxed());
+            lowPriority.append("shed", shed.loadRelaxed());
+        }
+        return section.obj();
+    }
+
+    AtomicWord<long long> admitted;
+    AtomicWord<long long> shed;
+} admissionControlSection;
+
+}  // namespace
+
+void admitOperation(OperationContext* opCtx,
+                    const Command& command,
+                    const OpMsgRequest& request,
+                    TicketHolderReleaser* admission) {
+    if (!isLowPriority(opCtx, command, request)) {
+        return;
+    }
+
+    auto& tickets = lowPriorityTickets();
+    const auto deadline = Date_t::now() + Milliseconds(gLowPriorityAdmissionTimeoutMS.load());
+    if (!tickets.waitForTicketUntil(opCtx, deadline)) {
+        admissionControlSection.shed.fetchAndAdd(1);
+        uasserted(ErrorCodes::ExceededTimeLimit,
+                  str::stream() << "Too many concurrent operations from low priority applications "
+                                   "to run '"
+                                << request.getCommandName() << "'");
+    }
+
+    admissionControlSection.admitted.fetchAndAdd(1);
+    admission->reset(&tickets);
+}
+
+}  // namespace mongo
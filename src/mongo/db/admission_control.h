@@ -0,0 +1,56 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/commands.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/util/concurrency/ticketholder.h"
+
+namespace mongo {
+
+/**
+ * Admits the operations of the applications listed in lowPriorityAppNames within a concurrency
+ * budget of their own, so that they cannot crowd out the rest of the workload. Operations which are
+ * not admitted within lowPriorityAdmissionTimeoutMS fail with ExceededTimeLimit, which drivers may
+ * retry.
+ *
+ * Operations of other applications, commands which don't require authentication and the
+ * statements of multi-document transactions, which may already be holding locks, are always
+ * admitted right away.
+ *
+ * On admission, 'admission' holds on to the ticket of the operation until it is destroyed.
+ */
+void admitOperation(OperationContext* opCtx,
+                    const Command& command,
+                    const OpMsgRequest& request,
+                    TicketHolderReleaser* admission);
+
+}  // namespace mongo
@@ -55,6 +55,7 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/base64.h"
+#include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/sequence_util.h"
 #include "mongo/util/str.h"
 
@@ -170,6 +171,17 @@ Status extractMechanism(const BSONObj& cmdObj, std::string* mechanism) {
     return bsonExtractStringField(cmdObj, saslCommandMechanismFieldName, mechanism);
 }
 
+/**
+ * Returns the TicketHolder bounding concurrent authentication steps, or nullptr if
+ * maxConcurrentAuthenticationSteps was not set.
+ */
+TicketHolder* getAuthenticationStepTicketHolder() {
+    static TicketHolder* const holder = saslGlobalParams.maxConcurrentAuthenticationSteps > 0
+        ? new TicketHolder(saslGlobalParams.maxConcurrentAuthenticationSteps)
+        : nullptr;
+    return holder;
+}
+
 Status doSaslStep(OperationContext* opCtx,
                   AuthenticationSession* session,
                   const BSONObj& cmdObj,
@@ -183,8 +195,17 @@ Status doSaslStep(OperationContext* opCtx,
 
     auto& mechanism = session->getMechanism();
 
+    // Under a connection storm, queue authentication work behind the configured limit so that it
+    // cannot starve operations that are already running.
+    TicketHolderReleaser stepTicket;
+    if (auto holder = getAuthenticationStepTicketHolder()) {
+        holder->waitForTicket(opCtx);
+        stepTicket.reset(holder);
+    }
+
     // Passing in a payload and extracting a responsePayload
     StatusWith<std::string> swResponse = mechanism.step(opCtx, payload);
+    stepTicket.reset();
 
     if (!swResponse.isOK()) {
         LOGV2(20249,
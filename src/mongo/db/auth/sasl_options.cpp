@@ -46,6 +46,9 @@ SASLGlobalParams::SASLGlobalParams() {
 
     // Default value for auth failed delay
     authFailedDelay.store(0);
+
+    // By default authentication steps are not throttled.
+    maxConcurrentAuthenticationSteps = 0;
 }
 
 namespace {
@@ -57,6 +57,7 @@ struct SASLGlobalParams {
     AtomicWord<int> scramSHA1IterationCount;
     AtomicWord<int> scramSHA256IterationCount;
     AtomicWord<int> authFailedDelay;
+    int maxConcurrentAuthenticationSteps;
 
     SASLGlobalParams();
 
@@ -67,15 +67,30 @@ private:
     CollectionUUID _uuid;
 };
 
+// Hands out catalog lock partitions to threads in round-robin order, so that threads doing
+// lookups at the same time are spread over distinct partitions.
+AtomicWord<unsigned> nextCatalogLockPartition{0};
+
 }  // namespace
 
+CollectionCatalog::CatalogLock::Exclusive::Exclusive(const CatalogLock& catalogLock) {
+    for (size_t i = 0; i < kNumPartitions; ++i) {
+        _locks[i] = stdx::unique_lock<Latch>(catalogLock._partitions[i].mutex);
+    }
+}
+
+Mutex& CollectionCatalog::CatalogLock::sharedPartition() const {
+    thread_local const size_t partition = nextCatalogLockPartition.fetchAndAdd(1) % kNumPartitions;
+    return _partitions[partition].mutex;
+}
+
 CollectionCatalog::iterator::iterator(StringData dbName,
                                       uint64_t genNum,
                                       const CollectionCatalog& catalog)
     : _dbName(dbName), _genNum(genNum), _catalog(&catalog) {
     auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
 
-    stdx::lock_guard<Latch> lock(_catalog->_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalog->_catalogLock.sharedPartition());
     _mapIter = _catalog->_orderedCollections.lower_bound(std::make_pair(_dbName, minUuid));
 
     // Start with the first collection that is visible outside of its transaction.
@@ -93,7 +108,7 @@ CollectionCatalog::iterator::iterator(
     : _mapIter(mapIter) {}
 
 CollectionCatalog::iterator::value_type CollectionCatalog::iterator::operator*() {
-    stdx::lock_guard<Latch> lock(_catalog->_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalog->_catalogLock.sharedPartition());
     _repositionIfNeeded();
     if (_exhausted()) {
         return _nullCollection;
@@ -107,7 +122,7 @@ boost::optional<CollectionUUID> CollectionCatalog::iterator::uuid() {
 }
 
 CollectionCatalog::iterator CollectionCatalog::iterator::operator++() {
-    stdx::lock_guard<Latch> lock(_catalog->_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalog->_catalogLock.sharedPartition());
 
     if (!_repositionIfNeeded()) {
         _mapIter++;  // If the position was not updated, increment iterator to next element.
@@ -137,7 +152,7 @@ CollectionCatalog::iterator CollectionCatalog::iterator::operator++(int) {
 }
 
 bool CollectionCatalog::iterator::operator==(const iterator& other) {
-    stdx::lock_guard<Latch> lock(_catalog->_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalog->_catalogLock.sharedPartition());
 
     if (other._mapIter == _catalog->_orderedCollections.end()) {
         return _uuid == boost::none;
@@ -201,12 +216,14 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
     // manager locks) are held. The purpose of this function is ensure that we write to the
     // Collection's namespace string under '_catalogLock'.
     invariant(coll);
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    CatalogLock::Exclusive lock(_catalogLock);
 
     coll->setNs(toCollection);
 
-    _collections[toCollection] = _collections[fromCollection];
+    // Read the entry out before inserting, as the insertion may move the map's elements.
+    Collection* const renamed = _collections[fromCollection];
     _collections.erase(fromCollection);
+    _collections[toCollection] = renamed;
 
     ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
     ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
@@ -215,11 +232,12 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
     addResource(newRid, toCollection.ns());
 
     opCtx->recoveryUnit()->onRollback([this, coll, fromCollection, toCollection] {
-        stdx::lock_guard<Latch> lock(_catalogLock);
+        CatalogLock::Exclusive lock(_catalogLock);
         coll->setNs(std::move(fromCollection));
 
-        _collections[fromCollection] = _collections[toCollection];
+        Collection* const renamed = _collections[toCollection];
         _collections.erase(toCollection);
+        _collections[fromCollection] = renamed;
 
         ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
         ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
@@ -237,7 +255,7 @@ void CollectionCatalog::onCloseDatabase(OperationContext* opCtx, std::string dbN
 
 void CollectionCatalog::onCloseCatalog(OperationContext* opCtx) {
     invariant(opCtx->lockState()->isW());
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    CatalogLock::Exclusive lock(_catalogLock);
     invariant(!_shadowCatalog);
     _shadowCatalog.emplace();
     for (auto& entry : _catalog)
@@ -246,7 +264,7 @@ void CollectionCatalog::onCloseCatalog(OperationContext* opCtx) {
 
 void CollectionCatalog::onOpenCatalog(OperationContext* opCtx) {
     invariant(opCtx->lockState()->isW());
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    CatalogLock::Exclusive lock(_catalogLock);
     invariant(_shadowCatalog);
     _shadowCatalog.reset();
 }
@@ -257,19 +275,19 @@ Collection* CollectionCatalog::lookupCollectionByUUID(OperationContext* opCtx,
         return coll;
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalogLock.sharedPartition());
     auto coll = _lookupCollectionByUUID(lock, uuid);
     return (coll && coll->isCommitted()) ? coll : nullptr;
 }
 
 void CollectionCatalog::makeCollectionVisible(CollectionUUID uuid) {
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    CatalogLock::Exclusive lock(_catalogLock);
     auto coll = _lookupCollectionByUUID(lock, uuid);
     coll->setCommitted(true);
 }
 
 bool CollectionCatalog::isCollectionAwaitingVisibility(CollectionUUID uuid) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalogLock.sharedPartition());
     auto coll = _lookupCollectionByUUID(lock, uuid);
     return coll && !coll->isCommitted();
 }
@@ -285,7 +303,7 @@ Collection* CollectionCatalog::lookupCollectionByNamespace(OperationContext* opC
         return coll;
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalogLock.sharedPartition());
     auto it = _collections.find(nss);
     auto coll = (it == _collections.end() ? nullptr : it->second);
     return (coll && coll->isCommitted()) ? coll : nullptr;
@@ -297,7 +315,7 @@ boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationCon
         return coll->ns();
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalogLock.sharedPartition());
     auto foundIt = _catalog.find(uuid);
     if (foundIt != _catalog.end()) {
         boost::optional<NamespaceString> ns = foundIt->second->ns();
@@ -322,7 +340,7 @@ boost::optional<CollectionUUID> CollectionCatalog::lookupUUIDByNSS(
         return coll->uuid();
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalogLock.sharedPartition());
     auto it = _collections.find(nss);
     if (it != _collections.end()) {
         boost::optional<CollectionUUID> uuid = it->second->uuid();
@@ -358,7 +376,7 @@ bool CollectionCatalog::checkIfCollectionSatisfiable(CollectionUUID uuid,
                                                      CollectionInfoFn predicate) const {
     invariant(predicate);
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalogLock.sharedPartition());
     auto collection = _lookupCollectionByUUID(lock, uuid);
 
     if (!collection) {
@@ -370,7 +388,7 @@ bool CollectionCatalog::checkIfCollectionSatisfiable(CollectionUUID uuid,
 
 std::vector<CollectionUUID> CollectionCatalog::getAllCollectionUUIDsFromDb(
     StringData dbName) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalogLock.sharedPartition());
     auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
     auto it = _orderedCollections.lower_bound(std::make_pair(dbName.toString(), minUuid));
 
@@ -388,7 +406,7 @@ std::vector<NamespaceString> CollectionCatalog::getAllCollectionNamesFromDb(
     OperationContext* opCtx, StringData dbName) const {
     invariant(opCtx->lockState()->isDbLockedForMode(dbName, MODE_S));
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalogLock.sharedPartition());
     auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
 
     std::vector<NamespaceString> ret;
@@ -404,7 +422,7 @@ std::vector<NamespaceString> CollectionCatalog::getAllCollectionNamesFromDb(
 
 std::vector<std::string> CollectionCatalog::getAllDbNames() const {
     std::vector<std::string> ret;
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    stdx::lock_guard<Latch> lock(_catalogLock.sharedPartition());
     auto maxUuid = UUID::parse("FFFFFFFF-FFFF-FFFF-FFFF-FFFFFFFFFFFF").getValue();
     auto iter = _orderedCollections.upper_bound(std::make_pair("", maxUuid));
     while (iter != _orderedCollections.end()) {
@@ -425,7 +443,7 @@ std::vector<std::string> CollectionCatalog::getAllDbNames() const {
 
 void CollectionCatalog::registerCollection(CollectionUUID uuid, std::unique_ptr<Collection>* coll) {
     auto ns = (*coll)->ns();
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    CatalogLock::Exclusive lock(_catalogLock);
     if (_collections.find(ns) != _collections.end()) {
         LOGV2(20279,
               "Conflicted creating a collection. ns: {coll_ns} ({coll_uuid}).",
@@ -459,7 +477,7 @@ void CollectionCatalog::registerCollection(CollectionUUID uuid, std::unique_ptr<
 }
 
 std::unique_ptr<Collection> CollectionCatalog::deregisterCollection(CollectionUUID uuid) {
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    CatalogLock::Exclusive lock(_catalogLock);
 
     invariant(_catalog.find(uuid) != _catalog.end());
 
@@ -498,7 +516,7 @@ std::unique_ptr<RecoveryUnit::Change> CollectionCatalog::makeFinishDropCollectio
 }
 
 void CollectionCatalog::deregisterAllCollections() {
-    stdx::lock_guard<Latch> lock(_catalogLock);
+    CatalogLock::Exclusive lock(_catalogLock);
 
     LOGV2(20282, "Deregistering all the collections");
     for (auto& entry : _catalog) {
@@ -29,13 +29,16 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <map>
 #include <set>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/service_context.h"
+#include "mongo/stdx/new.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/flat_hash_map.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -262,7 +265,51 @@ private:
 
     const std::vector<CollectionUUID>& _getOrdering_inlock(const StringData& db,
                                                            const stdx::lock_guard<Latch>&);
-    mutable mongo::Mutex _catalogLock;
+
+    /**
+     * Guards the catalog maps. The lock is split into partitions on distinct cache lines. Lookups
+     * only lock the partition assigned to the calling thread, so concurrent lookups from different
+     * threads do not serialize on a single mutex. Modifications of the catalog lock every
+     * partition, always in the same order.
+     */
+    class CatalogLock {
+    public:
+        static constexpr size_t kNumPartitions = 16;
+
+        /**
+         * Holds every partition of a CatalogLock for the lifetime of this object.
+         */
+        class Exclusive {
+        public:
+            explicit Exclusive(const CatalogLock& catalogLock);
+
+            operator WithLock() const {
+                return WithLock(_locks.front());
+            }
+
+        private:
+            std::array<stdx::unique_lock<Latch>, kNumPartitions> _locks;
+        };
+
+        /**
+         * Returns the partition which lookups performed by the calling thread should lock.
+         */
+        Mutex& sharedPartition() const;
+
+    private:
+        struct Partition {
+            Mutex mutex;
+
+            // Keeps the mutexes of neighbouring partitions on distinct cache lines. Padding is used
+            // rather than alignas because the catalog lives in a ServiceContext decoration, whose
+            // storage does not honour over-aligned types.
+            char padding[stdx::hardware_destructive_interference_size];
+        };
+
+        mutable std::array<Partition, kNumPartitions> _partitions;
+    };
+
+    CatalogLock _catalogLock;
 
     /**
      * When present, indicates that the catalog is in closed state, and contains a map from UUID
@@ -275,7 +322,7 @@ private:
     using CollectionCatalogMap = mongo::stdx::
         unordered_map<CollectionUUID, std::unique_ptr<Collection>, CollectionUUID::Hash>;
     using OrderedCollectionMap = std::map<std::pair<std::string, CollectionUUID>, Collection*>;
-    using NamespaceCollectionMap = mongo::stdx::unordered_map<NamespaceString, Collection*>;
+    using NamespaceCollectionMap = FlatHashMap<NamespaceString, Collection*>;
     CollectionCatalogMap _catalog;
     OrderedCollectionMap _orderedCollections;  // Ordered by <dbName, collUUID> pair
     NamespaceCollectionMap _collections;
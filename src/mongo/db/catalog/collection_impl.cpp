@@ -719,6 +719,24 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
     }
 }
 
+void CollectionImpl::_checkValidationForUpdate(OperationContext* opCtx,
+                                               const BSONObj& oldDoc,
+                                               const BSONObj& newDoc) const {
+    auto status = checkValidation(opCtx, newDoc);
+    if (!status.isOK()) {
+        if (_validationLevel == ValidationLevel::STRICT_V) {
+            uassertStatusOK(status);
+        }
+        // moderate means we have to check the old doc
+        auto oldDocStatus = checkValidation(opCtx, oldDoc);
+        if (oldDocStatus.isOK()) {
+            // transitioning from good -> bad is not ok
+            uassertStatusOK(status);
+        }
+        // bad -> bad is ok in moderate mode
+    }
+}
+
 Counter64 moveCounter;
 ServerStatusMetricField<Counter64> moveCounterDisplay("record.moves", &moveCounter);
 
@@ -729,21 +747,7 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
                                         bool indexesAffected,
                                         OpDebug* opDebug,
                                         CollectionUpdateArgs* args) {
-    {
-        auto status = checkValidation(opCtx, newDoc);
-        if (!status.isOK()) {
-            if (_validationLevel == ValidationLevel::STRICT_V) {
-                uassertStatusOK(status);
-            }
-            // moderate means we have to check the old doc
-            auto oldDocStatus = checkValidation(opCtx, oldDoc.value());
-            if (oldDocStatus.isOK()) {
-                // transitioning from good -> bad is not ok
-                uassertStatusOK(status);
-            }
-            // bad -> bad is ok in moderate mode
-        }
-    }
+    _checkValidationForUpdate(opCtx, oldDoc.value(), newDoc);
 
     dassert(opCtx->lockState()->isCollectionLockedForMode(ns(), MODE_IX));
     invariant(oldDoc.snapshotId() == opCtx->recoveryUnit()->getSnapshotId());
@@ -809,7 +813,7 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
 }
 
 bool CollectionImpl::updateWithDamagesSupported() const {
-    if (!_validator.isOK() || _validator.filter.getValue() != nullptr)
+    if (!_validator.isOK())
         return false;
 
     return _recordStore->updateWithDamagesSupported();
@@ -838,6 +842,12 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
 
     if (newRecStatus.isOK()) {
         args->updatedDoc = newRecStatus.getValue().toBson();
+
+        // The storage engine applied the damages, so the resulting document can only be validated
+        // now. A failure throws, which aborts the enclosing WriteUnitOfWork and undoes the write.
+        if (_validator.filter.getValue()) {
+            _checkValidationForUpdate(opCtx, oldRec.value().toBson(), args->updatedDoc);
+        }
         args->preImageRecordingEnabledForCollection = getRecordPreImages();
         OplogUpdateEntryArgs entryArgs(*args, ns(), _uuid);
         getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, entryArgs);
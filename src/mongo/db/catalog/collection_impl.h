@@ -362,6 +362,14 @@ private:
      */
     Status checkValidation(OperationContext* opCtx, const BSONObj& document) const;
 
+    /**
+     * Throws if replacing 'oldDoc' with 'newDoc' is not allowed by this collection's validator and
+     * validation level.
+     */
+    void _checkValidationForUpdate(OperationContext* opCtx,
+                                   const BSONObj& oldDoc,
+                                   const BSONObj& newDoc) const;
+
     Status aboutToDeleteCapped(OperationContext* opCtx, const RecordId& loc, RecordData data);
 
     /**
@@ -36,7 +36,9 @@
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_validation.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/repl/storage_interface_impl.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
@@ -48,6 +50,7 @@ using namespace mongo;
 class CollectionTest : public CatalogTestFixture {
 protected:
     void makeCapped(NamespaceString nss, long long cappedSize = 8192);
+    void makeCollectionWithIndex(NamespaceString nss, const BSONObj& indexSpec);
 };
 
 void CollectionTest::makeCapped(NamespaceString nss, long long cappedSize) {
@@ -57,6 +60,65 @@ void CollectionTest::makeCapped(NamespaceString nss, long long cappedSize) {
     ASSERT_OK(storageInterface()->createCollection(operationContext(), nss, options));
 }
 
+void CollectionTest::makeCollectionWithIndex(NamespaceString nss, const BSONObj& indexSpec) {
+    auto opCtx = operationContext();
+    ASSERT_OK(storageInterface()->createCollection(opCtx, nss, CollectionOptions()));
+
+    AutoGetCollection autoColl(opCtx, nss, MODE_X);
+    WriteUnitOfWork wuow(opCtx);
+    ASSERT_OK(autoColl.getCollection()
+                  ->getIndexCatalog()
+                  ->createIndexOnEmptyCollection(opCtx, indexSpec)
+                  .getStatus());
+    wuow.commit();
+}
+
+TEST_F(CollectionTest, MultiDocumentInsertIndexesEveryKeyAndMarksMultikey) {
+    NamespaceString nss("test.t");
+    makeCollectionWithIndex(nss, BSON("v" << 2 << "key" << BSON("a" << 1) << "name"
+                                          << "a_1"));
+
+    auto opCtx = operationContext();
+    AutoGetCollection autoColl(opCtx, nss, MODE_IX);
+    Collection* coll = autoColl.getCollection();
+
+    // Insert documents whose keys are out of order, so that they are reordered within the batch.
+    std::vector<InsertStatement> inserts;
+    for (int i = 0; i < 10; ++i) {
+        inserts.emplace_back(BSON("_id" << i << "a" << BSON_ARRAY(10 - i << 100 + i)));
+    }
+    {
+        WriteUnitOfWork wuow(opCtx);
+        ASSERT_OK(coll->insertDocuments(opCtx, inserts.begin(), inserts.end(), nullptr, false));
+        wuow.commit();
+    }
+
+    auto indexCatalog = coll->getIndexCatalog();
+    auto desc = indexCatalog->findIndexByName(opCtx, "a_1");
+    ASSERT(desc);
+    auto entry = indexCatalog->getEntry(desc);
+    ASSERT_TRUE(entry->isMultikey());
+    ASSERT_EQ(20, entry->accessMethod()->getSortedDataInterface()->numEntries(opCtx));
+}
+
+TEST_F(CollectionTest, MultiDocumentInsertDetectsDuplicatesWithinBatch) {
+    NamespaceString nss("test.t");
+    makeCollectionWithIndex(nss, BSON("v" << 2 << "key" << BSON("a" << 1) << "name"
+                                          << "a_1"
+                                          << "unique" << true));
+
+    auto opCtx = operationContext();
+    AutoGetCollection autoColl(opCtx, nss, MODE_IX);
+    Collection* coll = autoColl.getCollection();
+
+    std::vector<InsertStatement> inserts{InsertStatement(BSON("_id" << 0 << "a" << 2)),
+                                         InsertStatement(BSON("_id" << 1 << "a" << 1)),
+                                         InsertStatement(BSON("_id" << 2 << "a" << 2))};
+    WriteUnitOfWork wuow(opCtx);
+    ASSERT_EQ(ErrorCodes::DuplicateKey,
+              coll->insertDocuments(opCtx, inserts.begin(), inserts.end(), nullptr, false));
+}
+
 TEST_F(CollectionTest, CappedNotifierKillAndIsDead) {
     NamespaceString nss("test.t");
     makeCapped(nss);
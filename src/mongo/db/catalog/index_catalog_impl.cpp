@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/index_catalog_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/init.h"
@@ -1371,6 +1372,17 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, index->descriptor(), &options);
 
+    // When a batch of records is written at a single timestamp, its keys can be inserted in key
+    // order rather than document by document, so that consecutive inserts land next to each other
+    // in the index. Records written at different timestamps must be indexed in timestamp order.
+    if (bsonRecords.size() > 1 && !index->isHybridBuilding() &&
+        std::all_of(bsonRecords.begin(), bsonRecords.end(), [&](const BsonRecord& bsonRecord) {
+            return bsonRecord.ts == bsonRecords.front().ts;
+        })) {
+        return _indexFilteredRecordsInKeyOrder(
+            opCtx, index, bsonRecords, options, keysInsertedOut);
+    }
+
     for (auto bsonRecord : bsonRecords) {
         invariant(bsonRecord.id != RecordId());
 
@@ -1410,6 +1422,60 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status IndexCatalogImpl::_indexFilteredRecordsInKeyOrder(OperationContext* opCtx,
+                                                         IndexCatalogEntry* index,
+                                                         const std::vector<BsonRecord>& bsonRecords,
+                                                         const InsertDeleteOptions& options,
+                                                         int64_t* keysInsertedOut) {
+    const auto& ts = bsonRecords.front().ts;
+    if (!ts.isNull()) {
+        Status status = opCtx->recoveryUnit()->setTimestamp(ts);
+        if (!status.isOK())
+            return status;
+    }
+
+    auto iam = index->accessMethod();
+    std::vector<KeyString::Value> keys;
+    KeyStringSet multikeyMetadataKeys;
+    for (const auto& bsonRecord : bsonRecords) {
+        invariant(bsonRecord.id != RecordId());
+
+        KeyStringSet docKeys;
+        KeyStringSet docMultikeyMetadataKeys;
+        MultikeyPaths multikeyPaths;
+        iam->getKeys(*bsonRecord.docPtr,
+                     options.getKeysMode,
+                     IndexAccessMethod::GetKeysContext::kReadOrAddKeys,
+                     &docKeys,
+                     &docMultikeyMetadataKeys,
+                     &multikeyPaths,
+                     bsonRecord.id,
+                     IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        if (iam->shouldMarkIndexAsMultikey(
+                docKeys.size(),
+                {docMultikeyMetadataKeys.begin(), docMultikeyMetadataKeys.end()},
+                multikeyPaths)) {
+            index->setMultikey(opCtx, multikeyPaths);
+        }
+        keys.insert(keys.end(), docKeys.begin(), docKeys.end());
+        multikeyMetadataKeys.insert(docMultikeyMetadataKeys.begin(),
+                                    docMultikeyMetadataKeys.end());
+    }
+
+    // Multikey metadata keys are shared by documents with the same multikey paths, so each only
+    // needs to be written once. As in insertKeys(), they are inserted after the data keys.
+    std::sort(keys.begin(), keys.end());
+    keys.insert(keys.end(), multikeyMetadataKeys.begin(), multikeyMetadataKeys.end());
+
+    InsertResult result;
+    Status status = iam->insertKeysFromMultipleDocuments(opCtx, keys, options, &result);
+    if (keysInsertedOut) {
+        *keysInsertedOut += result.numInserted;
+    }
+    return status;
+}
+
 Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
                                        IndexCatalogEntry* index,
                                        const std::vector<BsonRecord>& bsonRecords,
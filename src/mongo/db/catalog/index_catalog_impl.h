@@ -321,6 +321,16 @@ private:
                                  const std::vector<BsonRecord>& bsonRecords,
                                  int64_t* keysInsertedOut);
 
+    /**
+     * Generates the keys of every record in 'bsonRecords' and inserts them into 'index' in key
+     * order. All of the records must share the same timestamp.
+     */
+    Status _indexFilteredRecordsInKeyOrder(OperationContext* opCtx,
+                                           IndexCatalogEntry* index,
+                                           const std::vector<BsonRecord>& bsonRecords,
+                                           const InsertDeleteOptions& options,
+                                           int64_t* keysInsertedOut);
+
     Status _indexRecords(OperationContext* opCtx,
                          IndexCatalogEntry* index,
                          const std::vector<BsonRecord>& bsonRecords,
@@ -302,6 +302,21 @@ public:
         _leftoverMaxTimeMicros = leftoverMaxTimeMicros;
     }
 
+    /**
+     * Returns the size in bytes of the batch built by the last getMore on this cursor, or 0 if
+     * there has been no getMore yet. Used to pre-size the reply buffer for the next getMore.
+     */
+    std::size_t getLastBatchBytes() const {
+        return _lastBatchBytes;
+    }
+
+    /**
+     * Sets the size in bytes of the batch built by the current getMore.
+     */
+    void setLastBatchBytes(std::size_t bytes) {
+        _lastBatchBytes = bytes;
+    }
+
     /**
      * Returns the commit point at the time the last batch was returned.
      */
@@ -407,6 +422,9 @@ private:
     // Tracks the number of batches returned by this cursor so far.
     std::uint64_t _nBatchesReturned = 0;
 
+    // Size in bytes of the batch returned by the last getMore on this cursor.
+    std::size_t _lastBatchBytes = 0;
+
     // Holds an owned copy of the command specification received from the client.
     const BSONObj _originatingCommand;
 
@@ -572,6 +572,16 @@ public:
 
             CursorId respondWithId = 0;
 
+            // Batches of a cursor tend to be of similar size, so pre-size the reply from the last
+            // one rather than letting the buffer double its way up from its initial size.
+            auto bytesToReserve = cursorPin->getLastBatchBytes();
+            // SERVER-22100: As in runCommandImpl, do not pre-allocate in Windows DEBUG builds.
+#ifdef _WIN32
+            if (kDebugBuild)
+                bytesToReserve = 0;
+#endif
+            reply->reserveBytes(bytesToReserve);
+
             CursorResponseBuilder nextBatch(reply, CursorResponseBuilder::Options());
             BSONObj obj;
             PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
@@ -650,6 +660,7 @@ public:
                 cursorPin->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
                 cursorPin->incNReturnedSoFar(numResults);
                 cursorPin->incNBatches();
+                cursorPin->setLastBatchBytes(nextBatch.bytesUsed());
 
                 if (opCtx->isExhaust() && !clientsLastKnownCommittedOpTime(opCtx).isNull()) {
                     // Set the commit point of the latest batch.
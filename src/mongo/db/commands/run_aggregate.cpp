@@ -47,9 +47,11 @@
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/aggregation_result_cache.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/pipeline.h"
@@ -61,10 +63,12 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/speculative_majority_read_info.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/service_context.h"
@@ -114,17 +118,122 @@ bool canOptimizeAwayPipeline(const Pipeline* pipeline,
         !request.getExchangeSpec();
 }
 
+/**
+ * Names of stages, expressions and match operators whose output depends on more than the contents
+ * of the collection being aggregated, or which have side effects. Aggregations which mention any of
+ * these are never answered from the AggregationResultCache.
+ */
+const StringData kResultCacheIneligibleNames[] = {"$sample"_sd,
+                                                  "$rand"_sd,
+                                                  "$function"_sd,
+                                                  "$accumulator"_sd,
+                                                  "$where"_sd,
+                                                  "$currentOp"_sd,
+                                                  "$collStats"_sd,
+                                                  "$indexStats"_sd,
+                                                  "$planCacheStats"_sd,
+                                                  "$listLocalSessions"_sd,
+                                                  "$listSessions"_sd,
+                                                  "$out"_sd,
+                                                  "$merge"_sd};
+
+bool referencesResultCacheIneligibleState(const BSONObj& spec) {
+    for (auto&& elem : spec) {
+        if (std::find(std::begin(kResultCacheIneligibleNames),
+                      std::end(kResultCacheIneligibleNames),
+                      elem.fieldNameStringData()) != std::end(kResultCacheIneligibleNames)) {
+            return true;
+        }
+        if (elem.type() == BSONType::String) {
+            auto str = elem.valueStringData();
+            if (str.startsWith("$$NOW") || str.startsWith("$$CLUSTER_TIME")) {
+                return true;
+            }
+        }
+        if (elem.isABSONObj() && referencesResultCacheIneligibleState(elem.Obj())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns true if the results of this aggregation are a pure function of the request and the
+ * current contents of 'collection', so that they may be served from, and stored in, the
+ * AggregationResultCache.
+ */
+bool isEligibleForResultCache(OperationContext* opCtx,
+                              const AggregationRequest& request,
+                              const LiteParsedPipeline& liteParsedPipeline,
+                              const Collection* collection) {
+    if (!AggregationResultCache::isEnabled() || !collection || collection->isCapped()) {
+        return false;
+    }
+
+    if (request.getExplain() || request.getExchangeSpec() || request.isFromMongos() ||
+        request.getRuntimeConstants() || request.getBatchSize() == 0 ||
+        liteParsedPipeline.hasChangeStream() ||
+        !liteParsedPipeline.getInvolvedNamespaces().empty()) {
+        return false;
+    }
+
+    if (opCtx->inMultiDocumentTransaction() || ShardingState::get(opCtx)->enabled()) {
+        return false;
+    }
+
+    // Secondaries read at lastApplied, which advances only after the applied writes have committed
+    // and invalidated the cache. A result computed in between would predate a write the cache has
+    // already accounted for, so only a node which accepts writes serves or stores results.
+    if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collection->ns())) {
+        return false;
+    }
+
+    // Only reads of the latest local data are tracked by the cache's invalidation.
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if ((readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern &&
+         readConcernArgs.getLevel() != repl::ReadConcernLevel::kAvailableReadConcern) ||
+        readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime() ||
+        readConcernArgs.getArgsOpTime()) {
+        return false;
+    }
+
+    return std::none_of(request.getPipeline().begin(),
+                        request.getPipeline().end(),
+                        [](const BSONObj& stage) {
+                            return referencesResultCacheIneligibleState(stage);
+                        });
+}
+
+/**
+ * Builds the part of the AggregationResultCache key which describes the request. The batch size is
+ * included so that a cached result always fits in the first batch of the request it answers, and
+ * 'allowDiskUse' so that a request which would exceed the memory limit is not answered from the
+ * results of one which was allowed to spill.
+ */
+BSONObj makeResultCacheKey(const AggregationRequest& request) {
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("pipeline", request.getPipeline());
+    keyBuilder.append("collation", request.getCollation());
+    keyBuilder.append("hint", request.getHint());
+    keyBuilder.append("batchSize", request.getBatchSize());
+    keyBuilder.append("allowDiskUse", request.shouldAllowDiskUse());
+    return keyBuilder.obj();
+}
+
 /**
  * Returns true if we need to keep a ClientCursor saved for this pipeline (for future getMore
  * requests). Otherwise, returns false. The passed 'nsForCursor' is only used to determine the
  * namespace used in the returned cursor, which will be registered with the global cursor manager,
  * and thus will be different from that in 'request'.
+ *
+ * If 'batchResults' is non-null, every document added to the first batch is also appended to it.
  */
 bool handleCursorCommand(OperationContext* opCtx,
                          const NamespaceString& nsForCursor,
                          std::vector<ClientCursor*> cursors,
                          const AggregationRequest& request,
-                         rpc::ReplyBuilderInterface* result) {
+                         rpc::ReplyBuilderInterface* result,
+                         std::vector<BSONObj>* batchResults = nullptr) {
     invariant(!cursors.empty());
     long long batchSize = request.getBatchSize();
 
@@ -227,6 +336,9 @@ bool handleCursorCommand(OperationContext* opCtx,
         // If this executor produces a postBatchResumeToken, add it to the cursor response.
         responseBuilder.setPostBatchResumeToken(exec->getPostBatchResumeToken());
         responseBuilder.append(next);
+        if (batchResults) {
+            batchResults->push_back(next.getOwned());
+        }
     }
 
     if (cursor) {
@@ -430,6 +542,16 @@ std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> createExchangePipelinesI
         boost::intrusive_ptr<Exchange> exchange =
             new Exchange(request.getExchangeSpec().get(), std::move(pipeline));
 
+        // When the exchange routes all documents of a group to the same consumer, a trailing
+        // $group can be evaluated by every consumer in parallel rather than by whichever consumer
+        // happens to be loading the shared input pipeline.
+        BSONObj consumerGroupSpec;
+        if (internalDocumentSourceExchangeParallelizesGroup.load()) {
+            if (auto group = exchange->detachPartitionedGroup()) {
+                consumerGroupSpec = group->serialize().getDocument().toBson();
+            }
+        }
+
         for (size_t idx = 0; idx < exchange->getConsumers(); ++idx) {
             // For every new pipeline we have create a new ExpressionContext as the context
             // cannot be shared between threads. There is no synchronization for pieces of
@@ -445,7 +567,12 @@ std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> createExchangePipelinesI
             // DocumentSourceExchange.
             boost::intrusive_ptr<DocumentSource> consumer = new DocumentSourceExchange(
                 expCtx, exchange, idx, expCtx->mongoProcessInterface->getResourceYielder());
-            pipelines.emplace_back(Pipeline::create({consumer}, expCtx));
+            Pipeline::SourceContainer sources{consumer};
+            if (!consumerGroupSpec.isEmpty()) {
+                sources.push_back(
+                    DocumentSourceGroup::createFromBson(consumerGroupSpec.firstElement(), expCtx));
+            }
+            pipelines.emplace_back(Pipeline::create(std::move(sources), expCtx));
         }
     } else {
         pipelines.emplace_back(std::move(pipeline));
@@ -514,6 +641,11 @@ Status runAggregate(OperationContext* opCtx,
     std::vector<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> execs;
     boost::intrusive_ptr<ExpressionContext> expCtx;
     auto curOp = CurOp::get(opCtx);
+
+    // Set if the results of this aggregation may be stored in the AggregationResultCache, along
+    // with the collection's cache generation as of before the aggregation began executing.
+    boost::optional<BSONObj> resultCacheKey;
+    uint64_t resultCacheGeneration = 0;
     {
         // If we are in a transaction, check whether the parsed pipeline supports
         // being in a transaction.
@@ -615,6 +747,31 @@ Status runAggregate(OperationContext* opCtx,
             return status;
         }
 
+        // Answer the aggregation from the result cache if an identical one was run recently. The
+        // generation must be read before the pipeline starts reading from the collection.
+        if (isEligibleForResultCache(opCtx, request, liteParsedPipeline, collection)) {
+            invariant(uuid);
+            auto resultCache = AggregationResultCache::get(opCtx);
+            resultCacheKey = makeResultCacheKey(request);
+            resultCacheGeneration = resultCache->getGeneration(*uuid);
+
+            const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+            if (auto cachedResults = resultCache->lookup(*uuid, *resultCacheKey, now)) {
+                CursorResponseBuilder::Options options;
+                options.isInitialResponse = true;
+                CursorResponseBuilder responseBuilder(result, options);
+                for (auto&& obj : *cachedResults) {
+                    responseBuilder.append(obj);
+                }
+                responseBuilder.done(0LL, origNss.ns());
+
+                liteParsedPipeline.tickGlobalStageCounters();
+                curOp->debug().nreturned = cachedResults->size();
+                curOp->debug().cursorExhausted = true;
+                return Status::OK();
+            }
+        }
+
         invariant(collatorToUse);
         expCtx = makeExpressionContext(opCtx, request, std::move(*collatorToUse), uuid);
 
@@ -795,10 +952,23 @@ Status runAggregate(OperationContext* opCtx,
         }
     } else {
         // Cursor must be specified, if explain is not.
-        const bool keepCursor =
-            handleCursorCommand(opCtx, origNss, std::move(cursors), request, result);
+        std::vector<BSONObj> batchResults;
+        const bool keepCursor = handleCursorCommand(opCtx,
+                                                    origNss,
+                                                    std::move(cursors),
+                                                    request,
+                                                    result,
+                                                    resultCacheKey ? &batchResults : nullptr);
         if (keepCursor) {
             cursorFreer.dismiss();
+        } else if (resultCacheKey) {
+            // The whole result fit in the first batch, so it can be replayed from the cache.
+            AggregationResultCache::get(opCtx)->insert(
+                *uuid,
+                *resultCacheKey,
+                std::move(batchResults),
+                resultCacheGeneration,
+                opCtx->getServiceContext()->getFastClockSource()->now());
         }
 
         PlanSummaryStats stats;
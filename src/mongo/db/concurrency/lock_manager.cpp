@@ -871,35 +871,56 @@ void LockManager::_buildLocksArray(const std::map<LockerId, BSONObj>& lockToClie
             if (lock->grantedList.empty())
                 continue;
             auto o = BSONObjBuilder(locks->subobjStart());
-            if (forLogging)
-                o.append("lockAddr", formatPtr(lock));
-            o.append("resourceId", lock->resourceId.toString());
-            struct {
-                StringData key;
-                LockRequest* iter;
-            } lists[] = {
-                {"granted"_sd, lock->grantedList._front},
-                {"pending"_sd, lock->conflictList._front},
-            };
-            for (auto [key, iter] : lists) {
-                auto arr = BSONArrayBuilder(o.subarrayStart(key));
-                for (; iter; iter = iter->next) {
-                    auto req = BSONObjBuilder(arr.subobjStart());
-                    if (forLogging) {
-                        req.append("lockRequest", formatHex(iter->locker->getId()));
-                        req.append("lockRequestAddr", formatPtr(iter->locker));
-                        req.append("thread", formatThreadId(iter->locker->getThreadId()));
-                    }
-                    req.append("mode", modeName(iter->mode));
-                    req.append("convertMode", modeName(iter->convertMode));
-                    req.append("enqueueAtFront", iter->enqueueAtFront);
-                    req.append("compatibleFirst", iter->compatibleFirst);
-                    req.append("debugInfo", iter->locker->getDebugInfo());
-                    if (auto it = lockToClientMap.find(iter->locker->getId());
-                        it != lockToClientMap.end()) {
-                        req.append("clientInfo", it->second);
-                    }
-                }
+            _appendLockInfo(lock, lockToClientMap, forLogging, &o);
+        }
+    }
+}
+
+BSONObj LockManager::getLockInfoBSON(ResourceId resId,
+                                     const std::map<LockerId, BSONObj>& lockToClientMap) const {
+    LockBucket* bucket = _getBucket(resId);
+    stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+
+    auto it = bucket->data.find(resId);
+    if (it == bucket->data.end() || it->second->grantedList.empty())
+        return BSONObj();
+
+    BSONObjBuilder o;
+    _appendLockInfo(it->second, lockToClientMap, false, &o);
+    return o.obj();
+}
+
+void LockManager::_appendLockInfo(const LockHead* lock,
+                                  const std::map<LockerId, BSONObj>& lockToClientMap,
+                                  bool forLogging,
+                                  BSONObjBuilder* o) const {
+    if (forLogging)
+        o->append("lockAddr", formatPtr(lock));
+    o->append("resourceId", lock->resourceId.toString());
+    struct {
+        StringData key;
+        LockRequest* iter;
+    } lists[] = {
+        {"granted"_sd, lock->grantedList._front},
+        {"pending"_sd, lock->conflictList._front},
+    };
+    for (auto [key, iter] : lists) {
+        auto arr = BSONArrayBuilder(o->subarrayStart(key));
+        for (; iter; iter = iter->next) {
+            auto req = BSONObjBuilder(arr.subobjStart());
+            if (forLogging) {
+                req.append("lockRequest", formatHex(iter->locker->getId()));
+                req.append("lockRequestAddr", formatPtr(iter->locker));
+                req.append("thread", formatThreadId(iter->locker->getThreadId()));
+            }
+            req.append("mode", modeName(iter->mode));
+            req.append("convertMode", modeName(iter->convertMode));
+            req.append("enqueueAtFront", iter->enqueueAtFront);
+            req.append("compatibleFirst", iter->compatibleFirst);
+            req.append("debugInfo", iter->locker->getDebugInfo());
+            if (auto it = lockToClientMap.find(iter->locker->getId());
+                it != lockToClientMap.end()) {
+                req.append("clientInfo", it->second);
             }
         }
     }
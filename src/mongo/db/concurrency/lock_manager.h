@@ -42,8 +42,9 @@
 #include "mongo/platform/compiler.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
-#include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/flat_hash_map.h"
 
 namespace mongo {
 
@@ -151,6 +152,14 @@ public:
     void getLockInfoBSON(const std::map<LockerId, BSONObj>& lockToClientMap,
                          BSONObjBuilder* result);
 
+    /**
+     * Returns the granted and pending requests on the resource 'resId', in the format of a single
+     * element of the "lockInfo" array built by getLockInfoBSON. Returns an empty object if no
+     * requests are granted on 'resId'.
+     */
+    BSONObj getLockInfoBSON(ResourceId resId,
+                            const std::map<LockerId, BSONObj>& lockToClientMap) const;
+
 private:
     // The lockheads need access to the partitions
     friend struct LockHead;
@@ -159,18 +168,19 @@ private:
 
     struct LockBucket {
         SimpleMutex mutex;
-        typedef stdx::unordered_map<ResourceId, LockHead*> Map;
+        typedef FlatHashMap<ResourceId, LockHead*> Map;
         Map data;
         LockHead* findOrInsert(ResourceId resId);
     };
 
     // Each locker maps to a partition that is used for resources acquired in intent modes
     // modes and potentially other modes that don't conflict with themselves. This avoids
-    // contention on the regular LockHead in the lock manager.
-    struct Partition {
+    // contention on the regular LockHead in the lock manager. Partitions are used by different
+    // threads at the same time, so each gets its own cache line.
+    struct alignas(stdx::hardware_destructive_interference_size) Partition {
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
-        typedef stdx::unordered_map<ResourceId, PartitionedLockHead*> Map;
+        typedef FlatHashMap<ResourceId, PartitionedLockHead*> Map;
         SimpleMutex mutex;
         Map data;
     };
@@ -197,6 +207,15 @@ private:
                           LockManager* mutableThis,
                           BSONArrayBuilder* buckets) const;
 
+    /**
+     * Appends the description of the granted and pending requests on 'lock' to 'result'. MUST be
+     * called under the lock bucket's mutex.
+     */
+    void _appendLockInfo(const LockHead* lock,
+                         const std::map<LockerId, BSONObj>& lockToClientMap,
+                         bool forLogging,
+                         BSONObjBuilder* result) const;
+
     /**
      * Should be invoked when the state of a lock changes in a way, which could potentially
      * allow other blocked requests to proceed.
@@ -38,6 +38,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/json.h"
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
+#include "mongo/db/concurrency/lock_state_gen.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/flow_control.h"
@@ -50,6 +51,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -350,10 +352,15 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
         auto restoreStateOnErrorGuard = makeGuard([&] { _clientState.store(kInactive); });
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
-        if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
-            return false;
+        if (!holder->tryAcquire()) {
+            Timer queuedTimer;
+            ON_BLOCK_EXIT([&] { _timeQueuedForTicket += Microseconds(queuedTimer.micros()); });
+
+            if (deadline == Date_t::max()) {
+                holder->waitForTicket(interruptible);
+            } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+                return false;
+            }
         }
         restoreStateOnErrorGuard.dismiss();
     }
@@ -930,8 +937,19 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
         timeout = Milliseconds::max();
     }
 
-    // Don't go sleeping without bound in order to be able to report long waits.
-    Milliseconds waitTime = std::min(timeout, MaxWaitTime);
+    // Don't go sleeping without bound in order to be able to report long waits. When slow lock
+    // waits are logged, also wake up once the threshold is reached so that the operations holding
+    // the resource can be reported while they still hold it.
+    const auto slowLockWaitThreshold = Milliseconds(gSlowLockWaitThresholdMillis.load());
+    bool reportedSlowLockWait = false;
+    const auto maxWaitTime = [&](Milliseconds totalBlockTime) {
+        if (slowLockWaitThreshold > totalBlockTime) {
+            return std::min(MaxWaitTime, slowLockWaitThreshold - totalBlockTime);
+        }
+        return MaxWaitTime;
+    };
+
+    Milliseconds waitTime = std::min(timeout, maxWaitTime(Milliseconds(0)));
     const uint64_t startOfTotalWaitTime = curTimeMicros64();
     uint64_t startOfCurrentWaitTime = startOfTotalWaitTime;
 
@@ -958,15 +976,24 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
         if (result == LOCK_OK)
             break;
 
+        const auto totalBlockTime = duration_cast<Milliseconds>(
+            Microseconds(int64_t(curTimeMicros - startOfTotalWaitTime)));
+
+        if (slowLockWaitThreshold > Milliseconds(0) && !reportedSlowLockWait &&
+            totalBlockTime >= slowLockWaitThreshold) {
+            _logSlowLockWait(opCtx, resId, mode, totalBlockTime);
+            reportedSlowLockWait = true;
+        }
+
         // If infinite timeout was requested, just keep waiting
         if (timeout == Milliseconds::max()) {
+            waitTime = maxWaitTime(totalBlockTime);
             continue;
         }
 
-        const auto totalBlockTime = duration_cast<Milliseconds>(
-            Microseconds(int64_t(curTimeMicros - startOfTotalWaitTime)));
-        waitTime = (totalBlockTime < timeout) ? std::min(timeout - totalBlockTime, MaxWaitTime)
-                                              : Milliseconds(0);
+        waitTime = (totalBlockTime < timeout)
+            ? std::min(timeout - totalBlockTime, maxWaitTime(totalBlockTime))
+            : Milliseconds(0);
 
         // Check if the lock acquisition has timed out. If we have an operation context and client
         // we can provide additional diagnostics data.
@@ -988,6 +1015,21 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
     unlockOnErrorGuard.dismiss();
 }
 
+void LockerImpl::_logSlowLockWait(OperationContext* opCtx,
+                                  ResourceId resId,
+                                  LockMode mode,
+                                  Milliseconds waitTime) const {
+    auto serviceContext = opCtx ? opCtx->getServiceContext() : getGlobalServiceContext();
+    LOGV2(5100026,
+          "Slow lock acquisition",
+          "resource"_attr = resId.toString(),
+          "mode"_attr = modeName(mode),
+          "waitTime"_attr = waitTime,
+          "opId"_attr = opCtx ? opCtx->getOpID() : 0,
+          "lockInfo"_attr = getGlobalLockManager()->getLockInfoBSON(
+              resId, LockManager::getLockToClientMap(serviceContext)));
+}
+
 void LockerImpl::getFlowControlTicket(OperationContext* opCtx, LockMode lockMode) {
     auto ticketholder = FlowControlTicketholder::get(opCtx);
     if (ticketholder && lockMode == LockMode::MODE_IX && _clientState.load() == kInactive &&
@@ -215,6 +215,14 @@ public:
         return _flowControlStats;
     }
 
+    Microseconds getTimeQueuedForTicket() const override {
+        return _timeQueuedForTicket;
+    }
+
+    void resetTimeQueuedForTicket() override {
+        _timeQueuedForTicket = Microseconds(0);
+    }
+
     //
     // Below functions are for testing only.
     //
@@ -284,6 +292,15 @@ private:
         _lockComplete(nullptr, resId, mode, deadline);
     }
 
+    /**
+     * Logs that the acquisition of 'resId' in 'mode' has been waiting for 'waitTime', along with
+     * the requests currently granted or pending on 'resId'.
+     */
+    void _logSlowLockWait(OperationContext* opCtx,
+                          ResourceId resId,
+                          LockMode mode,
+                          Milliseconds waitTime) const;
+
     /**
      * The main functionality of the unlock method, except accepts iterator in order to avoid
      * additional lookups during unlockGlobal. Frees locks immediately, so must not be called from
@@ -365,6 +382,9 @@ private:
     // A structure for accumulating time spent getting flow control tickets.
     FlowControlTicketholder::CurOp _flowControlStats;
 
+    // Time spent waiting for a read or write ticket which was not immediately available.
+    Microseconds _timeQueuedForTicket{0};
+
     // Tracks the global lock modes ever acquired in this Locker's life. This value should only ever
     // be accessed from the thread that owns the Locker.
     unsigned char _globalLockMode = (1 << MODE_NONE);
@@ -37,12 +37,14 @@
 
 #include "mongo/config.h"
 #include "mongo/db/concurrency/lock_manager_test_help.h"
+#include "mongo/db/concurrency/lock_state_gen.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer_mock.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
@@ -108,6 +110,35 @@ TEST_F(LockerImplTest, ConflictWithTimeout) {
     ASSERT(locker2.unlockGlobal());
 }
 
+TEST_F(LockerImplTest, SlowLockWaitIsLogged) {
+    const ResourceId resId(RESOURCE_COLLECTION, "TestDB.collection"_sd);
+
+    const auto originalThreshold = gSlowLockWaitThresholdMillis.load();
+    gSlowLockWaitThresholdMillis.store(1);
+    ON_BLOCK_EXIT([&] { gSlowLockWaitThresholdMillis.store(originalThreshold); });
+
+    LockerImpl locker1;
+    locker1.lockGlobal(MODE_IX);
+    locker1.lock(resId, MODE_X);
+
+    LockerImpl locker2;
+    locker2.lockGlobal(MODE_IX);
+
+    auto opCtx = makeOperationContext();
+    startCapturingLogMessages();
+    ASSERT_THROWS_CODE(locker2.lock(opCtx.get(), resId, MODE_S, Date_t::now() + Milliseconds(50)),
+                       AssertionException,
+                       ErrorCodes::LockTimeout);
+    stopCapturingLogMessages();
+
+    ASSERT_EQ(1, countTextFormatLogLinesContaining("Slow lock acquisition"));
+
+    ASSERT(locker1.unlock(resId));
+
+    ASSERT(locker1.unlockGlobal());
+    ASSERT(locker2.unlockGlobal());
+}
+
 TEST_F(LockerImplTest, ConflictUpgradeWithTimeout) {
     const ResourceId resId(RESOURCE_COLLECTION, "TestDB.collection"_sd);
 
@@ -506,6 +506,20 @@ public:
         return FlowControlTicketholder::CurOp();
     }
 
+    /**
+     * If tracked by an implementation, returns the time spent waiting for a read or write ticket
+     * which was not immediately available.
+     */
+    virtual Microseconds getTimeQueuedForTicket() const {
+        return Microseconds(0);
+    }
+
+    /**
+     * Restarts the count reported by getTimeQueuedForTicket(). Called when a Locker is handed to a
+     * new operation, as between the statements of a multi-document transaction.
+     */
+    virtual void resetTimeQueuedForTicket() {}
+
     /**
      * This function is for unit testing only.
      */
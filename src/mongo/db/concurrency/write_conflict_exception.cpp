@@ -28,16 +28,23 @@
  */
 
 #define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kWrite
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kWrite
 
 #include "mongo/db/concurrency/write_conflict_exception.h"
+
+#include <algorithm>
+
+#include "mongo/logv2/log.h"
 #include "mongo/util/log_and_backoff.h"
 #include "mongo/util/stacktrace.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
 MONGO_FAIL_POINT_DEFINE(skipWriteConflictRetries);
 
 AtomicWord<bool> WriteConflictException::trace(false);
+AtomicWord<bool> WriteConflictException::backoffJitter(false);
 
 WriteConflictException::WriteConflictException()
     : DBException(Status(ErrorCodes::WriteConflict,
@@ -48,7 +55,28 @@ WriteConflictException::WriteConflictException()
     }
 }
 
+Microseconds WriteConflictException::jitteredBackoff(int attempt, PseudoRandom& random) {
+    if (attempt < 4) {
+        return Microseconds(0);
+    }
+    const Microseconds cap = Milliseconds(std::min(100LL, 1LL << std::min(attempt - 4, 7)));
+    return Microseconds(random.nextInt64(durationCount<Microseconds>(cap)) + 1);
+}
+
 void WriteConflictException::logAndBackoff(int attempt, StringData operation, StringData ns) {
+    if (backoffJitter.load()) {
+        LOGV2_DEBUG(5100029,
+                    1,
+                    "Caught WriteConflictException, retrying",
+                    "operation"_attr = operation,
+                    "namespace"_attr = ns,
+                    "attempts"_attr = attempt);
+
+        static thread_local PseudoRandom random(SecureRandom().nextInt64());
+        sleepFor(jitteredBackoff(attempt, random));
+        return;
+    }
+
     mongo::logAndBackoff(4640401,
                          ::mongo::logv2::LogComponent::kWrite,
                          logv2::LogSeverity::Debug(1),
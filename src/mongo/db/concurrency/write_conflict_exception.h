@@ -33,7 +33,9 @@
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/curop.h"
+#include "mongo/platform/random.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -57,6 +59,20 @@ public:
      */
     static void logAndBackoff(int attempt, StringData operation, StringData ns);
 
+    /**
+     * Returns how long 'attempt' sleeps when backoff jitter is enabled: a uniformly random
+     * duration up to a cap which starts at 1ms on the fourth attempt and doubles with each attempt,
+     * up to 100ms. Randomizing the sleep keeps threads contending on the same document from
+     * retrying in lockstep.
+     */
+    static Microseconds jitteredBackoff(int attempt, PseudoRandom& random);
+
+    /**
+     * If true, logAndBackoff() sleeps for jitteredBackoff() rather than a fixed duration per
+     * attempt. Can be set via setParameter named writeConflictRetryBackoffJitter.
+     */
+    static AtomicWord<bool> backoffJitter;
+
     /**
      * If true, will call printStackTrace on every WriteConflictException created.
      * Can be set via setParameter named traceWriteConflictExceptions.
@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+// Returns the largest backoff observed for 'attempt' over many draws.
+Microseconds maxJitteredBackoff(int attempt, PseudoRandom& random) {
+    Microseconds maxBackoff{0};
+    for (int i = 0; i < 1000; ++i) {
+        auto backoff = WriteConflictException::jitteredBackoff(attempt, random);
+        ASSERT_GT(backoff, Microseconds(0));
+        maxBackoff = std::max(maxBackoff, backoff);
+    }
+    return maxBackoff;
+}
+
+TEST(WriteConflictExceptionTest, JitteredBackoffIsZeroForEarlyAttempts) {
+    PseudoRandom random(0);
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        ASSERT_EQ(WriteConflictException::jitteredBackoff(attempt, random), Microseconds(0));
+    }
+}
+
+TEST(WriteConflictExceptionTest, JitteredBackoffIsCappedAtOneMillisecondOnFourthAttempt) {
+    PseudoRandom random(0);
+    ASSERT_LTE(maxJitteredBackoff(4, random), Milliseconds(1));
+}
+
+TEST(WriteConflictExceptionTest, JitteredBackoffCapDoublesWithEachAttempt) {
+    PseudoRandom random(0);
+    for (int attempt = 5; attempt <= 10; ++attempt) {
+        const Microseconds cap = Milliseconds(1LL << (attempt - 4));
+        const auto maxBackoff = maxJitteredBackoff(attempt, random);
+        ASSERT_LTE(maxBackoff, cap);
+        // The previous attempt's cap is half of this one, so over many draws some must exceed it.
+        ASSERT_GT(maxBackoff, cap / 2);
+    }
+}
+
+TEST(WriteConflictExceptionTest, JitteredBackoffNeverExceedsOneHundredMilliseconds) {
+    PseudoRandom random(0);
+    for (int attempt : {11, 12, 20, 1000}) {
+        const auto maxBackoff = maxJitteredBackoff(attempt, random);
+        ASSERT_LTE(maxBackoff, Milliseconds(100));
+        ASSERT_GT(maxBackoff, Milliseconds(64));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
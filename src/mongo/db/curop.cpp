@@ -802,6 +802,11 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
         s << " flowControl:" << flowControlObj.toString();
     }
 
+    if (auto ticketQueuedMicros =
+            durationCount<Microseconds>(opCtx->lockState()->getTimeQueuedForTicket())) {
+        s << " ticketQueuedMicros:" << ticketQueuedMicros;
+    }
+
     {
         const auto& readConcern = repl::ReadConcernArgs::get(opCtx);
         if (readConcern.isSpecified()) {
@@ -967,6 +972,11 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("flowControl", flowControlObj);
     }
 
+    if (auto ticketQueuedMicros =
+            durationCount<Microseconds>(opCtx->lockState()->getTimeQueuedForTicket())) {
+        pAttrs->add("ticketQueuedMicros", ticketQueuedMicros);
+    }
+
     {
         const auto& readConcern = repl::ReadConcernArgs::get(opCtx);
         if (readConcern.isSpecified()) {
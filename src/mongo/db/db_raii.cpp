@@ -34,18 +34,33 @@
 #include "mongo/db/db_raii.h"
 
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
 
 const boost::optional<int> kDoNotChangeProfilingLevel = boost::none;
 
+// Reads served at the last applied timestamp without conflicting with secondary batch
+// application, and reads that had to conflict with it instead, along with the time those spent
+// re-acquiring their locks behind batch application.
+Counter64 lastAppliedReads;
+ServerStatusMetricField<Counter64> displayLastAppliedReads("repl.secondaryReads.atLastApplied",
+                                                           &lastAppliedReads);
+Counter64 batchApplicationWaits;
+ServerStatusMetricField<Counter64> displayBatchApplicationWaits(
+    "repl.secondaryReads.batchApplicationWaits", &batchApplicationWaits);
+Counter64 batchApplicationWaitMicros;
+ServerStatusMetricField<Counter64> displayBatchApplicationWaitMicros(
+    "repl.secondaryReads.batchApplicationWaitMicros", &batchApplicationWaitMicros);
+
 // TODO: SERVER-44105 remove
 // If set to false, secondary reads should wait behind the PBW lock.
 // Does nothing if gAllowSecondaryReadsDuringBatchApplication setting is false.
@@ -170,6 +185,10 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
             : boost::none;
 
         if (!_conflictingCatalogChanges(opCtx, minSnapshot, lastAppliedTimestamp)) {
+            if (readAtLastAppliedTimestamp &&
+                !opCtx->lockState()->shouldConflictWithSecondaryBatchApplication()) {
+                lastAppliedReads.increment();
+            }
             return;
         }
 
@@ -247,7 +266,16 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
             CurOp::get(opCtx)->yielded();
         }
 
-        _autoColl.emplace(opCtx, nsOrUUID, collectionLockMode, viewMode, deadline);
+        if (readSource == RecoveryUnit::ReadSource::kMajorityCommitted) {
+            _autoColl.emplace(opCtx, nsOrUUID, collectionLockMode, viewMode, deadline);
+        } else {
+            // We now conflict with secondary batch application, so taking the locks again waits
+            // for any batch in progress.
+            Timer batchApplicationWaitTimer;
+            _autoColl.emplace(opCtx, nsOrUUID, collectionLockMode, viewMode, deadline);
+            batchApplicationWaits.increment();
+            batchApplicationWaitMicros.increment(batchApplicationWaitTimer.micros());
+        }
     }
 }
 
@@ -115,6 +115,8 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
                 // Once a plan returns enough results, stop working. Update cache with stats
                 // from this run and return.
                 updatePlanCache();
+                _executionDeactivationRatio = internalQueryCacheExecutionDeactivationRatio.load();
+                _checkExecutionCost = _executionDeactivationRatio > 0.0;
                 return Status::OK();
             }
         } else if (PlanStage::IS_EOF == state) {
@@ -297,7 +299,39 @@ PlanStage::StageState CachedPlanStage::doWork(WorkingSetID* out) {
     }
 
     // Nothing left in trial period buffer.
-    return child()->work(out);
+    StageState state = child()->work(out);
+    if (_checkExecutionCost) {
+        checkExecutionCost(state);
+    }
+    return state;
+}
+
+void CachedPlanStage::checkExecutionCost(StageState stateFromChild) {
+    ++_worksAfterTrial;
+    if (PlanStage::ADVANCED == stateFromChild) {
+        ++_resultsAfterTrial;
+    }
+
+    // The results already returned cannot be taken back, so rather than switching plans
+    // mid-stream we let this query finish and make sure the next one of its shape replans.
+    const double maxWorks = _executionDeactivationRatio *
+        std::max(_decisionWorks, static_cast<size_t>(1)) * (1 + _resultsAfterTrial);
+    if (_worksAfterTrial <= maxWorks) {
+        return;
+    }
+    _checkExecutionCost = false;
+
+    LOGV2_DEBUG(5100004,
+                1,
+                "Deactivating cached plan which is doing more work per result than expected",
+                "query"_attr = redact(_canonicalQuery->toStringShort()),
+                "planSummary"_attr = Explain::getPlanSummary(child().get()),
+                "decisionWorks"_attr = _decisionWorks,
+                "worksAfterTrial"_attr = _worksAfterTrial,
+                "resultsAfterTrial"_attr = _resultsAfterTrial);
+
+    PlanCache* cache = CollectionQueryInfo::get(collection()).getPlanCache();
+    cache->deactivate(*_canonicalQuery);
 }
 
 std::unique_ptr<PlanStageStats> CachedPlanStage::getStats() {
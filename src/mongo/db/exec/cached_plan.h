@@ -117,6 +117,13 @@ private:
      */
     Status tryYield(PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Called for each work cycle of the cached plan after its trial period. Deactivates the plan
+     * cache entry if the plan is doing far more work per result than the cached works suggest,
+     * so that the next query of this shape replans rather than repeating the same mistake.
+     */
+    void checkExecutionCost(StageState stateFromChild);
+
     // Not owned.
     WorkingSet* _ws;
 
@@ -136,6 +143,15 @@ private:
     // Any results produced during trial period execution are kept here.
     std::queue<WorkingSetID> _results;
 
+    // Set once the cached plan has passed its trial period without replanning, if the cost of the
+    // rest of its execution should be checked against '_executionDeactivationRatio'.
+    bool _checkExecutionCost = false;
+    double _executionDeactivationRatio = 0.0;
+
+    // The work cycles and results of the cached plan after its trial period.
+    size_t _worksAfterTrial = 0;
+    size_t _resultsAfterTrial = 0;
+
     // Stats
     CachedPlanStats _specificStats;
 };
@@ -41,6 +41,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/logv2/log.h"
@@ -85,6 +86,11 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
         invariant(params.direction == CollectionScanParams::FORWARD);
     }
 
+    if (_filter && !params.stopApplyingFilterAfterFirstMatch &&
+        internalQueryEnableBatchMatchEvaluator.load()) {
+        _batchFilter = BatchMatchEvaluator::compile(_filter);
+    }
+
     // Set early stop condition.
     if (params.maxTs) {
         _endConditionBSON = BSON("$gte"_sd << *(params.maxTs));
@@ -122,6 +128,10 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             }
 
             _cursor = collection()->getCursor(opCtx(), forward);
+            if (!_params.tailable) {
+                // The scan may cover much of the collection, so let the storage engine read ahead.
+                _cursor->setReadAheadHint();
+            }
 
             if (!_lastSeenId.isNull()) {
                 invariant(_params.tailable);
@@ -221,6 +231,103 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     return returnIfMatches(member, id, out);
 }
 
+PlanStage::StageState CollectionScan::doWorkBatch(size_t maxBatchSize,
+                                                  std::vector<WorkingSetID>* results,
+                                                  WorkingSetID* out) {
+    if (_commonStats.isEOF) {
+        return PlanStage::IS_EOF;
+    }
+
+    // Cursor creation and repositioning is handled one record at a time.
+    if (!_cursor || !canUseNativeBatch()) {
+        return PlanStage::doWorkBatch(maxBatchSize, results, out);
+    }
+
+    const size_t resultsBefore = results->size();
+    auto endBatch = [&](StageState state, WorkingSetID id) {
+        if (results->size() > resultsBefore) {
+            stashPendingBatchState(state, id);
+            return PlanStage::ADVANCED;
+        }
+        *out = id;
+        return state;
+    };
+
+    // With a batch filter, every record read is appended to 'results' and the whole batch is
+    // filtered at once after the read loop.
+    if (_batchFilter) {
+        _batchDocs.clear();
+    }
+
+    boost::optional<StageState> endState;
+    const SnapshotId snapshotId = opCtx()->recoveryUnit()->getSnapshotId();
+    for (size_t i = 0; i < maxBatchSize; ++i) {
+        boost::optional<Record> record;
+        try {
+            record = _cursor->next();
+        } catch (const WriteConflictException&) {
+            // The cursor is left in a state to try again next time.
+            endState = PlanStage::NEED_YIELD;
+            break;
+        }
+        ++_commonStats.works;
+
+        if (!record) {
+            // Non-tailable scans treat EOF as permanent.
+            _commonStats.isEOF = true;
+            endState = PlanStage::IS_EOF;
+            break;
+        }
+
+        _lastSeenId = record->id;
+
+        // The record may point into cursor memory, which the next call to next() invalidates.
+        WorkingSetID id = _workingSet->allocate();
+        WorkingSetMember* member = _workingSet->get(id);
+        BSONObj obj = record->data.isOwned() ? record->data.releaseToBson()
+                                             : member->copyOwned(record->data.toBson());
+        member->recordId = record->id;
+        member->resetDocument(snapshotId, obj);
+        _workingSet->transitionToRecordIdAndObj(id);
+
+        ++_specificStats.docsTested;
+        if (_batchFilter) {
+            _batchDocs.push_back(std::move(obj));
+            results->push_back(id);
+        } else if (Filter::passes(member, _filter)) {
+            if (_params.stopApplyingFilterAfterFirstMatch) {
+                _filter = nullptr;
+            }
+            results->push_back(id);
+        } else {
+            _workingSet->free(id);
+            ++_commonStats.needTime;
+        }
+    }
+
+    if (_batchFilter && !_batchDocs.empty()) {
+        _batchFilter->evaluate(_batchDocs.data(), _batchDocs.size(), &_batchMatches);
+
+        // Compact the matching members to the front of this batch's results, preserving order.
+        size_t numMatched = resultsBefore;
+        for (size_t i = 0; i < _batchDocs.size(); ++i) {
+            const WorkingSetID id = (*results)[resultsBefore + i];
+            if (_batchMatches[i]) {
+                (*results)[numMatched++] = id;
+            } else {
+                _workingSet->free(id);
+                ++_commonStats.needTime;
+            }
+        }
+        results->resize(numMatched);
+    }
+
+    if (endState) {
+        return endBatch(*endState, WorkingSet::INVALID_ID);
+    }
+    return results->size() > resultsBefore ? PlanStage::ADVANCED : PlanStage::NEED_TIME;
+}
+
 Status CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
     if (tsElem.type() != BSONType::bsonTimestamp) {
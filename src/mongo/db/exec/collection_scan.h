@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/matcher/batch_match_evaluator.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 
@@ -62,6 +63,10 @@ public:
     StageState doWork(WorkingSetID* out) final;
     bool isEOF() final;
 
+    bool supportsBatchExecution() const final {
+        return canUseNativeBatch();
+    }
+
     void doDetachFromOperationContext() final;
     void doReattachToOperationContext() final;
 
@@ -82,11 +87,26 @@ public:
     const SpecificStats* getSpecificStats() const final;
 
 protected:
+    StageState doWorkBatch(size_t maxBatchSize,
+                           std::vector<WorkingSetID>* results,
+                           WorkingSetID* out) final;
+
     void doSaveStateRequiresCollection() final;
 
     void doRestoreStateRequiresCollection() final;
 
 private:
+    /**
+     * Returns true if this scan can produce batches straight off the record cursor. Tailable
+     * scans, oplog scans bounded by timestamp or tracking the latest oplog timestamp, and scans
+     * which must report a resume token for each result need per-record handling, so they are
+     * driven by the generic adapter instead.
+     */
+    bool canUseNativeBatch() const {
+        return !_params.tailable && !_params.minTs && !_params.maxTs &&
+            !_params.shouldTrackLatestOplogTimestamp && !_params.requestResumeToken;
+    }
+
     /**
      * If the member (with id memberID) passes our filter, set *out to memberID and return that
      * ADVANCED.  Otherwise, free memberID and return NEED_TIME.
@@ -111,6 +131,12 @@ private:
     BSONObj _endConditionBSON;
     std::unique_ptr<GTEMatchExpression> _endCondition;
 
+    // Evaluates '_filter' over a whole batch of documents in doWorkBatch(). Null if the filter is
+    // not eligible for batch evaluation.
+    std::unique_ptr<BatchMatchEvaluator> _batchFilter;
+    std::vector<BSONObj> _batchDocs;
+    std::vector<uint8_t> _batchMatches;
+
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
     CollectionScanParams _params;
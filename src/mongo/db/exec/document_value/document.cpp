@@ -118,7 +118,8 @@ bool DocumentStorageIterator::shouldSkipDeleted() {
             _it = nullptr;
         }
     } else if (!atEnd()) {
-        if (_it->val.missing() || _it->kind == ValueElement::Kind::kCached) {
+        if (_it->val.missing() || _it->kind == ValueElement::Kind::kCached ||
+            _it->kind == ValueElement::Kind::kCachedUnmodified) {
             return true;
         }
     }
@@ -126,12 +127,12 @@ bool DocumentStorageIterator::shouldSkipDeleted() {
     return false;
 }
 
-Position DocumentStorage::findFieldInCache(StringData requested) const {
+Position DocumentStorage::findFieldInCache(StringData requested,
+                                           boost::optional<unsigned> hash) const {
     int reqSize = requested.size();  // get size calculation out of the way if needed
 
     if (_numFields >= HASH_TAB_MIN) {  // hash lookup
-        const unsigned hash = hashKey(requested);
-        const unsigned bucket = hash & _hashTabMask;
+        const unsigned bucket = (hash ? *hash : hashKey(requested)) & _hashTabMask;
 
         Position pos = _hashTab[bucket];
         while (pos.found()) {
@@ -160,6 +161,22 @@ Position DocumentStorage::findField(StringData requested, LookupPolicy policy) c
         return pos;
     }
 
+    return findFieldInBSON(requested);
+}
+
+Position DocumentStorage::findField(StringData requested,
+                                    unsigned hash,
+                                    LookupPolicy policy) const {
+    dassert(hash == hashKey(requested));
+    if (auto pos = findFieldInCache(requested, hash);
+        pos.found() || policy == LookupPolicy::kCacheOnly) {
+        return pos;
+    }
+
+    return findFieldInBSON(requested);
+}
+
+Position DocumentStorage::findFieldInBSON(StringData requested) const {
     for (auto&& bsonElement : _bson) {
         if (requested == bsonElement.fieldNameStringData()) {
             return const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
@@ -171,16 +188,19 @@ Position DocumentStorage::findField(StringData requested, LookupPolicy policy) c
 }
 
 Position DocumentStorage::constructInCache(const BSONElement& elem) {
-    auto savedModified = _modified;
     auto pos = getNextPosition();
     const auto fieldName = elem.fieldNameStringData();
-    appendField(fieldName, ValueElement::Kind::kCached) = Value(elem);
-    _modified = savedModified;
+    appendElement(fieldName, ValueElement::Kind::kCachedUnmodified) = Value(elem);
 
     return pos;
 }
 
 Value& DocumentStorage::appendField(StringData name, ValueElement::Kind kind) {
+    _modified = true;
+    return appendElement(name, kind);
+}
+
+Value& DocumentStorage::appendElement(StringData name, ValueElement::Kind kind) {
     Position pos = getNextPosition();
     const int nameSize = name.size();
 
@@ -208,7 +228,7 @@ Value& DocumentStorage::appendField(StringData name, ValueElement::Kind kind) {
 #undef append
 
     // Make sure next field starts where we expect it
-    fassert(16486, getField(pos).next()->ptr() == _cache + _usedBytes);
+    fassert(16486, getElement(pos).next()->ptr() == _cache + _usedBytes);
 
     _numFields++;
 
@@ -219,12 +239,12 @@ Value& DocumentStorage::appendField(StringData name, ValueElement::Kind kind) {
         rehash();
     }
 
-    return getField(pos).val;
+    return getElement(pos).val;
 }
 
 // Call after adding field to _fields and increasing _numFields
 void DocumentStorage::addFieldToHashTable(Position pos) {
-    ValueElement& elem = getField(pos);
+    ValueElement& elem = getElement(pos);
     elem.nextCollision = Position();
 
     const unsigned bucket = bucketForKey(elem.nameSD());
@@ -232,7 +252,7 @@ void DocumentStorage::addFieldToHashTable(Position pos) {
     Position* posPtr = &_hashTab[bucket];
     while (posPtr->found()) {
         // collision: walk links and add new to end
-        posPtr = &getField(*posPtr).nextCollision;
+        posPtr = &getElement(*posPtr).nextCollision;
     }
     *posPtr = Position(pos.index);
 }
@@ -435,13 +455,32 @@ void Document::toBson(BSONObjBuilder* builder, size_t recursionLevel) const {
                           << BSONDepth::getMaxAllowableDepth() << " levels of nesting",
             recursionLevel <= BSONDepth::getMaxAllowableDepth());
 
+    // Fields which are unchanged from the backing BSON are copied from it verbatim. Consecutive
+    // runs of such fields are contiguous in the BSON, so each run is spliced in with one copy.
+    const char* runStart = nullptr;
+    const char* runEnd = nullptr;
+    auto flushRun = [&] {
+        if (runStart != runEnd) {
+            builder->bb().appendBuf(runStart, runEnd - runStart);
+        }
+        runStart = runEnd = nullptr;
+    };
+
     for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
-        if (auto cached = it.cachedValue()) {
-            cached->val.addToBsonObj(builder, cached->nameSD(), recursionLevel);
+        auto cached = it.cachedValue();
+        if (!cached || cached->kind == ValueElement::Kind::kCachedUnmodified) {
+            BSONElement elem = *it.bsonIter();
+            if (elem.rawdata() != runEnd) {
+                flushRun();
+                runStart = elem.rawdata();
+            }
+            runEnd = elem.rawdata() + elem.size();
         } else {
-            builder->append(*it.bsonIter());
+            flushRun();
+            cached->val.addToBsonObj(builder, cached->nameSD(), recursionLevel);
         }
     }
+    flushRun();
 }
 
 BSONObj Document::toBson() const {
@@ -569,8 +608,7 @@ static Value getNestedFieldHelper(const Document& doc,
                                   const FieldPath& fieldNames,
                                   vector<Position>* positions,
                                   size_t level) {
-    const auto fieldName = fieldNames.getFieldName(level);
-    const Position pos = doc.positionOf(fieldName);
+    const Position pos = doc.positionOf(fieldNames, level);
 
     if (!pos.found())
         return Value();
@@ -588,6 +626,16 @@ static Value getNestedFieldHelper(const Document& doc,
     return getNestedFieldHelper(val.getDocument(), fieldNames, positions, level + 1);
 }
 
+Position Document::positionOf(const FieldPath& path, size_t level) const {
+    return storage().findField(path.getFieldName(level),
+                               path.getFieldNameHash(level),
+                               DocumentStorage::LookupPolicy::kCacheAndBSON);
+}
+
+const Value Document::getField(const FieldPath& path, size_t level) const {
+    return storage().getField(path.getFieldName(level), path.getFieldNameHash(level));
+}
+
 const Value Document::getNestedField(const FieldPath& path, vector<Position>* positions) const {
     fassert(16489, path.getPathLength());
     return getNestedFieldHelper(*this, path, positions, 0);
@@ -164,6 +164,9 @@ public:
         return storage().getField(pos).val;
     }
 
+    /// Look up the field named by component 'level' of 'path', using the hash the path precomputed.
+    const Value getField(const FieldPath& path, size_t level) const;
+
     /**
      * Returns the Value stored at the location given by 'path', or Value() if no such path exists.
      * If 'positions' is non-null, it will be filled with a path suitable to pass to
@@ -290,6 +293,9 @@ public:
         return storage().findField(fieldName, DocumentStorage::LookupPolicy::kCacheAndBSON);
     }
 
+    /// Like positionOf(StringData), but for component 'level' of 'path'.
+    Position positionOf(const FieldPath& path, size_t level) const;
+
     /** Clone a document.
      *
      *  This should only be called by MutableDocument and tests
@@ -29,14 +29,14 @@
 
 #pragma once
 
-#include <third_party/murmurhash3/MurmurHash3.h>
-
 #include <bitset>
 #include <boost/intrusive_ptr.hpp>
+#include <boost/optional.hpp>
 
 #include "mongo/base/static_assert.h"
 #include "mongo/db/exec/document_value/document_metadata_fields.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/field_path.h"
 #include "mongo/util/intrusive_counter.h"
 
 namespace mongo {
@@ -86,8 +86,11 @@ public:
     enum class Kind : char {
         // The value does not exist in the underlying BSON.
         kInserted,
-        // The value has the image in the underlying BSON.
+        // The value has the image in the underlying BSON, but may have been modified since.
         kCached,
+        // The value has the image in the underlying BSON and has only been read, so the BSON
+        // element can be used in place of the value when serializing.
+        kCachedUnmodified,
         // The value has been opportunistically inserted into the cache without checking the BSON.
         kMaybeInserted
     };
@@ -326,6 +329,9 @@ public:
     /// Returns the position of the named field or Position()
     Position findField(StringData name, LookupPolicy policy) const;
 
+    /// Like findField(), but takes the name's precomputed hashKey() instead of hashing it again.
+    Position findField(StringData name, unsigned hash, LookupPolicy policy) const;
+
     // Document uses these
     const ValueElement& getField(Position pos) const {
         verify(pos.found());
@@ -337,12 +343,21 @@ public:
             return Value();
         return getField(pos).val;
     }
+    Value getField(StringData name, unsigned hash) const {
+        Position pos = findField(name, hash, LookupPolicy::kCacheAndBSON);
+        if (!pos.found())
+            return Value();
+        return getField(pos).val;
+    }
 
     // MutableDocument uses these
     ValueElement& getField(Position pos) {
         _modified = true;
-        verify(pos.found());
-        return *(_firstElement->plusBytes(pos.index));
+        auto& elem = getElement(pos);
+        if (elem.kind == ValueElement::Kind::kCachedUnmodified) {
+            elem.kind = ValueElement::Kind::kCached;
+        }
+        return elem;
     }
     Value& getField(StringData name, LookupPolicy policy) {
         _modified = true;
@@ -442,10 +457,7 @@ public:
     }
 
     static unsigned hashKey(StringData name) {
-        // TODO consider FNV-1a once we have a better benchmark corpus
-        unsigned out;
-        MurmurHash3_x86_32(name.rawData(), name.size(), 0, &out);
-        return out;
+        return FieldPath::hashFieldName(name);
     }
 
     const ValueElement* begin() const {
@@ -472,8 +484,12 @@ public:
     }
 
 private:
-    /// Returns the position of the named field in the cache or Position()
-    Position findFieldInCache(StringData name) const;
+    /// Returns the position of the named field in the cache or Position(). The name is hashed only
+    /// if the cache is large enough to use its hash table and no precomputed 'hash' was given.
+    Position findFieldInCache(StringData name, boost::optional<unsigned> hash = boost::none) const;
+
+    /// Returns the position of the named field in the underlying BSON, loading it into the cache.
+    Position findFieldInBSON(StringData name) const;
 
     /// Allocates space in _cache. Copies existing data if there is any.
     void alloc(unsigned newSize);
@@ -481,6 +497,9 @@ private:
     /// Call after adding field to _cache and increasing _numFields
     void addFieldToHashTable(Position pos);
 
+    /// Like appendField(), but does not mark the document as modified.
+    Value& appendElement(StringData name, ValueElement::Kind kind);
+
     // assumes _hashTabMask is (power of two) - 1
     unsigned hashTabBuckets() const {
         return _hashTabMask + 1;
@@ -503,6 +522,12 @@ private:
         return hashKey(name) & _hashTabMask;
     }
 
+    /// Returns the element at 'pos' without treating it as modified.
+    ValueElement& getElement(Position pos) {
+        verify(pos.found());
+        return *(_firstElement->plusBytes(pos.index));
+    }
+
     /// Adds all fields to the hash table
     void rehash() {
         hashTabInit();
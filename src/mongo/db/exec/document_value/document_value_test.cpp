@@ -175,6 +175,39 @@ TEST(DocumentSerialization, CannotSerializeDocumentThatExceedsDepthLimit) {
     throwaway.abandon();
 }
 
+TEST(DocumentSerialization, ReadingFieldsDoesNotMarkDocumentModified) {
+    const Document doc(BSON("a" << 1 << "b" << BSON("c" << 2) << "d" << 3));
+    ASSERT_VALUE_EQ(doc["b"]["c"], mongo::Value(2));
+    ASSERT_VALUE_EQ(doc["d"], mongo::Value(3));
+    ASSERT_FALSE(doc.isModified());
+    ASSERT_TRUE(doc.toBsonIfTriviallyConvertible());
+}
+
+TEST(DocumentSerialization, SplicesUnmodifiedFieldsAroundChangedOnes) {
+    const BSONObj original = BSON("a" << 1 << "b" << 2 << "c" << 3 << "d" << 4 << "e" << 5);
+    MutableDocument md{Document(original)};
+
+    // Read some fields without changing them, change one in the middle, remove one and add a new
+    // one at the end.
+    ASSERT_VALUE_EQ(md.peek()["a"], mongo::Value(1));
+    ASSERT_VALUE_EQ(md.peek()["d"], mongo::Value(4));
+    md["c"] = mongo::Value("changed"_sd);
+    md.remove("e");
+    md["f"] = mongo::Value(6);
+
+    ASSERT_BSONOBJ_EQ(md.freeze().toBson(),
+                      BSON("a" << 1 << "b" << 2 << "c"
+                               << "changed"
+                               << "d" << 4 << "f" << 6));
+}
+
+TEST(DocumentSerialization, FieldChangedThroughMutableReferenceIsSerialized) {
+    MutableDocument md{Document(BSON("a" << BSON("b" << 1) << "c" << 2))};
+    ASSERT_VALUE_EQ(md.peek()["a"]["b"], mongo::Value(1));
+    md.setNestedField(FieldPath("a.b"), mongo::Value(5));
+    ASSERT_BSONOBJ_EQ(md.freeze().toBson(), BSON("a" << BSON("b" << 5) << "c" << 2));
+}
+
 /** Add Document fields. */
 class AddField {
 public:
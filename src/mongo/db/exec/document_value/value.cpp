@@ -189,6 +189,9 @@ Value::Value(const BSONElement& elem) : _storage(elem.type()) {
 
         case Array: {
             auto vec = make_intrusive<RCVector>();
+            // Counting the elements only walks the buffer, which is much cheaper than the
+            // repeated reallocations of growing the vector one element at a time.
+            vec->vec.reserve(elem.embeddedObject().nFields());
             BSONForEach(sub, elem.embeddedObject()) {
                 vec->vec.push_back(Value(sub));
             }
@@ -251,6 +254,7 @@ Value::Value(const BSONElement& elem) : _storage(elem.type()) {
 
 Value::Value(const BSONArray& arr) : _storage(Array) {
     auto vec = make_intrusive<RCVector>();
+    vec->vec.reserve(arr.nFields());
     BSONForEach(sub, arr) {
         vec->vec.push_back(Value(sub));
     }
@@ -29,11 +29,13 @@
 
 #pragma once
 
+#include <absl/container/flat_hash_map.h>
 #include <map>
 #include <set>
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/stdx/trusted_hasher.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/stdx/unordered_set.h"
 
@@ -183,6 +185,18 @@ public:
         return stdx::unordered_map<Value, T, Hasher, EqualTo>(0, Hasher(this), EqualTo(this));
     }
 
+    /**
+     * Like makeUnorderedValueMap(), but the returned map stores its entries inline in a single
+     * open-addressing table rather than allocating a node per entry. Inserting into the map
+     * invalidates references to its entries. This comparator must outlive the returned map.
+     */
+    template <typename T>
+    absl::flat_hash_map<Value, T, EnsureTrustedHasher<Hasher, Value>, EqualTo>
+    makeFlatUnorderedValueMap() const {
+        return absl::flat_hash_map<Value, T, EnsureTrustedHasher<Hasher, Value>, EqualTo>(
+            0, Hasher(this), EqualTo(this));
+    }
+
 private:
     const StringData::ComparatorInterface* _stringComparator = nullptr;
 };
@@ -203,4 +217,11 @@ template <typename T>
 using ValueUnorderedMap =
     stdx::unordered_map<Value, T, ValueComparator::Hasher, ValueComparator::EqualTo>;
 
+template <typename T>
+using ValueFlatUnorderedMap =
+    absl::flat_hash_map<Value,
+                        T,
+                        EnsureTrustedHasher<ValueComparator::Hasher, Value>,
+                        ValueComparator::EqualTo>;
+
 }  // namespace mongo
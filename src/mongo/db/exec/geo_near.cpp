@@ -447,6 +447,17 @@ PlanStage::StageState GeoNear2DStage::initialize(OperationContext* opCtx,
     return state;
 }
 
+void adjustGeoNearBoundsIncrement(const IntervalStats& lastIntervalStats,
+                                  double* boundsIncrement) {
+    // TODO: Generally we want small numbers of results fast, then larger numbers later
+    if (lastIntervalStats.numResultsBuffered == 0)
+        *boundsIncrement *= 4;
+    else if (lastIntervalStats.numResultsReturned < 300)
+        *boundsIncrement *= 2;
+    else if (lastIntervalStats.numResultsReturned > 600)
+        *boundsIncrement /= 2;
+}
+
 static const string kTwoDIndexNearStage("GEO_NEAR_2D");
 
 GeoNear2DStage::GeoNear2DStage(const GeoNearParams& nearParams,
@@ -583,13 +594,7 @@ GeoNear2DStage::nextInterval(OperationContext* opCtx,
     //
 
     if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        adjustGeoNearBoundsIncrement(_specificStats.intervalStats.back(), &_boundsIncrement);
     }
 
     _boundsIncrement =
@@ -979,13 +984,7 @@ GeoNear2DSphereStage::nextInterval(OperationContext* opCtx,
     //
 
     if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        adjustGeoNearBoundsIncrement(_specificStats.intervalStats.back(), &_boundsIncrement);
     }
 
     invariant(_boundsIncrement > 0.0);
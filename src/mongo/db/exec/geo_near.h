@@ -63,6 +63,16 @@ struct GeoNearParams {
     bool addDistMeta;
 };
 
+/**
+ * Resizes the width of the next search annulus based on how many results the last one returned,
+ * aiming for a few hundred results per annulus. Each annulus costs an index scan, so when the last
+ * one's covering found nothing at all the data is sparse here and the width grows faster. Documents
+ * the covering found beyond the annulus are returned with a later one, but they still show that
+ * the region is not empty.
+ */
+void adjustGeoNearBoundsIncrement(const IntervalStats& lastIntervalStats,
+                                  double* boundsIncrement);
+
 /**
  * Implementation of GeoNear on top of a 2D index
  */
@@ -0,0 +1,70 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/geo_near.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+double nextBoundsIncrement(long long numResultsBuffered, long long numResultsReturned) {
+    IntervalStats stats;
+    stats.numResultsBuffered = numResultsBuffered;
+    stats.numResultsReturned = numResultsReturned;
+    double boundsIncrement = 1.0;
+    adjustGeoNearBoundsIncrement(stats, &boundsIncrement);
+    return boundsIncrement;
+}
+
+TEST(GeoNearBoundsIncrementTest, QuadruplesAfterAnEmptyCovering) {
+    ASSERT_EQ(4.0, nextBoundsIncrement(0, 0));
+}
+
+TEST(GeoNearBoundsIncrementTest, DoublesWhenTheCoveringFoundResultsBeyondTheAnnulus) {
+    ASSERT_EQ(2.0, nextBoundsIncrement(5, 0));
+}
+
+TEST(GeoNearBoundsIncrementTest, DoublesBelowThreeHundredResults) {
+    ASSERT_EQ(2.0, nextBoundsIncrement(1, 1));
+    ASSERT_EQ(2.0, nextBoundsIncrement(299, 299));
+}
+
+TEST(GeoNearBoundsIncrementTest, KeepsItsWidthBetweenThreeAndSixHundredResults) {
+    ASSERT_EQ(1.0, nextBoundsIncrement(300, 300));
+    ASSERT_EQ(1.0, nextBoundsIncrement(600, 600));
+}
+
+TEST(GeoNearBoundsIncrementTest, HalvesAboveSixHundredResults) {
+    ASSERT_EQ(0.5, nextBoundsIncrement(601, 601));
+}
+
+}  // namespace
+}  // namespace mongo
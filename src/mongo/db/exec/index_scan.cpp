@@ -223,12 +223,11 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
         return PlanStage::NEED_TIME;
     }
 
-    if (!kv->key.isOwned())
-        kv->key = kv->key.getOwned();
-
     // We found something to return, so fill out the WSM.
     WorkingSetID id = _workingSet->allocate();
     WorkingSetMember* member = _workingSet->get(id);
+    if (!kv->key.isOwned())
+        kv->key = member->copyOwned(kv->key);
     member->recordId = kv->loc;
     member->keyData.push_back(IndexKeyDatum(
         _keyPattern, kv->key, workingSetIndexId(), opCtx()->recoveryUnit()->getSnapshotId()));
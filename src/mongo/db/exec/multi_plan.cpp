@@ -194,6 +194,13 @@ size_t MultiPlanStage::getTrialPeriodNumToReturn(const CanonicalQuery& query) {
         numResults = std::min(static_cast<size_t>(*query.getQueryRequest().getLimit()), numResults);
     }
 
+    // A batchSize of zero only establishes the cursor, and tells us nothing about how many results
+    // the first getMore will want.
+    const auto batchSize = query.getQueryRequest().getBatchSize();
+    if (internalQueryPlanEvaluationStopAtFirstBatch.load() && batchSize && *batchSize > 0) {
+        numResults = std::min(static_cast<size_t>(*batchSize), numResults);
+    }
+
     return numResults;
 }
 
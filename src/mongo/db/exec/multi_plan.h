@@ -124,6 +124,8 @@ public:
     /**
      * Returns the max number of documents which we should allow any plan to return during the
      * trial period. As soon as any plan hits this number of documents, the trial period ends.
+     * When internalQueryPlanEvaluationStopAtFirstBatch is set, this is also capped at the size of
+     * the query's first batch.
      */
     static size_t getTrialPeriodNumToReturn(const CanonicalQuery& query);
 
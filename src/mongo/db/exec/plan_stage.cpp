@@ -33,6 +33,8 @@
 
 #include "mongo/db/exec/plan_stage.h"
 
+#include <algorithm>
+
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
@@ -59,6 +61,65 @@ PlanStage::StageState PlanStage::work(WorkingSetID* out) {
     return workResult;
 }
 
+PlanStage::StageState PlanStage::workBatch(size_t maxBatchSize,
+                                           std::vector<WorkingSetID>* results,
+                                           WorkingSetID* out) {
+    invariant(_opCtx);
+    invariant(maxBatchSize > 0);
+
+    StageState workResult;
+    if (_pendingBatchState) {
+        workResult = *_pendingBatchState;
+        *out = _pendingBatchId;
+        _pendingBatchState = boost::none;
+        _pendingBatchId = WorkingSet::INVALID_ID;
+    } else {
+        ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+        ++_commonStats.batches;
+        _commonStats.maxBatchSize = std::max(_commonStats.maxBatchSize, maxBatchSize);
+
+        const size_t resultsBefore = results->size();
+        workResult = doWorkBatch(maxBatchSize, results, out);
+
+        const size_t produced = results->size() - resultsBefore;
+        invariant((StageState::ADVANCED == workResult) == (produced > 0));
+        _commonStats.advanced += produced;
+    }
+
+    if (StageState::NEED_YIELD == workResult) {
+        ++_commonStats.needYield;
+    } else if (StageState::FAILURE == workResult) {
+        _commonStats.failed = true;
+    }
+
+    return workResult;
+}
+
+PlanStage::StageState PlanStage::doWorkBatch(size_t maxBatchSize,
+                                             std::vector<WorkingSetID>* results,
+                                             WorkingSetID* out) {
+    for (size_t i = 0; i < maxBatchSize; ++i) {
+        ++_commonStats.works;
+
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        StageState workResult = doWork(&id);
+
+        if (StageState::ADVANCED == workResult) {
+            // A result produced by doWork() may point into storage engine memory which is only
+            // valid until the stage does more work, so the adapter ends the batch here.
+            results->push_back(id);
+            return workResult;
+        } else if (StageState::NEED_TIME == workResult) {
+            ++_commonStats.needTime;
+        } else {
+            *out = id;
+            return workResult;
+        }
+    }
+
+    return StageState::NEED_TIME;
+}
+
 void PlanStage::saveState() {
     ++_commonStats.yields;
     for (auto&& child : _children) {
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <memory>
 #include <vector>
 
@@ -196,6 +197,31 @@ public:
      */
     StageState work(WorkingSetID* out);
 
+    /**
+     * Batch-at-a-time counterpart of work(). Performs at most 'maxBatchSize' units of work and
+     * appends the id of every result produced along the way to 'results'.
+     *
+     * Returns ADVANCED if and only if at least one id was appended to 'results'. Otherwise returns
+     * the state work() would have returned, with '*out' populated following the same rules. If a
+     * stage hits IS_EOF, NEED_YIELD or FAILURE after having already produced results, it returns
+     * ADVANCED for the partial batch and reports the pending state on the next call.
+     *
+     * Stages which do not override doWorkBatch() are driven through an adapter which calls
+     * doWork() in a loop, so this may be called on any stage.
+     */
+    StageState workBatch(size_t maxBatchSize,
+                         std::vector<WorkingSetID>* results,
+                         WorkingSetID* out);
+
+    /**
+     * Returns true if this stage, and every stage it pulls results from, has a native batch
+     * implementation. The PlanExecutor only drives a plan through workBatch() when its root
+     * reports true.
+     */
+    virtual bool supportsBatchExecution() const {
+        return false;
+    }
+
     /**
      * Returns true if no more work can be done on the query / out of results.
      */
@@ -344,6 +370,31 @@ protected:
      */
     virtual StageState doWork(WorkingSetID* out) = 0;
 
+    /**
+     * Produces a batch of results. See comment at workBatch() above.
+     *
+     * The default implementation adapts doWork() by calling it up to 'maxBatchSize' times, ending
+     * the batch at the first result. Native implementations may produce many results per batch,
+     * and must ensure that every member they produce holds owned data, since the stage keeps
+     * working after producing it. Overrides are responsible for maintaining the 'works' and
+     * 'needTime' counters in '_commonStats'; the remaining counters are maintained by workBatch().
+     */
+    virtual StageState doWorkBatch(size_t maxBatchSize,
+                                   std::vector<WorkingSetID>* results,
+                                   WorkingSetID* out);
+
+    /**
+     * Records a state (IS_EOF, NEED_YIELD or FAILURE) which could not be returned from
+     * doWorkBatch() because the current batch already holds results. It is returned, along with
+     * 'id', by the next call to workBatch().
+     */
+    void stashPendingBatchState(StageState state, WorkingSetID id) {
+        invariant(state != ADVANCED && state != NEED_TIME);
+        invariant(!_pendingBatchState);
+        _pendingBatchState = state;
+        _pendingBatchId = id;
+    }
+
     /**
      * Saves any stage-specific state required to resume where it was if the underlying data
      * changes.
@@ -397,6 +448,10 @@ private:
     // The PlanExecutor holds a strong reference to this which ensures that this pointer remains
     // valid for the entire lifetime of the PlanStage.
     ExpressionContext* _expCtx;
+
+    // Set when doWorkBatch() had to end a batch early; see stashPendingBatchState().
+    boost::optional<StageState> _pendingBatchState;
+    WorkingSetID _pendingBatchId = WorkingSet::INVALID_ID;
 };
 
 }  // namespace mongo
@@ -68,6 +68,8 @@ struct CommonStats {
           advanced(0),
           needTime(0),
           needYield(0),
+          batches(0),
+          maxBatchSize(0),
           executionTimeMillis(0),
           failed(false),
           isEOF(false) {}
@@ -88,6 +90,11 @@ struct CommonStats {
     size_t needTime;
     size_t needYield;
 
+    // Calls to workBatch(...) and the largest batch size requested by any of them. Both are zero
+    // unless the stage was driven in batch mode.
+    size_t batches;
+    size_t maxBatchSize;
+
     // BSON representation of a MatchExpression affixed to this node. If there
     // is no filter affixed, then 'filter' should be an empty BSONObj.
     BSONObj filter;
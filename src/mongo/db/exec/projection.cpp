@@ -34,6 +34,7 @@
 #include <boost/optional.hpp>
 #include <memory>
 
+#include "mongo/base/exact_cast.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/exec/projection_executor_builder.h"
@@ -161,6 +162,45 @@ PlanStage::StageState ProjectionStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState ProjectionStage::doWorkBatch(size_t maxBatchSize,
+                                                   std::vector<WorkingSetID>* results,
+                                                   WorkingSetID* out) {
+    const size_t resultsBefore = results->size();
+    StageState status = child()->workBatch(maxBatchSize, results, out);
+    if (PlanStage::ADVANCED != status) {
+        // The child has already populated 'out' as required by 'status'.
+        ++_commonStats.works;
+        if (PlanStage::NEED_TIME == status) {
+            ++_commonStats.needTime;
+        }
+        return status;
+    }
+
+    _commonStats.works += results->size() - resultsBefore;
+    for (size_t i = resultsBefore; i < results->size(); ++i) {
+        Status projStatus = transform(_ws.get((*results)[i]));
+        if (!projStatus.isOK()) {
+            LOGV2_WARNING(5100001,
+                          "Couldn't execute projection, status = {projStatus}",
+                          "projStatus"_attr = redact(projStatus));
+            for (size_t j = i; j < results->size(); ++j) {
+                _ws.free((*results)[j]);
+            }
+            results->resize(i);
+
+            WorkingSetID statusId = WorkingSetCommon::allocateStatusMember(&_ws, projStatus);
+            if (results->size() > resultsBefore) {
+                stashPendingBatchState(PlanStage::FAILURE, statusId);
+                return PlanStage::ADVANCED;
+            }
+            *out = statusId;
+            return PlanStage::FAILURE;
+        }
+    }
+
+    return PlanStage::ADVANCED;
+}
+
 std::unique_ptr<PlanStageStats> ProjectionStage::getStats() {
     _commonStats.isEOF = isEOF();
     auto ret = std::make_unique<PlanStageStats>(_commonStats, stageType());
@@ -292,10 +332,24 @@ ProjectionStageSimple::ProjectionStageSimple(ExpressionContext* expCtx,
                                              const projection_ast::Projection* projection,
                                              WorkingSet* ws,
                                              std::unique_ptr<PlanStage> child)
-    : ProjectionStage{expCtx, projObj, ws, std::move(child), "PROJECTION_SIMPLE"} {
-    invariant(projection->isSimple());
-    _includedFields = {projection->getRequiredFields().begin(),
-                       projection->getRequiredFields().end()};
+    : ProjectionStage{expCtx, projObj, ws, std::move(child), "PROJECTION_SIMPLE"},
+      _isExclusion{projection->isSimpleExclusion()} {
+    if (!_isExclusion) {
+        invariant(projection->isSimple());
+        _fields = {projection->getRequiredFields().begin(),
+                   projection->getRequiredFields().end()};
+        return;
+    }
+
+    const auto* root = projection->root();
+    for (size_t i = 0; i < root->children().size(); ++i) {
+        const auto* boolNode = exact_pointer_cast<const projection_ast::BooleanConstantASTNode*>(
+            root->children()[i].get());
+        invariant(boolNode);
+        if (!boolNode->value()) {
+            _fields.insert(root->fieldNames()[i]);
+        }
+    }
 }
 
 Status ProjectionStageSimple::transform(WorkingSetMember* member) const {
@@ -307,11 +361,23 @@ Status ProjectionStageSimple::transform(WorkingSetMember* member) const {
     // Apply the SIMPLE_DOC projection.
     // Look at every field in the source document and see if we're including it.
     auto objToProject = member->doc.value().toBson();
-    auto nFieldsNeeded = _includedFields.size();
+    if (_isExclusion) {
+        for (auto&& elt : objToProject) {
+            auto fieldName{elt.fieldNameStringData()};
+            absl::string_view fieldNameKey{fieldName.rawData(), fieldName.size()};
+            if (_fields.find(fieldNameKey) == _fields.end()) {
+                bob.append(elt);
+            }
+        }
+        transitionMemberToOwnedObj(bob.obj(), member);
+        return Status::OK();
+    }
+
+    auto nFieldsNeeded = _fields.size();
     for (auto&& elt : objToProject) {
         auto fieldName{elt.fieldNameStringData()};
         absl::string_view fieldNameKey{fieldName.rawData(), fieldName.size()};
-        if (auto fieldIt = _includedFields.find(fieldNameKey); _includedFields.end() != fieldIt) {
+        if (auto fieldIt = _fields.find(fieldNameKey); _fields.end() != fieldIt) {
             bob.append(elt);
             if (--nFieldsNeeded == 0) {
                 break;
@@ -53,6 +53,10 @@ public:
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
 
+    bool supportsBatchExecution() const final {
+        return child()->supportsBatchExecution();
+    }
+
     std::unique_ptr<PlanStageStats> getStats() final;
 
     const SpecificStats* getSpecificStats() const final {
@@ -60,6 +64,10 @@ public:
     }
 
 protected:
+    StageState doWorkBatch(size_t maxBatchSize,
+                           std::vector<WorkingSetID>* results,
+                           WorkingSetID* out) final;
+
     using FieldSet = StringSet;
 
     // The raw BSON projection used to populate projection stats. Optional, since it is required
@@ -148,8 +156,8 @@ private:
 
 /**
  * This class is used when we expect an object and the following rules are met: the projection
- * consists only of inclusions e.g. '{field: 1}', it has no $meta projections, it is not a returnKey
- * projection and it has no dotted fields.
+ * consists only of inclusions e.g. '{field: 1}' or only of exclusions e.g. '{field: 0}', it has no
+ * $meta projections, it is not a returnKey projection and it has no dotted fields.
  */
 class ProjectionStageSimple final : public ProjectionStage {
 public:
@@ -169,8 +177,12 @@ public:
 private:
     Status transform(WorkingSetMember* member) const final;
 
-    // Has the field names present in the simple projection.
-    stdx::unordered_set<std::string> _includedFields;
+    // Whether '_fields' lists the fields to keep or the fields to drop.
+    bool _isExclusion;
+
+    // Has the field names present in the simple projection. For an exclusion projection these are
+    // only the excluded fields, so an explicit '_id: 1' is not listed.
+    stdx::unordered_set<std::string> _fields;
 };
 
 }  // namespace mongo
@@ -31,6 +31,8 @@
 
 #include "mongo/db/exec/projection_node.h"
 
+#include "mongo/db/pipeline/expression_bytecode.h"
+
 namespace mongo::projection_executor {
 using ArrayRecursionPolicy = ProjectionPolicies::ArrayRecursionPolicy;
 using ComputedFieldsPolicy = ProjectionPolicies::ComputedFieldsPolicy;
@@ -247,7 +249,8 @@ void ProjectionNode::reportComputedPaths(std::set<std::string>* computedPaths,
 
 void ProjectionNode::optimize() {
     for (auto&& expressionIt : _expressions) {
-        _expressions[expressionIt.first] = expressionIt.second->optimize();
+        _expressions[expressionIt.first] =
+            ExpressionBytecode::compileIfEligible(expressionIt.second->optimize());
     }
     for (auto&& childPair : _children) {
         childPair.second->optimize();
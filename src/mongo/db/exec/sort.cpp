@@ -107,17 +107,30 @@ SortStageDefault::SortStageDefault(boost::intrusive_ptr<ExpressionContext> expCt
                                    uint64_t limit,
                                    uint64_t maxMemoryUsageBytes,
                                    bool addSortKeyMetadata,
+                                   bool discardFetchedDocuments,
                                    std::unique_ptr<PlanStage> child)
     : SortStage(expCtx, ws, sortPattern, addSortKeyMetadata, std::move(child)),
       _sortExecutor(std::move(sortPattern),
                     limit,
                     maxMemoryUsageBytes,
                     expCtx->tempDir,
-                    expCtx->allowDiskUse) {}
+                    expCtx->allowDiskUse),
+      _discardFetchedDocuments(discardFetchedDocuments) {}
 
 void SortStageDefault::spool(WorkingSetID wsid) {
+    auto member = _ws->get(wsid);
+    auto sortKey = _sortKeyGen.computeSortKey(*member);
+
+    if (_discardFetchedDocuments && member->hasRecordId() && member->hasObj()) {
+        // The sort key may point into the document, so it must be made owned before the document
+        // is released. The record id is all that is needed to fetch the document again.
+        sortKey = sortKey.getOwned();
+        member->doc.reset();
+        member->keyData.clear();
+        _ws->transitionToRecordIdAndIdx(wsid);
+    }
+
     SortableWorkingSetMember extractedMember{_ws->extract(wsid)};
-    auto sortKey = _sortKeyGen.computeSortKey(*extractedMember);
     _sortExecutor.add(sortKey, extractedMember);
 }
 
@@ -106,12 +106,18 @@ private:
  */
 class SortStageDefault final : public SortStage {
 public:
+    /**
+     * If 'discardFetchedDocuments' is true, a fetched document with a record id is reduced to its
+     * record id once its sort key has been computed, so that the sort only holds sort keys and
+     * record ids. The documents must then be fetched again by a stage above the sort.
+     */
     SortStageDefault(boost::intrusive_ptr<ExpressionContext> expCtx,
                      WorkingSet* ws,
                      SortPattern sortPattern,
                      uint64_t limit,
                      uint64_t maxMemoryUsageBytes,
                      bool addSortKeyMetadata,
+                     bool discardFetchedDocuments,
                      std::unique_ptr<PlanStage> child);
 
     void spool(WorkingSetID wsid) override final;
@@ -136,6 +142,8 @@ public:
 
 private:
     SortExecutor<SortableWorkingSetMember> _sortExecutor;
+
+    const bool _discardFetchedDocuments;
 };
 
 /**
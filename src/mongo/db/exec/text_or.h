@@ -35,6 +35,7 @@
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
+#include "mongo/util/flat_hash_map.h"
 
 namespace mongo {
 
@@ -146,7 +147,9 @@ private:
         double score;
     };
 
-    typedef stdx::unordered_map<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
+    // Holds an entry for every posting read from the children, so it is kept flat to avoid a node
+    // allocation per matching document. No reference to an entry is kept across insertions.
+    typedef FlatHashMap<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
@@ -152,10 +152,37 @@ bool WorkingSetMember::hasOwnedObj() const {
 
 void WorkingSetMember::makeObjOwnedIfNeeded() {
     if (_state == RID_AND_OBJ && !doc.value().isOwned()) {
+        if (!doc.value().metadata()) {
+            if (auto bson = doc.value().toBsonIfTriviallyConvertible()) {
+                // Reuse both the member's buffer and the Document's storage where possible.
+                resetDocument(doc.snapshotId(), copyOwned(*bson));
+                return;
+            }
+        }
         doc.value() = doc.value().getOwned();
     }
 }
 
+BSONObj WorkingSetMember::copyOwned(const BSONObj& obj) {
+    const size_t size = obj.objsize();
+    if (size >= kMaxRecycledBufferSize) {
+        return obj.getOwned();
+    }
+
+    if (!_recycledBuffer || _recycledBuffer.isShared() || _recycledBuffer.capacity() < size) {
+        // Round up to a power of two so that a member serving similarly sized objects settles on
+        // a single buffer.
+        size_t capacity = kMinRecycledBufferSize;
+        while (capacity < size) {
+            capacity *= 2;
+        }
+        _recycledBuffer = SharedBuffer::allocate(capacity);
+    }
+
+    memcpy(_recycledBuffer.get(), obj.objdata(), size);
+    return BSONObj(_recycledBuffer);
+}
+
 bool WorkingSetMember::getFieldDotted(const string& field, BSONElement* out) const {
     // If our state is such that we have an object, use it.
     if (hasObj()) {
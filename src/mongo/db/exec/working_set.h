@@ -38,6 +38,7 @@
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/snapshot.h"
 #include "mongo/stdx/unordered_set.h"
+#include "mongo/util/shared_buffer.h"
 
 namespace mongo {
 
@@ -167,6 +168,14 @@ public:
      */
     void makeObjOwnedIfNeeded();
 
+    /**
+     * Returns an owned copy of 'obj'. Small objects are copied into a buffer that this member
+     * recycles once every object previously copied into it has been released, which is usually
+     * the case after the member is freed back to its WorkingSet. This lets stages which must own
+     * per-result data avoid a heap allocation for each result they produce.
+     */
+    BSONObj copyOwned(const BSONObj& obj);
+
     /**
      * getFieldDotted uses its state (obj or index data) to produce the field with the provided
      * name.
@@ -227,9 +236,19 @@ public:
 private:
     friend class WorkingSet;
 
+    // Objects at least this large are never copied into '_recycledBuffer', so that a member does
+    // not pin a large allocation for the lifetime of its WorkingSet.
+    static constexpr size_t kMaxRecycledBufferSize = 64 * 1024;
+
+    // The smallest buffer allocated for '_recycledBuffer'.
+    static constexpr size_t kMinRecycledBufferSize = 256;
+
     MemberState _state = WorkingSetMember::INVALID;
 
     DocumentMetadataFields _metadata;
+
+    // Backs the objects returned by copyOwned(). Only reused when no other reference to it exists.
+    SharedBuffer _recycledBuffer;
 };
 
 /**
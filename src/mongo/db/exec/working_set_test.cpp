@@ -313,4 +313,51 @@ TEST_F(WorkingSetFixture, WsmCanBeExtractedAndReinserted) {
     ASSERT_FALSE(emplacedWsm->metadata());
 }
 
+TEST_F(WorkingSetFixture, CopyOwnedReusesBufferOnceReleased) {
+    BSONObj source = BSON("a" << 1 << "b"
+                              << "foo");
+    BSONObj unowned(source.objdata());
+
+    const char* firstBuffer = nullptr;
+    {
+        BSONObj copy = member->copyOwned(unowned);
+        ASSERT_TRUE(copy.isOwned());
+        ASSERT_BSONOBJ_EQ(copy, source);
+        firstBuffer = copy.objdata();
+
+        // The buffer is still referenced by 'copy', so a second copy may not overwrite it.
+        BSONObj secondCopy = member->copyOwned(BSON("c" << 2));
+        ASSERT_NOT_EQUALS(secondCopy.objdata(), firstBuffer);
+        ASSERT_BSONOBJ_EQ(copy, source);
+        ASSERT_BSONOBJ_EQ(secondCopy, BSON("c" << 2));
+    }
+
+    // With every copy released, the member recycles its most recent buffer.
+    BSONObj third = member->copyOwned(unowned);
+    const char* thirdBuffer = third.objdata();
+    third = BSONObj();
+    BSONObj fourth = member->copyOwned(unowned);
+    ASSERT_EQUALS(fourth.objdata(), thirdBuffer);
+    ASSERT_BSONOBJ_EQ(fourth, source);
+}
+
+TEST_F(WorkingSetFixture, MakeObjOwnedIfNeededCopiesUnownedBson) {
+    BSONObj source = BSON("a" << 1);
+    member->resetDocument(SnapshotId{1u}, BSONObj(source.objdata()));
+    ws->transitionToRecordIdAndObj(id);
+    ASSERT_FALSE(member->doc.value().isOwned());
+
+    member->makeObjOwnedIfNeeded();
+    ASSERT_TRUE(member->doc.value().isOwned());
+    ASSERT_EQ(member->doc.snapshotId().toNumber(), 1u);
+    ASSERT_BSONOBJ_EQ(member->doc.value().toBson(), source);
+}
+
+TEST_F(WorkingSetFixture, CopyOwnedHandlesLargeObjects) {
+    BSONObj source = BSON("a" << std::string(128 * 1024, 'x'));
+    BSONObj copy = member->copyOwned(BSONObj(source.objdata()));
+    ASSERT_TRUE(copy.isOwned());
+    ASSERT_BSONOBJ_EQ(copy, source);
+}
+
 }  // namespace mongo
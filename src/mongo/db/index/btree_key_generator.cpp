@@ -89,7 +89,8 @@ BSONElement BtreeKeyGenerator::_extractNextElement(const BSONObj& obj,
                                                    const char** field,
                                                    bool* arrayNestedArray) const {
     StringData firstField = str::before(*field, '.');
-    bool haveObjField = !obj.getField(firstField).eoo();
+    BSONElement firstElt = obj.getField(firstField);
+    bool haveObjField = !firstElt.eoo();
     BSONElement arrField = positionalInfo.positionallyIndexedElt;
 
     // An index component field name cannot exist in both a document
@@ -116,7 +117,19 @@ BSONElement BtreeKeyGenerator::_extractNextElement(const BSONObj& obj,
 
     *arrayNestedArray = false;
     if (haveObjField) {
-        return dps::extractElementAtPathOrArrayAlongPath(obj, *field);
+        // Continue from the element found above, rather than having
+        // dps::extractElementAtPathOrArrayAlongPath() scan 'obj' for it a second time.
+        *field += firstField.size();
+        if (**field == '.') {
+            ++*field;
+        }
+
+        if (firstElt.type() == Array || **field == '\0') {
+            return firstElt;
+        } else if (firstElt.type() == Object) {
+            return dps::extractElementAtPathOrArrayAlongPath(firstElt.embeddedObject(), *field);
+        }
+        return BSONElement();
     } else if (positionalInfo.hasPositionallyIndexedElt()) {
         if (arrField.type() == Array) {
             *arrayNestedArray = true;
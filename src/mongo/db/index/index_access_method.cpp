@@ -48,6 +48,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/timestamp_block.h"
 #include "mongo/db/storage/durable_catalog.h"
@@ -164,25 +165,9 @@ Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
     // over the data keys, each of them should point to the doc's RecordId. When iterating over
     // the multikey metadata keys, they should point to the reserved 'kMultikeyMetadataKeyId'.
     for (const auto keyVec : {&keys, &multikeyMetadataKeys}) {
-        for (const auto& keyString : *keyVec) {
-            bool unique = _descriptor->unique();
-            Status status = _newInterface->insert(opCtx, keyString, !unique /* dupsAllowed */);
-
-            // When duplicates are encountered and allowed, retry with dupsAllowed. Add the
-            // key to the output vector so callers know which duplicate keys were inserted.
-            if (ErrorCodes::DuplicateKey == status.code() && options.dupsAllowed) {
-                invariant(unique);
-                status = _newInterface->insert(opCtx, keyString, true /* dupsAllowed */);
-
-                if (status.isOK() && result) {
-                    auto key =
-                        KeyString::toBson(keyString, getSortedDataInterface()->getOrdering());
-                    result->dupsInserted.push_back(key);
-                }
-            }
-            if (isFatalError(opCtx, status, keyString)) {
-                return status;
-            }
+        Status status = _insertKeys(opCtx, *keyVec, options, result);
+        if (!status.isOK()) {
+            return status;
         }
     }
 
@@ -196,6 +181,44 @@ Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status AbstractIndexAccessMethod::insertKeysFromMultipleDocuments(
+    OperationContext* opCtx,
+    const vector<KeyString::Value>& keys,
+    const InsertDeleteOptions& options,
+    InsertResult* result) {
+    Status status = _insertKeys(opCtx, keys, options, result);
+    if (status.isOK() && result) {
+        result->numInserted += keys.size();
+    }
+    return status;
+}
+
+Status AbstractIndexAccessMethod::_insertKeys(OperationContext* opCtx,
+                                              const vector<KeyString::Value>& keys,
+                                              const InsertDeleteOptions& options,
+                                              InsertResult* result) {
+    const bool unique = _descriptor->unique();
+    for (const auto& keyString : keys) {
+        Status status = _newInterface->insert(opCtx, keyString, !unique /* dupsAllowed */);
+
+        // When duplicates are encountered and allowed, retry with dupsAllowed. Add the
+        // key to the output vector so callers know which duplicate keys were inserted.
+        if (ErrorCodes::DuplicateKey == status.code() && options.dupsAllowed) {
+            invariant(unique);
+            status = _newInterface->insert(opCtx, keyString, true /* dupsAllowed */);
+
+            if (status.isOK() && result) {
+                auto key = KeyString::toBson(keyString, getSortedDataInterface()->getOrdering());
+                result->dupsInserted.push_back(key);
+            }
+        }
+        if (isFatalError(opCtx, status, keyString)) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
 void AbstractIndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                              const KeyString::Value& keyString,
                                              const RecordId& loc,
@@ -505,7 +528,9 @@ AbstractIndexAccessMethod::BulkBuilderImpl::BulkBuilderImpl(IndexCatalogEntry* i
           SortOptions()
               .TempDir(storageGlobalParams.dbpath + "/_tmp")
               .ExtSortAllowed()
-              .MaxMemoryUsageBytes(maxMemoryUsageBytes),
+              .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+              .PrefixCompressKeys()
+              .MaxSpillFanIn(internalQueryMaxSpillFanIn.load()),
           BtreeExternalSortComparison(),
           std::pair<KeyString::Value::SorterDeserializeSettings,
                     mongo::NullValue::SorterDeserializeSettings>(
@@ -98,6 +98,16 @@ public:
                               const InsertDeleteOptions& options,
                               InsertResult* result) = 0;
 
+    /**
+     * Inserts 'keys', which may have been generated from several documents, into the index in the
+     * order given. Unlike insertKeys(), this never marks the index as multikey; the caller is
+     * responsible for doing so for each document that requires it.
+     */
+    virtual Status insertKeysFromMultipleDocuments(OperationContext* opCtx,
+                                                   const std::vector<KeyString::Value>& keys,
+                                                   const InsertDeleteOptions& options,
+                                                   InsertResult* result) = 0;
+
     /**
      * Analogous to insertKeys above, but remove the keys instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the provided keys.
@@ -463,6 +473,11 @@ public:
                       const InsertDeleteOptions& options,
                       InsertResult* result) final;
 
+    Status insertKeysFromMultipleDocuments(OperationContext* opCtx,
+                                           const std::vector<KeyString::Value>& keys,
+                                           const InsertDeleteOptions& options,
+                                           InsertResult* result) final;
+
     Status removeKeys(OperationContext* opCtx,
                       const std::vector<KeyString::Value>& keys,
                       const RecordId& loc,
@@ -563,6 +578,15 @@ private:
      */
     bool isFatalError(OperationContext* opCtx, Status status, KeyString::Value key);
 
+    /**
+     * Inserts each of 'keys' into the index, retrying duplicates if 'options' allows them. Does not
+     * update 'result->numInserted' or the index's multikey state.
+     */
+    Status _insertKeys(OperationContext* opCtx,
+                       const std::vector<KeyString::Value>& keys,
+                       const InsertDeleteOptions& options,
+                       InsertResult* result);
+
     /**
      * Removes a single key from the index.
      *
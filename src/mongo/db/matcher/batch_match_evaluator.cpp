@@ -0,0 +1,476 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/batch_match_evaluator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <type_traits>
+
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_type.h"
+
+// TODO replace this with #if BOOST_HW_SIMD_X86 >= BOOST_HW_SIMD_X86_SSE2_VERSION in boost 1.60
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#define MONGO_BATCH_MATCH_HAVE_SSE2
+#endif
+
+namespace mongo {
+
+namespace {
+
+// Every 64-bit integer with a magnitude up to 2^53 converts to a double exactly, so comparisons of
+// such integers against numbers are carried out exactly in double precision.
+constexpr long long kMaxExactIntegerInDouble = 1LL << 53;
+
+// Beyond this many $in operands the operands are binary searched rather than each checked with a
+// kernel.
+constexpr size_t kMaxInOperandsForKernel = 8;
+
+bool isTopLevelField(StringData path) {
+    return !path.empty() && path.find('.') == std::string::npos;
+}
+
+/**
+ * Converts a comparison operand into the representation used by the kernels. Returns false if the
+ * operand cannot be handled by the kernels.
+ */
+bool parseOperand(const BSONElement& elem,
+                  BatchMatchEvaluator::ValueClass* operandClass,
+                  double* number,
+                  long long* date) {
+    switch (elem.type()) {
+        case NumberInt:
+            *operandClass = BatchMatchEvaluator::ValueClass::kNumber;
+            *number = elem._numberInt();
+            return true;
+        case NumberLong: {
+            const long long value = elem._numberLong();
+            if (value > kMaxExactIntegerInDouble || value < -kMaxExactIntegerInDouble) {
+                return false;
+            }
+            *operandClass = BatchMatchEvaluator::ValueClass::kNumber;
+            *number = static_cast<double>(value);
+            return true;
+        }
+        case NumberDouble:
+            if (std::isnan(elem._numberDouble())) {
+                return false;
+            }
+            *operandClass = BatchMatchEvaluator::ValueClass::kNumber;
+            *number = elem._numberDouble();
+            return true;
+        case Date:
+            *operandClass = BatchMatchEvaluator::ValueClass::kDate;
+            *date = elem.date().toMillisSinceEpoch();
+            return true;
+        default:
+            return false;
+    }
+}
+
+//
+// Compare kernels. Each one sets (or, when accumulating, ORs into) out[i] the result of comparing
+// values[i] against 'operand', for every i in [0, n).
+//
+
+struct CmpLT : std::less<> {
+#ifdef MONGO_BATCH_MATCH_HAVE_SSE2
+    static __m128d vec(__m128d lhs, __m128d rhs) {
+        return _mm_cmplt_pd(lhs, rhs);
+    }
+#endif
+};
+
+struct CmpLTE : std::less_equal<> {
+#ifdef MONGO_BATCH_MATCH_HAVE_SSE2
+    static __m128d vec(__m128d lhs, __m128d rhs) {
+        return _mm_cmple_pd(lhs, rhs);
+    }
+#endif
+};
+
+struct CmpEQ : std::equal_to<> {
+#ifdef MONGO_BATCH_MATCH_HAVE_SSE2
+    static __m128d vec(__m128d lhs, __m128d rhs) {
+        return _mm_cmpeq_pd(lhs, rhs);
+    }
+#endif
+};
+
+struct CmpGT : std::greater<> {
+#ifdef MONGO_BATCH_MATCH_HAVE_SSE2
+    static __m128d vec(__m128d lhs, __m128d rhs) {
+        return _mm_cmpgt_pd(lhs, rhs);
+    }
+#endif
+};
+
+struct CmpGTE : std::greater_equal<> {
+#ifdef MONGO_BATCH_MATCH_HAVE_SSE2
+    static __m128d vec(__m128d lhs, __m128d rhs) {
+        return _mm_cmpge_pd(lhs, rhs);
+    }
+#endif
+};
+
+template <bool kAccumulate>
+void storeResult(uint8_t* out, size_t i, uint8_t result) {
+    if (kAccumulate) {
+        out[i] |= result;
+    } else {
+        out[i] = result;
+    }
+}
+
+template <typename Cmp, bool kAccumulate, typename T>
+void compareKernel(const T* values, size_t n, T operand, uint8_t* out) {
+    size_t i = 0;
+#ifdef MONGO_BATCH_MATCH_HAVE_SSE2
+    if constexpr (std::is_same<T, double>::value) {
+        // IEEE comparisons against NaN are false, which is also how the matcher treats a NaN value
+        // compared to a non-NaN operand.
+        const __m128d rhs = _mm_set1_pd(operand);
+        for (; i + 2 <= n; i += 2) {
+            const int mask = _mm_movemask_pd(Cmp::vec(_mm_loadu_pd(values + i), rhs));
+            storeResult<kAccumulate>(out, i, mask & 1);
+            storeResult<kAccumulate>(out, i + 1, (mask >> 1) & 1);
+        }
+    }
+#endif
+    const Cmp cmp;
+    for (; i < n; ++i) {
+        storeResult<kAccumulate>(out, i, cmp(values[i], operand));
+    }
+}
+
+template <typename T>
+void compareKernel(
+    MatchExpression::MatchType op, const T* values, size_t n, T operand, uint8_t* out) {
+    switch (op) {
+        case MatchExpression::LT:
+            return compareKernel<CmpLT, false>(values, n, operand, out);
+        case MatchExpression::LTE:
+            return compareKernel<CmpLTE, false>(values, n, operand, out);
+        case MatchExpression::EQ:
+            return compareKernel<CmpEQ, false>(values, n, operand, out);
+        case MatchExpression::GT:
+            return compareKernel<CmpGT, false>(values, n, operand, out);
+        case MatchExpression::GTE:
+            return compareKernel<CmpGTE, false>(values, n, operand, out);
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+/**
+ * ORs into out[i] whether values[i] is one of 'operands', which must be sorted.
+ */
+template <typename T>
+void inKernel(const T* values, size_t n, const std::vector<T>& operands, uint8_t* out) {
+    if (operands.size() <= kMaxInOperandsForKernel) {
+        for (auto&& operand : operands) {
+            compareKernel<CmpEQ, true>(values, n, operand, out);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        out[i] |= std::binary_search(operands.begin(), operands.end(), values[i]);
+    }
+}
+
+}  // namespace
+
+std::unique_ptr<BatchMatchEvaluator> BatchMatchEvaluator::compile(const MatchExpression* expr) {
+    if (!expr) {
+        return nullptr;
+    }
+
+    std::unique_ptr<BatchMatchEvaluator> evaluator(new BatchMatchEvaluator(expr));
+    if (!evaluator->addPredicates(expr) || evaluator->_predicates.empty()) {
+        return nullptr;
+    }
+    return evaluator;
+}
+
+bool BatchMatchEvaluator::addPredicates(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                if (!addPredicates(expr->getChild(i))) {
+                    return false;
+                }
+            }
+            return true;
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE: {
+            auto cmp = static_cast<const ComparisonMatchExpression*>(expr);
+            if (!isTopLevelField(cmp->path())) {
+                return false;
+            }
+
+            Predicate pred{Predicate::Kind::kCompare};
+            pred.op = cmp->matchType();
+            if (!parseOperand(
+                    cmp->getData(), &pred.operandClass, &pred.numberOperand, &pred.dateOperand)) {
+                return false;
+            }
+            pred.column = columnFor(cmp->path());
+            _predicates.push_back(std::move(pred));
+            return true;
+        }
+        case MatchExpression::MATCH_IN: {
+            auto in = static_cast<const InMatchExpression*>(expr);
+            if (!isTopLevelField(in->path()) || !in->getRegexes().empty() ||
+                in->getEqualities().empty()) {
+                return false;
+            }
+
+            Predicate pred{Predicate::Kind::kIn};
+            for (auto&& equality : in->getEqualities()) {
+                ValueClass operandClass;
+                double number;
+                long long date;
+                if (!parseOperand(equality, &operandClass, &number, &date)) {
+                    return false;
+                }
+                if (operandClass == ValueClass::kNumber) {
+                    pred.inNumbers.push_back(number);
+                } else {
+                    pred.inDates.push_back(date);
+                }
+            }
+            std::sort(pred.inNumbers.begin(), pred.inNumbers.end());
+            std::sort(pred.inDates.begin(), pred.inDates.end());
+            pred.column = columnFor(in->path());
+            _predicates.push_back(std::move(pred));
+            return true;
+        }
+        case MatchExpression::TYPE_OPERATOR: {
+            auto type = static_cast<const TypeMatchExpression*>(expr);
+            if (!isTopLevelField(type->path())) {
+                return false;
+            }
+
+            Predicate pred{Predicate::Kind::kType};
+            pred.typeExpr = type;
+            pred.column = columnFor(type->path());
+            _predicates.push_back(std::move(pred));
+            return true;
+        }
+        case MatchExpression::EXISTS: {
+            auto exists = static_cast<const ExistsMatchExpression*>(expr);
+            if (!isTopLevelField(exists->path())) {
+                return false;
+            }
+
+            Predicate pred{Predicate::Kind::kExists};
+            pred.column = columnFor(exists->path());
+            _predicates.push_back(std::move(pred));
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+size_t BatchMatchEvaluator::columnFor(StringData fieldName) {
+    for (size_t i = 0; i < _columns.size(); ++i) {
+        if (_columns[i].fieldName == fieldName) {
+            return i;
+        }
+    }
+    _columns.emplace_back();
+    _columns.back().fieldName = fieldName.toString();
+    return _columns.size() - 1;
+}
+
+void BatchMatchEvaluator::extractColumns(const BSONObj* docs, size_t numDocs) {
+    for (auto&& column : _columns) {
+        column.classes.assign(numDocs, ValueClass::kMissing);
+        column.types.assign(numDocs, EOO);
+        column.numbers.assign(numDocs, 0);
+        column.dates.assign(numDocs, 0);
+    }
+
+    for (size_t i = 0; i < numDocs; ++i) {
+        size_t found = 0;
+        for (auto&& elem : docs[i]) {
+            const StringData fieldName = elem.fieldNameStringData();
+            for (auto&& column : _columns) {
+                // Only the first occurrence of a field name is considered, as in the matcher.
+                if (column.classes[i] != ValueClass::kMissing || column.fieldName != fieldName) {
+                    continue;
+                }
+
+                ++found;
+                column.types[i] = elem.type();
+                switch (elem.type()) {
+                    case NumberInt:
+                        column.classes[i] = ValueClass::kNumber;
+                        column.numbers[i] = elem._numberInt();
+                        break;
+                    case NumberLong: {
+                        const long long value = elem._numberLong();
+                        if (value > kMaxExactIntegerInDouble || value < -kMaxExactIntegerInDouble) {
+                            column.classes[i] = ValueClass::kInexactNumber;
+                        } else {
+                            column.classes[i] = ValueClass::kNumber;
+                            column.numbers[i] = static_cast<double>(value);
+                        }
+                        break;
+                    }
+                    case NumberDouble:
+                        column.classes[i] = ValueClass::kNumber;
+                        column.numbers[i] = elem._numberDouble();
+                        break;
+                    case NumberDecimal:
+                        column.classes[i] = ValueClass::kInexactNumber;
+                        break;
+                    case Date:
+                        column.classes[i] = ValueClass::kDate;
+                        column.dates[i] = elem.date().toMillisSinceEpoch();
+                        break;
+                    case Array:
+                        column.classes[i] = ValueClass::kArray;
+                        break;
+                    default:
+                        column.classes[i] = ValueClass::kOther;
+                        break;
+                }
+            }
+
+            if (found == _columns.size()) {
+                break;
+            }
+        }
+    }
+}
+
+void BatchMatchEvaluator::evaluatePredicate(const Predicate& pred, size_t numDocs) {
+    const Column& column = _columns[pred.column];
+    uint8_t* out = _scratch.data();
+
+    switch (pred.kind) {
+        case Predicate::Kind::kCompare: {
+            if (pred.operandClass == ValueClass::kNumber) {
+                compareKernel(pred.op, column.numbers.data(), numDocs, pred.numberOperand, out);
+            } else {
+                compareKernel(pred.op, column.dates.data(), numDocs, pred.dateOperand, out);
+            }
+
+            const bool numeric = pred.operandClass == ValueClass::kNumber;
+            for (size_t i = 0; i < numDocs; ++i) {
+                const ValueClass valueClass = column.classes[i];
+                const bool undecided = valueClass == ValueClass::kArray ||
+                    (numeric && valueClass == ValueClass::kInexactNumber);
+                out[i] = (out[i] & (valueClass == pred.operandClass)) | undecided;
+                _undecided[i] |= undecided;
+            }
+            return;
+        }
+        case Predicate::Kind::kIn: {
+            std::fill(out, out + numDocs, 0);
+            inKernel(column.numbers.data(), numDocs, pred.inNumbers, out);
+            for (size_t i = 0; i < numDocs; ++i) {
+                out[i] &= column.classes[i] == ValueClass::kNumber;
+            }
+            if (!pred.inDates.empty()) {
+                std::vector<uint8_t> dateMatches(numDocs, 0);
+                inKernel(column.dates.data(), numDocs, pred.inDates, dateMatches.data());
+                for (size_t i = 0; i < numDocs; ++i) {
+                    out[i] |= dateMatches[i] & (column.classes[i] == ValueClass::kDate);
+                }
+            }
+
+            for (size_t i = 0; i < numDocs; ++i) {
+                const ValueClass valueClass = column.classes[i];
+                const bool undecided = valueClass == ValueClass::kArray ||
+                    (!pred.inNumbers.empty() && valueClass == ValueClass::kInexactNumber);
+                out[i] |= undecided;
+                _undecided[i] |= undecided;
+            }
+            return;
+        }
+        case Predicate::Kind::kType: {
+            const auto& typeSet = static_cast<const TypeMatchExpression*>(pred.typeExpr)->typeSet();
+            for (size_t i = 0; i < numDocs; ++i) {
+                const bool undecided = column.classes[i] == ValueClass::kArray;
+                out[i] = typeSet.hasType(static_cast<BSONType>(column.types[i])) || undecided;
+                _undecided[i] |= undecided;
+            }
+            return;
+        }
+        case Predicate::Kind::kExists: {
+            for (size_t i = 0; i < numDocs; ++i) {
+                const bool undecided = column.classes[i] == ValueClass::kArray;
+                out[i] = column.classes[i] != ValueClass::kMissing;
+                _undecided[i] |= undecided;
+            }
+            return;
+        }
+    }
+    MONGO_UNREACHABLE;
+}
+
+void BatchMatchEvaluator::evaluate(const BSONObj* docs,
+                                   size_t numDocs,
+                                   std::vector<uint8_t>* matches) {
+    matches->assign(numDocs, 1);
+    _scratch.resize(numDocs);
+    _undecided.assign(numDocs, 0);
+
+    extractColumns(docs, numDocs);
+
+    for (auto&& pred : _predicates) {
+        evaluatePredicate(pred, numDocs);
+        for (size_t i = 0; i < numDocs; ++i) {
+            (*matches)[i] &= _scratch[i];
+        }
+    }
+
+    // A document which a kernel could not decide, and which no other predicate has ruled out, is
+    // handed to the original expression.
+    for (size_t i = 0; i < numDocs; ++i) {
+        if ((*matches)[i] && _undecided[i]) {
+            (*matches)[i] = _expr->matchesBSON(docs[i]);
+        }
+    }
+}
+
+}  // namespace mongo
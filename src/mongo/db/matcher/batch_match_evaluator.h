@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+/**
+ * Evaluates a MatchExpression over a batch of documents at once, rather than one document at a
+ * time through MatchableDocument.
+ *
+ * Only expressions made up of the following predicates over top-level (non-dotted) fields, joined
+ * by $and, can be compiled:
+ *  - $eq, $lt, $lte, $gt and $gte against a non-NaN number or a date,
+ *  - $in against a list of non-NaN numbers and dates,
+ *  - $type,
+ *  - {$exists: true}.
+ *
+ * Every referenced field is extracted from each document of the batch in a single pass over the
+ * document into a contiguous column, and each predicate is then checked over that column with a
+ * compare kernel. Documents whose value cannot be decided by a kernel (arrays, decimals, and 64-bit
+ * integers which have no exact double representation) fall back to the original expression, so the
+ * results are always identical to MatchExpression::matchesBSON().
+ */
+class BatchMatchEvaluator {
+public:
+    /**
+     * Returns an evaluator for 'expr', or nullptr if 'expr' is not eligible. The expression is not
+     * owned and must outlive the evaluator.
+     */
+    static std::unique_ptr<BatchMatchEvaluator> compile(const MatchExpression* expr);
+
+    /**
+     * Sets (*matches)[i] to 1 if 'docs[i]' matches the expression and to 0 otherwise. 'matches'
+     * is resized to 'numDocs'.
+     */
+    void evaluate(const BSONObj* docs, size_t numDocs, std::vector<uint8_t>* matches);
+
+    /**
+     * Classification of a single extracted value, which decides how a predicate treats it.
+     */
+    enum class ValueClass : uint8_t {
+        kMissing,
+        kNumber,
+        kDate,
+        kOther,
+        // Values which only the original expression can decide.
+        kArray,
+        kInexactNumber,
+    };
+
+private:
+    struct Column {
+        std::string fieldName;
+        std::vector<ValueClass> classes;
+        std::vector<int8_t> types;
+        std::vector<double> numbers;
+        std::vector<long long> dates;
+    };
+
+    struct Predicate {
+        enum class Kind { kCompare, kIn, kType, kExists };
+
+        Kind kind;
+        MatchExpression::MatchType op = MatchExpression::EQ;
+        size_t column = 0;
+
+        // Operands of a kCompare predicate; exactly one of them applies, according to
+        // 'operandClass'.
+        ValueClass operandClass = ValueClass::kNumber;
+        double numberOperand = 0;
+        long long dateOperand = 0;
+
+        // Operands of a kIn predicate.
+        std::vector<double> inNumbers;
+        std::vector<long long> inDates;
+
+        // The $type expression, for kType predicates.
+        const MatchExpression* typeExpr = nullptr;
+    };
+
+    explicit BatchMatchEvaluator(const MatchExpression* expr) : _expr(expr) {}
+
+    bool addPredicates(const MatchExpression* expr);
+    size_t columnFor(StringData fieldName);
+
+    void extractColumns(const BSONObj* docs, size_t numDocs);
+    void evaluatePredicate(const Predicate& pred, size_t numDocs);
+
+    const MatchExpression* _expr;
+
+    std::vector<Column> _columns;
+    std::vector<Predicate> _predicates;
+
+    // Per-batch scratch space, reused across calls to evaluate().
+    std::vector<uint8_t> _scratch;
+    std::vector<uint8_t> _undecided;
+};
+
+}  // namespace mongo
@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/batch_match_evaluator.h"
+
+#include <limits>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& query) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto statusWithMatcher = MatchExpressionParser::parse(query, expCtx);
+    ASSERT_OK(statusWithMatcher.getStatus());
+    return std::move(statusWithMatcher.getValue());
+}
+
+std::vector<BSONObj> testDocuments() {
+    const long long kBigLong = (1LL << 53) + 1;
+    return {
+        BSONObj(),
+        BSON("a" << 1),
+        BSON("a" << 5),
+        BSON("a" << 5.0),
+        BSON("a" << 5LL),
+        BSON("a" << -5),
+        BSON("a" << 4.999),
+        BSON("a" << 10),
+        BSON("a" << std::numeric_limits<double>::quiet_NaN()),
+        BSON("a" << std::numeric_limits<double>::infinity()),
+        BSON("a" << kBigLong),
+        BSON("a" << -kBigLong),
+        BSON("a" << Decimal128("5")),
+        BSON("a" << Decimal128("5.5")),
+        BSON("a"
+             << "5"),
+        BSON("a" << BSONNULL),
+        BSON("a" << true),
+        BSON("a" << Date_t::fromMillisSinceEpoch(5)),
+        BSON("a" << Date_t::fromMillisSinceEpoch(1000)),
+        BSON("a" << Timestamp(5, 0)),
+        BSON("a" << BSON_ARRAY(1 << 7)),
+        BSON("a" << BSON_ARRAY(5)),
+        BSONObj(BSON("a" << BSONArray())),
+        BSON("a" << BSON("b" << 5)),
+        BSON("a" << 5 << "a" << 100),
+        BSON("b" << 5),
+        BSON("a" << 5 << "b" << 7),
+        BSON("a" << 7 << "b" << 5),
+        BSON("b" << 7 << "a" << 6),
+    };
+}
+
+/**
+ * Asserts that the batch evaluator agrees with MatchExpression::matchesBSON() for every test
+ * document.
+ */
+void assertMatchesLikeMatcher(const BSONObj& query) {
+    auto expr = parse(query);
+    auto evaluator = BatchMatchEvaluator::compile(expr.get());
+    ASSERT(evaluator) << query;
+
+    const auto docs = testDocuments();
+    std::vector<uint8_t> matches;
+    evaluator->evaluate(docs.data(), docs.size(), &matches);
+    ASSERT_EQ(docs.size(), matches.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        ASSERT_EQ(expr->matchesBSON(docs[i]), static_cast<bool>(matches[i]))
+            << "query: " << query << ", document: " << docs[i];
+    }
+}
+
+TEST(BatchMatchEvaluatorTest, NumericComparisonsAgreeWithMatcher) {
+    for (auto&& op : {"$eq", "$lt", "$lte", "$gt", "$gte"}) {
+        assertMatchesLikeMatcher(BSON("a" << BSON(op << 5)));
+        assertMatchesLikeMatcher(BSON("a" << BSON(op << 5.0)));
+        assertMatchesLikeMatcher(BSON("a" << BSON(op << 5LL)));
+        assertMatchesLikeMatcher(BSON("a" << BSON(op << 4.5)));
+        assertMatchesLikeMatcher(BSON("a" << BSON(op << -1)));
+    }
+}
+
+TEST(BatchMatchEvaluatorTest, DateComparisonsAgreeWithMatcher) {
+    for (auto&& op : {"$eq", "$lt", "$lte", "$gt", "$gte"}) {
+        assertMatchesLikeMatcher(BSON("a" << BSON(op << Date_t::fromMillisSinceEpoch(5))));
+    }
+}
+
+TEST(BatchMatchEvaluatorTest, InAgreesWithMatcher) {
+    assertMatchesLikeMatcher(fromjson("{a: {$in: [1, 5, 7]}}"));
+    assertMatchesLikeMatcher(
+        BSON("a" << BSON("$in" << BSON_ARRAY(10 << Date_t::fromMillisSinceEpoch(5)))));
+    assertMatchesLikeMatcher(fromjson("{a: {$in: [1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12]}}"));
+}
+
+TEST(BatchMatchEvaluatorTest, TypeAndExistsAgreeWithMatcher) {
+    assertMatchesLikeMatcher(fromjson("{a: {$type: 'number'}}"));
+    assertMatchesLikeMatcher(fromjson("{a: {$type: ['double', 'date']}}"));
+    assertMatchesLikeMatcher(fromjson("{a: {$type: 'array'}}"));
+    assertMatchesLikeMatcher(fromjson("{a: {$exists: true}}"));
+}
+
+TEST(BatchMatchEvaluatorTest, ConjunctionsAgreeWithMatcher) {
+    assertMatchesLikeMatcher(fromjson("{a: {$gt: 1, $lte: 7}}"));
+    assertMatchesLikeMatcher(fromjson("{a: {$gte: 5}, b: {$lt: 6}}"));
+    assertMatchesLikeMatcher(fromjson("{$and: [{a: {$exists: true}}, {b: {$in: [5, 7]}}]}"));
+}
+
+TEST(BatchMatchEvaluatorTest, IneligibleExpressionsDoNotCompile) {
+    for (auto&& query : {"{'a.b': {$lt: 5}}",
+                         "{a: {$lt: 'abc'}}",
+                         "{a: {$lt: NaN}}",
+                         "{a: {$lt: NumberDecimal('5')}}",
+                         "{a: {$eq: null}}",
+                         "{a: {$in: [1, /abc/]}}",
+                         "{$or: [{a: 1}, {b: 1}]}",
+                         "{a: {$exists: false}}",
+                         "{a: {$ne: 5}}"}) {
+        auto expr = parse(fromjson(query));
+        ASSERT_FALSE(BatchMatchEvaluator::compile(expr.get())) << query;
+    }
+
+    auto expr = parse(BSON("a" << BSON("$lt" << (1LL << 60))));
+    ASSERT_FALSE(BatchMatchEvaluator::compile(expr.get()));
+}
+
+}  // namespace
+}  // namespace mongo
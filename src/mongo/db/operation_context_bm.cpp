@@ -0,0 +1,79 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Returns a ServiceContext shared by all benchmark threads, which outlives every Client they make.
+ */
+ServiceContext* benchmarkServiceContext() {
+    static const auto serviceContext = ServiceContext::make();
+    return serviceContext.get();
+}
+
+/**
+ * Measures the cost of constructing and destroying a Client, which includes constructing every
+ * Client decoration linked into the binary.
+ */
+void BM_MakeClient(benchmark::State& state) {
+    auto serviceContext = benchmarkServiceContext();
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(serviceContext->makeClient("BM_MakeClient"));
+    }
+}
+
+/**
+ * Measures the per-request cost of constructing and destroying an OperationContext on an existing
+ * Client, which includes running the ClientObservers and constructing every OperationContext
+ * decoration. Each thread uses its own Client, as each connection would.
+ */
+void BM_MakeOperationContext(benchmark::State& state) {
+    auto client = benchmarkServiceContext()->makeClient(
+        str::stream() << "BM_MakeOperationContext-" << state.thread_index);
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(client->makeOperationContext());
+    }
+}
+
+BENCHMARK(BM_MakeClient);
+BENCHMARK(BM_MakeOperationContext)->ThreadRange(1, 16);
+
+}  // namespace
+}  // namespace mongo
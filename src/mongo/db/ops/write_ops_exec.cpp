@@ -213,6 +213,35 @@ void assertCanWrite_inlock(OperationContext* opCtx, const NamespaceString& ns) {
     CollectionShardingState::get(opCtx, ns)->checkShardVersionOrThrow(opCtx);
 }
 
+/**
+ * Lets the storage engine throttle writes to the collection held by 'collection' before they
+ * start. If the write is to be delayed, 'collection' is reset so that the wait happens without
+ * holding any locks, and true is returned to tell the caller to reacquire the collection. Each
+ * write is delayed at most once, as tracked by 'admitted'. Writes made inside of a
+ * WriteUnitOfWork, as in multi-document transactions, and writes nested under other locks are
+ * never delayed, since waiting would hold their storage transaction or those locks. They are not
+ * asked for a delay either, so that the storage engine only counts writes which actually wait.
+ */
+bool waitForWriteAdmission(OperationContext* opCtx,
+                           boost::optional<AutoGetCollection>* collection,
+                           bool* admitted) {
+    if (*admitted || !(*collection)->getCollection() ||
+        opCtx->lockState()->inAWriteUnitOfWork() ||
+        opCtx->lockState()->isGlobalLockedRecursively()) {
+        return false;
+    }
+    *admitted = true;
+
+    auto delay = (*collection)->getCollection()->getRecordStore()->getWriteAdmissionDelay(opCtx);
+    if (delay <= Milliseconds(0))
+        return false;
+
+    collection->reset();  // unlock.
+    invariant(!opCtx->lockState()->isLocked());
+    opCtx->sleepFor(delay);
+    return true;
+}
+
 void makeCollection(OperationContext* opCtx, const NamespaceString& ns) {
     auto isFullyUpgradedTo44 =
         (serverGlobalParams.featureCompatibility.isVersionInitialized() &&
@@ -412,14 +441,18 @@ bool insertBatchAndHandleErrors(OperationContext* opCtx,
     }
 
     boost::optional<AutoGetCollection> collection;
+    bool writeAdmitted = false;
     auto acquireCollection = [&] {
         while (true) {
             collection.emplace(
                 opCtx,
                 wholeOp.getNamespace(),
                 fixLockModeForSystemDotViewsChanges(wholeOp.getNamespace(), MODE_IX));
-            if (collection->getCollection())
+            if (collection->getCollection()) {
+                if (waitForWriteAdmission(opCtx, &collection, &writeAdmitted))
+                    continue;
                 break;
+            }
 
             collection.reset();  // unlock.
             makeCollection(opCtx, wholeOp.getNamespace());
@@ -647,13 +680,17 @@ static SingleWriteResult performSingleUpdateOp(OperationContext* opCtx,
     }
 
     boost::optional<AutoGetCollection> collection;
+    bool writeAdmitted = false;
     while (true) {
         collection.emplace(opCtx, ns, fixLockModeForSystemDotViewsChanges(ns, MODE_IX));
 
         // If this is an upsert, which is an insert, we must have a collection.
         // An update on a non-existant collection is okay and handled later.
-        if (collection->getCollection() || !updateRequest.isUpsert())
+        if (collection->getCollection() || !updateRequest.isUpsert()) {
+            if (waitForWriteAdmission(opCtx, &collection, &writeAdmitted))
+                continue;
             break;
+        }
 
         collection.reset();  // unlock.
         makeCollection(opCtx, ns);
@@ -906,10 +943,14 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
         uasserted(ErrorCodes::InternalError, "failAllRemoves failpoint active!");
     }
 
-    AutoGetCollection collection(opCtx, ns, fixLockModeForSystemDotViewsChanges(ns, MODE_IX));
+    boost::optional<AutoGetCollection> collection;
+    bool writeAdmitted = false;
+    do {
+        collection.emplace(opCtx, ns, fixLockModeForSystemDotViewsChanges(ns, MODE_IX));
+    } while (waitForWriteAdmission(opCtx, &collection, &writeAdmitted));
 
-    if (collection.getDb()) {
-        curOp.raiseDbProfileLevel(collection.getDb()->getProfilingLevel());
+    if (collection->getDb()) {
+        curOp.raiseDbProfileLevel(collection->getDb()->getProfilingLevel());
     }
 
     assertCanWrite_inlock(opCtx, ns);
@@ -918,7 +959,7 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
         &hangWithLockDuringBatchRemove, opCtx, "hangWithLockDuringBatchRemove");
 
     auto exec = uassertStatusOK(getExecutorDelete(
-        &curOp.debug(), collection.getCollection(), &parsedDelete, boost::none /* verbosity */));
+        &curOp.debug(), collection->getCollection(), &parsedDelete, boost::none /* verbosity */));
 
     {
         stdx::lock_guard<Client> lk(*opCtx->getClient());
@@ -931,8 +972,8 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
 
     PlanSummaryStats summary;
     Explain::getSummaryStats(*exec, &summary);
-    if (collection.getCollection()) {
-        CollectionQueryInfo::get(collection.getCollection()).notifyOfQuery(opCtx, summary);
+    if (collection->getCollection()) {
+        CollectionQueryInfo::get(collection->getCollection()).notifyOfQuery(opCtx, summary);
     }
     curOp.debug().setPlanSummaryMetrics(summary);
 
@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+
+namespace mongo {
+namespace {
+
+enum class InputType { kInt, kLong, kDouble, kMixed };
+
+std::vector<Value> makeValues(InputType type, long long numValues) {
+    std::vector<Value> values;
+    values.reserve(numValues);
+    for (long long i = 0; i < numValues; ++i) {
+        switch (type) {
+            case InputType::kInt:
+                values.emplace_back(static_cast<int>(i % 1000));
+                break;
+            case InputType::kLong:
+                values.emplace_back(i * 1000003);
+                break;
+            case InputType::kDouble:
+                values.emplace_back(i * 0.5);
+                break;
+            case InputType::kMixed:
+                values.emplace_back(i % 2 ? Value(static_cast<int>(i)) : Value(i * 0.5));
+                break;
+        }
+    }
+    return values;
+}
+
+/**
+ * Feeds 'state.range(0)' values of the given type to a fresh accumulator per iteration, and reports
+ * the throughput in values processed.
+ */
+template <typename AccumulatorType>
+void runAccumulator(benchmark::State& state, InputType type) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    const auto values = makeValues(type, state.range(0));
+
+    for (auto _ : state) {
+        auto accumulator = AccumulatorType::create(expCtx);
+        for (auto&& value : values) {
+            accumulator->process(value, false);
+        }
+        benchmark::DoNotOptimize(accumulator->getValue(false));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SumInt(benchmark::State& state) {
+    runAccumulator<AccumulatorSum>(state, InputType::kInt);
+}
+
+void BM_SumLong(benchmark::State& state) {
+    runAccumulator<AccumulatorSum>(state, InputType::kLong);
+}
+
+void BM_SumDouble(benchmark::State& state) {
+    runAccumulator<AccumulatorSum>(state, InputType::kDouble);
+}
+
+void BM_SumMixed(benchmark::State& state) {
+    runAccumulator<AccumulatorSum>(state, InputType::kMixed);
+}
+
+void BM_AvgDouble(benchmark::State& state) {
+    runAccumulator<AccumulatorAvg>(state, InputType::kDouble);
+}
+
+void BM_MinLong(benchmark::State& state) {
+    runAccumulator<AccumulatorMin>(state, InputType::kLong);
+}
+
+void BM_MaxDouble(benchmark::State& state) {
+    runAccumulator<AccumulatorMax>(state, InputType::kDouble);
+}
+
+BENCHMARK(BM_SumInt)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_SumLong)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_SumDouble)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_SumMixed)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_AvgDouble)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_MinLong)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_MaxDouble)->Range(1 << 10, 1 << 16);
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,228 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/aggregation_result_cache.h"
+
+#include <iterator>
+#include <limits>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getAggregationResultCache =
+    ServiceContext::declareDecoration<AggregationResultCache>();
+
+Counter64 aggregationResultCacheHits;
+Counter64 aggregationResultCacheMisses;
+
+ServerStatusMetricField<Counter64> displayAggregationResultCacheHits(
+    "query.aggregationResultCache.hits", &aggregationResultCacheHits);
+ServerStatusMetricField<Counter64> displayAggregationResultCacheMisses(
+    "query.aggregationResultCache.misses", &aggregationResultCacheMisses);
+
+// Accounts for the list node, the hash table slot and the vector header of each entry.
+constexpr size_t kPerEntryOverheadBytes = 128;
+
+// How many collections without cached entries may have their generation tracked before they are
+// pruned.
+constexpr size_t kMaxIdleCollections = 1024;
+
+}  // namespace
+
+AggregationResultCache::AggregationResultCache()
+    : _entries(std::numeric_limits<std::size_t>::max()) {}
+
+AggregationResultCache* AggregationResultCache::get(ServiceContext* serviceContext) {
+    return &getAggregationResultCache(serviceContext);
+}
+
+AggregationResultCache* AggregationResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool AggregationResultCache::isEnabled() {
+    return internalQueryAggregationResultCacheSizeBytes.load() > 0;
+}
+
+std::string AggregationResultCache::makeKey(const UUID& uuid, const BSONObj& key) {
+    std::string out;
+    out.reserve(UUID::kNumBytes + key.objsize());
+    auto uuidData = uuid.toCDR();
+    out.append(uuidData.data(), uuidData.length());
+    out.append(key.objdata(), key.objsize());
+    return out;
+}
+
+uint64_t AggregationResultCache::getGeneration(const UUID& uuid) {
+    // Publish that writes must be tracked before reading the generation, so that any write which
+    // commits after this read is guaranteed to bump it.
+    _active.store(true);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _currentGeneration(lk, uuid);
+}
+
+boost::optional<std::vector<BSONObj>> AggregationResultCache::lookup(const UUID& uuid,
+                                                                     const BSONObj& key,
+                                                                     Date_t now) {
+    const Milliseconds maxAge{internalQueryAggregationResultCacheMaxAgeMs.load()};
+    const auto cacheKey = makeKey(uuid, key);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entries.find(cacheKey);
+    if (it == _entries.end()) {
+        aggregationResultCacheMisses.increment();
+        return boost::none;
+    }
+
+    if (it->second.generation != _currentGeneration(lk, uuid) ||
+        now - it->second.created > maxAge) {
+        _erase(lk, it);
+        aggregationResultCacheMisses.increment();
+        return boost::none;
+    }
+
+    aggregationResultCacheHits.increment();
+    return it->second.results;
+}
+
+void AggregationResultCache::insert(const UUID& uuid,
+                                    const BSONObj& key,
+                                    std::vector<BSONObj> results,
+                                    uint64_t generation,
+                                    Date_t now) {
+    const auto budget = internalQueryAggregationResultCacheSizeBytes.load();
+    auto cacheKey = makeKey(uuid, key);
+
+    size_t bytes = kPerEntryOverheadBytes + cacheKey.size();
+    for (auto&& result : results) {
+        bytes += result.objsize();
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (budget <= 0 || bytes > static_cast<size_t>(budget)) {
+        _evictUntilWithinBudget(lk, std::max(budget, 0LL));
+        return;
+    }
+
+    if (generation != _currentGeneration(lk, uuid)) {
+        // The collection was written to while the results were being computed.
+        return;
+    }
+
+    auto existing = _entries.find(cacheKey);
+    if (existing != _entries.end()) {
+        _erase(lk, existing);
+    }
+
+    _entries.add(std::move(cacheKey), Entry{uuid, std::move(results), generation, now, bytes});
+    _bytesUsed += bytes;
+    _collections.emplace(uuid, CollectionState{generation, 0}).first->second.numEntries++;
+    _evictUntilWithinBudget(lk, budget);
+    _pruneIdleCollections(lk);
+}
+
+void AggregationResultCache::invalidate(const UUID& uuid) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto& state = _collections.emplace(uuid, CollectionState{0, 0}).first->second;
+    state.generation = ++_latestGeneration;
+    _pruneIdleCollections(lk);
+}
+
+void AggregationResultCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+    _bytesUsed = 0;
+
+    // Every generation handed out so far is older than the new base generation, so results that
+    // are being computed right now will not be cached.
+    _collections.clear();
+    _baseGeneration = ++_latestGeneration;
+}
+
+size_t AggregationResultCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+size_t AggregationResultCache::bytesUsed() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _bytesUsed;
+}
+
+uint64_t AggregationResultCache::_currentGeneration(WithLock, const UUID& uuid) const {
+    auto it = _collections.find(uuid);
+    return it == _collections.end() ? _baseGeneration : it->second.generation;
+}
+
+void AggregationResultCache::_erase(WithLock, EntryMap::iterator it) {
+    auto state = _collections.find(it->second.uuid);
+    invariant(state != _collections.end() && state->second.numEntries > 0);
+    state->second.numEntries--;
+
+    _bytesUsed -= it->second.bytes;
+    _entries.erase(it);
+}
+
+void AggregationResultCache::_evictUntilWithinBudget(WithLock lk, size_t budget) {
+    while (_bytesUsed > budget && !_entries.empty()) {
+        _erase(lk, std::prev(_entries.end()));
+    }
+}
+
+void AggregationResultCache::_pruneIdleCollections(WithLock) {
+    // Every collection with cached entries accounts for at least one of them.
+    if (_collections.size() <= _entries.size() + kMaxIdleCollections) {
+        return;
+    }
+
+    for (auto it = _collections.begin(); it != _collections.end();) {
+        if (it->second.numEntries == 0) {
+            _collections.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+
+    // The pruned collections fall back to '_baseGeneration', which must differ from any generation
+    // handed out for them so far. In-flight results for collections without cached entries will
+    // not be stored, which is harmless.
+    _baseGeneration = ++_latestGeneration;
+}
+
+}  // namespace mongo
@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * A process-wide, memory-bounded LRU cache of the complete results of read-only aggregations.
+ * Entries are keyed by the UUID of the collection the aggregation read from along with a caller
+ * supplied BSON description of the request.
+ *
+ * Staleness is tracked with a per-collection generation number. Callers must read the generation
+ * with getGeneration() before they begin executing the aggregation and pass it back to insert();
+ * writes to the collection bump the generation through invalidate(), which causes both entries
+ * computed before the write and in-flight results that straddle it to be discarded. Entries are
+ * additionally never served once they are older than 'internalQueryAggregationResultCacheMaxAgeMs'.
+ *
+ * This class is thread-safe.
+ */
+class AggregationResultCache {
+    AggregationResultCache(const AggregationResultCache&) = delete;
+    AggregationResultCache& operator=(const AggregationResultCache&) = delete;
+
+public:
+    AggregationResultCache();
+
+    static AggregationResultCache* get(ServiceContext* serviceContext);
+    static AggregationResultCache* get(OperationContext* opCtx);
+
+    /**
+     * Returns whether the budget knob currently allows results to be cached.
+     */
+    static bool isEnabled();
+
+    /**
+     * Returns true once any caller has read a generation, meaning that writes which commit from
+     * then on must be reported through invalidate(). Until then invalidate() calls can be skipped.
+     */
+    bool isActive() const {
+        return _active.load();
+    }
+
+    /**
+     * Returns the current generation of the collection with the given UUID.
+     */
+    uint64_t getGeneration(const UUID& uuid);
+
+    /**
+     * Returns the cached results for 'key' on the collection 'uuid', or boost::none if there is no
+     * live entry. Updates the hit and miss counters reported by serverStatus.
+     */
+    boost::optional<std::vector<BSONObj>> lookup(const UUID& uuid, const BSONObj& key, Date_t now);
+
+    /**
+     * Caches 'results' for 'key' on the collection 'uuid', provided the collection is still at
+     * 'generation' and the results fit within the configured budget. Least recently used entries
+     * are evicted to make room.
+     */
+    void insert(const UUID& uuid,
+                const BSONObj& key,
+                std::vector<BSONObj> results,
+                uint64_t generation,
+                Date_t now);
+
+    /**
+     * Marks every cached result for the collection 'uuid' as stale. Stale entries are dropped
+     * when they are next looked up or when they are evicted to make room.
+     */
+    void invalidate(const UUID& uuid);
+
+    /**
+     * Discards every cached result, e.g. after a rollback or a database drop.
+     */
+    void clear();
+
+    size_t size() const;
+
+    size_t bytesUsed() const;
+
+private:
+    struct Entry {
+        UUID uuid;
+        std::vector<BSONObj> results;
+        uint64_t generation;
+        Date_t created;
+        size_t bytes;
+    };
+
+    struct CollectionState {
+        uint64_t generation;
+        size_t numEntries;
+    };
+
+    using EntryMap = LRUCache<std::string, Entry>;
+
+    static std::string makeKey(const UUID& uuid, const BSONObj& key);
+
+    uint64_t _currentGeneration(WithLock, const UUID& uuid) const;
+
+    void _erase(WithLock, EntryMap::iterator it);
+
+    void _evictUntilWithinBudget(WithLock, size_t budget);
+
+    /**
+     * Stops tracking the generations of collections without cached entries once there are more
+     * than a fixed number of them.
+     */
+    void _pruneIdleCollections(WithLock);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("AggregationResultCache::_mutex");
+
+    // Entry counts are unbounded; the cache is sized by '_bytesUsed' instead.
+    EntryMap _entries;
+    size_t _bytesUsed = 0;
+
+    // Generations are drawn from a single counter so that they are never reused, even across
+    // clear(). Collections without an entry in '_collections' are at '_baseGeneration'. Every
+    // collection with cached entries is in '_collections'; once the collections without any have
+    // accumulated, they are removed and '_baseGeneration' is advanced past their generations.
+    stdx::unordered_map<UUID, CollectionState, UUID::Hash> _collections;
+    uint64_t _baseGeneration = 0;
+    uint64_t _latestGeneration = 0;
+
+    AtomicWord<bool> _active{false};
+};
+
+}  // namespace mongo
@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/aggregation_result_cache_op_observer.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/aggregation_result_cache.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Invalidates the cached results for 'uuid' once the current write commits. Invalidating at commit
+ * time, rather than now, ensures that an aggregation cannot read the collection before the write is
+ * visible and then cache its result after the invalidation has already happened.
+ *
+ * The commit handler is registered even while the cache is inactive. A write which is in progress
+ * when the cache is first used can commit after an aggregation has read the old data, and must
+ * still invalidate the result that aggregation caches.
+ */
+void invalidateOnCommit(OperationContext* opCtx, OptionalCollectionUUID uuid) {
+    if (!uuid) {
+        return;
+    }
+
+    auto cache = AggregationResultCache::get(opCtx);
+    opCtx->recoveryUnit()->onCommit([cache, uuid = *uuid](boost::optional<Timestamp>) {
+        if (cache->isActive()) {
+            cache->invalidate(uuid);
+        }
+    });
+}
+
+}  // namespace
+
+AggregationResultCacheOpObserver::AggregationResultCacheOpObserver() = default;
+
+AggregationResultCacheOpObserver::~AggregationResultCacheOpObserver() = default;
+
+void AggregationResultCacheOpObserver::onInserts(OperationContext* opCtx,
+                                                 const NamespaceString& nss,
+                                                 OptionalCollectionUUID uuid,
+                                                 std::vector<InsertStatement>::const_iterator begin,
+                                                 std::vector<InsertStatement>::const_iterator end,
+                                                 bool fromMigrate) {
+    invalidateOnCommit(opCtx, uuid);
+}
+
+void AggregationResultCacheOpObserver::onUpdate(OperationContext* opCtx,
+                                                const OplogUpdateEntryArgs& args) {
+    invalidateOnCommit(opCtx, args.uuid);
+}
+
+void AggregationResultCacheOpObserver::onDelete(OperationContext* opCtx,
+                                                const NamespaceString& nss,
+                                                OptionalCollectionUUID uuid,
+                                                StmtId stmtId,
+                                                bool fromMigrate,
+                                                const boost::optional<BSONObj>& deletedDoc) {
+    invalidateOnCommit(opCtx, uuid);
+}
+
+void AggregationResultCacheOpObserver::onCollMod(OperationContext* opCtx,
+                                                 const NamespaceString& nss,
+                                                 OptionalCollectionUUID uuid,
+                                                 const BSONObj& collModCmd,
+                                                 const CollectionOptions& oldCollOptions,
+                                                 boost::optional<TTLCollModInfo> ttlInfo) {
+    invalidateOnCommit(opCtx, uuid);
+}
+
+repl::OpTime AggregationResultCacheOpObserver::onDropCollection(
+    OperationContext* opCtx,
+    const NamespaceString& collectionName,
+    OptionalCollectionUUID uuid,
+    std::uint64_t numRecords,
+    CollectionDropType dropType) {
+    invalidateOnCommit(opCtx, uuid);
+    return {};
+}
+
+void AggregationResultCacheOpObserver::onDropIndex(OperationContext* opCtx,
+                                                   const NamespaceString& nss,
+                                                   OptionalCollectionUUID uuid,
+                                                   const std::string& indexName,
+                                                   const BSONObj& indexInfo) {
+    // A cached result may have been computed for a request which hints the dropped index.
+    invalidateOnCommit(opCtx, uuid);
+}
+
+void AggregationResultCacheOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                          const NamespaceString& fromCollection,
+                                                          const NamespaceString& toCollection,
+                                                          OptionalCollectionUUID uuid,
+                                                          OptionalCollectionUUID dropTargetUUID,
+                                                          std::uint64_t numRecords,
+                                                          bool stayTemp) {
+    postRenameCollection(opCtx, fromCollection, toCollection, uuid, dropTargetUUID, stayTemp);
+}
+
+void AggregationResultCacheOpObserver::postRenameCollection(
+    OperationContext* opCtx,
+    const NamespaceString& fromCollection,
+    const NamespaceString& toCollection,
+    OptionalCollectionUUID uuid,
+    OptionalCollectionUUID dropTargetUUID,
+    bool stayTemp) {
+    invalidateOnCommit(opCtx, uuid);
+    invalidateOnCommit(opCtx, dropTargetUUID);
+}
+
+void AggregationResultCacheOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                                     const NamespaceString& collectionName,
+                                                     OptionalCollectionUUID uuid) {
+    invalidateOnCommit(opCtx, uuid);
+}
+
+void AggregationResultCacheOpObserver::onReplicationRollback(OperationContext* opCtx,
+                                                             const RollbackObserverInfo& rbInfo) {
+    // Rollback rewinds data without going through the write paths observed above.
+    AggregationResultCache::get(opCtx)->clear();
+}
+
+}  // namespace mongo
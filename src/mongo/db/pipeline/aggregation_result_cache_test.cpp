@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/aggregation_result_cache.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+class AggregationResultCacheTest : public unittest::Test {
+public:
+    AggregationResultCacheTest() {
+        internalQueryAggregationResultCacheSizeBytes.store(1024 * 1024);
+    }
+
+    ~AggregationResultCacheTest() {
+        internalQueryAggregationResultCacheSizeBytes.store(0);
+    }
+
+protected:
+    const UUID _uuid = UUID::gen();
+    const BSONObj _key = BSON("pipeline" << BSON_ARRAY(BSON("$match" << BSON("a" << 1))));
+    const std::vector<BSONObj> _results = {BSON("_id" << 1 << "a" << 1),
+                                           BSON("_id" << 2 << "a" << 1)};
+    const Date_t _now = Date_t::now();
+
+    AggregationResultCache _cache;
+};
+
+TEST_F(AggregationResultCacheTest, LookupReturnsInsertedResults) {
+    ASSERT_FALSE(_cache.lookup(_uuid, _key, _now));
+
+    _cache.insert(_uuid, _key, _results, _cache.getGeneration(_uuid), _now);
+    auto cached = _cache.lookup(_uuid, _key, _now);
+    ASSERT_TRUE(cached);
+    ASSERT_EQ(cached->size(), 2U);
+    ASSERT_BSONOBJ_EQ((*cached)[0], _results[0]);
+    ASSERT_BSONOBJ_EQ((*cached)[1], _results[1]);
+
+    ASSERT_FALSE(_cache.lookup(UUID::gen(), _key, _now));
+    ASSERT_FALSE(_cache.lookup(_uuid, BSON("pipeline" << BSONArray()), _now));
+}
+
+TEST_F(AggregationResultCacheTest, InvalidateMakesEntriesStale) {
+    _cache.insert(_uuid, _key, _results, _cache.getGeneration(_uuid), _now);
+    _cache.invalidate(_uuid);
+    ASSERT_FALSE(_cache.lookup(_uuid, _key, _now));
+    ASSERT_EQ(_cache.size(), 0U);
+    ASSERT_EQ(_cache.bytesUsed(), 0U);
+}
+
+TEST_F(AggregationResultCacheTest, ResultsComputedAcrossAWriteAreNotCached) {
+    auto generation = _cache.getGeneration(_uuid);
+    _cache.invalidate(_uuid);
+    _cache.insert(_uuid, _key, _results, generation, _now);
+    ASSERT_EQ(_cache.size(), 0U);
+    ASSERT_FALSE(_cache.lookup(_uuid, _key, _now));
+}
+
+TEST_F(AggregationResultCacheTest, ResultsComputedAcrossAClearAreNotCached) {
+    auto generation = _cache.getGeneration(_uuid);
+    _cache.clear();
+    _cache.insert(_uuid, _key, _results, generation, _now);
+    ASSERT_EQ(_cache.size(), 0U);
+}
+
+TEST_F(AggregationResultCacheTest, PruningIdleCollectionsKeepsLiveEntriesAndRejectsStaleResults) {
+    _cache.insert(_uuid, _key, _results, _cache.getGeneration(_uuid), _now);
+
+    const auto otherUuid = UUID::gen();
+    const auto otherGeneration = _cache.getGeneration(otherUuid);
+    _cache.invalidate(otherUuid);
+
+    // Writes to many collections without cached entries eventually prune their generations.
+    for (int i = 0; i < 2000; ++i) {
+        _cache.invalidate(UUID::gen());
+    }
+
+    ASSERT_TRUE(_cache.lookup(_uuid, _key, _now));
+
+    // Results which straddled the write to the pruned collection must still be rejected.
+    _cache.insert(otherUuid, _key, _results, otherGeneration, _now);
+    ASSERT_FALSE(_cache.lookup(otherUuid, _key, _now));
+
+    _cache.insert(otherUuid, _key, _results, _cache.getGeneration(otherUuid), _now);
+    ASSERT_TRUE(_cache.lookup(otherUuid, _key, _now));
+}
+
+TEST_F(AggregationResultCacheTest, EntriesExpireAfterMaxAge) {
+    const auto maxAgeMs = internalQueryAggregationResultCacheMaxAgeMs.load();
+    ON_BLOCK_EXIT([maxAgeMs] { internalQueryAggregationResultCacheMaxAgeMs.store(maxAgeMs); });
+    internalQueryAggregationResultCacheMaxAgeMs.store(1000);
+
+    _cache.insert(_uuid, _key, _results, _cache.getGeneration(_uuid), _now);
+    ASSERT_TRUE(_cache.lookup(_uuid, _key, _now + Milliseconds(1000)));
+    ASSERT_FALSE(_cache.lookup(_uuid, _key, _now + Milliseconds(1001)));
+}
+
+TEST_F(AggregationResultCacheTest, EvictsLeastRecentlyUsedEntriesToStayWithinBudget) {
+    const auto generation = _cache.getGeneration(_uuid);
+    const BSONObj otherKey = BSON("pipeline" << BSONArray());
+    _cache.insert(_uuid, _key, _results, generation, _now);
+    const auto entryBytes = _cache.bytesUsed();
+    _cache.insert(_uuid, otherKey, _results, generation, _now);
+    ASSERT_EQ(_cache.size(), 2U);
+
+    // Touch the first entry so that the second becomes the least recently used.
+    ASSERT_TRUE(_cache.lookup(_uuid, _key, _now));
+
+    internalQueryAggregationResultCacheSizeBytes.store(_cache.bytesUsed() + entryBytes / 2);
+    _cache.insert(_uuid, BSON("pipeline" << BSON_ARRAY(BSONObj())), _results, generation, _now);
+    ASSERT_EQ(_cache.size(), 2U);
+    ASSERT_LTE(_cache.bytesUsed(),
+               static_cast<size_t>(internalQueryAggregationResultCacheSizeBytes.load()));
+    ASSERT_TRUE(_cache.lookup(_uuid, _key, _now));
+    ASSERT_FALSE(_cache.lookup(_uuid, otherKey, _now));
+}
+
+TEST_F(AggregationResultCacheTest, ResultsLargerThanTheBudgetAreNotCached) {
+    internalQueryAggregationResultCacheSizeBytes.store(16);
+    _cache.insert(_uuid, _key, _results, _cache.getGeneration(_uuid), _now);
+    ASSERT_EQ(_cache.size(), 0U);
+    ASSERT_EQ(_cache.bytesUsed(), 0U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/logv2/log.h"
 
@@ -400,7 +401,7 @@ size_t Exchange::loadNextBatch() {
     return kInvalidThreadId;
 }
 
-size_t Exchange::getTargetConsumer(const Document& input) {
+size_t Exchange::getTargetConsumer(const Document& input) const {
     // Build the key.
     BSONObjBuilder kb;
     size_t counter = 0;
@@ -438,6 +439,45 @@ size_t Exchange::getTargetConsumer(const Document& input) {
     return cid;
 }
 
+boost::intrusive_ptr<DocumentSourceGroup> Exchange::detachPartitionedGroup() {
+    invariant(_loadingThreadId == kInvalidThreadId);
+
+    auto& sources = _pipeline->getSources();
+    if (_policy != ExchangePolicyEnum::kKeyRange || _keyPaths.size() != 1 || sources.size() < 2) {
+        return nullptr;
+    }
+
+    // Key ranges are compared using the simple collation, so strings the $group considers equal
+    // under a non-simple collation could be routed to different consumers.
+    if (_pipeline->getContext()->getCollator()) {
+        return nullptr;
+    }
+
+    auto group = dynamic_cast<DocumentSourceGroup*>(sources.back().get());
+    if (!group) {
+        return nullptr;
+    }
+
+    // The key names a field of the $group's output, such as "_id" or "_id.x". Documents can only be
+    // routed before grouping if that field is a plain copy of a top-level field of the input.
+    auto renames = group->getModifiedPaths().renames;
+    auto inputPath = renames.find(_keyPaths.front().fullPath());
+    if (inputPath == renames.end()) {
+        return nullptr;
+    }
+
+    // The $group may put documents where the field is missing in the same group as documents where
+    // it is null. The former are always sent to consumer 0, so the latter must be as well.
+    MutableDocument nullKey;
+    nullKey.setNestedField(_keyPaths.front(), Value(BSONNULL));
+    if (getTargetConsumer(nullKey.freeze()) != 0) {
+        return nullptr;
+    }
+
+    _keyPaths = {FieldPath(inputPath->second)};
+    return static_cast<DocumentSourceGroup*>(_pipeline->popBack().get());
+}
+
 void Exchange::dispose(OperationContext* opCtx, size_t consumerId) {
     stdx::lock_guard<Latch> lk(_mutex);
 
@@ -41,6 +41,8 @@
 
 namespace mongo {
 
+class DocumentSourceGroup;
+
 class Exchange : public RefCountable {
     static constexpr size_t kInvalidThreadId{std::numeric_limits<size_t>::max()};
     static constexpr size_t kMaxBufferSize = 100 * 1024 * 1024;  // 100 MB
@@ -95,6 +97,17 @@ public:
 
     void dispose(OperationContext* opCtx, size_t consumerId);
 
+    /**
+     * If the input pipeline ends with a $group, and this exchange partitions the $group's output by
+     * a key range over a single _id field which is a copy of a top-level input field, then every
+     * group is complete within the buffer of a single consumer. In that case the $group is removed
+     * from the input pipeline and returned so that each consumer can run its own copy in parallel,
+     * and the exchange instead partitions the $group's input documents by that input field.
+     * Otherwise the input pipeline is left untouched and nullptr is returned. Must be called before
+     * the first call to getNext().
+     */
+    boost::intrusive_ptr<DocumentSourceGroup> detachPartitionedGroup();
+
     /**
      * Unblocks the loading thread (a producer) if the loading is blocked by a consumer identified
      * by consumerId. Note that there is no such thing as being blocked by multiple consumers. It is
@@ -107,7 +120,7 @@ public:
 private:
     size_t loadNextBatch();
 
-    size_t getTargetConsumer(const Document& input);
+    size_t getTargetConsumer(const Document& input) const;
 
     class ExchangeBuffer {
     public:
@@ -142,7 +155,8 @@ private:
 
     const Ordering _ordering;
 
-    const std::vector<FieldPath> _keyPaths;
+    // Not const, since detachPartitionedGroup() rewrites the key in terms of the $group's input.
+    std::vector<FieldPath> _keyPaths;
 
     // Range boundaries. The boundaries are ordered and must cover the whole domain, e.g.
     // [Min, -200, 0, 200, Max] partitions the domain into 4 ranges (i.e. 1 less than number of
@@ -34,6 +34,7 @@
 #include "mongo/db/hasher.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/executor/network_interface_factory.h"
@@ -635,6 +636,141 @@ TEST_F(DocumentSourceExchangeTest, RangeRandomHashExchangeNConsumer) {
     ASSERT_EQ(nDocs, processedDocs.load());
 }
 
+TEST_F(DocumentSourceExchangeTest, DetachesGroupOnRangePartitionedKey) {
+    const size_t nDocs = 50;
+    auto source = getMockSource(nDocs);
+    auto group = DocumentSourceGroup::createFromBson(
+        BSON("$group" << BSON("_id"
+                              << "$a"
+                              << "count" << BSON("$sum" << 1)))
+            .firstElement(),
+        getExpCtx());
+
+    // The exchange key refers to the $group's output, where "_id" holds the value of 'a'.
+    BSONObj spec =
+        BSON("policy"
+             << "keyRange"
+             << "consumers" << 2 << "key" << BSON("_id" << 1) << "boundaries"
+             << BSON_ARRAY(BSON("_id" << MINKEY) << BSON("_id" << 25) << BSON("_id" << MAXKEY))
+             << "consumerIds" << BSON_ARRAY(0 << 1));
+
+    auto opCtx = getOpCtx();
+    boost::intrusive_ptr<Exchange> ex =
+        new Exchange(parseSpec(spec), Pipeline::create({source, group}, getExpCtx()));
+    ASSERT(ex->detachPartitionedGroup() == group);
+
+    // The input pipeline no longer groups, so consumer 0 receives the raw documents of its range.
+    size_t docs = 0;
+    for (auto input = ex->getNext(opCtx, 0, nullptr); input.isAdvanced();
+         input = ex->getNext(opCtx, 0, nullptr)) {
+        auto doc = input.releaseDocument();
+        ASSERT_LT(doc["a"].getInt(), 25);
+        ASSERT_FALSE(doc["b"].missing());
+        ++docs;
+    }
+    ASSERT_EQ(docs, 25u);
+}
+
+TEST_F(DocumentSourceExchangeTest, DetachesGroupOnRenamedCompoundIdField) {
+    const size_t nDocs = 50;
+    auto group = DocumentSourceGroup::createFromBson(
+        BSON("$group" << BSON("_id" << BSON("x"
+                                            << "$a"
+                                            << "y"
+                                            << "$b")
+                                    << "count" << BSON("$sum" << 1)))
+            .firstElement(),
+        getExpCtx());
+
+    BSONObj spec = BSON(
+        "policy"
+        << "keyRange"
+        << "consumers" << 2 << "key" << BSON("_id.x" << 1) << "boundaries"
+        << BSON_ARRAY(BSON("_id.x" << MINKEY) << BSON("_id.x" << 10) << BSON("_id.x" << MAXKEY))
+        << "consumerIds" << BSON_ARRAY(0 << 1));
+
+    auto opCtx = getOpCtx();
+    boost::intrusive_ptr<Exchange> ex = new Exchange(
+        parseSpec(spec), Pipeline::create({getMockSource(nDocs), group}, getExpCtx()));
+    ASSERT(ex->detachPartitionedGroup() == group);
+
+    // The input documents are now routed by 'a', the field that "_id.x" is copied from.
+    size_t docs = 0;
+    for (auto input = ex->getNext(opCtx, 1, nullptr); input.isAdvanced();
+         input = ex->getNext(opCtx, 1, nullptr)) {
+        auto doc = input.releaseDocument();
+        ASSERT_GTE(doc["a"].getInt(), 10);
+        ++docs;
+    }
+    ASSERT_EQ(docs, 40u);
+}
+
+TEST_F(DocumentSourceExchangeTest, DoesNotDetachGroupWhenKeyIsAnInputFieldName) {
+    auto group = DocumentSourceGroup::createFromBson(BSON("$group" << BSON("_id"
+                                                                           << "$a"))
+                                                         .firstElement(),
+                                                     getExpCtx());
+
+    // The $group's output has no field 'a', so every output document goes to consumer 0. Routing
+    // the input by 'a' instead would change which consumer produces each group.
+    BSONObj spec = BSON("policy"
+                        << "keyRange"
+                        << "consumers" << 2 << "key" << BSON("a" << 1) << "boundaries"
+                        << BSON_ARRAY(BSON("a" << MINKEY) << BSON("a" << 25) << BSON("a" << MAXKEY))
+                        << "consumerIds" << BSON_ARRAY(0 << 1));
+    Exchange ex(parseSpec(spec), Pipeline::create({getMockSource(1), group}, getExpCtx()));
+    ASSERT(ex.detachPartitionedGroup() == nullptr);
+}
+
+TEST_F(DocumentSourceExchangeTest, DoesNotDetachGroupOnComputedKey) {
+    auto group = DocumentSourceGroup::createFromBson(
+        BSON("$group" << BSON("_id" << BSON("$toUpper"
+                                            << "$b")))
+            .firstElement(),
+        getExpCtx());
+
+    // "_id" is computed rather than copied from an input field, so there is no input field by
+    // which the documents of each group could be routed together.
+    BSONObj spec = BSON("policy"
+                        << "keyRange"
+                        << "consumers" << 1 << "key" << BSON("_id" << 1) << "boundaries"
+                        << BSON_ARRAY(BSON("_id" << MINKEY) << BSON("_id" << MAXKEY))
+                        << "consumerIds" << BSON_ARRAY(0));
+    Exchange ex(parseSpec(spec), Pipeline::create({getMockSource(1), group}, getExpCtx()));
+    ASSERT(ex.detachPartitionedGroup() == nullptr);
+}
+
+TEST_F(DocumentSourceExchangeTest, DoesNotDetachGroupForRoundRobinExchange) {
+    auto group = DocumentSourceGroup::createFromBson(BSON("$group" << BSON("_id"
+                                                                           << "$a"))
+                                                         .firstElement(),
+                                                     getExpCtx());
+
+    ExchangeSpec spec;
+    spec.setPolicy(ExchangePolicyEnum::kRoundRobin);
+    spec.setConsumers(2);
+    Exchange ex(spec, Pipeline::create({getMockSource(1), group}, getExpCtx()));
+    ASSERT(ex.detachPartitionedGroup() == nullptr);
+}
+
+TEST_F(DocumentSourceExchangeTest, DoesNotDetachGroupWhenNullIsNotRoutedToFirstConsumer) {
+    auto group = DocumentSourceGroup::createFromBson(BSON("$group" << BSON("_id"
+                                                                           << "$a"))
+                                                         .firstElement(),
+                                                     getExpCtx());
+
+    // Documents missing 'a' go to consumer 0, but those with a null 'a' would go to consumer 1,
+    // which would split the null group across consumers.
+    BSONObj spec =
+        BSON("policy"
+             << "keyRange"
+             << "consumers" << 2 << "key" << BSON("_id" << 1) << "boundaries"
+             << BSON_ARRAY(BSON("_id" << MINKEY) << BSON("_id" << 0) << BSON("_id" << MAXKEY))
+             << "consumerIds" << BSON_ARRAY(1 << 0));
+    Exchange ex(parseSpec(spec), Pipeline::create({getMockSource(1), group}, getExpCtx()));
+    ASSERT(ex.detachPartitionedGroup() == nullptr);
+}
+
 TEST_F(DocumentSourceExchangeTest, RejectNoConsumers) {
     BSONObj spec = BSON("policy"
                         << "broadcast"
@@ -39,8 +39,10 @@
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_bytecode.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/destructor_guard.h"
 
 namespace mongo {
@@ -132,6 +134,10 @@ const char* DocumentSourceGroup::getSourceName() const {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
+    if (_streaming) {
+        return getNextStreaming();
+    }
+
     if (!_initialized) {
         const auto initializationResult = initialize();
         if (initializationResult.isPaused()) {
@@ -144,11 +150,16 @@ DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
         accum->reset();  // Prep accumulators for a new group.
     }
 
-    if (_spilled) {
-        return getNextSpilled();
-    } else {
-        return getNextStandard();
+    auto next = _spilled ? getNextSpilled() : getNextStandard();
+    if (!_sortedOutput || !next.isAdvanced()) {
+        return next;
     }
+
+    // Groups come out in order of their key, which the merger uses to combine the partial groups
+    // of every shard in a single sorted pass.
+    MutableDocument out(next.releaseDocument());
+    out.metadata().setSortKey(out.peek()["_id"], true /* isSingleElementKey */);
+    return out.freeze();
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
@@ -201,6 +212,14 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     if (_groups->empty())
         return GetNextResult::makeEOF();
 
+    if (_sortedOutput) {
+        const auto* group = _sortedGroups[_sortedGroupsPos];
+        Document out = makeDocument(group->first, group->second, pExpCtx->needsMerge);
+        if (++_sortedGroupsPos == _sortedGroups.size())
+            dispose();
+        return std::move(out);
+    }
+
     Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
 
     if (++groupsIterator == _groups->end())
@@ -209,13 +228,110 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     return std::move(out);
 }
 
+DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
+    GetNextResult input = pSource->getNext();
+    for (; input.isAdvanced(); input = pSource->getNext()) {
+        auto rootDocument = input.releaseDocument();
+        Value id = computeId(rootDocument);
+
+        // A sort places a document by a single element of an array rather than by the array as a
+        // whole, which is what it is grouped by. Documents with the same array may therefore be
+        // interleaved with others, so the remaining input has to be grouped in the hash table.
+        // Likewise, a sort treats a missing component of a compound _id as null, whereas the
+        // $group keeps {x: missing} and {x: null} apart, so those groups may be interleaved too.
+        const bool idIsNotContiguous = _idExpressions.size() == 1
+            ? id.isArray()
+            : std::any_of(id.getArray().begin(), id.getArray().end(), [](const Value& part) {
+                  return part.isArray() || part.nullish();
+              });
+        if (idIsNotContiguous) {
+            return stopStreaming(std::move(rootDocument));
+        }
+
+        boost::optional<Document> out;
+        if (!_streamingGroupStarted) {
+            startStreamingGroup(std::move(id));
+        } else if (!pExpCtx->getValueComparator().evaluate(_currentId == id)) {
+            out = makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+            startStreamingGroup(std::move(id));
+        }
+
+        for (size_t i = 0; i < _accumulatedFields.size(); i++) {
+            _memoryUsageBytes -= _currentAccumulators[i]->memUsageForSorter();
+            _currentAccumulators[i]->process(
+                _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
+                _doingMerge);
+            _memoryUsageBytes += _currentAccumulators[i]->memUsageForSorter();
+        }
+
+        if (out) {
+            return std::move(*out);
+        }
+
+        if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+            // Let the hash table spill the oversized group, or fail if spilling is not allowed.
+            return stopStreaming(boost::none);
+        }
+    }
+
+    if (input.isPaused()) {
+        return input;
+    }
+
+    invariant(input.isEOF());
+    _streaming = false;
+    _initialized = true;
+    if (!_streamingGroupStarted) {
+        return input;
+    }
+
+    _streamingGroupStarted = false;
+    Document out = makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+    dispose();
+    return std::move(out);
+}
+
+void DocumentSourceGroup::startStreamingGroup(Value id) {
+    _currentId = std::move(id);
+    _streamingGroupStarted = true;
+    _memoryUsageBytes = _currentId.getApproximateSize();
+
+    Value expandedId = expandId(_currentId);
+    Document idDoc =
+        expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+    _currentAccumulators.clear();
+    _currentAccumulators.reserve(_accumulatedFields.size());
+    for (auto&& accumulatedField : _accumulatedFields) {
+        auto accum = accumulatedField.makeAccumulator();
+        accum->startNewGroup(
+            accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables));
+        _memoryUsageBytes += accum->memUsageForSorter();
+        _currentAccumulators.push_back(std::move(accum));
+    }
+}
+
+DocumentSource::GetNextResult DocumentSourceGroup::stopStreaming(
+    boost::optional<Document> pendingInput) {
+    _streaming = false;
+    if (_streamingGroupStarted) {
+        // '_memoryUsageBytes' already accounts for exactly this group.
+        _streamingGroupStarted = false;
+        (*_groups)[_currentId] = std::move(_currentAccumulators);
+        _currentAccumulators.clear();
+    }
+    _pendingInput = std::move(pendingInput);
+    return doGetNext();
+}
+
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
-    _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    _groups = pExpCtx->getValueComparator().makeFlatUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
 
     // Make us look done.
     groupsIterator = _groups->end();
+    _sortedGroups.clear();
+    _sortedGroupsPos = 0;
 }
 
 intrusive_ptr<DocumentSource> DocumentSourceGroup::optimize() {
@@ -223,12 +339,13 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::optimize() {
     // will be only one group. We should take advantage of that to avoid going through the hash
     // table.
     for (size_t i = 0; i < _idExpressions.size(); i++) {
-        _idExpressions[i] = _idExpressions[i]->optimize();
+        _idExpressions[i] = ExpressionBytecode::compileIfEligible(_idExpressions[i]->optimize());
     }
 
     for (auto&& accumulatedField : _accumulatedFields) {
         accumulatedField.expr.initializer = accumulatedField.expr.initializer->optimize();
-        accumulatedField.expr.argument = accumulatedField.expr.argument->optimize();
+        accumulatedField.expr.argument =
+            ExpressionBytecode::compileIfEligible(accumulatedField.expr.argument->optimize());
     }
 
     return this;
@@ -266,6 +383,10 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
         insides["$doingMerge"] = Value(true);
     }
 
+    if (_sortedOutput) {
+        insides["$sortedOutput"] = Value(true);
+    }
+
     return Value(DOC(getSourceName() << insides.freeze()));
 }
 
@@ -345,7 +466,7 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _maxMemoryUsageBytes(maxMemoryUsageBytes ? *maxMemoryUsageBytes
                                                : internalDocumentSourceGroupMaxMemoryBytes.load()),
       _initialized(false),
-      _groups(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
+      _groups(pExpCtx->getValueComparator().makeFlatUnorderedValueMap<Accumulators>()),
       _spilled(false),
       _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
     if (!pExpCtx->inMongos && (pExpCtx->allowDiskUse || kDebugBuild)) {
@@ -434,6 +555,10 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
             massert(17030, "$doingMerge should be true if present", groupField.Bool());
 
             pGroup->setDoingMerge(true);
+        } else if (pFieldName == "$sortedOutput") {
+            uassert(5100020, "$sortedOutput should be true if present", groupField.trueValue());
+
+            pGroup->setSortedOutput(true);
         } else {
             // Any other field will be treated as an accumulator specification.
             pGroup->addAccumulator(
@@ -479,16 +604,25 @@ private:
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     const size_t numAccumulators = _accumulatedFields.size();
 
-    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
-    GetNextResult input = pSource->getNext();
+    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'. It starts with
+    // the document that was pending when streaming was abandoned, if any.
+    GetNextResult input = _pendingInput ? GetNextResult(std::move(*_pendingInput))
+                                        : pSource->getNext();
+    _pendingInput = boost::none;
     for (; input.isAdvanced(); input = pSource->getNext()) {
-        if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+        if (_memoryUsageBytes + groupsTableBytes() > _maxMemoryUsageBytes) {
             uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
                     "Exceeded memory limit for $group, but didn't allow external sort."
                     " Pass allowDiskUse:true to opt in.",
                     _allowDiskUse);
+            const size_t numGroupsSpilled = _groups->size();
             _sortedFiles.push_back(spill());
             _memoryUsageBytes = 0;
+
+            // The next run is likely to hold about as many groups as the one just spilled, so size
+            // the table for them up front rather than growing it one rehash at a time. The groups
+            // fit alongside their table before, so the table alone is within the memory limit.
+            _groups->reserve(numGroupsSpilled);
         }
 
         // We release the result document here so that it does not outlive the end of this loop
@@ -564,7 +698,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                 }
 
                 // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+                _groups = pExpCtx->getValueComparator().makeFlatUnorderedValueMap<Accumulators>();
 
                 _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
                     _sortedFiles,
@@ -584,6 +718,16 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             } else {
                 // start the group iterator
                 groupsIterator = _groups->begin();
+
+                if (_sortedOutput) {
+                    _sortedGroups.reserve(_groups->size());
+                    for (auto it = _groups->begin(); it != _groups->end(); ++it) {
+                        _sortedGroups.push_back(&*it);
+                    }
+                    std::sort(_sortedGroups.begin(),
+                              _sortedGroups.end(),
+                              SpillSTLComparator(pExpCtx->getValueComparator()));
+                }
             }
 
             // This must happen last so that, unless control gets here, we will re-enter
@@ -595,6 +739,11 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     MONGO_UNREACHABLE;
 }
 
+size_t DocumentSourceGroup::groupsTableBytes() const {
+    // Each slot holds an entry inline along with one byte of control metadata.
+    return _groups->capacity() * (sizeof(GroupsMap::value_type) + 1);
+}
+
 bool DocumentSourceGroup::usedDisk() {
     return _usedDisk;
 }
@@ -720,6 +869,16 @@ boost::optional<DocumentSource::DistributedPlanLogic> DocumentSourceGroup::distr
         mergingGroup->addAccumulator(copiedAccumulatedField);
     }
 
+    // Without a collation the shards can return their partial groups ordered by group key, which
+    // lets the merger combine them as a sorted stream rather than hashing every group again.
+    if (internalQueryShardsSortPartialGroups.load() && !pExpCtx->getCollator() && !_streaming) {
+        setSortedOutput(true);
+        mergingGroup->setStreaming(true);
+
+        // {shardsStage, mergingStage, sortPattern}
+        return DistributedPlanLogic{this, mergingGroup, BSON("_id" << 1)};
+    }
+
     // {shardsStage, mergingStage, sortPattern}
     return DistributedPlanLogic{this, mergingGroup, boost::none};
 }
@@ -760,30 +919,62 @@ bool DocumentSourceGroup::canRunInParallelBeforeWriteStage(
     return true;
 }
 
-std::unique_ptr<GroupFromFirstDocumentTransformation>
-DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
+bool DocumentSourceGroup::groupsAreContiguousUnder(const SortPattern& sortPattern) const {
+    std::set<std::string> groupPaths;
+    for (auto&& idExpression : _idExpressions) {
+        auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(idExpression.get());
+        if (!fieldPathExpr || !fieldPathExpr->isRootFieldPath() ||
+            fieldPathExpr->getFieldPath().getPathLength() == 1) {
+            return false;
+        }
+        groupPaths.insert(fieldPathExpr->getFieldPath().tail().fullPath());
+    }
+
+    size_t numGroupPathsSorted = 0;
+    for (auto&& part : sortPattern) {
+        if (numGroupPathsSorted == groupPaths.size()) {
+            break;
+        }
+        if (!part.fieldPath || groupPaths.count(part.fieldPath->fullPath()) == 0) {
+            return false;
+        }
+        ++numGroupPathsSorted;
+    }
+    return numGroupPathsSorted == groupPaths.size();
+}
+
+boost::optional<FieldPath> DocumentSourceGroup::getIdFieldPath() const {
     if (!_idFieldNames.empty()) {
-        // This transformation is only intended for $group stages that group on a single field.
-        return nullptr;
+        return boost::none;
     }
 
     invariant(_idExpressions.size() == 1);
     auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(_idExpressions.front().get());
     if (!fieldPathExpr || !fieldPathExpr->isRootFieldPath()) {
-        return nullptr;
+        return boost::none;
     }
 
     const auto fieldPath = fieldPathExpr->getFieldPath();
     if (fieldPath.getPathLength() == 1) {
         // The path is $$CURRENT or $$ROOT. This isn't really a sensible value to group by (since
-        // each document has a unique _id, it will just return the entire collection). We only
-        // apply the rewrite when grouping by a single field, so we cannot apply it in this case,
-        // where we are grouping by the entire document.
+        // each document has a unique _id, it will just return the entire collection), so we do
+        // not treat it as grouping by a single field.
         invariant(fieldPath.getFieldName(0) == "CURRENT" || fieldPath.getFieldName(0) == "ROOT");
+        return boost::none;
+    }
+
+    return fieldPath.tail();
+}
+
+std::unique_ptr<GroupFromFirstDocumentTransformation>
+DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
+    // This transformation is only intended for $group stages that group on a single field.
+    auto idFieldPath = getIdFieldPath();
+    if (!idFieldPath) {
         return nullptr;
     }
 
-    const auto groupId = fieldPath.tail().fullPath();
+    const auto groupId = idFieldPath->fullPath();
 
     // We can't do this transformation if there are any non-$first accumulators.
     for (auto&& accumulator : _accumulatedFields) {
@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/transformer_interface.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
@@ -89,7 +90,7 @@ private:
 class DocumentSourceGroup final : public DocumentSource {
 public:
     using Accumulators = std::vector<boost::intrusive_ptr<AccumulatorState>>;
-    using GroupsMap = ValueUnorderedMap<Accumulators>;
+    using GroupsMap = ValueFlatUnorderedMap<Accumulators>;
 
     static constexpr StringData kStageName = "$group"_sd;
 
@@ -156,6 +157,40 @@ public:
         _doingMerge = doingMerge;
     }
 
+    /**
+     * Returns true if input sorted by 'sortPattern' presents all the documents of each group one
+     * after another. This is the case when every group key is a field path and together they make
+     * up a prefix of 'sortPattern', in any order.
+     */
+    bool groupsAreContiguousUnder(const SortPattern& sortPattern) const;
+
+    /**
+     * Tells this source that all the documents of each group arrive one after another, so that it
+     * can emit a group as soon as the group key changes rather than buffering every group.
+     */
+    void setStreaming(bool streaming) {
+        invariant(!_initialized);
+        _streaming = streaming;
+    }
+
+    bool isStreaming() const {
+        return _streaming;
+    }
+
+    /**
+     * Tells this source to return its groups in ascending order of group key, each carrying its
+     * '_id' as sort key metadata, so that the outputs of several partial groups can be combined
+     * with a sorted merge.
+     */
+    void setSortedOutput(bool sortedOutput) {
+        invariant(!_initialized);
+        _sortedOutput = sortedOutput;
+    }
+
+    bool isSortedOutput() const {
+        return _sortedOutput;
+    }
+
     /**
      * Returns true if this $group stage used disk during execution and false otherwise.
      */
@@ -177,6 +212,12 @@ public:
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewriteGroupAsTransformOnFirstDocument()
         const;
 
+    /**
+     * Returns the path of the field being grouped on if the _id of this $group is a single field
+     * path over the current document, e.g. {_id: "$a.b"}, or boost::none otherwise.
+     */
+    boost::optional<FieldPath> getIdFieldPath() const;
+
 protected:
     GetNextResult doGetNext() final;
     void doDispose() final;
@@ -194,6 +235,19 @@ private:
      */
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
+    GetNextResult getNextStreaming();
+
+    /**
+     * Starts accumulating a new group with key 'id' in '_currentAccumulators' while streaming.
+     */
+    void startStreamingGroup(Value id);
+
+    /**
+     * Abandons streaming because the remaining input may not be contiguous by group key or the
+     * group being streamed has grown too large. The group accumulated so far is moved into
+     * '_groups', and 'pendingInput', if any, is the first document initialize() will process.
+     */
+    GetNextResult stopStreaming(boost::optional<Document> pendingInput);
 
     /**
      * Before returning anything, this source must prepare itself. In a streaming $group,
@@ -232,6 +286,13 @@ private:
      */
     bool pathIncludedInGroupKeys(const std::string& dottedPath) const;
 
+    /**
+     * Returns the number of bytes used by the slots of '_groups', whether or not they are occupied.
+     * This is accounted for separately from the keys and accumulators since it only changes when
+     * the table grows.
+     */
+    size_t groupsTableBytes() const;
+
     std::vector<AccumulationStatement> _accumulatedFields;
 
     bool _usedDisk;  // Keeps track of whether this $group spilled to disk.
@@ -247,6 +308,22 @@ private:
 
     bool _initialized;
 
+    // Set when the input is known to be contiguous by group key. Cleared when the stage falls back
+    // to buffering groups, or once the streamed input is exhausted.
+    bool _streaming = false;
+    bool _streamingGroupStarted = false;
+
+    // Set when the groups must be returned in ascending order of group key. When the groups were
+    // not spilled, '_sortedGroups' then holds them in that order and '_sortedGroupsPos' is the
+    // position of the next one to return.
+    bool _sortedOutput = false;
+    std::vector<const GroupsMap::value_type*> _sortedGroups;
+    size_t _sortedGroupsPos = 0;
+
+    // A document already pulled from 'pSource' while streaming that initialize() must process
+    // before asking for more input.
+    boost::optional<Document> _pendingInput;
+
     Value _currentId;
     Accumulators _currentAccumulators;
 
@@ -49,11 +49,14 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -101,6 +104,175 @@ TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoading) {
     ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", BSONNULL}, {"count", 4}}));
 }
 
+TEST_F(DocumentSourceGroupTest, StreamingGroupEmitsEachGroupWhenKeyChanges) {
+    auto expCtx = getExpCtx();
+    auto group = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$a', count: {$sum: 1}}}").firstElement(), expCtx);
+    static_cast<DocumentSourceGroup*>(group.get())->setStreaming(true);
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 1}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 1}},
+                                           Document{{"a", 2}},
+                                           Document{{"a", 3}}},
+                                          expCtx);
+    group->setSource(mock.get());
+
+    // The pause is propagated without losing the partially accumulated group.
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 1}, {"count", 2}}));
+
+    // The first group is returned before the rest of the input has been read.
+    ASSERT_FALSE(mock->isDisposed);
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 2}, {"count", 1}}));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 3}, {"count", 1}}));
+
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupFallsBackToHashingOnArrayKey) {
+    auto expCtx = getExpCtx();
+    auto group = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$a', count: {$sum: 1}}}").firstElement(), expCtx);
+    static_cast<DocumentSourceGroup*>(group.get())->setStreaming(true);
+
+    // Sorted on 'a', the array [1, 3] sorts alongside the scalar 1, so neither group is contiguous.
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 0}},
+                                           Document{{"a", 1}},
+                                           Document{{"a", vector<Value>{Value(1), Value(3)}}},
+                                           Document{{"a", 1}},
+                                           Document{{"a", vector<Value>{Value(1), Value(3)}}},
+                                           Document{{"a", 2}}},
+                                          expCtx);
+    group->setSource(mock.get());
+
+    vector<Value> expected = {
+        Value(Document{{"_id", 0}, {"count", 1}}),
+        Value(Document{{"_id", 1}, {"count", 2}}),
+        Value(Document{{"_id", vector<Value>{Value(1), Value(3)}}, {"count", 2}}),
+        Value(Document{{"_id", 2}, {"count", 1}})};
+    auto results = expCtx->getValueComparator().makeOrderedValueSet();
+    for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+        results.insert(Value(next.releaseDocument()));
+    }
+    ASSERT_EQ(results.size(), expected.size());
+    for (auto&& value : expected) {
+        ASSERT_EQ(results.count(value), 1u) << value.toString();
+    }
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupFallsBackToHashingOnMissingCompoundIdComponent) {
+    auto expCtx = getExpCtx();
+    auto group = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: {x: '$a', y: '$b'}, count: {$sum: 1}}}").firstElement(), expCtx);
+    static_cast<DocumentSourceGroup*>(group.get())->setStreaming(true);
+
+    // Sorted on 'a' and 'b', a missing 'b' sorts as null, so the {y: missing} and {y: null} groups
+    // are interleaved.
+    auto mock = DocumentSourceMock::createForTest({Document{{"a", 0}, {"b", 0}},
+                                                   Document{{"a", 1}},
+                                                   Document{{"a", 1}, {"b", BSONNULL}},
+                                                   Document{{"a", 1}},
+                                                   Document{{"a", 1}, {"b", BSONNULL}},
+                                                   Document{{"a", 1}, {"b", 1}}},
+                                                  expCtx);
+    group->setSource(mock.get());
+
+    vector<Value> expected = {Value(Document{{"_id", Document{{"x", 0}, {"y", 0}}}, {"count", 1}}),
+                              Value(Document{{"_id", Document{{"x", 1}}}, {"count", 2}}),
+                              Value(Document{{"_id", Document{{"x", 1}, {"y", BSONNULL}}},
+                                             {"count", 2}}),
+                              Value(Document{{"_id", Document{{"x", 1}, {"y", 1}}}, {"count", 1}})};
+    // Round-trip through BSON so that a missing _id component compares as an absent field.
+    auto results = expCtx->getValueComparator().makeOrderedValueSet();
+    for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+        results.insert(Value(next.releaseDocument().toBson()));
+    }
+    ASSERT_EQ(results.size(), expected.size());
+    for (auto&& value : expected) {
+        ASSERT_EQ(results.count(value), 1u) << value.toString();
+    }
+}
+
+TEST_F(DocumentSourceGroupTest, SortedOutputReturnsGroupsInKeyOrderWithSortKeys) {
+    auto expCtx = getExpCtx();
+    auto group = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$a', count: {$sum: 1}, $sortedOutput: true}}").firstElement(),
+        expCtx);
+    ASSERT_TRUE(static_cast<DocumentSourceGroup*>(group.get())->isSortedOutput());
+    auto mock = DocumentSourceMock::createForTest(
+        {Document{{"a", 3}}, Document{{"a", 1}}, Document{{"a", 2}}, Document{{"a", 1}}}, expCtx);
+    group->setSource(mock.get());
+
+    for (auto&& expected : {std::make_pair(1, 2), std::make_pair(2, 1), std::make_pair(3, 1)}) {
+        auto result = group->getNext();
+        ASSERT_TRUE(result.isAdvanced());
+        auto doc = result.releaseDocument();
+        ASSERT_DOCUMENT_EQ(doc, (Document{{"_id", expected.first}, {"count", expected.second}}));
+        ASSERT_TRUE(doc.metadata().hasSortKey());
+        ASSERT_VALUE_EQ(doc.metadata().getSortKey(), Value(expected.first));
+    }
+    ASSERT_TRUE(group->getNext().isEOF());
+
+    // The flag survives serialization so that it reaches the shards.
+    vector<Value> serialized;
+    group->serializeToArray(serialized);
+    ASSERT_VALUE_EQ(serialized[0]["$group"]["$sortedOutput"], Value(true));
+}
+
+TEST_F(DocumentSourceGroupTest, PartialGroupsAreSortedForAStreamingMergeWhenEnabled) {
+    internalQueryShardsSortPartialGroups.store(true);
+    ON_BLOCK_EXIT([] { internalQueryShardsSortPartialGroups.store(false); });
+
+    auto expCtx = getExpCtx();
+    auto group = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$a', count: {$sum: 1}}}").firstElement(), expCtx);
+    auto distributedPlanLogic = group->distributedPlanLogic();
+    ASSERT(distributedPlanLogic);
+    ASSERT_EQ(distributedPlanLogic->shardsStage, group);
+    ASSERT_TRUE(static_cast<DocumentSourceGroup*>(group.get())->isSortedOutput());
+    ASSERT(distributedPlanLogic->inputSortPattern);
+    ASSERT_BSONOBJ_EQ(*distributedPlanLogic->inputSortPattern, BSON("_id" << 1));
+    auto mergingGroup =
+        dynamic_cast<DocumentSourceGroup*>(distributedPlanLogic->mergingStage.get());
+    ASSERT(mergingGroup);
+    ASSERT_TRUE(mergingGroup->doingMerge());
+    ASSERT_TRUE(mergingGroup->isStreaming());
+}
+
+TEST_F(DocumentSourceGroupTest, GroupOnSortKeyStreamsAfterOptimization) {
+    auto expCtx = getExpCtx();
+    auto assertStreaming = [&](const BSONObj& sortSpec, const BSONObj& groupSpec, bool expected) {
+        auto pipeline = Pipeline::parse({sortSpec, groupSpec}, expCtx);
+        pipeline->optimizePipeline();
+        auto group = dynamic_cast<DocumentSourceGroup*>(pipeline->getSources().back().get());
+        ASSERT(group);
+        ASSERT_EQ(group->isStreaming(), expected) << sortSpec << " " << groupSpec;
+    };
+
+    assertStreaming(fromjson("{$sort: {a: 1}}"), fromjson("{$group: {_id: '$a'}}"), true);
+    assertStreaming(fromjson("{$sort: {a: -1, b: 1}}"), fromjson("{$group: {_id: '$a'}}"), true);
+    assertStreaming(
+        fromjson("{$sort: {b: 1, a: -1}}"), fromjson("{$group: {_id: {x: '$a', y: '$b'}}}"), true);
+    assertStreaming(fromjson("{$sort: {b: 1, a: 1}}"), fromjson("{$group: {_id: '$a'}}"), false);
+    assertStreaming(fromjson("{$sort: {a: 1, c: 1, b: 1}}"),
+                    fromjson("{$group: {_id: {x: '$a', y: '$b'}}}"),
+                    false);
+    assertStreaming(
+        fromjson("{$sort: {a: 1}}"), fromjson("{$group: {_id: {$add: ['$a', 1]}}}"), false);
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoadingWhileSpilled) {
     auto expCtx = getExpCtx();
 
@@ -206,6 +378,30 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
         group->getNext(), AssertionException, ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldCountHashTableSlotsTowardsMemoryLimit) {
+    auto expCtx = getExpCtx();
+    const size_t numGroups = 100;
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+
+    // The group keys alone fit within the limit, but not once the slots of the table holding them
+    // are accounted for.
+    const size_t maxMemoryUsageBytes = numGroups * sizeof(Value) + sizeof(Value);
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx, "$_id", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(expCtx, groupByExpression, {}, maxMemoryUsageBytes);
+
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (size_t i = 0; i < numGroups + 1; ++i) {
+        inputs.emplace_back(Document{{"_id", static_cast<int>(i)}});
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+    group->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(
+        group->getNext(), AssertionException, ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldReportSingleFieldGroupKeyAsARename) {
     auto expCtx = getExpCtx();
     VariablesParseState vps = expCtx->variablesParseState;
@@ -244,6 +244,24 @@ void assertIsValidCollectionState(const boost::intrusive_ptr<ExpressionContext>&
     }
 }
 
+/**
+ * Adds the size of 'result' to 'objsize', the total size of the foreign documents joined to a
+ * single input document, and throws if it exceeds the maximum.
+ */
+void addToLookupResultSize(const Document& result,
+                           const NamespaceString& fromNs,
+                           long long* objsize) {
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    long long safeSum = 0;
+    bool hasOverflowed = overflow::add(*objsize, result.getApproximateSize(), &safeSum);
+    uassert(4568,
+            str::stream() << "Total size of documents in " << fromNs.coll()
+                          << " matching pipeline's $lookup stage exceeds " << maxBytes << " bytes",
+
+            !hasOverflowed && *objsize <= maxBytes);
+    *objsize = safeSum;
+}
+
 void lookupPipeValidator(const Pipeline& pipeline) {
     const auto& sources = pipeline.getSources();
     std::for_each(sources.begin(), sources.end(), [](auto& src) {
@@ -272,6 +290,18 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     invariant(!_matchSrc);
 
     if (!wasConstructedWithPipelineSyntax()) {
+        if (!_joinStrategyChosen) {
+            chooseJoinStrategy();
+        }
+
+        if (_hashTable) {
+            if (auto results = lookUpInHashTable(inputDoc)) {
+                MutableDocument output(std::move(inputDoc));
+                output.setNestedField(_as, Value(std::move(*results)));
+                return output.freeze();
+            }
+        }
+
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
         // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
@@ -282,18 +312,9 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
 
     std::vector<Value> results;
     long long objsize = 0;
-    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
 
     while (auto result = pipeline->getNext()) {
-        long long safeSum = 0;
-        bool hasOverflowed = overflow::add(objsize, result->getApproximateSize(), &safeSum);
-        uassert(4568,
-                str::stream() << "Total size of documents in " << _fromNs.coll()
-                              << " matching pipeline's $lookup stage exceeds " << maxBytes
-                              << " bytes",
-
-                !hasOverflowed && objsize <= maxBytes);
-        objsize = safeSum;
+        addToLookupResultSize(*result, _fromNs, &objsize);
         results.emplace_back(std::move(*result));
     }
     _usedDisk = _usedDisk || pipeline->usedDisk();
@@ -303,6 +324,73 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     return output.freeze();
 }
 
+void DocumentSourceLookUp::chooseJoinStrategy() {
+    invariant(!wasConstructedWithPipelineSyntax());
+    _joinStrategyChosen = true;
+
+    const auto maxForeignRecords = internalDocumentSourceLookupHashJoinMaxForeignRecords.load();
+    if (maxForeignRecords == 0 || pExpCtx->inMongos ||
+        !LookupHashTable::canBuildOn(*_foreignField)) {
+        return;
+    }
+
+    assertIsValidCollectionState(_fromExpCtx);
+    if (pExpCtx->mongoProcessInterface->isSharded(pExpCtx->opCtx, _resolvedNs)) {
+        return;
+    }
+
+    BSONObjBuilder countBuilder;
+    if (!pExpCtx->mongoProcessInterface
+             ->appendRecordCount(pExpCtx->opCtx, _resolvedNs, &countBuilder)
+             .isOK()) {
+        return;
+    }
+    const auto count = countBuilder.done()["count"];
+    if (!count.isNumber() || count.safeNumberLong() > maxForeignRecords) {
+        return;
+    }
+
+    // Read the entire foreign collection, through the definition of the view if it is one.
+    _resolvedPipeline.back() = BSON("$match" << BSONObj());
+    auto pipeline = buildPipeline(Document());
+
+    auto hashTable = std::make_unique<LookupHashTable>(
+        pExpCtx->getValueComparator(),
+        *_foreignField,
+        static_cast<size_t>(internalDocumentSourceLookupHashJoinMaxMemoryBytes.load()));
+    while (auto result = pipeline->getNext()) {
+        hashTable->add(std::move(*result));
+        if (hashTable->isAbandoned()) {
+            return;
+        }
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+    _hashTable = std::move(hashTable);
+}
+
+boost::optional<std::vector<Value>> DocumentSourceLookUp::lookUpInHashTable(
+    const Document& inputDoc) const {
+    std::vector<Value> localValues;
+    bool canProbe = true;
+    document_path_support::visitAllValuesAtPath(inputDoc, *_localField, [&](const Value& value) {
+        canProbe = canProbe && LookupHashTable::canProbeWith(value);
+        localValues.push_back(value);
+    });
+
+    // A missing local field is matched as null, which also matches missing foreign fields.
+    if (!canProbe || localValues.empty()) {
+        return boost::none;
+    }
+
+    std::vector<Value> results;
+    long long objsize = 0;
+    for (auto&& match : _hashTable->probe(localValues)) {
+        addToLookupResultSize(match, _fromNs, &objsize);
+        results.emplace_back(std::move(match));
+    }
+    return {std::move(results)};
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     const Document& inputDoc) {
     // Copy all 'let' variables into the foreign pipeline's expression context.
@@ -498,6 +586,7 @@ bool DocumentSourceLookUp::usedDisk() {
 }
 
 void DocumentSourceLookUp::doDispose() {
+    _hashTable.reset();
     if (_pipeline) {
         _usedDisk = _usedDisk || _pipeline->usedDisk();
         _pipeline->dispose(pExpCtx->opCtx);
@@ -725,6 +814,11 @@ void DocumentSourceLookUp::serializeToArray(
             output[getSourceName()]["matching"] = Value(*_additionalFilter);
         }
 
+        if (_joinStrategyChosen) {
+            output[getSourceName()]["strategy"] =
+                Value(_hashTable ? "hashJoin"_sd : "nestedLoopJoin"_sd);
+        }
+
         array.push_back(Value(output.freeze()));
     } else {
         array.push_back(Value(output.freeze()));
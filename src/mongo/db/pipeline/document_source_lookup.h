@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/pipeline/lookup_hash_table.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
 
 namespace mongo {
@@ -242,6 +243,21 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Decides, on the first input document, whether a localField/foreignField $lookup joins by
+     * building a hash table over the whole foreign collection rather than querying the foreign
+     * collection for each input document. The hash table is only built if the foreign collection
+     * has at most 'internalDocumentSourceLookupHashJoinMaxForeignRecords' records, and is dropped
+     * if it grows beyond 'internalDocumentSourceLookupHashJoinMaxMemoryBytes'.
+     */
+    void chooseJoinStrategy();
+
+    /**
+     * Returns the foreign documents matching 'inputDoc' from the hash table, or boost::none if the
+     * values of the local field cannot be looked up in the hash table.
+     */
+    boost::optional<std::vector<Value>> lookUpInHashTable(const Document& inputDoc) const;
+
     /**
      * Copies 'vars' and 'vps' to the Variables and VariablesParseState objects in 'expCtx'. These
      * copies provide access to 'let' defined variables in sub-pipeline execution.
@@ -299,6 +315,11 @@ private:
     // from a cursor source.
     boost::optional<SequentialDocumentCache> _cache;
 
+    // Whether chooseJoinStrategy() has run. If it chose to hash join, '_hashTable' holds the
+    // documents of the foreign collection.
+    bool _joinStrategyChosen = false;
+    std::unique_ptr<LookupHashTable> _hashTable;
+
     // The ExpressionContext used when performing aggregation pipelines against the '_resolvedNs'
     // namespace.
     boost::intrusive_ptr<ExpressionContext> _fromExpCtx;
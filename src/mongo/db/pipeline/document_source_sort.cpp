@@ -37,6 +37,7 @@
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_skip.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
@@ -169,6 +170,16 @@ Pipeline::SourceContainer::iterator DocumentSourceSort::doOptimizeAt(
         _sortExecutor->setLimit(*limit);
     }
 
+    // A $group on the sort key sees each group's documents one after another, so it can emit
+    // every group as soon as the key changes instead of holding all of them until the end.
+    auto nextStage = std::next(itr);
+    if (nextStage != container->end()) {
+        auto group = dynamic_cast<DocumentSourceGroup*>(nextStage->get());
+        if (group && group->groupsAreContiguousUnder(getSortKeyPattern())) {
+            group->setStreaming(true);
+        }
+    }
+
     return std::next(itr);
 }
 
@@ -33,6 +33,7 @@
 #include <iterator>
 
 #include "mongo/db/commands/test_commands_enabled.h"
+#include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
@@ -224,6 +225,20 @@ Pipeline::SourceContainer::iterator DocumentSourceUnionWith::doOptimizeAt(
         else if (auto nextProject = dynamic_cast<DocumentSourceSingleDocumentTransformation*>(
                      (*std::next(itr)).get()))
             return duplicateAcrossUnion(nextProject);
+        else if (auto nextLimit = dynamic_cast<DocumentSourceLimit*>((*std::next(itr)).get())) {
+            // A $limit applies to the documents from both inputs, so it must stay behind the
+            // $unionWith. The sub-pipeline can never contribute more than 'limit' documents though,
+            // so a copy of the $limit can be pushed into it. This lets a sharded foreign collection
+            // apply the limit on each shard rather than after every document has been returned.
+            auto&& subSources = _pipeline->getSources();
+            auto subLimit = subSources.empty()
+                ? nullptr
+                : dynamic_cast<DocumentSourceLimit*>(subSources.back().get());
+            if (!subLimit || subLimit->getLimit() > nextLimit->getLimit()) {
+                _pipeline->addFinalSource(
+                    DocumentSourceLimit::create(_pipeline->getContext(), nextLimit->getLimit()));
+            }
+        }
     }
     return std::next(itr);
 };
@@ -42,6 +42,7 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_add_fields.h"
 #include "mongo/db/pipeline/document_source_facet.h"
+#include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_replace_root.h"
@@ -447,6 +448,34 @@ TEST_F(DocumentSourceUnionWithTest, ConcatenatesViewDefinitionToPipeline) {
     ASSERT_TRUE(unionWith->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceUnionWithTest, LimitIsCopiedIntoSubPipeline) {
+    auto expCtx = getExpCtx();
+    NamespaceString nsToUnionWith(expCtx->ns.db(), "coll");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {nsToUnionWith.coll().toString(), {nsToUnionWith, std::vector<BSONObj>()}}});
+
+    auto unionWith = DocumentSourceUnionWith::createFromBson(
+        BSON("$unionWith" << nsToUnionWith.coll()).firstElement(), expCtx);
+    auto pipeline = Pipeline::create({unionWith, DocumentSourceLimit::create(expCtx, 3)}, expCtx);
+
+    const auto expected = std::vector<BSONObj>{
+        fromjson("{$unionWith: {coll: 'coll', pipeline: [{$limit: 3}]}}"),
+        fromjson("{$limit: 3}")};
+
+    pipeline->optimizePipeline();
+    ASSERT_EQ(pipeline->serializeToBson().size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(pipeline->serializeToBson()[i], expected[i]);
+    }
+
+    // Optimizing again must not push a second copy of the $limit.
+    pipeline->optimizePipeline();
+    ASSERT_EQ(pipeline->serializeToBson().size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(pipeline->serializeToBson()[i], expected[i]);
+    }
+}
+
 TEST_F(DocumentSourceUnionWithTest, RejectUnionWhenDepthLimitIsExceeded) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "coll");
@@ -0,0 +1,200 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_bytecode.h"
+
+#include <absl/container/inlined_vector.h>
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/summation.h"
+
+namespace mongo {
+namespace {
+
+bool isArithmetic(const Expression* expression) {
+    return dynamic_cast<const ExpressionAdd*>(expression) ||
+        dynamic_cast<const ExpressionSubtract*>(expression) ||
+        dynamic_cast<const ExpressionMultiply*>(expression) ||
+        dynamic_cast<const ExpressionDivide*>(expression);
+}
+
+/**
+ * Returns the value of 'expression' if it is a constant which the program can hold in a double
+ * register without changing the result of the arithmetic it feeds into.
+ */
+boost::optional<Value> getCompilableConstant(const Expression* expression) {
+    auto constant = dynamic_cast<const ExpressionConstant*>(expression);
+    if (!constant) {
+        return boost::none;
+    }
+    auto value = constant->getValue();
+    if (value.getType() != NumberDouble && value.getType() != NumberInt) {
+        return boost::none;
+    }
+    return value;
+}
+
+}  // namespace
+
+ExpressionBytecode::ExpressionBytecode(boost::intrusive_ptr<Expression> tree)
+    : Expression(tree->getExpressionContext(), {tree}) {
+    compile(_children[0].get(), 0);
+}
+
+boost::intrusive_ptr<Expression> ExpressionBytecode::compileIfEligible(
+    boost::intrusive_ptr<Expression> expression) {
+    if (!internalQueryCompileArithmeticExpressions.load() || !expression ||
+        !isArithmetic(expression.get()) || !isCompilable(expression.get())) {
+        return expression;
+    }
+    return new ExpressionBytecode(std::move(expression));
+}
+
+bool ExpressionBytecode::isCompilable(const Expression* expression) {
+    auto&& children = expression->getChildren();
+    if (children.empty()) {
+        return false;
+    }
+    if ((dynamic_cast<const ExpressionSubtract*>(expression) ||
+         dynamic_cast<const ExpressionDivide*>(expression)) &&
+        children.size() != 2) {
+        return false;
+    }
+
+    // Each operation must have at least one operand which is known to be a double, since only then
+    // does the original expression produce a double whatever the other, int, operands are.
+    bool hasDoubleOperand = false;
+    for (auto&& child : children) {
+        if (isArithmetic(child.get())) {
+            if (!isCompilable(child.get())) {
+                return false;
+            }
+            hasDoubleOperand = true;
+        } else if (dynamic_cast<const ExpressionFieldPath*>(child.get())) {
+            // Checked to be a double when the program runs.
+            hasDoubleOperand = true;
+        } else if (auto constant = getCompilableConstant(child.get())) {
+            hasDoubleOperand = hasDoubleOperand || constant->getType() == NumberDouble;
+        } else {
+            return false;
+        }
+    }
+    return hasDoubleOperand;
+}
+
+void ExpressionBytecode::compile(const Expression* expression, uint32_t dest) {
+    if (auto constant = getCompilableConstant(expression)) {
+        _program.push_back({OpCode::kLoadConstant, dest, uint32_t(_constants.size()), 1});
+        _constants.push_back(constant->coerceToDouble());
+        return;
+    }
+    if (dynamic_cast<const ExpressionFieldPath*>(expression)) {
+        _program.push_back({OpCode::kLoadField, dest, uint32_t(_fields.size()), 1});
+        _fields.push_back(expression);
+        return;
+    }
+
+    // Evaluate the operands into consecutive registers, then combine them into 'dest'.
+    auto&& children = expression->getChildren();
+    const uint32_t first = _numRegisters;
+    _numRegisters += children.size();
+    for (size_t i = 0; i < children.size(); ++i) {
+        compile(children[i].get(), first + i);
+    }
+
+    OpCode op;
+    if (dynamic_cast<const ExpressionAdd*>(expression)) {
+        op = OpCode::kAdd;
+    } else if (dynamic_cast<const ExpressionSubtract*>(expression)) {
+        op = OpCode::kSubtract;
+    } else if (dynamic_cast<const ExpressionMultiply*>(expression)) {
+        op = OpCode::kMultiply;
+    } else {
+        invariant(dynamic_cast<const ExpressionDivide*>(expression));
+        op = OpCode::kDivide;
+    }
+    _program.push_back({op, dest, first, uint32_t(children.size())});
+}
+
+Value ExpressionBytecode::evaluate(const Document& root, Variables* variables) const {
+    absl::InlinedVector<double, 16> registers(_numRegisters);
+
+    for (auto&& instruction : _program) {
+        const double* operands = registers.data() + instruction.operand;
+        double& result = registers[instruction.dest];
+
+        switch (instruction.op) {
+            case OpCode::kLoadConstant:
+                result = _constants[instruction.operand];
+                break;
+            case OpCode::kLoadField: {
+                Value field = _fields[instruction.operand]->evaluate(root, variables);
+                if (field.getType() != NumberDouble) {
+                    return _children[0]->evaluate(root, variables);
+                }
+                result = field.getDouble();
+                break;
+            }
+            case OpCode::kAdd: {
+                // Sum the same way as ExpressionAdd, so that rounding is identical.
+                DoubleDoubleSummation sum;
+                for (uint32_t i = 0; i < instruction.count; ++i) {
+                    sum.addDouble(operands[i]);
+                }
+                result = sum.getDouble();
+                break;
+            }
+            case OpCode::kSubtract:
+                result = operands[0] - operands[1];
+                break;
+            case OpCode::kMultiply: {
+                double product = 1;
+                for (uint32_t i = 0; i < instruction.count; ++i) {
+                    product *= operands[i];
+                }
+                result = product;
+                break;
+            }
+            case OpCode::kDivide:
+                if (operands[1] == 0.0) {
+                    // Let the original expression report the error.
+                    return _children[0]->evaluate(root, variables);
+                }
+                result = operands[0] / operands[1];
+                break;
+        }
+    }
+
+    return Value(registers[0]);
+}
+
+}  // namespace mongo
@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/pipeline/expression.h"
+
+namespace mongo {
+
+/**
+ * An Expression which evaluates an arithmetic expression tree by running a flat, register based
+ * program compiled from it, rather than by a virtual evaluate() call per node with a Value for each
+ * intermediate result.
+ *
+ * Only trees made of $add, $subtract, $multiply and $divide over field paths and numeric constants
+ * are compiled, and the program only handles the case where every field path evaluates to a
+ * double, in which case every intermediate result is a double too. Whenever an input falls outside
+ * of that case, for instance because a field is missing, has another numeric type or a division by
+ * zero would occur, the original tree is evaluated instead, so that results and errors are always
+ * exactly those of the tree.
+ *
+ * The original tree is kept as the only child, and is used for serialization, dependency analysis
+ * and visitors.
+ */
+class ExpressionBytecode final : public Expression {
+public:
+    /**
+     * Returns an ExpressionBytecode for 'expression' if compilation is enabled and 'expression' can
+     * be compiled, or 'expression' itself otherwise. Should be called on already optimized
+     * expressions, so that constant subtrees have been folded.
+     */
+    static boost::intrusive_ptr<Expression> compileIfEligible(
+        boost::intrusive_ptr<Expression> expression);
+
+    Value evaluate(const Document& root, Variables* variables) const final;
+
+    Value serialize(bool explain) const final {
+        return _children[0]->serialize(explain);
+    }
+
+    ComputedPaths getComputedPaths(const std::string& exprFieldPath,
+                                   Variables::Id renamingVar) const final {
+        return _children[0]->getComputedPaths(exprFieldPath, renamingVar);
+    }
+
+    void acceptVisitor(ExpressionVisitor* visitor) final {
+        _children[0]->acceptVisitor(visitor);
+    }
+
+    size_t getNumInstructions() const {
+        return _program.size();
+    }
+
+protected:
+    void _doAddDependencies(DepsTracker* deps) const final {
+        _children[0]->addDependencies(deps);
+    }
+
+private:
+    enum class OpCode : uint8_t {
+        kLoadConstant,
+        kLoadField,
+        kAdd,
+        kSubtract,
+        kMultiply,
+        kDivide,
+    };
+
+    /**
+     * Writes the result of the operation to register 'dest'. Loads read slot 'operand' of the
+     * constant or field table; arithmetic reads the 'count' consecutive registers which start at
+     * register 'operand'.
+     */
+    struct Instruction {
+        OpCode op;
+        uint32_t dest;
+        uint32_t operand;
+        uint32_t count;
+    };
+
+    explicit ExpressionBytecode(boost::intrusive_ptr<Expression> tree);
+
+    static bool isCompilable(const Expression* expression);
+
+    void compile(const Expression* expression, uint32_t dest);
+
+    std::vector<Instruction> _program;
+    std::vector<double> _constants;
+    std::vector<const Expression*> _fields;
+    uint32_t _numRegisters = 1;
+};
+
+}  // namespace mongo
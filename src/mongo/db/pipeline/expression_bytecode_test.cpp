@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/expression_bytecode.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class ExpressionBytecodeTest : public unittest::Test {
+public:
+    ExpressionBytecodeTest() {
+        internalQueryCompileArithmeticExpressions.store(true);
+    }
+
+    ~ExpressionBytecodeTest() {
+        internalQueryCompileArithmeticExpressions.store(false);
+    }
+
+protected:
+    boost::intrusive_ptr<Expression> parse(const std::string& json) {
+        auto obj = fromjson("{expr: " + json + "}");
+        return Expression::parseOperand(_expCtx, obj.firstElement(), _expCtx->variablesParseState)
+            ->optimize();
+    }
+
+    /**
+     * Asserts that 'json' compiles, and that the compiled expression evaluates to exactly the same
+     * value, including its numeric type, as the original tree on each of 'inputs'.
+     */
+    void assertCompiledMatchesTree(const std::string& json, const std::vector<Document>& inputs) {
+        auto tree = parse(json);
+        auto compiled = ExpressionBytecode::compileIfEligible(tree);
+        ASSERT_TRUE(dynamic_cast<ExpressionBytecode*>(compiled.get())) << json;
+        for (auto&& input : inputs) {
+            auto expected = tree->evaluate(input, &_expCtx->variables);
+            auto actual = compiled->evaluate(input, &_expCtx->variables);
+            ASSERT_VALUE_EQ(actual, expected);
+            ASSERT_EQ(actual.getType(), expected.getType()) << json << " on " << input.toString();
+        }
+    }
+
+    boost::intrusive_ptr<ExpressionContextForTest> _expCtx = new ExpressionContextForTest();
+};
+
+TEST_F(ExpressionBytecodeTest, DoubleArithmeticMatchesTree) {
+    const std::vector<Document> inputs = {Document{{"a", 1.5}, {"b", 2.25}, {"c", -4.0}},
+                                          Document{{"a", 1e16}, {"b", 1.0}, {"c", -1e16}},
+                                          Document{{"a", -0.0}, {"b", 0.1}, {"c", 0.2}}};
+    assertCompiledMatchesTree("{$add: ['$a', '$b', '$c']}", inputs);
+    assertCompiledMatchesTree("{$subtract: ['$a', '$b']}", inputs);
+    assertCompiledMatchesTree("{$multiply: ['$a', '$b', '$c']}", inputs);
+    assertCompiledMatchesTree("{$divide: ['$a', '$c']}", inputs);
+    assertCompiledMatchesTree(
+        "{$add: [{$multiply: ['$a', 1.1]}, {$divide: [{$subtract: ['$b', 3]}, '$c']}]}", inputs);
+    assertCompiledMatchesTree("{$multiply: [2, '$a', {$add: [1, '$b']}]}", inputs);
+}
+
+TEST_F(ExpressionBytecodeTest, NonDoubleInputsFallBackToTree) {
+    const std::vector<Document> inputs = {
+        Document{{"a", 1}, {"b", 2}},
+        Document{{"a", 1LL}, {"b", 2.5}},
+        Document{{"a", Decimal128("1.5")}, {"b", 2.0}},
+        Document{{"a", BSONNULL}, {"b", 2.0}},
+        Document{{"b", 2.0}},
+        Document{{"a", Date_t::fromMillisSinceEpoch(1000)}, {"b", 2.0}}};
+    assertCompiledMatchesTree("{$add: ['$a', '$b']}", inputs);
+    assertCompiledMatchesTree("{$multiply: [{$add: ['$b', 1]}, '$b']}", inputs);
+}
+
+TEST_F(ExpressionBytecodeTest, ErrorsAreReportedByTree) {
+    auto compiled = ExpressionBytecode::compileIfEligible(parse("{$divide: ['$a', '$b']}"));
+    ASSERT_TRUE(dynamic_cast<ExpressionBytecode*>(compiled.get()));
+    ASSERT_THROWS_CODE(compiled->evaluate(Document{{"a", 1.0}, {"b", 0.0}}, &_expCtx->variables),
+                       AssertionException,
+                       16608);
+    ASSERT_THROWS_CODE(compiled->evaluate(Document{{"a", 1.0}, {"b", "x"_sd}}, &_expCtx->variables),
+                       AssertionException,
+                       16609);
+}
+
+TEST_F(ExpressionBytecodeTest, OnlyArithmeticWithADoubleOperandIsCompiled) {
+    auto isCompiled = [&](const std::string& json) {
+        auto compiled = ExpressionBytecode::compileIfEligible(parse(json));
+        return static_cast<bool>(dynamic_cast<ExpressionBytecode*>(compiled.get()));
+    };
+    ASSERT_TRUE(isCompiled("{$add: ['$a', 1]}"));
+    ASSERT_FALSE(isCompiled("'$a'"));
+    ASSERT_FALSE(isCompiled("{$concat: ['$a', '$b']}"));
+    ASSERT_FALSE(isCompiled("{$add: ['$a', {$abs: '$b'}]}"));
+    ASSERT_FALSE(isCompiled("{$add: ['$a', {$literal: 5000000000}]}"));
+
+    internalQueryCompileArithmeticExpressions.store(false);
+    ASSERT_FALSE(isCompiled("{$add: ['$a', 1]}"));
+}
+
+TEST_F(ExpressionBytecodeTest, SerializesAsOriginalExpression) {
+    auto tree = parse("{$add: ['$a', {$multiply: ['$b', 2]}]}");
+    auto compiled = ExpressionBytecode::compileIfEligible(tree);
+    ASSERT_VALUE_EQ(compiled->serialize(false), tree->serialize(false));
+
+    DepsTracker deps;
+    compiled->addDependencies(&deps);
+    ASSERT_EQ(deps.fields.size(), 2U);
+    ASSERT_EQ(deps.fields.count("a"), 1U);
+    ASSERT_EQ(deps.fields.count("b"), 1U);
+}
+
+}  // namespace
+}  // namespace mongo
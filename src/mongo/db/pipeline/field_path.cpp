@@ -87,8 +87,10 @@ FieldPath::FieldPath(std::string inputPath)
     uassert(ErrorCodes::Overflow,
             "FieldPath is too long",
             pathLength <= BSONDepth::getMaxAllowableDepth());
+    _fieldHash.reserve(pathLength);
     for (size_t i = 0; i < pathLength; ++i) {
         uassertValidFieldName(getFieldName(i));
+        _fieldHash.push_back(hashFieldName(getFieldName(i)));
     }
 }
 
@@ -136,6 +138,11 @@ FieldPath FieldPath::concat(const FieldPath& tail) const {
     invariant(newDots.back() == concat.size());
     invariant(newDots.size() == expectedDotSize);
 
-    return FieldPath(std::move(concat), std::move(newDots));
+    std::vector<unsigned> newHashes;
+    newHashes.reserve(head._fieldHash.size() + tail._fieldHash.size());
+    newHashes.insert(newHashes.end(), head._fieldHash.begin(), head._fieldHash.end());
+    newHashes.insert(newHashes.end(), tail._fieldHash.begin(), tail._fieldHash.end());
+
+    return FieldPath(std::move(concat), std::move(newDots), std::move(newHashes));
 }
 }  // namespace mongo
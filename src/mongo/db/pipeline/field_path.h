@@ -30,6 +30,7 @@
 #pragma once
 
 #include <string>
+#include <third_party/murmurhash3/MurmurHash3.h>
 #include <vector>
 
 #include "mongo/base/string_data.h"
@@ -60,6 +61,17 @@ public:
         return path.substr(0, path.find('.'));
     }
 
+    /**
+     * Hashes a single field name. Documents key their field hash tables with this function, so the
+     * hashes a FieldPath precomputes for its components can be used directly for lookups.
+     */
+    static unsigned hashFieldName(StringData fieldName) {
+        // TODO consider FNV-1a once we have a better benchmark corpus
+        unsigned out;
+        MurmurHash3_x86_32(fieldName.rawData(), fieldName.size(), 0, &out);
+        return out;
+    }
+
     /**
      * Throws a AssertionException if the string is empty or if any of the field names fail
      * validation.
@@ -109,6 +121,14 @@ public:
         return StringData(&_fieldPath[begin], end - begin);
     }
 
+    /**
+     * Return the hashFieldName() of the ith field name, computed when this path was constructed.
+     */
+    unsigned getFieldNameHash(size_t i) const {
+        dassert(i < getPathLength());
+        return _fieldHash[i];
+    }
+
     /**
      * Returns the full path, not including the prefix 'FieldPath::prefix'.
      */
@@ -141,8 +161,10 @@ public:
     FieldPath concat(const FieldPath& tail) const;
 
 private:
-    FieldPath(std::string string, std::vector<size_t> dots)
-        : _fieldPath(std::move(string)), _fieldPathDotPosition(std::move(dots)) {}
+    FieldPath(std::string string, std::vector<size_t> dots, std::vector<unsigned> hashes)
+        : _fieldPath(std::move(string)),
+          _fieldPathDotPosition(std::move(dots)),
+          _fieldHash(std::move(hashes)) {}
 
     static const char prefix = '$';
 
@@ -153,6 +175,10 @@ private:
     // string::npos (which evaluates to -1) and the last contains _fieldPath.size() to facilitate
     // lookup.
     std::vector<size_t> _fieldPathDotPosition;
+
+    // Contains the hashFieldName() of each path component, so that looking this path up in
+    // documents does not rehash the same names once per document.
+    std::vector<unsigned> _fieldHash;
 };
 
 inline bool operator<(const FieldPath& lhs, const FieldPath& rhs) {
@@ -214,9 +214,18 @@ void checkConcatWorks(const FieldPath& head, const FieldPath& tail) {
             ? head.getFieldName(i)
             : tail.getFieldName(i - head.getPathLength());
         ASSERT_EQ(concat.getFieldName(i), expected);
+        ASSERT_EQ(concat.getFieldNameHash(i), FieldPath::hashFieldName(expected));
     }
 }
 
+TEST(FieldPathTest, PrecomputesFieldNameHashes) {
+    FieldPath path("a.bc.$id");
+    ASSERT_EQ(path.getFieldNameHash(0), FieldPath::hashFieldName("a"));
+    ASSERT_EQ(path.getFieldNameHash(1), FieldPath::hashFieldName("bc"));
+    ASSERT_EQ(path.getFieldNameHash(2), FieldPath::hashFieldName("$id"));
+    ASSERT_EQ(path.tail().getFieldNameHash(0), FieldPath::hashFieldName("bc"));
+}
+
 TEST(FieldPathTest, Concat) {
     checkConcatWorks("abc", "cde");
     checkConcatWorks("abc.ef", "cde.ab");
@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/lookup_hash_table.h"
+
+#include <algorithm>
+
+#include "mongo/db/pipeline/document_path_support.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+LookupHashTable::LookupHashTable(const ValueComparator& comparator,
+                                 FieldPath foreignField,
+                                 size_t maxSizeBytes)
+    : _foreignField(std::move(foreignField)),
+      _maxSizeBytes(maxSizeBytes),
+      _index(comparator.makeUnorderedValueMap<std::vector<size_t>>()) {}
+
+bool LookupHashTable::canBuildOn(const FieldPath& foreignField) {
+    for (size_t i = 1; i < foreignField.getPathLength(); ++i) {
+        if (str::parseUnsignedBase10Integer(foreignField.getFieldName(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LookupHashTable::canProbeWith(const Value& localValue) {
+    return !localValue.nullish() && !localValue.isArray() &&
+        localValue.getType() != BSONType::RegEx;
+}
+
+void LookupHashTable::add(Document doc) {
+    invariant(!_abandoned);
+
+    const size_t position = _documents.size();
+    size_t addedBytes = doc.getApproximateSize();
+    document_path_support::visitAllValuesAtPath(doc, _foreignField, [&](const Value& value) {
+        auto& positions = _index[value];
+        if (positions.empty()) {
+            addedBytes += value.getApproximateSize();
+        }
+        // An array may hold the same value more than once.
+        if (positions.empty() || positions.back() != position) {
+            positions.push_back(position);
+            addedBytes += sizeof(size_t);
+        }
+    });
+
+    _sizeBytes += addedBytes;
+    if (_sizeBytes > _maxSizeBytes) {
+        abandon();
+        return;
+    }
+    _documents.push_back(std::move(doc));
+}
+
+void LookupHashTable::abandon() {
+    _abandoned = true;
+    _sizeBytes = 0;
+
+    _index.clear();
+    _documents.clear();
+    _documents.shrink_to_fit();
+}
+
+std::vector<Document> LookupHashTable::probe(const std::vector<Value>& localValues) const {
+    invariant(!_abandoned);
+
+    std::vector<size_t> positions;
+    for (auto&& localValue : localValues) {
+        dassert(canProbeWith(localValue));
+        auto it = _index.find(localValue);
+        if (it != _index.end()) {
+            positions.insert(positions.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    // Several local values may match the same foreign document.
+    if (localValues.size() > 1) {
+        std::sort(positions.begin(), positions.end());
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    }
+
+    std::vector<Document> matches;
+    matches.reserve(positions.size());
+    for (auto position : positions) {
+        matches.push_back(_documents[position]);
+    }
+    return matches;
+}
+
+}  // namespace mongo
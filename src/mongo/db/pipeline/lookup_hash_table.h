@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/pipeline/field_path.h"
+
+namespace mongo {
+
+/**
+ * An in-memory hash table over the documents of a $lookup's foreign collection, keyed by every
+ * value found along the 'foreignField' path, up to a maximum size. Probing the table with the
+ * values of a local document's 'localField' returns the foreign documents which would have been
+ * matched by the equality query that $lookup otherwise runs for that local document.
+ *
+ * Keys are hashed and compared by the ValueComparator the table is constructed with, which must
+ * outlive the table.
+ */
+class LookupHashTable {
+    LookupHashTable(const LookupHashTable&) = delete;
+    LookupHashTable& operator=(const LookupHashTable&) = delete;
+
+public:
+    LookupHashTable(const ValueComparator& comparator, FieldPath foreignField, size_t maxSizeBytes);
+
+    /**
+     * Returns true if documents can be keyed by 'foreignField'. A numeric path component may refer
+     * to either an array position or a field name when matching, so such paths are not supported.
+     */
+    static bool canBuildOn(const FieldPath& foreignField);
+
+    /**
+     * Returns true if the equality match on 'localValue' is the same as a lookup of 'localValue' in
+     * the table. This is not the case for nullish values, which also match missing fields, nor for
+     * arrays and regular expressions, which match differently from other values.
+     */
+    static bool canProbeWith(const Value& localValue);
+
+    /**
+     * Adds 'doc' to the table. Abandons the table if it would then exceed its maximum size. May
+     * only be called while the table has not been abandoned.
+     */
+    void add(Document doc);
+
+    /**
+     * Releases all of the documents in the table and marks it as abandoned.
+     */
+    void abandon();
+
+    /**
+     * Returns the documents that have any of 'localValues' along their 'foreignField' path, in
+     * the order in which they were added and without duplicates. Each of 'localValues' must
+     * satisfy canProbeWith(). May only be called while the table has not been abandoned.
+     */
+    std::vector<Document> probe(const std::vector<Value>& localValues) const;
+
+    bool isAbandoned() const {
+        return _abandoned;
+    }
+
+    size_t sizeBytes() const {
+        return _sizeBytes;
+    }
+
+    size_t count() const {
+        return _documents.size();
+    }
+
+private:
+    const FieldPath _foreignField;
+    const size_t _maxSizeBytes;
+
+    bool _abandoned = false;
+    size_t _sizeBytes = 0;
+
+    std::vector<Document> _documents;
+
+    // Maps each value found along '_foreignField' to the positions in '_documents' of the documents
+    // containing it, in ascending order.
+    ValueUnorderedMap<std::vector<size_t>> _index;
+};
+
+}  // namespace mongo
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/lookup_hash_table.h"
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const size_t kTableSizeBytes = 1024 * 1024;
+
+TEST(LookupHashTableTest, ProbeReturnsDocumentsWithMatchingScalarOrArrayElement) {
+    ValueComparator comparator;
+    LookupHashTable table(comparator, FieldPath("a"), kTableSizeBytes);
+    table.add(DOC("_id" << 0 << "a" << 1));
+    table.add(DOC("_id" << 1 << "a" << DOC_ARRAY(1 << 2 << 1)));
+    table.add(DOC("_id" << 2 << "a" << 2.0));
+    table.add(DOC("_id" << 3));
+    ASSERT_EQ(table.count(), 4ul);
+
+    auto matches = table.probe({Value(1)});
+    ASSERT_EQ(matches.size(), 2ul);
+    ASSERT_DOCUMENT_EQ(matches[0], DOC("_id" << 0 << "a" << 1));
+    ASSERT_DOCUMENT_EQ(matches[1], DOC("_id" << 1 << "a" << DOC_ARRAY(1 << 2 << 1)));
+
+    // Numbers of different types compare equal, and each document is returned once and in the
+    // order it was added.
+    matches = table.probe({Value(2LL), Value(1)});
+    ASSERT_EQ(matches.size(), 3ul);
+    ASSERT_VALUE_EQ(matches[0]["_id"], Value(0));
+    ASSERT_VALUE_EQ(matches[1]["_id"], Value(1));
+    ASSERT_VALUE_EQ(matches[2]["_id"], Value(2));
+
+    ASSERT(table.probe({Value(3)}).empty());
+}
+
+TEST(LookupHashTableTest, ProbeFollowsArraysAlongDottedPath) {
+    ValueComparator comparator;
+    LookupHashTable table(comparator, FieldPath("a.b"), kTableSizeBytes);
+    table.add(DOC("_id" << 0 << "a" << DOC_ARRAY(DOC("b" << 1) << DOC("b" << 2))));
+    table.add(DOC("_id" << 1 << "a" << DOC("b" << DOC_ARRAY(2 << 3))));
+
+    auto matches = table.probe({Value(2)});
+    ASSERT_EQ(matches.size(), 2ul);
+    ASSERT_VALUE_EQ(matches[0]["_id"], Value(0));
+    ASSERT_VALUE_EQ(matches[1]["_id"], Value(1));
+}
+
+TEST(LookupHashTableTest, ProbeUsesCollationOfComparator) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    ValueComparator comparator(&collator);
+    LookupHashTable table(comparator, FieldPath("a"), kTableSizeBytes);
+    table.add(DOC("_id" << 0 << "a"
+                        << "FOO"_sd));
+
+    ASSERT_EQ(table.probe({Value("foo"_sd)}).size(), 1ul);
+}
+
+TEST(LookupHashTableTest, CannotProbeWithValuesThatMatchDifferently) {
+    ASSERT_FALSE(LookupHashTable::canProbeWith(Value()));
+    ASSERT_FALSE(LookupHashTable::canProbeWith(Value(BSONNULL)));
+    ASSERT_FALSE(LookupHashTable::canProbeWith(Value(BSONUndefined)));
+    ASSERT_FALSE(LookupHashTable::canProbeWith(Value(std::vector<Value>{Value(1)})));
+    ASSERT_FALSE(LookupHashTable::canProbeWith(Value(BSONRegEx("^a"))));
+    ASSERT_TRUE(LookupHashTable::canProbeWith(Value(1)));
+    ASSERT_TRUE(LookupHashTable::canProbeWith(Value(DOC("b" << 1))));
+}
+
+TEST(LookupHashTableTest, CannotBuildOnPathWithNumericComponent) {
+    ASSERT_TRUE(LookupHashTable::canBuildOn(FieldPath("a.b")));
+    ASSERT_TRUE(LookupHashTable::canBuildOn(FieldPath("0.b")));
+    ASSERT_FALSE(LookupHashTable::canBuildOn(FieldPath("a.0")));
+}
+
+TEST(LookupHashTableTest, TableIsAbandonedWhenMaxSizeIsExceeded) {
+    ValueComparator comparator;
+    LookupHashTable table(comparator, FieldPath("a"), 1024);
+    table.add(DOC("_id" << 0 << "a" << 1));
+    ASSERT_FALSE(table.isAbandoned());
+
+    table.add(DOC("_id" << 1 << "a" << std::string(1024, 'x')));
+    ASSERT_TRUE(table.isAbandoned());
+    ASSERT_EQ(table.count(), 0ul);
+    ASSERT_EQ(table.sizeBytes(), 0ul);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/pipeline.h"
+
+namespace mongo {
+namespace {
+
+std::deque<DocumentSource::GetNextResult> makeDocuments(long long numDocs) {
+    std::deque<DocumentSource::GetNextResult> docs;
+    for (long long i = 0; i < numDocs; ++i) {
+        // Spread 'b' so that sorts do not see already ordered input.
+        docs.emplace_back(Document{{"_id", i},
+                                   {"a", i % 100},
+                                   {"b", (i * 7919) % numDocs},
+                                   {"s", "some string payload"_sd},
+                                   {"arr", BSON_ARRAY(1 << 2 << 3 << 4)}});
+    }
+    return docs;
+}
+
+/**
+ * Runs 'stages' over 'state.range(0)' in-memory documents and reports the throughput in documents
+ * consumed from the source, so that the per-document cost of a stage can be compared across input
+ * sizes.
+ */
+void runPipeline(benchmark::State& state, const std::vector<BSONObj>& stages) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    const auto docs = makeDocuments(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto pipeline = Pipeline::parse(stages, expCtx);
+        pipeline->addInitialSource(DocumentSourceMock::createForTest(docs, expCtx));
+        pipeline->optimizePipeline();
+        state.ResumeTiming();
+
+        while (auto next = pipeline->getNext()) {
+            benchmark::DoNotOptimize(next);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Match(benchmark::State& state) {
+    runPipeline(state, {fromjson("{$match: {a: {$lt: 10}}}")});
+}
+
+void BM_Project(benchmark::State& state) {
+    runPipeline(state, {fromjson("{$project: {a: 1, c: {$add: ['$a', '$b']}}}")});
+}
+
+void BM_Group(benchmark::State& state) {
+    runPipeline(state, {fromjson("{$group: {_id: '$a', total: {$sum: '$b'}, n: {$sum: 1}}}")});
+}
+
+void BM_Sort(benchmark::State& state) {
+    runPipeline(state, {fromjson("{$sort: {b: 1}}")});
+}
+
+void BM_SortLimit(benchmark::State& state) {
+    runPipeline(state, {fromjson("{$sort: {b: 1}}"), fromjson("{$limit: 10}")});
+}
+
+void BM_Unwind(benchmark::State& state) {
+    runPipeline(state, {fromjson("{$unwind: '$arr'}")});
+}
+
+void BM_UnwindGroup(benchmark::State& state) {
+    runPipeline(state,
+                {fromjson("{$unwind: '$arr'}"),
+                 fromjson("{$group: {_id: '$arr', total: {$sum: '$b'}}}")});
+}
+
+BENCHMARK(BM_Match)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_Project)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_Group)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_Sort)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_SortLimit)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_Unwind)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_UnwindGroup)->Range(1 << 10, 1 << 16);
+
+}  // namespace
+}  // namespace mongo
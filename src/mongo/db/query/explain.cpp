@@ -332,6 +332,10 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         bob->appendNumber("advanced", stats.common.advanced);
         bob->appendNumber("needTime", stats.common.needTime);
         bob->appendNumber("needYield", stats.common.needYield);
+        if (stats.common.batches) {
+            bob->appendNumber("batches", stats.common.batches);
+            bob->appendNumber("batchSize", stats.common.maxBatchSize);
+        }
         bob->appendNumber("saveState", stats.common.yields);
         bob->appendNumber("restoreState", stats.common.unyields);
         if (stats.common.failed)
@@ -1045,6 +1049,7 @@ void Explain::planCacheEntryToBSON(const PlanCacheEntry& entry, BSONObjBuilder*
     // Append whether or not the entry is active.
     out->append("isActive", entry.isActive);
     out->append("works", static_cast<long long>(entry.works));
+    out->append("estimatedSizeBytes", static_cast<long long>(entry.estimatedEntrySizeBytes()));
 
     BSONObjBuilder cachedPlanBob(out->subobjStart("cachedPlan"));
     Explain::statsToBSON(
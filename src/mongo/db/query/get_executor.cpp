@@ -448,7 +448,7 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
             // document, so we don't support covered projections. However, we might use the
             // simple inclusion fast path.
             // Stuff the right data into the params depending on what proj impl we use.
-            if (!cqProjection->isSimple()) {
+            if (!cqProjection->isSimple() && !cqProjection->isSimpleExclusion()) {
                 root = std::make_unique<ProjectionStageDefault>(
                     canonicalQuery->getExpCtx(),
                     canonicalQuery->getQueryRequest().getProj(),
@@ -492,7 +492,14 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
                           .getPlanCache()
                           ->getCacheEntryIfActive(planCacheKey)) {
             // We have a CachedSolution.  Have the planner turn it into a QuerySolution.
-            auto statusWithQs = QueryPlanner::planFromCache(*canonicalQuery, plannerParams, *cs);
+            std::unique_ptr<PlanCacheBoundTemplate> boundTemplate;
+            auto statusWithQs =
+                QueryPlanner::planFromCache(*canonicalQuery, plannerParams, *cs, &boundTemplate);
+            if (boundTemplate) {
+                CollectionQueryInfo::get(collection)
+                    .getPlanCache()
+                    ->setBoundTemplate(planCacheKey, *cs->plannerData[0], std::move(boundTemplate));
+            }
 
             if (statusWithQs.isOK()) {
                 auto querySolution = std::move(statusWithQs.getValue());
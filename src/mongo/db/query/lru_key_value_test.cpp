@@ -176,6 +176,30 @@ TEST(LRUKeyValueTest, ReplaceKeyTest) {
     assertInKVStore(cache, 4, 5);
 }
 
+/**
+ * Test that removeLeastRecentlyUsed() evicts entries in LRU order.
+ */
+TEST(LRUKeyValueTest, RemoveLeastRecentlyUsed) {
+    LRUKeyValue<int, int> cache(10);
+    cache.add(1, new int(1));
+    cache.add(2, new int(2));
+    cache.add(3, new int(3));
+
+    // Promote 1 to the most recently used.
+    assertInKVStore(cache, 1, 1);
+
+    auto evicted = cache.removeLeastRecentlyUsed();
+    ASSERT(evicted);
+    ASSERT_EQUALS(*evicted, 2);
+    assertNotInKVStore(cache, 2);
+    ASSERT_EQUALS(cache.size(), 2U);
+
+    ASSERT_EQUALS(*cache.removeLeastRecentlyUsed(), 3);
+    ASSERT_EQUALS(*cache.removeLeastRecentlyUsed(), 1);
+    ASSERT_EQUALS(cache.size(), 0U);
+    ASSERT_FALSE(cache.removeLeastRecentlyUsed());
+}
+
 /**
  * Test iteration over the kv-store.
  */
@@ -174,7 +174,8 @@ CachedSolution::CachedSolution(const PlanCacheKey& key, const PlanCacheEntry& en
       sort(entry.sort.getOwned()),
       projection(entry.projection.getOwned()),
       collation(entry.collation.getOwned()),
-      decisionWorks(entry.works) {
+      decisionWorks(entry.works),
+      boundTemplate(entry.boundTemplate) {
     // CachedSolution should not having any references into
     // cache entry. All relevant data should be cloned/copied.
     for (size_t i = 0; i < entry.plannerData.size(); ++i) {
@@ -287,18 +288,20 @@ std::unique_ptr<PlanCacheEntry> PlanCacheEntry::clone() const {
     }
 
     auto decisionPtr = std::unique_ptr<PlanRankingDecision>(decision->clone());
-    return std::unique_ptr<PlanCacheEntry>(new PlanCacheEntry(std::move(solutionCacheData),
-                                                              query,
-                                                              sort,
-                                                              projection,
-                                                              collation,
-                                                              timeOfCreation,
-                                                              queryHash,
-                                                              planCacheKey,
-                                                              std::move(decisionPtr),
-                                                              feedback,
-                                                              isActive,
-                                                              works));
+    auto entry = std::unique_ptr<PlanCacheEntry>(new PlanCacheEntry(std::move(solutionCacheData),
+                                                                     query,
+                                                                     sort,
+                                                                     projection,
+                                                                     collation,
+                                                                     timeOfCreation,
+                                                                     queryHash,
+                                                                     planCacheKey,
+                                                                     std::move(decisionPtr),
+                                                                     feedback,
+                                                                     isActive,
+                                                                     works));
+    entry->boundTemplate = boundTemplate;
+    return entry;
 }
 
 uint64_t PlanCacheEntry::_estimateObjectSizeInBytes() const {
@@ -416,6 +419,10 @@ std::string SolutionCacheData::toString() const {
                                  << "tree=" << this->tree->toString() << ")";
         case COLLSCAN_SOLN:
             return "(collection scan)";
+        case SKIP_SCAN_SOLN:
+            verify(this->tree.get());
+            return str::stream() << "(skip scan solution: "
+                                 << "tree=" << this->tree->toString() << ")";
         case USE_INDEX_TAGS_SOLN:
             verify(this->tree.get());
             return str::stream() << "(index-tagged expression tree: "
@@ -448,6 +455,23 @@ std::unique_ptr<CachedSolution> PlanCache::getCacheEntryIfActive(const PlanCache
     return std::move(res.cachedSolution);
 }
 
+void PlanCache::setBoundTemplate(const PlanCacheKey& key,
+                                 const SolutionCacheData& winnerCacheData,
+                                 std::unique_ptr<const PlanCacheBoundTemplate> boundTemplate) {
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    PlanCacheEntry* entry;
+    if (!_cache.get(key, &entry).isOK()) {
+        return;
+    }
+    invariant(entry);
+
+    if (entry->boundTemplate || entry->plannerData.empty() ||
+        entry->plannerData[0]->toString() != winnerCacheData.toString()) {
+        return;
+    }
+    entry->boundTemplate = std::move(boundTemplate);
+}
+
 /**
  * Given a query, and an (optional) current cache entry for its shape ('oldEntry'), determine
  * whether:
@@ -620,9 +644,16 @@ Status PlanCache::set(const CanonicalQuery& query,
     auto newEntry(PlanCacheEntry::create(
         solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
 
+    PlanCacheEntry* replacedEntry = nullptr;
+    if (_cache.get(key, &replacedEntry).isOK()) {
+        _totalSizeBytes -= replacedEntry->estimatedEntrySizeBytes();
+    }
+    _totalSizeBytes += newEntry->estimatedEntrySizeBytes();
+
     std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
 
     if (nullptr != evictedEntry.get()) {
+        _totalSizeBytes -= evictedEntry->estimatedEntrySizeBytes();
         LOGV2_DEBUG(20942,
                     1,
                     "{query_nss}: plan cache maximum size exceeded - removed least recently used "
@@ -631,9 +662,30 @@ Status PlanCache::set(const CanonicalQuery& query,
                     "evictedEntry"_attr = redact(evictedEntry->toString()));
     }
 
+    evictToSizeBudget(query);
+
     return Status::OK();
 }
 
+void PlanCache::evictToSizeBudget(const CanonicalQuery& query) {
+    const auto maxSizeBytes = internalQueryCacheMaxSizeBytesPerCollection.load();
+    if (maxSizeBytes <= 0) {
+        return;
+    }
+
+    while (_totalSizeBytes > static_cast<uint64_t>(maxSizeBytes) && _cache.size() > 1) {
+        auto evictedEntry = _cache.removeLeastRecentlyUsed();
+        _totalSizeBytes -= evictedEntry->estimatedEntrySizeBytes();
+        LOGV2_DEBUG(5100028,
+                    1,
+                    "Plan cache size budget exceeded - removed least recently used entry",
+                    "namespace"_attr = query.nss(),
+                    "evictedEntry"_attr = redact(evictedEntry->toString()),
+                    "maxSizeBytes"_attr = maxSizeBytes,
+                    "remainingSizeBytes"_attr = _totalSizeBytes);
+    }
+}
+
 void PlanCache::deactivate(const CanonicalQuery& query) {
     if (internalQueryCacheDisableInactiveEntries.load()) {
         // This is a noop if inactive entries are disabled.
@@ -692,13 +744,19 @@ Status PlanCache::feedback(const CanonicalQuery& cq, double score) {
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
+    const auto key = computeKey(canonicalQuery);
     stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    PlanCacheEntry* entry = nullptr;
+    if (_cache.get(key, &entry).isOK()) {
+        _totalSizeBytes -= entry->estimatedEntrySizeBytes();
+    }
+    return _cache.remove(key);
 }
 
 void PlanCache::clear() {
     stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     _cache.clear();
+    _totalSizeBytes = 0;
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -36,6 +36,7 @@
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/lru_key_value.h"
+#include "mongo/db/query/plan_cache_bound_template.h"
 #include "mongo/db/query/plan_cache_indexability.h"
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/platform/atomic_word.h"
@@ -250,6 +251,11 @@ struct SolutionCacheData {
         // The cached plan is a collection scan.
         COLLSCAN_SOLN,
 
+        // Indicates that the plan should scan the index
+        // in 'tree' while skipping over its unconstrained
+        // leading field.
+        SKIP_SCAN_SOLN,
+
         // Build the solution by using 'tree'
         // to tag the match expression.
         USE_INDEX_TAGS_SOLN
@@ -298,6 +304,10 @@ public:
     // The number of work cycles taken to decide on a winning plan when the plan was first
     // cached.
     size_t decisionWorks;
+
+    // If set, the planner may bind the literals of a query directly into this template rather
+    // than planning from 'plannerData'.
+    std::shared_ptr<const PlanCacheBoundTemplate> boundTemplate;
 };
 
 /**
@@ -331,6 +341,13 @@ public:
     // For debugging.
     std::string toString() const;
 
+    /**
+     * Returns the approximate deep size of this entry in bytes.
+     */
+    uint64_t estimatedEntrySizeBytes() const {
+        return _entireObjectSize;
+    }
+
     //
     // Planner data
     //
@@ -378,6 +395,10 @@ public:
     // cause this value to be increased.
     size_t works = 0;
 
+    // Built the first time the winning plan is recovered from this entry, if the plan has a form
+    // that a PlanCacheBoundTemplate can reproduce.
+    std::shared_ptr<const PlanCacheBoundTemplate> boundTemplate;
+
     /**
      * Tracks the approximate cumulative size of the plan cache entries across all the collections.
      */
@@ -516,6 +537,15 @@ public:
      */
     std::unique_ptr<CachedSolution> getCacheEntryIfActive(const PlanCacheKey& key) const;
 
+    /**
+     * Attaches 'boundTemplate' to the entry for 'key', provided the entry still has a winning plan
+     * described by 'winnerCacheData' and does not already have a template. The entry may have been
+     * evicted or replaced since 'winnerCacheData' was read from it, in which case this is a no-op.
+     */
+    void setBoundTemplate(const PlanCacheKey& key,
+                          const SolutionCacheData& winnerCacheData,
+                          std::unique_ptr<const PlanCacheBoundTemplate> boundTemplate);
+
 
     /**
      * When the CachedPlanStage runs a plan out of the cache, we want to record data about the
@@ -601,9 +631,21 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
+    /**
+     * Evicts least recently used entries until the estimated size of the cache is within
+     * 'internalQueryCacheMaxSizeBytesPerCollection', always keeping the most recent entry.
+     *
+     * Callers must hold '_cacheMutex'.
+     */
+    void evictToSizeBudget(const CanonicalQuery& query);
+
     LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
 
-    // Protects _cache.
+    // Sum of the estimated sizes of the entries in '_cache', kept up to date on every add,
+    // eviction and removal so that evictToSizeBudget() need not walk the cache.
+    uint64_t _totalSizeBytes = 0;
+
+    // Protects _cache and _totalSizeBytes.
     mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
 
     // Holds computed information about the collection's indexes.  Used for generating plan
@@ -0,0 +1,302 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cache_bound_template.h"
+
+#include "mongo/db/index_names.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_tree.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Returns the children of 'root' if it is an AND, or 'root' itself otherwise. Canonicalization
+ * flattens nested ANDs, so these are the predicates the plan cache key describes in order.
+ */
+std::vector<const MatchExpression*> topLevelPredicates(const MatchExpression* root) {
+    std::vector<const MatchExpression*> predicates;
+    if (MatchExpression::AND == root->matchType()) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            predicates.push_back(root->getChild(i));
+        }
+    } else {
+        predicates.push_back(root);
+    }
+    return predicates;
+}
+
+/**
+ * Returns true if 'expr' is a predicate whose index bounds we are able to rebuild for new literals.
+ * Whether the bounds are exact still depends on the literals, and is checked when binding.
+ */
+bool isBoundable(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return true;
+        case MatchExpression::MATCH_IN:
+            return static_cast<const InMatchExpression*>(expr)->getRegexes().empty();
+        default:
+            return false;
+    }
+}
+
+/**
+ * Multikey, sparse and partial indexes make the planner's use of a predicate depend on more than
+ * the predicate's shape, so they are never bound through a template.
+ */
+bool isEligibleIndex(const IndexEntry& index) {
+    return INDEX_BTREE == index.type && !index.multikey && !index.sparse && !index.filterExpr;
+}
+
+/**
+ * Returns true if 'lhs' and 'rhs' are conjunctions of equivalent predicates, in any order.
+ */
+bool isSameConjunction(const MatchExpression* lhs, const MatchExpression* rhs) {
+    if (!lhs || !rhs) {
+        return !lhs && !rhs;
+    }
+
+    auto lhsPredicates = topLevelPredicates(lhs);
+    auto rhsPredicates = topLevelPredicates(rhs);
+    if (lhsPredicates.size() != rhsPredicates.size()) {
+        return false;
+    }
+
+    std::vector<bool> matched(rhsPredicates.size(), false);
+    for (auto&& lhsPredicate : lhsPredicates) {
+        bool found = false;
+        for (size_t i = 0; i < rhsPredicates.size() && !found; ++i) {
+            if (!matched[i] && lhsPredicate->equivalent(rhsPredicates[i])) {
+                matched[i] = found = true;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<PlanCacheBoundTemplate> PlanCacheBoundTemplate::make(
+    const CanonicalQuery& query, const QuerySolutionNode& accessRoot) {
+    const bool fetch = STAGE_FETCH == accessRoot.getType();
+    const QuerySolutionNode* scanNode = &accessRoot;
+    if (fetch) {
+        if (accessRoot.children.size() != 1) {
+            return nullptr;
+        }
+        scanNode = accessRoot.children[0];
+    }
+
+    if (STAGE_IXSCAN != scanNode->getType() || scanNode->filter) {
+        return nullptr;
+    }
+
+    const auto& scan = static_cast<const IndexScanNode&>(*scanNode);
+    if (!isEligibleIndex(scan.index) || scan.direction != 1) {
+        return nullptr;
+    }
+
+    std::unique_ptr<PlanCacheBoundTemplate> boundTemplate(
+        new PlanCacheBoundTemplate(scan.index.identifier));
+    boundTemplate->_fetch = fetch;
+
+    // Assign boundable predicates to the fields of the index in order, stopping at the first field
+    // without any. This mirrors how the planner builds bounds for a single index, and anything it
+    // did differently is caught by the comparison below.
+    auto predicates = topLevelPredicates(query.root());
+    std::vector<bool> usedForBounds(predicates.size(), false);
+    bool prefixEnded = false;
+    for (auto&& keyPatternElt : scan.index.keyPattern) {
+        std::vector<size_t> positions;
+        for (size_t i = 0; i < predicates.size() && !prefixEnded; ++i) {
+            if (!usedForBounds[i] && isBoundable(predicates[i]) &&
+                predicates[i]->path() == keyPatternElt.fieldNameStringData()) {
+                positions.push_back(i);
+                usedForBounds[i] = true;
+            }
+        }
+        prefixEnded = prefixEnded || positions.empty();
+        boundTemplate->_boundsPositions.push_back(std::move(positions));
+    }
+
+    for (size_t i = 0; i < predicates.size(); ++i) {
+        boundTemplate->_predicates.push_back(
+            {predicates[i]->matchType(), predicates[i]->path().toString()});
+        if (!usedForBounds[i]) {
+            boundTemplate->_residualPositions.push_back(i);
+        }
+    }
+
+    if (!fetch && !boundTemplate->_residualPositions.empty()) {
+        return nullptr;
+    }
+
+    // Only keep the template if binding the original query reproduces the planner's access plan.
+    auto rebuilt = boundTemplate->bindToIndex(predicates, query, scan.index);
+    if (!rebuilt) {
+        return nullptr;
+    }
+
+    const auto& rebuiltScan =
+        static_cast<const IndexScanNode&>(fetch ? *rebuilt->children[0] : *rebuilt);
+    if (rebuiltScan.bounds != scan.bounds || rebuiltScan.addKeyMetadata != scan.addKeyMetadata ||
+        !isSameConjunction(rebuilt->filter.get(), accessRoot.filter.get())) {
+        return nullptr;
+    }
+
+    return boundTemplate;
+}
+
+std::unique_ptr<QuerySolutionNode> PlanCacheBoundTemplate::bind(
+    const CanonicalQuery& query, const QueryPlannerParams& params) const {
+    const IndexEntry* index = nullptr;
+    for (auto&& entry : params.indices) {
+        if (entry.identifier == _indexIdentifier) {
+            index = &entry;
+            break;
+        }
+    }
+
+    if (!index || !isEligibleIndex(*index) ||
+        static_cast<size_t>(index->keyPattern.nFields()) != _boundsPositions.size()) {
+        return nullptr;
+    }
+
+    auto predicates = topLevelPredicates(query.root());
+    if (predicates.size() != _predicates.size()) {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < predicates.size(); ++i) {
+        if (predicates[i]->matchType() != _predicates[i].matchType ||
+            predicates[i]->path() != _predicates[i].path) {
+            return nullptr;
+        }
+    }
+
+    return bindToIndex(predicates, query, *index);
+}
+
+std::unique_ptr<QuerySolutionNode> PlanCacheBoundTemplate::bindToIndex(
+    const std::vector<const MatchExpression*>& predicates,
+    const CanonicalQuery& query,
+    const IndexEntry& index) const {
+    auto scan = std::make_unique<IndexScanNode>(index);
+    scan->bounds.fields.resize(_boundsPositions.size());
+    scan->addKeyMetadata = query.metadataDeps()[DocumentMetadataFields::kIndexKey];
+    scan->queryCollator = query.getCollator();
+
+    BSONObjIterator keyPatternIt(index.keyPattern);
+    for (size_t field = 0; field < _boundsPositions.size(); ++field) {
+        BSONElement keyPatternElt = keyPatternIt.next();
+        OrderedIntervalList* oil = &scan->bounds.fields[field];
+        const auto& positions = _boundsPositions[field];
+        if (positions.empty()) {
+            IndexBoundsBuilder::allValuesForField(keyPatternElt, oil);
+            continue;
+        }
+
+        for (size_t i = 0; i < positions.size(); ++i) {
+            const MatchExpression* predicate = predicates[positions[i]];
+            if (!isBoundable(predicate)) {
+                return nullptr;
+            }
+
+            IndexBoundsBuilder::BoundsTightness tightness;
+            if (i == 0) {
+                IndexBoundsBuilder::translate(predicate, keyPatternElt, index, oil, &tightness);
+            } else {
+                IndexBoundsBuilder::translateAndIntersect(
+                    predicate, keyPatternElt, index, oil, &tightness);
+            }
+
+            // Inexact bounds leave the predicate to be re-checked by a filter, which is a
+            // different plan from the one this template describes.
+            if (IndexBoundsBuilder::EXACT != tightness) {
+                return nullptr;
+            }
+        }
+    }
+    IndexBoundsBuilder::alignBounds(&scan->bounds, index.keyPattern);
+
+    if (!_fetch) {
+        return std::move(scan);
+    }
+
+    auto fetch = std::make_unique<FetchNode>();
+    if (_residualPositions.size() == 1) {
+        fetch->filter = predicates[_residualPositions.front()]->shallowClone();
+    } else if (_residualPositions.size() > 1) {
+        auto residual = std::make_unique<AndMatchExpression>();
+        for (auto position : _residualPositions) {
+            residual->add(predicates[position]->shallowClone().release());
+        }
+        fetch->filter = std::move(residual);
+    }
+    fetch->children.push_back(scan.release());
+    return std::move(fetch);
+}
+
+std::string PlanCacheBoundTemplate::toString() const {
+    str::stream ss;
+    ss << "index: " << _indexIdentifier.toString() << ", bounds: [";
+    for (size_t field = 0; field < _boundsPositions.size(); ++field) {
+        ss << (field ? ", " : "") << "[";
+        for (size_t i = 0; i < _boundsPositions[field].size(); ++i) {
+            ss << (i ? ", " : "") << _boundsPositions[field][i];
+        }
+        ss << "]";
+    }
+    ss << "], residual: [";
+    for (size_t i = 0; i < _residualPositions.size(); ++i) {
+        ss << (i ? ", " : "") << _residualPositions[i];
+    }
+    ss << "], fetch: " << (_fetch ? "true" : "false");
+    return ss;
+}
+
+}  // namespace mongo
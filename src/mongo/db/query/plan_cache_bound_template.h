@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/query/index_entry.h"
+
+namespace mongo {
+
+class CanonicalQuery;
+struct QueryPlannerParams;
+struct QuerySolutionNode;
+
+/**
+ * A literal-free description of a cached access plan consisting of a single index scan, optionally
+ * followed by a fetch with a residual filter. Queries sharing a plan cache key have the same
+ * predicates in the same canonical order, differing only in their literals, so the template
+ * records which top-level predicates produce the bounds of each index field and which are left
+ * to the fetch. Binding a query then only requires translating its predicates into new index
+ * bounds, skipping the tagging and access planning done by QueryPlanner::planFromCache().
+ */
+class PlanCacheBoundTemplate {
+public:
+    /**
+     * Returns a template for queries shaped like 'query', or nullptr if 'accessRoot', the data
+     * access plan built for 'query' from the plan cache, cannot be reproduced by a template.
+     */
+    static std::unique_ptr<PlanCacheBoundTemplate> make(const CanonicalQuery& query,
+                                                        const QuerySolutionNode& accessRoot);
+
+    /**
+     * Builds the data access plan for 'query', which must share the plan cache key of the query
+     * this template was made from. Returns nullptr if the literals in 'query' do not produce exact
+     * bounds or the index is no longer eligible, in which case the caller must plan from the cache
+     * data instead.
+     */
+    std::unique_ptr<QuerySolutionNode> bind(const CanonicalQuery& query,
+                                            const QueryPlannerParams& params) const;
+
+    std::string toString() const;
+
+private:
+    struct Predicate {
+        MatchExpression::MatchType matchType;
+        std::string path;
+    };
+
+    PlanCacheBoundTemplate(IndexEntry::Identifier indexIdentifier)
+        : _indexIdentifier(std::move(indexIdentifier)) {}
+
+    std::unique_ptr<QuerySolutionNode> bindToIndex(
+        const std::vector<const MatchExpression*>& predicates,
+        const CanonicalQuery& query,
+        const IndexEntry& index) const;
+
+    IndexEntry::Identifier _indexIdentifier;
+
+    // The match type and path of each top-level predicate of the query, in canonical order.
+    std::vector<Predicate> _predicates;
+
+    // For each field of the index key pattern, the positions of the predicates whose bounds are
+    // intersected to produce the bounds for that field. Fields without predicates scan all values.
+    std::vector<std::vector<size_t>> _boundsPositions;
+
+    // The positions of the predicates which are evaluated by the fetch rather than the index scan.
+    std::vector<size_t> _residualPositions;
+
+    // Whether the access plan fetches the documents found by the index scan.
+    bool _fetch = false;
+};
+
+}  // namespace mongo
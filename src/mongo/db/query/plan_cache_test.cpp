@@ -45,6 +45,7 @@
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_test_lib.h"
@@ -1143,6 +1144,46 @@ protected:
         return std::move(statusWithQs.getValue());
     }
 
+    /**
+     * Recovers 'soln' for 'query' from a mock cache entry with bound templates enabled, and returns
+     * the template built from the recovered plan, or nullptr if there is none.
+     */
+    std::unique_ptr<PlanCacheBoundTemplate> makeBoundTemplate(const BSONObj& query,
+                                                              const QuerySolution& soln) const {
+        internalQueryPlanCacheUseBoundTemplates.store(true);
+        ON_BLOCK_EXIT([] { internalQueryPlanCacheUseBoundTemplates.store(false); });
+
+        unique_ptr<CanonicalQuery> scopedCq = canonicalize(query);
+
+        QuerySolution qs;
+        qs.cacheData.reset(soln.cacheData->clone());
+        std::vector<QuerySolution*> solutions;
+        solutions.push_back(&qs);
+
+        uint32_t queryHash = canonical_query_encoder::computeHash(ck.stringData());
+        auto entry = PlanCacheEntry::create(
+            solutions, createDecision(1U), *scopedCq, queryHash, queryHash, Date_t(), false, 0);
+        CachedSolution cachedSoln(ck, *entry);
+
+        std::unique_ptr<PlanCacheBoundTemplate> boundTemplate;
+        ASSERT_OK(
+            QueryPlanner::planFromCache(*scopedCq, params, cachedSoln, &boundTemplate).getStatus());
+        return boundTemplate;
+    }
+
+    /**
+     * Binds the literals of 'query' into 'boundTemplate'. Returns nullptr if they cannot be bound.
+     */
+    std::unique_ptr<QuerySolution> bindQuery(const PlanCacheBoundTemplate& boundTemplate,
+                                             const BSONObj& query) const {
+        unique_ptr<CanonicalQuery> scopedCq = canonicalize(query);
+        auto solnRoot = boundTemplate.bind(*scopedCq, params);
+        if (!solnRoot) {
+            return nullptr;
+        }
+        return QueryPlannerAnalysis::analyzeDataAccess(*scopedCq, params, std::move(solnRoot));
+    }
+
     /**
      * @param solnJson -- a json representation of a query solution.
      *
@@ -1253,6 +1294,52 @@ TEST_F(CachePlanSelectionTest, EqualityIndexScanWithTrailingFields) {
         BSON("x" << 5), "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1, y: 1}}}}}");
 }
 
+//
+// Bound templates
+//
+
+TEST_F(CachePlanSelectionTest, BoundTemplateRebindsLiterals) {
+    addIndex(BSON("a" << 1 << "b" << 1), "a_1_b_1");
+    BSONObj query = fromjson("{a: 5, b: {$lt: 2}, c: 3}");
+    runQuery(query);
+
+    auto bestSoln =
+        firstMatchingSolution("{fetch: {filter: {c: 3}, node: {ixscan: {pattern: {a: 1, b: 1}}}}}");
+    auto boundTemplate = makeBoundTemplate(query, *bestSoln);
+    ASSERT(boundTemplate);
+
+    auto soln = bindQuery(*boundTemplate, fromjson("{a: 7, b: {$lt: 10}, c: 4}"));
+    ASSERT(soln);
+    assertSolutionMatches(soln.get(),
+                          "{fetch: {filter: {c: 4}, node: {ixscan: {pattern: {a: 1, b: 1}, "
+                          "bounds: {a: [[7, 7, true, true]], "
+                          "b: [[-Infinity, 10, true, false]]}}}}}");
+}
+
+TEST_F(CachePlanSelectionTest, BoundTemplateRejectsInexactLiterals) {
+    addIndex(BSON("a" << 1), "a_1");
+    BSONObj query = fromjson("{a: 5}");
+    runQuery(query);
+
+    auto bestSoln =
+        firstMatchingSolution("{fetch: {filter: null, node: {ixscan: {pattern: {a: 1}}}}}");
+    auto boundTemplate = makeBoundTemplate(query, *bestSoln);
+    ASSERT(boundTemplate);
+
+    // Equality to null also matches missing fields, so its bounds need a residual filter.
+    ASSERT_FALSE(bindQuery(*boundTemplate, fromjson("{a: null}")));
+    ASSERT(bindQuery(*boundTemplate, fromjson("{a: 6}")));
+}
+
+TEST_F(CachePlanSelectionTest, NoBoundTemplateForMultikeyIndex) {
+    addIndex(BSON("a" << 1), "a_1", true);
+    BSONObj query = fromjson("{a: {$gt: 1, $lt: 5}}");
+    runQuery(query);
+
+    auto bestSoln = firstMatchingSolution("{fetch: {node: {ixscan: {pattern: {a: 1}}}}}");
+    ASSERT_FALSE(makeBoundTemplate(query, *bestSoln));
+}
+
 //
 // Geo
 //
@@ -2257,6 +2344,46 @@ TEST(PlanCacheTest, PlanCacheSizeWithEviction) {
     ASSERT_EQ(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(), originalSize);
 }
 
+TEST(PlanCacheTest, PlanCacheEvictsToSizeBudget) {
+    PlanCache planCache;
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+
+    // Distinct shapes of the same size, so that each entry costs the same against the budget.
+    const std::vector<std::string> queryStrings = {"{a: 1}", "{b: 1}", "{c: 1}", "{d: 1}"};
+    auto setEntry = [&](int i) {
+        unique_ptr<CanonicalQuery> query(canonicalize(queryStrings[i]));
+        ASSERT_OK(planCache.set(*query, solns, createDecision(1U), Date_t{}));
+    };
+    auto isCached = [&](int i) {
+        unique_ptr<CanonicalQuery> query(canonicalize(queryStrings[i]));
+        return planCache.get(*query).state != PlanCache::CacheEntryState::kNotPresent;
+    };
+
+    long long sizeBefore = PlanCacheEntry::planCacheTotalSizeEstimateBytes.get();
+    setEntry(0);
+    long long entrySize = PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() - sizeBefore;
+    ASSERT_GT(entrySize, 0);
+
+    // Allow a little more than two entries of this shape.
+    internalQueryCacheMaxSizeBytesPerCollection.store(2 * entrySize + entrySize / 2);
+    ON_BLOCK_EXIT([] { internalQueryCacheMaxSizeBytesPerCollection.store(0); });
+
+    setEntry(1);
+    ASSERT_EQ(planCache.size(), 2U);
+    setEntry(2);
+    ASSERT_EQ(planCache.size(), 2U);
+    ASSERT_FALSE(isCached(0));
+    ASSERT_TRUE(isCached(1));
+    ASSERT_TRUE(isCached(2));
+
+    // The most recent entry is kept even if it alone exceeds the budget.
+    internalQueryCacheMaxSizeBytesPerCollection.store(1);
+    setEntry(3);
+    ASSERT_EQ(planCache.size(), 1U);
+    ASSERT_TRUE(isCached(3));
+}
+
 TEST(PlanCacheTest, PlanCacheSizeWithMultiplePlanCaches) {
     PlanCache planCache1;
     PlanCache planCache2;
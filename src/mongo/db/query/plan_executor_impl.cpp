@@ -54,6 +54,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
@@ -247,6 +248,12 @@ PlanExecutorImpl::PlanExecutorImpl(OperationContext* opCtx,
         _oplogTrackingStage = static_cast<CollectionScan*>(collectionScan);
     }
 
+    // Only user queries are executed in batch mode. Internal executors, which may modify the
+    // collection in between calls to getNext(), are always executed one result at a time.
+    if (_cq && _root->supportsBatchExecution()) {
+        _batchSize = std::max(internalQueryExecBatchSize.load(), 0);
+    }
+
     // We may still need to initialize _nss from either collection or _cq.
     if (!_nss.isEmpty()) {
         return;  // We already have an _nss set, so there's nothing more to do.
@@ -570,7 +577,20 @@ PlanExecutor::ExecState PlanExecutorImpl::_getNextImpl(Snapshotted<Document>* ob
         }
 
         WorkingSetID id = WorkingSet::INVALID_ID;
-        PlanStage::StageState code = _root->work(&id);
+        PlanStage::StageState code;
+        if (_nextBatchedResult < _batchedResults.size()) {
+            id = _batchedResults[_nextBatchedResult++];
+            code = PlanStage::ADVANCED;
+        } else if (_batchSize > 0) {
+            _batchedResults.clear();
+            _nextBatchedResult = 0;
+            code = _root->workBatch(_batchSize, &_batchedResults, &id);
+            if (PlanStage::ADVANCED == code) {
+                id = _batchedResults[_nextBatchedResult++];
+            }
+        } else {
+            code = _root->work(&id);
+        }
 
         if (code != PlanStage::NEED_YIELD)
             writeConflictsInARow = 0;
@@ -675,7 +695,8 @@ PlanExecutor::ExecState PlanExecutorImpl::_getNextImpl(Snapshotted<Document>* ob
 
 bool PlanExecutorImpl::isEOF() {
     invariant(_currentState == kUsable);
-    return isMarkedAsKilled() || (_stash.empty() && _root->isEOF());
+    return isMarkedAsKilled() ||
+        (_stash.empty() && _nextBatchedResult == _batchedResults.size() && _root->isEOF());
 }
 
 void PlanExecutorImpl::markAsKilled(Status killStatus) {
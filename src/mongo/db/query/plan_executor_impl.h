@@ -31,7 +31,9 @@
 
 #include <boost/optional.hpp>
 #include <queue>
+#include <vector>
 
+#include "mongo/db/exec/working_set.h"
 #include "mongo/db/query/plan_executor.h"
 
 namespace mongo {
@@ -189,6 +191,12 @@ private:
     // stages.
     std::queue<Document> _stash;
 
+    // When non-zero, results are pulled from '_root' via workBatch() in batches of up to this
+    // many results, and buffered in '_batchedResults' until returned by getNext().
+    size_t _batchSize = 0;
+    std::vector<WorkingSetID> _batchedResults;
+    size_t _nextBatchedResult = 0;
+
     // The output document that is used by getNext BSON API. This allows us to avoid constantly
     // allocating and freeing DocumentStorage.
     Document _docOutput;
@@ -46,6 +46,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/planner_ixselect.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
@@ -207,6 +208,65 @@ bool isOplogTsLowerBoundPred(const mongo::MatchExpression* me) {
 
     return me->path() == repl::OpTime::kTimestampFieldName;
 }
+
+/**
+ * Returns true if 'expr', whose bounds over 'index' are INEXACT_COVERED, may be evaluated by the
+ * index scan against the index keys rather than by a fetch. With a multikey btree index this is
+ * only safe if path-level multikey metadata shows that no path read by 'expr' has an array
+ * component, since otherwise each key holds just one element of the array.
+ */
+bool canUseCoveredFilter(const MatchExpression* expr, const IndexEntry& index) {
+    if (!index.multikey) {
+        return true;
+    }
+
+    if (INDEX_BTREE != index.type || index.multikeyPaths.empty()) {
+        return false;
+    }
+
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                if (!canUseCoveredFilter(expr->getChild(i), index)) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            break;
+    }
+
+    size_t keyPatternFieldIndex = 0;
+    for (auto&& elt : index.keyPattern) {
+        if (elt.fieldNameStringData() == expr->path()) {
+            return index.multikeyPaths[keyPatternFieldIndex].empty();
+        }
+        ++keyPatternFieldIndex;
+    }
+    return false;
+}
+
+/**
+ * Returns true if 'expr' is a comparison whose index bounds may be used to constrain a field
+ * after the skipped prefix of a skip scan.
+ */
+bool isSkipScanBoundable(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return true;
+        case MatchExpression::MATCH_IN:
+            return static_cast<const InMatchExpression*>(expr)->getRegexes().empty();
+        default:
+            return false;
+    }
+}
 }  // namespace
 
 std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
@@ -615,7 +675,7 @@ bool QueryPlannerAccess::orNeedsFetch(const ScanBuildingState* scanState) {
     } else {
         invariant(scanState->loosestBounds == IndexBoundsBuilder::INEXACT_COVERED);
         const IndexEntry& index = scanState->indices[scanState->currentIndexNumber];
-        return index.multikey;
+        return !canUseCoveredFilter(scanState->curOr.get(), index);
     }
 }
 
@@ -1295,7 +1355,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::_buildIndexedDataAccess(
             if (tightness == IndexBoundsBuilder::EXACT) {
                 return soln;
             } else if (tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-                       !indices[tag->index].multikey) {
+                       canUseCoveredFilter(ownedRoot.get(), indices[tag->index])) {
                 verify(nullptr == soln->filter.get());
                 soln->filter = std::move(ownedRoot);
                 return soln;
@@ -1370,6 +1430,91 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
     return solnRoot;
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanIndexSkippingPrefix(
+    const IndexEntry& index, const CanonicalQuery& query, const QueryPlannerParams& params) {
+    if (index.type != INDEX_BTREE || index.multikey || index.sparse || index.filterExpr ||
+        index.keyPattern.nFields() < 2) {
+        return nullptr;
+    }
+
+    // Only the top-level conjuncts of the query can be used to constrain the scan.
+    const MatchExpression* root = query.root();
+    std::vector<const MatchExpression*> predicates;
+    if (MatchExpression::AND == root->matchType()) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            predicates.push_back(root->getChild(i));
+        }
+    } else {
+        predicates.push_back(root);
+    }
+
+    // If the leading field has a predicate, the index was already considered by the regular
+    // enumeration.
+    const StringData leadingField = index.keyPattern.firstElementFieldNameStringData();
+    for (auto&& predicate : predicates) {
+        if (predicate->path() == leadingField) {
+            return nullptr;
+        }
+    }
+
+    auto isn = std::make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.metadataDeps()[DocumentMetadataFields::kIndexKey];
+    isn->queryCollator = query.getCollator();
+    isn->bounds.fields.resize(index.keyPattern.nFields());
+
+    bool constrainsAnyField = false;
+    size_t pos = 0;
+    for (auto&& elt : index.keyPattern) {
+        OrderedIntervalList* oil = &isn->bounds.fields[pos++];
+        oil->name = elt.fieldName();
+
+        bool constrained = false;
+        for (auto&& predicate : predicates) {
+            if (predicate->path() != elt.fieldNameStringData() ||
+                !isSkipScanBoundable(predicate)) {
+                continue;
+            }
+
+            // As for regular index bounds, comparisons to strings, objects and arrays can only be
+            // translated into bounds when the query and the index use the same collation.
+            if ((QueryPlannerIXSelect::boundsGeneratingNodeContainsComparisonToType(
+                     predicate, BSONType::String) ||
+                 QueryPlannerIXSelect::boundsGeneratingNodeContainsComparisonToType(
+                     predicate, BSONType::Array) ||
+                 QueryPlannerIXSelect::boundsGeneratingNodeContainsComparisonToType(
+                     predicate, BSONType::Object)) &&
+                !CollatorInterface::collatorsMatch(query.getCollator(), index.collator)) {
+                continue;
+            }
+
+            // The tightness is not needed, since the fetch re-applies the whole query.
+            IndexBoundsBuilder::BoundsTightness tightness;
+            if (!constrained) {
+                IndexBoundsBuilder::translate(predicate, elt, index, oil, &tightness);
+            } else {
+                IndexBoundsBuilder::translateAndIntersect(predicate, elt, index, oil, &tightness);
+            }
+            constrained = true;
+        }
+
+        if (!constrained) {
+            IndexBoundsBuilder::allValuesForField(elt, oil);
+        }
+        constrainsAnyField = constrainsAnyField || constrained;
+    }
+
+    if (!constrainsAnyField) {
+        return nullptr;
+    }
+
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index.keyPattern);
+
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->filter = root->shallowClone();
+    fetch->children.push_back(isn.release());
+    return std::move(fetch);
+}
+
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  MatchExpression* match,
                                                  MatchExpression::MatchType type) {
@@ -1443,18 +1588,18 @@ void QueryPlannerAccess::handleFilterAnd(ScanBuildingState* scanState) {
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
         delete child;
     } else if (scanState->tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-               (INDEX_TEXT == index.type || !index.multikey)) {
+               (INDEX_TEXT == index.type || canUseCoveredFilter(child, index))) {
         // The bounds are not exact, but the information needed to
         // evaluate the predicate is in the index key. Remove the
         // MatchExpression from its parent and attach it to the filter
         // of the index scan we're building.
         //
-        // We can only use this optimization if the index is NOT multikey.
-        // Suppose that we had the multikey index {x: 1} and a document
-        // {x: ["a", "b"]}. Now if we query for {x: /b/} the filter might
-        // ever only be applied to the index key "a". We'd incorrectly
-        // conclude that the document does not match the query :( so we
-        // gotta stick to non-multikey indices.
+        // We can only use this optimization if the predicate's path has
+        // no array components. Suppose that we had the multikey index
+        // {x: 1} and a document {x: ["a", "b"]}. Now if we query for
+        // {x: /b/} the filter might ever only be applied to the index key
+        // "a". We'd incorrectly conclude that the document does not match
+        // the query :( so we gotta stick to non-multikey paths.
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
 
         addFilterToSolutionNode(scanState->currentScan.get(), child, root->matchType());
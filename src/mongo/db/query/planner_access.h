@@ -110,6 +110,18 @@ public:
                                                              const QueryPlannerParams& params,
                                                              int direction = 1);
 
+    /**
+     * Return a plan that scans the provided compound index when the query has no predicate over
+     * its leading field but does constrain some of the later fields. The leading field is given
+     * all-values bounds, so the bounds checker seeks from one distinct leading value to the next
+     * instead of examining every key. The full query is applied as a filter after the fetch.
+     *
+     * Returns nullptr if the index is not a non-multikey, non-sparse, non-partial btree index
+     * or if the query does not restrict it in this way.
+     */
+    static std::unique_ptr<QuerySolutionNode> scanIndexSkippingPrefix(
+        const IndexEntry& index, const CanonicalQuery& query, const QueryPlannerParams& params);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
@@ -40,6 +40,7 @@
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/logv2/log.h"
@@ -363,10 +364,11 @@ std::unique_ptr<ProjectionNode> analyzeProjection(const CanonicalQuery& query,
     // need a sort key, don't have any dotted-path inclusions, don't have a positional projection,
     // and don't have the 'requiresDocument' property: the ProjectionNodeSimple fast-path for plans
     // that have a fetch stage and the ProjectionNodeCovered for plans with an index scan that the
-    // projection can cover. Plans that don't meet all the requirements for these fast path
-    // projections will all use ProjectionNodeDefault, which is able to handle all projections,
-    // covered or otherwise.
-    if (query.getProj()->isSimple()) {
+    // projection can cover. Exclusions of top-level fields always require the document and so
+    // are fetched, which makes them eligible for the ProjectionNodeSimple fast-path too. Plans that
+    // don't meet all the requirements for these fast path projections will all use
+    // ProjectionNodeDefault, which is able to handle all projections, covered or otherwise.
+    if (query.getProj()->isSimple() || query.getProj()->isSimpleExclusion()) {
         // If the projection is simple, but not covered, use 'ProjectionNodeSimple'.
         if (solnRoot->fetched()) {
             return std::make_unique<ProjectionNodeSimple>(
@@ -492,6 +494,38 @@ bool canUseSimpleSort(const QuerySolutionNode& solnRoot,
         && !splitLimitedSortEligible;
 }
 
+/**
+ * Makes 'sortNode' keep only the sort key and record id of each input document, and fetches the
+ * sorted documents again above it. The returned FETCH owns 'sortNode', which is replaced with a
+ * SortNodeDefault if it is a SortNodeSimple, since the simple sort drops the record ids.
+ */
+QuerySolutionNode* discardFetchedDocumentsUntilSorted(const CanonicalQuery& query,
+                                                      SortNode* sortNode) {
+    std::unique_ptr<SortNode> sortNodeDefault;
+    if (STAGE_SORT_SIMPLE == sortNode->getType()) {
+        sortNodeDefault = std::make_unique<SortNodeDefault>();
+        sortNodeDefault->pattern = sortNode->pattern;
+        sortNodeDefault->limit = sortNode->limit;
+        sortNodeDefault->addSortKeyMetadata = sortNode->addSortKeyMetadata;
+        sortNodeDefault->children.swap(sortNode->children);
+        delete sortNode;
+    } else {
+        sortNodeDefault.reset(sortNode);
+    }
+    sortNodeDefault->discardFetchedDocuments = true;
+
+    auto fetch = std::make_unique<FetchNode>();
+
+    // A document may have changed since it was sorted, so the query is applied to it again. This
+    // is unnecessary for find({}).
+    const MatchExpression* root = query.root();
+    if (MatchExpression::AND != root->matchType() || 0 != root->numChildren()) {
+        fetch->filter = root->shallowClone();
+    }
+    fetch->children.push_back(sortNodeDefault.release());
+    return fetch.release();
+}
+
 }  // namespace
 
 // static
@@ -822,6 +856,17 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sortNodeRaw->limit = 0;
     }
 
+    // A top-k sort only keeps a handful of its input documents, so there is little point in
+    // holding on to each document while it is a candidate. Skipped for the SPLIT_LIMITED_SORT
+    // plan, whose parent deduplicates the results of both branches, and for text and geoNear
+    // queries, whose predicates cannot be applied by a FETCH.
+    if (internalQueryTopKSortDiscardsFetchedDocuments.load() && solnRoot == sortNodeRaw &&
+        sortNodeRaw->limit > 0 && sortNodeRaw->children[0]->fetched() &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT) &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR)) {
+        solnRoot = discardFetchedDocumentsUntilSorted(query, sortNodeRaw);
+    }
+
     *blockingSortOut = true;
 
     return solnRoot;
@@ -199,10 +199,9 @@ static bool twoDWontWrap(const Circle& circle, const IndexEntry& index) {
     return ret;
 }
 
-// Checks whether 'node' contains any comparison to an element of type 'type'. Nested objects and
-// arrays are not checked recursively. We assume 'node' is bounds-generating or is a recursive child
-// of a bounds-generating node, i.e. it does not contain AND, OR, ELEM_MATCH_OBJECT, or NOR.
-static bool boundsGeneratingNodeContainsComparisonToType(MatchExpression* node, BSONType type) {
+// static
+bool QueryPlannerIXSelect::boundsGeneratingNodeContainsComparisonToType(const MatchExpression* node,
+                                                                        BSONType type) {
     invariant(node->matchType() != MatchExpression::AND &&
               node->matchType() != MatchExpression::OR &&
               node->matchType() != MatchExpression::NOR &&
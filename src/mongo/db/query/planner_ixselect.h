@@ -135,6 +135,15 @@ public:
     static std::vector<IndexEntry> expandIndexes(const stdx::unordered_set<std::string>& fields,
                                                  std::vector<IndexEntry> relevantIndices);
 
+    /**
+     * Checks whether 'node' contains any comparison to an element of type 'type'. Nested objects
+     * and arrays are not checked recursively. We assume 'node' is bounds-generating or is a
+     * recursive child of a bounds-generating node, i.e. it does not contain AND, OR,
+     * ELEM_MATCH_OBJECT, or NOR.
+     */
+    static bool boundsGeneratingNodeContainsComparisonToType(const MatchExpression* node,
+                                                             BSONType type);
+
     /**
      * Check if this match expression is a leaf and is supported by a wildcard index.
      */
@@ -120,6 +120,17 @@ public:
             !_deps.metadataRequested.any() && !_deps.requiresDocument && !_deps.hasExpressions;
     }
 
+    /**
+     * A projection is a "simple exclusion" if it only excludes top-level fields: it has no dotted
+     * paths, positional projection, $slice, $elemMatch, expressions or metadata. Such projections
+     * can be applied by copying the remaining top-level elements of the input BSON.
+     */
+    bool isSimpleExclusion() const {
+        return _type == ProjectType::kExclusion && !_deps.hasDottedPath &&
+            !_deps.requiresMatchDetails && !_deps.metadataRequested.any() &&
+            !_deps.hasExpressions;
+    }
+
     /**
      * Returns true if this projection has any fields which are the result of computing an
      * expression.
@@ -542,4 +542,18 @@ TEST(QueryProjectionTest, AssignmentToDottedPathRequiresFirstComponent) {
     ASSERT_EQ(fields[0], "a");
 }
 
+TEST(QueryProjectionTest, TopLevelExclusionIsSimpleExclusion) {
+    ASSERT_TRUE(createProjection("{}", "{a: 0, b: 0}").isSimpleExclusion());
+    ASSERT_TRUE(createProjection("{}", "{_id: 0}").isSimpleExclusion());
+    ASSERT_TRUE(createProjection("{}", "{_id: 1, a: 0}").isSimpleExclusion());
+    ASSERT_FALSE(createProjection("{}", "{a: 0}").isSimple());
+}
+
+TEST(QueryProjectionTest, ComplexExclusionIsNotSimpleExclusion) {
+    ASSERT_FALSE(createProjection("{}", "{'a.b': 0}").isSimpleExclusion());
+    ASSERT_FALSE(createFindProjection("{}", "{a: {$slice: 1}}").isSimpleExclusion());
+    ASSERT_FALSE(createFindProjection("{}", "{a: {$elemMatch: {b: 1}}}").isSimpleExclusion());
+    ASSERT_FALSE(createProjection("{}", "{a: 1}").isSimpleExclusion());
+}
+
 }  // namespace
@@ -48,10 +48,12 @@
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_cache_bound_template.h"
 #include "mongo/db/query/plan_enumerator.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/logv2/log.h"
@@ -287,6 +289,17 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+std::unique_ptr<QuerySolution> buildSkipScanSoln(const IndexEntry& index,
+                                                 const CanonicalQuery& query,
+                                                 const QueryPlannerParams& params) {
+    std::unique_ptr<QuerySolutionNode> solnRoot(
+        QueryPlannerAccess::scanIndexSkippingPrefix(index, query, params));
+    if (!solnRoot) {
+        return nullptr;
+    }
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
@@ -437,7 +450,8 @@ Status QueryPlanner::tagAccordingToCache(MatchExpression* filter,
 StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
     const CanonicalQuery& query,
     const QueryPlannerParams& params,
-    const CachedSolution& cachedSoln) {
+    const CachedSolution& cachedSoln,
+    std::unique_ptr<PlanCacheBoundTemplate>* boundTemplateOut) {
     invariant(!cachedSoln.plannerData.empty());
 
     // A query not suitable for caching should not have made its way into the cache.
@@ -466,12 +480,36 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
         } else {
             return {std::move(soln)};
         }
+    } else if (SolutionCacheData::SKIP_SCAN_SOLN == winnerCacheData.solnType) {
+        auto soln = buildSkipScanSoln(*winnerCacheData.tree->entry, query, params);
+        if (!soln) {
+            return Status(ErrorCodes::NoQueryExecutionPlans,
+                          "plan cache error: skip scan soln");
+        } else {
+            return {std::move(soln)};
+        }
     }
 
     // SolutionCacheData::USE_TAGS_SOLN == cacheData->solnType
     // If we're here then this is neither the whole index scan or collection scan
     // cases, and we proceed by using the PlanCacheIndexTree to tag the query tree.
 
+    const bool useBoundTemplates = internalQueryPlanCacheUseBoundTemplates.load();
+    if (useBoundTemplates && cachedSoln.boundTemplate) {
+        // Queries of this shape only differ in their literals, so bind them straight into the
+        // access plan recorded for the shape. If they cannot be bound, plan from the tags below.
+        if (auto solnRoot = cachedSoln.boundTemplate->bind(query, params)) {
+            if (auto soln =
+                    QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot))) {
+                LOGV2_DEBUG(5100002,
+                            5,
+                            "Planner: solution bound from the plan cache template",
+                            "solution"_attr = redact(soln->toString()));
+                return {std::move(soln)};
+            }
+        }
+    }
+
     // Create a copy of the expression tree.  We use cachedSoln to annotate this with indices.
     unique_ptr<MatchExpression> clone = query.root()->shallowClone();
 
@@ -524,6 +562,10 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
                                     << query.toStringShort());
     }
 
+    if (useBoundTemplates && boundTemplateOut && !cachedSoln.boundTemplate) {
+        *boundTemplateOut = PlanCacheBoundTemplate::make(query, *solnRoot);
+    }
+
     auto soln = QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
     if (!soln) {
         return Status(ErrorCodes::NoQueryExecutionPlans,
@@ -1046,6 +1088,40 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // Consider scanning compound indexes whose leading field the query does not constrain, seeking
+    // past each distinct leading value. Without statistics on the number of distinct values, the
+    // multi-planner is left to decide whether this beats the alternatives.
+    size_t numSkipScans = 0;
+    if (internalQueryPlannerGenerateSkipScans.load() && hintedIndex.isEmpty() &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT)) {
+        for (auto&& index : fullIndexList) {
+            if (out.size() >= params.maxIndexedSolutions) {
+                break;
+            }
+
+            auto soln = buildSkipScanSoln(index, query, params);
+            if (!soln) {
+                continue;
+            }
+
+            LOGV2_DEBUG(5100003,
+                        5,
+                        "Planner: outputting skip scan soln",
+                        "solution"_attr = redact(soln->toString()));
+            PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
+            indexTree->setIndexEntry(index);
+
+            SolutionCacheData* scd = new SolutionCacheData();
+            scd->tree.reset(indexTree);
+            scd->solnType = SolutionCacheData::SKIP_SCAN_SOLN;
+            soln->cacheData.reset(scd);
+
+            out.push_back(std::move(soln));
+            ++numSkipScans;
+        }
+    }
+
     // The caller can explicitly ask for a collscan.
     bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
 
@@ -1065,7 +1141,13 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         return Status(ErrorCodes::NoQueryExecutionPlans, "No query solutions");
     }
 
-    if (possibleToCollscan && (collscanRequested || collScanRequired)) {
+    // A skip scan over a leading field with many distinct values can be slower than a collection
+    // scan, so a collscan competes with it when nothing else does.
+    bool collScanCompetesWithSkipScans =
+        canTableScan && numSkipScans > 0 && numSkipScans == out.size();
+
+    if (possibleToCollscan &&
+        (collscanRequested || collScanRequired || collScanCompetesWithSkipScans)) {
         auto collscan = buildCollscanSoln(query, isTailable, params);
         if (!collscan && collScanRequired) {
             return Status(ErrorCodes::NoQueryExecutionPlans,
@@ -38,6 +38,7 @@ namespace mongo {
 
 class CachedSolution;
 class Collection;
+class PlanCacheBoundTemplate;
 
 /**
  * QueryPlanner's job is to provide an entry point to the query planning and optimization
@@ -61,11 +62,15 @@ public:
      * @param query -- query for which we are generating a plan
      * @param params -- planning parameters
      * @param cachedSoln -- the CachedSolution retrieved from the plan cache.
+     * @param boundTemplateOut -- if non-null and 'cachedSoln' has no bound template, receives a
+     *                            template for binding later queries of the same shape, when the
+     *                            recovered plan allows one.
      */
     static StatusWith<std::unique_ptr<QuerySolution>> planFromCache(
         const CanonicalQuery& query,
         const QueryPlannerParams& params,
-        const CachedSolution& cachedSoln);
+        const CachedSolution& cachedSoln,
+        std::unique_ptr<PlanCacheBoundTemplate>* boundTemplateOut = nullptr);
 
     /**
      * Generates and returns the index tag tree that will be inserted into the plan cache. This data
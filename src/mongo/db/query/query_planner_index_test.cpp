@@ -32,8 +32,10 @@
 #include "mongo/db/matcher/expression_always_boolean.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -1426,5 +1428,72 @@ TEST_F(QueryPlannerTest, PlansForWholeIndexScanWithSortAreGenerated) {
         "{proj: {spec: {'b': 1, _id: 0}, node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, SkipScanSkipsUnconstrainedLeadingField) {
+    internalQueryPlannerGenerateSkipScans.store(true);
+    ON_BLOCK_EXIT([] { internalQueryPlannerGenerateSkipScans.store(false); });
+    params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+
+    runQuery(fromjson("{b: 5, c: {$gt: 1, $lt: 3}}"));
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: {b: 5, c: {$gt: 1, $lt: 3}}, node: {ixscan: "
+        "{pattern: {a: 1, b: 1, c: 1}, bounds: {a: [['MinKey','MaxKey',true,true]], "
+        "b: [[5,5,true,true]], c: [[1,3,false,false]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanBoundsForStringPredicateWhenCollationsDiffer) {
+    internalQueryPlannerGenerateSkipScans.store(true);
+    ON_BLOCK_EXIT([] { internalQueryPlannerGenerateSkipScans.store(false); });
+    params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    addIndex(fromjson("{a: 1, b: 1}"), &collator);
+
+    runQuery(fromjson("{b: 'foo'}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanLeavesStringFieldUnboundedWhenCollationsDiffer) {
+    internalQueryPlannerGenerateSkipScans.store(true);
+    ON_BLOCK_EXIT([] { internalQueryPlannerGenerateSkipScans.store(false); });
+    params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    addIndex(fromjson("{a: 1, b: 1, c: 1}"), &collator);
+
+    // The string comparison on 'b' is left to the fetch filter, while 'c' still bounds the scan.
+    runQuery(fromjson("{b: 'foo', c: 5}"));
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: {b: 'foo', c: 5}, node: {ixscan: "
+        "{pattern: {a: 1, b: 1, c: 1}, bounds: {a: [['MinKey','MaxKey',true,true]], "
+        "b: [['MinKey','MaxKey',true,true]], c: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanWhenLeadingFieldIsConstrained) {
+    internalQueryPlannerGenerateSkipScans.store(true);
+    ON_BLOCK_EXIT([] { internalQueryPlannerGenerateSkipScans.store(false); });
+    params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{a: {$exists: true}, b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{fetch: {node: {ixscan: {pattern: {a: 1, b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanForMultikeyIndex) {
+    internalQueryPlannerGenerateSkipScans.store(true);
+    ON_BLOCK_EXIT([] { internalQueryPlannerGenerateSkipScans.store(false); });
+    params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    const bool multikey = true;
+    addIndex(BSON("a" << 1 << "b" << 1), multikey);
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
 }  // namespace
 }  // namespace mongo
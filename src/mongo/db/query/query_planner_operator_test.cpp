@@ -30,9 +30,11 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -836,6 +838,35 @@ TEST_F(QueryPlannerTest, SortSoftLimit) {
         "{cscan: {dir: 1}}}}");
 }
 
+TEST_F(QueryPlannerTest, SortLimitDiscardsFetchedDocumentsUntilSorted) {
+    internalQueryTopKSortDiscardsFetchedDocuments.store(true);
+    ON_BLOCK_EXIT([] { internalQueryTopKSortDiscardsFetchedDocuments.store(false); });
+    addIndex(BSON("a" << 1));
+
+    runQuerySortProjSkipNToReturn(fromjson("{a: {$gt: 0}}"), fromjson("{b: 1}"), BSONObj(), 2, -3);
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{skip: {n: 2, node: {fetch: {filter: {a: {$gt: 0}}, node: "
+        "{sort: {pattern: {b: 1}, limit: 5, type: 'default', node: "
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1}}}}}}}}}}}");
+    assertSolutionExists(
+        "{skip: {n: 2, node: {fetch: {filter: {a: {$gt: 0}}, node: "
+        "{sort: {pattern: {b: 1}, limit: 5, type: 'default', node: "
+        "{cscan: {dir: 1, filter: {a: {$gt: 0}}}}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SortWithoutLimitKeepsFetchedDocuments) {
+    internalQueryTopKSortDiscardsFetchedDocuments.store(true);
+    ON_BLOCK_EXIT([] { internalQueryTopKSortDiscardsFetchedDocuments.store(false); });
+
+    runQuerySortProjSkipNToReturn(BSONObj(), fromjson("{a: 1}"), BSONObj(), 2, 0);
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{skip: {n: 2, node: "
+        "{sort: {pattern: {a: 1}, limit: 0, type: 'simple', node: "
+        "{cscan: {dir: 1}}}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, SortSkipSoftLimit) {
     runQuerySortProjSkipNToReturn(BSONObj(), fromjson("{a: 1}"), BSONObj(), 2, 3);
     assertNumSolutions(1U);
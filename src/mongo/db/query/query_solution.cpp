@@ -1097,6 +1097,10 @@ void SortNode::appendToString(str::stream* ss, int indent) const {
     *ss << "pattern = " << pattern.toString() << '\n';
     addIndent(ss, indent + 1);
     *ss << "limit = " << limit << '\n';
+    if (discardFetchedDocuments) {
+        addIndent(ss, indent + 1);
+        *ss << "discardFetchedDocuments = true\n";
+    }
     addCommon(ss, indent);
     addIndent(ss, indent + 1);
     *ss << "Child:" << '\n';
@@ -1109,6 +1113,7 @@ void SortNode::cloneSortData(SortNode* copy) const {
     copy->pattern = this->pattern;
     copy->limit = this->limit;
     copy->addSortKeyMetadata = this->addSortKeyMetadata;
+    copy->discardFetchedDocuments = this->discardFetchedDocuments;
 }
 
 QuerySolutionNode* SortNodeDefault::clone() const {
@@ -765,10 +765,11 @@ struct SortNode : public QuerySolutionNode {
     virtual void appendToString(str::stream* ss, int indent) const;
 
     bool fetched() const {
-        return children[0]->fetched();
+        return !discardFetchedDocuments && children[0]->fetched();
     }
     FieldAvailability getFieldAvailability(const std::string& field) const {
-        return children[0]->getFieldAvailability(field);
+        return discardFetchedDocuments ? FieldAvailability::kNotProvided
+                                       : children[0]->getFieldAvailability(field);
     }
     bool sortedByDiskLoc() const {
         return false;
@@ -795,6 +796,10 @@ struct SortNode : public QuerySolutionNode {
 
     bool addSortKeyMetadata = false;
 
+    // If true, the sort keeps only the sort key and the record id of each input document, and a
+    // FETCH above it must retrieve the documents again. Only supported by SortNodeDefault.
+    bool discardFetchedDocuments = false;
+
 protected:
     void cloneSortData(SortNode* copy) const;
 
@@ -132,6 +132,7 @@ std::unique_ptr<PlanStage> buildStages(OperationContext* opCtx,
                 snDefault->limit,
                 internalQueryMaxBlockingSortMemoryUsageBytes.load(),
                 snDefault->addSortKeyMetadata,
+                snDefault->discardFetchedDocuments,
                 std::move(childStage));
         }
         case STAGE_SORT_SIMPLE: {
@@ -44,10 +44,12 @@
 #include "mongo/db/repl/speculative_majority_read_info.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/stats/server_read_concern_metrics.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/grid.h"
 #include "mongo/util/concurrency/notification.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -342,7 +344,12 @@ Status waitForReadConcernImpl(OperationContext* opCtx,
         }
 
         if (replCoord->isReplEnabled() || !afterClusterTime) {
+            Timer waitTimer;
             auto status = replCoord->waitUntilOpTimeForRead(opCtx, readConcernArgs);
+            if (targetClusterTime || readConcernArgs.getArgsOpTime()) {
+                ServerReadConcernMetrics::get(opCtx)->recordOpTimeWait(readConcernArgs,
+                                                                       waitTimer.micros());
+            }
             if (!status.isOK()) {
                 return status;
             }
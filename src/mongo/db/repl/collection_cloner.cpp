@@ -31,7 +31,11 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/repl/collection_bulk_loader.h"
@@ -40,6 +44,8 @@
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/wire_version.h"
 #include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -53,6 +59,11 @@ MONGO_FAIL_POINT_DEFINE(initialSyncHangDuringCollectionClone);
 // DBClientConnection, optionally limited to a specific collection.
 MONGO_FAIL_POINT_DEFINE(initialSyncHangCollectionClonerAfterHandlingBatchResponse);
 
+namespace {
+// The number of $sample documents per range used to estimate the range boundaries.
+const int kRangeSamplesPerRange = 20;
+}  // namespace
+
 CollectionCloner::CollectionCloner(const NamespaceString& sourceNss,
                                    const CollectionOptions& collectionOptions,
                                    InitialSyncSharedData* sharedData,
@@ -200,7 +211,16 @@ BaseCloner::AfterStageBehavior CollectionCloner::createCollectionStage() {
 }
 
 BaseCloner::AfterStageBehavior CollectionCloner::queryStage() {
-    runQuery();
+    // Choose how to clone the collection only once, so a retried query never switches between a
+    // single query and range queries after some documents have been copied.
+    if (!_rangeBoundaries) {
+        _rangeBoundaries = sampleRangeBoundaries();
+    }
+    if (_rangeBoundaries->empty()) {
+        runQuery();
+    } else {
+        runRangeQueries(*_rangeBoundaries);
+    }
     waitForDatabaseWorkToComplete();
     // We want to free the _collLoader regardless of whether the commit succeeds.
     std::unique_ptr<CollectionBulkLoader> loader = std::move(_collLoader);
@@ -280,18 +300,179 @@ void CollectionCloner::runQuery() {
     }
 }
 
-void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
+std::vector<BSONObj> CollectionCloner::sampleRangeBoundaries() {
+    const int numRanges = collectionClonerNumRanges;
     {
-        stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
-        if (!getSharedData()->getInitialSyncStatus(lk).isOK()) {
-            static constexpr char message[] =
-                "Collection cloning cancelled due to initial sync failure";
-            LOGV2(21136, message, "error"_attr = getSharedData()->getInitialSyncStatus(lk));
-            uasserted(ErrorCodes::CallbackCanceled,
-                      str::stream()
-                          << message << ": " << getSharedData()->getInitialSyncStatus(lk));
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (numRanges <= 1 ||
+            _stats.documentToCopy < static_cast<size_t>(collectionClonerRangeMinDocuments)) {
+            return {};
         }
     }
+    // Range boundaries are compared with the simple collation, and capped collections must be
+    // cloned in natural order.
+    if (_idIndexSpec.isEmpty() || _collectionOptions.capped ||
+        !_collectionOptions.collation.isEmpty()) {
+        return {};
+    }
+
+    const int sampleSize = numRanges * kRangeSamplesPerRange;
+    std::vector<BSONObj> samples;
+    try {
+        BSONObj res;
+        getClient()->runCommand(
+            _sourceNss.db().toString(),
+            BSON("aggregate" << _sourceNss.coll() << "pipeline"
+                             << BSON_ARRAY(BSON("$sample" << BSON("size" << sampleSize))
+                                           << BSON("$project" << BSON("_id" << 1)))
+                             << "cursor" << BSON("batchSize" << sampleSize)),
+            res,
+            QueryOption_SlaveOk);
+        uassertStatusOK(getStatusFromCommandResult(res));
+        for (auto&& doc : res["cursor"]["firstBatch"].Array()) {
+            samples.push_back(BSON("_id" << doc["_id"]));
+        }
+    } catch (const DBException& ex) {
+        LOGV2(5100016,
+              "Failed to sample collection for range cloning, cloning it with a single query",
+              "namespace"_attr = _sourceNss,
+              "error"_attr = ex.toStatus());
+        return {};
+    }
+
+    const auto& comparator = SimpleBSONObjComparator::kInstance;
+    std::sort(samples.begin(), samples.end(), comparator.makeLessThan());
+    samples.erase(std::unique(samples.begin(), samples.end(), comparator.makeEqualTo()),
+                  samples.end());
+    if (samples.size() < static_cast<size_t>(numRanges)) {
+        return {};
+    }
+
+    std::vector<BSONObj> boundaries;
+    for (int i = 1; i < numRanges; ++i) {
+        auto& boundary = samples[i * samples.size() / numRanges];
+        if (boundaries.empty() || comparator.evaluate(boundaries.back() != boundary)) {
+            boundaries.push_back(boundary);
+        }
+    }
+    return boundaries;
+}
+
+void CollectionCloner::runRangeQueries(const std::vector<BSONObj>& boundaries) {
+    const size_t numRanges = boundaries.size() + 1;
+    std::vector<Query> queries;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stats.ranges.assign(numRanges, {});
+        for (size_t i = 0; i < numRanges; ++i) {
+            Query query = QUERY("query" << BSONObj() << "$readOnce" << true);
+            query.hint(BSON("_id" << 1));
+            if (i > 0) {
+                query.minKey(boundaries[i - 1]);
+                _stats.ranges[i].min = boundaries[i - 1];
+            }
+            if (i < numRanges - 1) {
+                query.maxKey(boundaries[i]);
+                _stats.ranges[i].max = boundaries[i];
+            }
+            queries.push_back(std::move(query));
+        }
+    }
+    LOGV2(5100017,
+          "Collection cloner will fetch the collection in parallel ranges",
+          "namespace"_attr = _sourceNss,
+          "numRanges"_attr = numRanges);
+
+    Status firstError = Status::OK();
+    std::vector<stdx::thread> fetchers;
+    for (size_t i = 0; i < numRanges; ++i) {
+        fetchers.emplace_back([this, i, &queries, &firstError] {
+            Client::initThread("CollectionClonerRangeFetcher");
+            try {
+                auto conn = std::make_unique<DBClientConnection>(true /* autoReconnect */);
+                uassertStatusOK(conn->connect(getSource(), StringData()));
+                uassertStatusOK(replAuthenticate(conn.get())
+                                    .withContext(str::stream()
+                                                 << "Failed to authenticate to " << getSource()));
+                conn->query(
+                    [this, i](DBClientCursorBatchIterator& iter) { handleNextRangeBatch(i, iter); },
+                    _sourceDbAndUuid,
+                    queries[i],
+                    nullptr /* fieldsToReturn */,
+                    QueryOption_NoCursorTimeout | QueryOption_SlaveOk |
+                        (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
+                    _collectionClonerBatchSize,
+                    ReadConcernArgs::kImplicitDefault);
+            } catch (const DBException& ex) {
+                _rangeCloneFailed.store(true);
+                stdx::lock_guard<Latch> lk(_mutex);
+                if (firstError.isOK()) {
+                    firstError = ex.toStatus();
+                }
+            }
+        });
+    }
+    for (auto&& fetcher : fetchers) {
+        fetcher.join();
+    }
+
+    if (firstError.isOK()) {
+        return;
+    }
+    // If the collection was dropped at any point, we can just move on to the next cloner.
+    if (firstError == ErrorCodes::NamespaceNotFound) {
+        uassertStatusOK(firstError);
+    }
+    LOGV2(5100018,
+          "Error during range clone",
+          "namespace"_attr = _sourceNss,
+          "error"_attr = firstError);
+    uasserted(ErrorCodes::InitialSyncFailure,
+              str::stream() << "Collection range clone failed and is not resumable. nss: "
+                            << _sourceNss << ": " << firstError);
+}
+
+void CollectionCloner::handleNextRangeBatch(size_t rangeIndex,
+                                            DBClientCursorBatchIterator& iter) {
+    checkForInitialSyncFailure();
+    if (_rangeCloneFailed.load()) {
+        uasserted(ErrorCodes::CallbackCanceled, "Another range of the collection clone failed");
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stats.receivedBatches++;
+        auto& rangeStats = _stats.ranges[rangeIndex];
+        rangeStats.receivedBatches++;
+        while (iter.moreInCurrentBatch()) {
+            _documentsToInsert.emplace_back(iter.nextSafe());
+            rangeStats.documentsFetched++;
+        }
+    }
+
+    // Schedule the next document batch insertion.  The database work threads insert the batches
+    // of all ranges one at a time.
+    auto&& scheduleResult = _scheduleDbWorkFn(
+        [=](const executor::TaskExecutor::CallbackArgs& cbd) { insertDocumentsCallback(cbd); });
+    if (!scheduleResult.isOK()) {
+        uassertStatusOK(scheduleResult.getStatus().withContext(
+            str::stream() << "Error cloning collection '" << _sourceNss.ns() << "'"));
+    }
+}
+
+void CollectionCloner::checkForInitialSyncFailure() {
+    stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
+    if (!getSharedData()->getInitialSyncStatus(lk).isOK()) {
+        static constexpr char message[] =
+            "Collection cloning cancelled due to initial sync failure";
+        LOGV2(21136, message, "error"_attr = getSharedData()->getInitialSyncStatus(lk));
+        uasserted(ErrorCodes::CallbackCanceled,
+                  str::stream() << message << ": " << getSharedData()->getInitialSyncStatus(lk));
+    }
+}
+
+void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
+    checkForInitialSyncFailure();
 
     // If this is 'true', it means that something happened to our remote cursor for a reason other
     // than the collection being dropped, all while we were running a non-resumable (4.2) clone.
@@ -445,6 +626,20 @@ void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
         }
     }
     builder->appendNumber("receivedBatches", receivedBatches);
+    if (!ranges.empty()) {
+        BSONArrayBuilder rangesBuilder(builder->subarrayStart("ranges"));
+        for (auto&& range : ranges) {
+            BSONObjBuilder rangeBuilder(rangesBuilder.subobjStart());
+            if (!range.min.isEmpty()) {
+                rangeBuilder.append("min", range.min);
+            }
+            if (!range.max.isEmpty()) {
+                rangeBuilder.append("max", range.max);
+            }
+            rangeBuilder.appendNumber("documentsFetched", range.documentsFetched);
+            rangeBuilder.appendNumber("receivedBatches", range.receivedBatches);
+        }
+    }
 }
 
 }  // namespace repl
@@ -29,11 +29,13 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <memory>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
 #include "mongo/db/repl/task_runner.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/progress_meter.h"
 
 namespace mongo {
@@ -59,6 +61,15 @@ public:
         size_t fetchedBatches{0};  // This is actually inserted batches.
         size_t receivedBatches{0};
 
+        // Progress of each _id range, when the collection is cloned in parallel ranges.
+        struct RangeStats {
+            BSONObj min;
+            BSONObj max;
+            size_t documentsFetched{0};
+            size_t receivedBatches{0};
+        };
+        std::vector<RangeStats> ranges;
+
         std::string toString() const;
         BSONObj toBSON() const;
         void append(BSONObjBuilder* builder) const;
@@ -216,6 +227,30 @@ private:
      */
     void runQuery();
 
+    /**
+     * Throws CallbackCanceled if initial sync has already failed.
+     */
+    void checkForInitialSyncFailure();
+
+    /**
+     * Returns the _id values splitting the collection into 'collectionClonerNumRanges' ranges of
+     * roughly equal document counts, as estimated from a $sample of the collection on the sync
+     * source.  Returns an empty vector if the collection should be cloned with a single query.
+     */
+    std::vector<BSONObj> sampleRangeBoundaries();
+
+    /**
+     * Fetches each range delimited by 'boundaries' over its own connection to the sync source,
+     * in parallel.  Documents are handed to the database work threads like in runQuery().  Range
+     * queries are not resumable, so any error other than NamespaceNotFound fails the clone.
+     */
+    void runRangeQueries(const std::vector<BSONObj>& boundaries);
+
+    /**
+     * Like handleNextBatch, for a batch from the query fetching range 'rangeIndex'.
+     */
+    void handleNextRangeBatch(size_t rangeIndex, DBClientCursorBatchIterator& iter);
+
     /**
      * Used to terminate the clone when we encounter a fatal error during a non-resumable query.
      * Throws.
@@ -270,6 +305,13 @@ private:
     // Signifies that there were changes to the collection on the sync source that resulted in
     // our remote cursor getting killed.
     bool _lostNonResumableCursor = false;  // (X)
+
+    // The _id range boundaries chosen by the first attempt of the query stage.  An empty vector
+    // means the collection is cloned with a single, possibly resumable, query.
+    boost::optional<std::vector<BSONObj>> _rangeBoundaries;  // (X)
+
+    // Set once any range query fails, so the other range queries stop early.
+    AtomicWord<bool> _rangeCloneFailed{false};  // (S)
 };
 
 }  // namespace repl
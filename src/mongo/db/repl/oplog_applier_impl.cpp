@@ -32,6 +32,8 @@
 
 #include "mongo/db/repl/oplog_applier_impl.h"
 
+#include <queue>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database.h"
@@ -276,6 +278,9 @@ void _addOplogChainOpsToWriterVectors(OperationContext* opCtx,
     addDerivedOps(opCtx, &derivedOps->back(), writerVectors, collPropertiesCache, shouldSerialize);
 }
 
+// When balancing writer load, ops are first hashed into this many buckets per writer thread.
+constexpr size_t kWriterBucketsPerThread = 8;
+
 void stableSortByNamespace(std::vector<const OplogEntry*>* oplogEntryPointers) {
     auto nssComparator = [](const OplogEntry* l, const OplogEntry* r) {
         return l->getNss() < r->getNss();
@@ -627,6 +632,7 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
     oplogApplicationBatchSize.increment(ops.size());
 
     std::vector<WorkerMultikeyPathInfo> multikeyVector(_writerPool->getStats().numThreads);
+    Timer batchApplyTimer;
     {
         // Each node records cumulative batch application stats for itself using this timer.
         TimerHolder timer(&applyBatchStats);
@@ -703,6 +709,7 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
             }
 
             _writerPool->waitForIdle();
+            _oplogBatcher->recordBatchApplied(ops.size(), Microseconds(batchApplyTimer.micros()));
 
             // If any of the statuses is not ok, return error.
             for (auto it = statusVector.cbegin(); it != statusVector.cend(); ++it) {
@@ -890,14 +897,57 @@ void OplogApplierImpl::fillWriterVectors(
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     std::vector<std::vector<OplogEntry>>* derivedOps) noexcept {
 
+    // When balancing writer load, hash the ops into several buckets per writer and then spread
+    // the buckets over the writers by size, so that unrelated ops whose hashes collide on one
+    // writer no longer leave the others idle.
+    const bool balanceWriterLoad = replBalanceWriterLoad.load() && writerVectors->size() > 1;
+    std::vector<std::vector<const OplogEntry*>> buckets;
+    if (balanceWriterLoad) {
+        buckets.resize(writerVectors->size() * kWriterBucketsPerThread);
+    }
+    auto* targets = balanceWriterLoad ? &buckets : writerVectors;
+
     SessionUpdateTracker sessionUpdateTracker;
-    _deriveOpsAndFillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker);
+    _deriveOpsAndFillWriterVectors(opCtx, ops, targets, derivedOps, &sessionUpdateTracker);
 
     auto newOplogWrites = sessionUpdateTracker.flushAll();
     if (!newOplogWrites.empty()) {
         derivedOps->emplace_back(std::move(newOplogWrites));
-        _deriveOpsAndFillWriterVectors(
-            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+        _deriveOpsAndFillWriterVectors(opCtx, &derivedOps->back(), targets, derivedOps, nullptr);
+    }
+
+    if (balanceWriterLoad) {
+        assignBucketsToWriterVectors(&buckets, writerVectors);
+    }
+}
+
+void assignBucketsToWriterVectors(std::vector<std::vector<const OplogEntry*>>* buckets,
+                                  std::vector<std::vector<const OplogEntry*>>* writerVectors) {
+    invariant(!writerVectors->empty());
+
+    std::vector<std::vector<const OplogEntry*>*> bySize;
+    bySize.reserve(buckets->size());
+    for (auto& bucket : *buckets) {
+        if (!bucket.empty())
+            bySize.push_back(&bucket);
+    }
+    std::stable_sort(bySize.begin(), bySize.end(), [](const auto* l, const auto* r) {
+        return l->size() > r->size();
+    });
+
+    // Min-heap of (number of ops, writer index).
+    using WriterLoad = std::pair<size_t, size_t>;
+    std::priority_queue<WriterLoad, std::vector<WriterLoad>, std::greater<WriterLoad>> writers;
+    for (size_t i = 0; i < writerVectors->size(); i++) {
+        writers.emplace((*writerVectors)[i].size(), i);
+    }
+
+    for (auto* bucket : bySize) {
+        auto [load, writerIndex] = writers.top();
+        writers.pop();
+        auto& writer = (*writerVectors)[writerIndex];
+        writer.insert(writer.end(), bucket->begin(), bucket->end());
+        writers.emplace(load + bucket->size(), writerIndex);
     }
 }
 
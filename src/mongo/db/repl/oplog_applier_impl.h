@@ -146,5 +146,13 @@ Status applyOplogEntryOrGroupedInserts(OperationContext* opCtx,
                                        const OplogEntryOrGroupedInserts& entryOrGroupedInserts,
                                        OplogApplication::Mode oplogApplicationMode);
 
+/**
+ * Appends the ops of each bucket to the writer vector holding the fewest ops so far, assigning the
+ * largest buckets first. The ops of a bucket stay together and in order, so ops hashed into buckets
+ * by namespace and _id are still applied in order by a single writer.
+ */
+void assignBucketsToWriterVectors(std::vector<std::vector<const OplogEntry*>>* buckets,
+                                  std::vector<std::vector<const OplogEntry*>>* writerVectors);
+
 }  // namespace repl
 }  // namespace mongo
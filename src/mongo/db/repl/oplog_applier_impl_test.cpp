@@ -212,6 +212,39 @@ typedef SetSteadyStateConstraints<OplogApplierImplTest, false>
 typedef SetSteadyStateConstraints<OplogApplierImplTest, true>
     OplogApplierImplTestEnableSteadyStateConstraints;
 
+TEST(AssignBucketsToWriterVectorsTest, BucketsAreBalancedAndKeptInOrder) {
+    NamespaceString nss("test.t");
+    std::vector<OplogEntry> entries;
+    for (int i = 0; i < 12; i++) {
+        entries.push_back(makeOplogEntry(OpTypeEnum::kInsert, nss, {}, BSON("_id" << i), {}));
+    }
+
+    // Bucket sizes 5, 1, 1, 1 and 4, with ops taken from 'entries' in order.
+    std::vector<std::vector<const OplogEntry*>> buckets(6);
+    const std::vector<size_t> bucketSizes{5, 1, 1, 1, 4, 0};
+    size_t next = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        for (size_t j = 0; j < bucketSizes[i]; j++) {
+            buckets[i].push_back(&entries[next++]);
+        }
+    }
+
+    std::vector<std::vector<const OplogEntry*>> writerVectors(2);
+    assignBucketsToWriterVectors(&buckets, &writerVectors);
+
+    ASSERT_EQ(6U, writerVectors[0].size());
+    ASSERT_EQ(6U, writerVectors[1].size());
+
+    // The largest bucket goes to the first writer, followed by a single-op bucket.
+    for (size_t i = 0; i < 5; i++) {
+        ASSERT_EQ(&entries[i], writerVectors[0][i]);
+    }
+    // The second largest bucket goes to the second writer, with its ops still in order.
+    for (size_t i = 0; i < 4; i++) {
+        ASSERT_EQ(&entries[8 + i], writerVectors[1][i]);
+    }
+}
+
 TEST_F(OplogApplierImplTest, applyOplogEntryOrGroupedInsertsInsertDocumentDatabaseMissing) {
     NamespaceString nss("test.t");
     auto op = makeOplogEntry(OpTypeEnum::kInsert, nss, {});
@@ -509,6 +509,38 @@ TEST_F(OplogApplierTest, LastOpInLargeTransactionIsProcessedIndividually) {
     ASSERT_EQUALS(srcOps[4], batch[0]);
 }
 
+TEST(OplogBatchSizeControllerTest, UsesMaximumUntilEnabledAndMeasured) {
+    OplogBatchSizeController controller;
+    ASSERT_EQUALS(5000U, controller.getBatchLimitOps(5000, Milliseconds(100), 0));
+
+    controller.recordBatchApplied(1000, Milliseconds(100));
+    ASSERT_EQUALS(5000U, controller.getBatchLimitOps(5000, Milliseconds(0), 0));
+}
+
+TEST(OplogBatchSizeControllerTest, SizesBatchesToTheTargetApplyTime) {
+    OplogBatchSizeController controller;
+    // 100 microseconds per operation.
+    controller.recordBatchApplied(1000, Milliseconds(100));
+    ASSERT_EQUALS(500U, controller.getBatchLimitOps(5000, Milliseconds(50), 0));
+
+    // Never below the minimum nor above the maximum.
+    ASSERT_EQUALS(OplogBatchSizeController::kMinBatchLimitOps,
+                  controller.getBatchLimitOps(5000, Milliseconds(1), 0));
+    ASSERT_EQUALS(300U, controller.getBatchLimitOps(300, Milliseconds(50), 0));
+
+    // Slower batches shrink the next ones.
+    controller.recordBatchApplied(1000, Milliseconds(600));
+    ASSERT_EQUALS(200.0, controller.getMicrosPerOp());
+    ASSERT_EQUALS(250U, controller.getBatchLimitOps(5000, Milliseconds(50), 0));
+}
+
+TEST(OplogBatchSizeControllerTest, DoublesBatchesWhenLagging) {
+    OplogBatchSizeController controller;
+    controller.recordBatchApplied(1000, Milliseconds(100));
+    ASSERT_EQUALS(500U, controller.getBatchLimitOps(5000, Milliseconds(50), 1999));
+    ASSERT_EQUALS(1000U, controller.getBatchLimitOps(5000, Milliseconds(50), 2000));
+}
+
 }  // namespace
 }  // namespace repl
 }  // namespace mongo
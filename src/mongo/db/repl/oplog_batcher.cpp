@@ -31,7 +31,10 @@
 
 #include "mongo/db/repl/oplog_batcher.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/commands/txn_cmds_gen.h"
 #include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
@@ -41,6 +44,87 @@ namespace mongo {
 namespace repl {
 MONGO_FAIL_POINT_DEFINE(skipOplogBatcherWaitForData);
 
+namespace {
+// The weight of the latest batch in the moving average of the per-operation apply time.
+const double kMicrosPerOpSmoothing = 0.2;
+
+/**
+ * Reports the decisions of the OplogBatchSizeController in serverStatus.
+ */
+class AdaptiveBatchLimitStats {
+public:
+    void record(std::size_t limitOps, double microsPerOp, bool increased, bool decreased) {
+        _limitOps.store(limitOps);
+        _microsPerOp.store(static_cast<long long>(microsPerOp));
+        if (increased) {
+            _increases.increment();
+        }
+        if (decreased) {
+            _decreases.increment();
+        }
+    }
+
+    BSONObj getReport() const {
+        BSONObjBuilder b;
+        b.append("limitOps", _limitOps.load());
+        b.append("microsPerOp", _microsPerOp.load());
+        b.append("increases", _increases.get());
+        b.append("decreases", _decreases.get());
+        return b.obj();
+    }
+    operator BSONObj() const {
+        return getReport();
+    }
+
+private:
+    AtomicWord<long long> _limitOps{0};
+    AtomicWord<long long> _microsPerOp{0};
+    Counter64 _increases;
+    Counter64 _decreases;
+};
+
+AdaptiveBatchLimitStats adaptiveBatchLimitStats;
+ServerStatusMetricField<AdaptiveBatchLimitStats> displayAdaptiveBatchLimit(
+    "repl.apply.adaptiveBatchLimit", &adaptiveBatchLimitStats);
+}  // namespace
+
+void OplogBatchSizeController::recordBatchApplied(std::size_t numOps, Microseconds elapsed) {
+    if (numOps == 0) {
+        return;
+    }
+    const double microsPerOp = static_cast<double>(durationCount<Microseconds>(elapsed)) / numOps;
+    stdx::lock_guard<Latch> lk(_mutex);
+    _microsPerOp = _microsPerOp == 0
+        ? microsPerOp
+        : kMicrosPerOpSmoothing * microsPerOp + (1 - kMicrosPerOpSmoothing) * _microsPerOp;
+}
+
+std::size_t OplogBatchSizeController::getBatchLimitOps(std::size_t maxOps,
+                                                       Milliseconds target,
+                                                       std::size_t bufferedOps) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (target <= Milliseconds(0) || _microsPerOp <= 0) {
+        return maxOps;
+    }
+
+    const double targetMicros = durationCount<Microseconds>(target);
+    auto limit = static_cast<std::size_t>(std::min(targetMicros / _microsPerOp, double(maxOps)));
+    if (bufferedOps >= kLaggingBufferedBatches * limit) {
+        limit *= 2;
+    }
+    limit = std::min(std::max(limit, kMinBatchLimitOps), maxOps);
+
+    adaptiveBatchLimitStats.record(
+        limit, _microsPerOp, _lastLimit && limit > _lastLimit, limit < _lastLimit);
+    _lastLimit = limit;
+    return limit;
+}
+
+double OplogBatchSizeController::getMicrosPerOp() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _microsPerOp;
+}
+
 OplogBatcher::OplogBatcher(OplogApplier* oplogApplier, OplogBuffer* oplogBuffer)
     : _oplogApplier(oplogApplier), _oplogBuffer(oplogBuffer), _ops(0) {}
 OplogBatcher::~OplogBatcher() {
@@ -277,7 +361,10 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
         batchLimits.slaveDelayLatestTimestamp = _calculateSlaveDelayLatestTimestamp();
 
         // Check the limits once per batch since users can change them at runtime.
-        batchLimits.ops = getBatchLimitOplogEntries();
+        batchLimits.ops = _batchSizeController.getBatchLimitOps(
+            getBatchLimitOplogEntries(),
+            Milliseconds(replBatchTargetApplyMillis.load()),
+            _oplogBuffer->getCount());
 
         // Use the OplogBuffer to populate a local OplogBatch. Note that the buffer may be empty.
         OplogBatch ops(batchLimits.ops);
@@ -32,7 +32,9 @@
 #include "mongo/db/repl/oplog_buffer.h"
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/storage_interface.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/invariant.h"
 
@@ -111,6 +113,46 @@ private:
     boost::optional<long long> _termWhenExhausted;
 };
 
+/**
+ * Chooses the number of operations in each oplog batch so that applying a batch takes about a
+ * target time. Small batches waste the per-batch barrier overhead, while large batches delay
+ * when secondary reads see new writes.
+ *
+ * The controller keeps a moving average of the time applying one operation took in recent
+ * batches and sizes the next batch to fit the target. When the oplog buffer holds several
+ * batches worth of operations, the node is lagging and the batch size is doubled to catch up.
+ */
+class OplogBatchSizeController {
+public:
+    // The smallest batch size the controller chooses, so barriers stay amortized.
+    static constexpr std::size_t kMinBatchLimitOps = 100;
+
+    // The buffer depth, in batches, from which the node is considered to be lagging.
+    static constexpr std::size_t kLaggingBufferedBatches = 4;
+
+    /**
+     * Records that applying a batch of 'numOps' operations took 'elapsed'.
+     */
+    void recordBatchApplied(std::size_t numOps, Microseconds elapsed);
+
+    /**
+     * Returns the operation limit for the next batch, at most 'maxOps'. Returns 'maxOps' when
+     * 'target' is not positive or no batch has been recorded yet.
+     */
+    std::size_t getBatchLimitOps(std::size_t maxOps, Milliseconds target, std::size_t bufferedOps);
+
+    /**
+     * Returns the moving average of the time applying one operation took, in microseconds.
+     */
+    double getMicrosPerOp() const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogBatchSizeController::_mutex");
+    // Zero until the first batch is recorded.
+    double _microsPerOp = 0;
+    std::size_t _lastLimit = 0;
+};
+
 /**
  * Consumes batches of oplog entries from the OplogBuffer to give to the oplog applier, freeing
  * up space for more operations to be fetched from a sync source and allocated onto the OplogBuffer.
@@ -173,6 +215,14 @@ public:
     StatusWith<std::vector<OplogEntry>> getNextApplierBatch(OperationContext* opCtx,
                                                             const BatchLimits& batchLimits);
 
+    /**
+     * Feeds the time applying a batch took to the controller sizing the batches returned by
+     * getNextBatch().
+     */
+    void recordBatchApplied(std::size_t numOps, Microseconds elapsed) {
+        _batchSizeController.recordBatchApplied(numOps, elapsed);
+    }
+
 private:
     /**
      * If slaveDelay is enabled, this function calculates the most recent timestamp of any oplog
@@ -199,6 +249,8 @@ private:
     OplogBatch _ops;
 
     std::unique_ptr<stdx::thread> _thread;
+
+    OplogBatchSizeController _batchSizeController;
 };
 
 /**
@@ -318,8 +318,14 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
       _oplogFetcherRestartDecision(std::move(oplogFetcherRestartDecision)),
       _onShutdownCallbackFn(onShutdownCallbackFn),
       _lastFetched(lastFetched),
-      _createClientFn(
-          [] { return std::make_unique<DBClientConnection>(true /* autoReconnect */); }),
+      _createClientFn([] {
+          auto conn = std::make_unique<DBClientConnection>(true /* autoReconnect */);
+          if (!oplogFetcherPreferredCompressor.empty()) {
+              conn->getCompressorManager().setPreferredCompressors(
+                  {oplogFetcherPreferredCompressor});
+          }
+          return conn;
+      }),
       _requireFresherSyncSource(requireFresherSyncSource),
       _dataReplicatorExternalState(dataReplicatorExternalState),
       _enqueueDocumentsFn(enqueueDocumentsFn),
@@ -690,6 +696,9 @@ StatusWith<OplogFetcher::Documents> OplogFetcher::_getNextBatch() {
             _cursor->more();
         }
 
+        // The documents share ownership of the reply message buffer, so they are not copied
+        // here or when they are pushed into the oplog buffer.
+        batch.reserve(_cursor->objsLeftInBatch());
         while (_cursor->moreInCurrentBatch()) {
             batch.emplace_back(_cursor->nextSafe());
         }
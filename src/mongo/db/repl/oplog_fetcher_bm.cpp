@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_entry.h"
+#include "mongo/db/repl/oplog_fetcher.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const int kOpsPerBatch = 1000;
+
+/**
+ * Returns a serialized getMore reply carrying a batch of 'kOpsPerBatch' insert oplog entries,
+ * each with a string payload of 'payloadSize' bytes.
+ */
+Message makeOplogBatchReply(int payloadSize) {
+    const auto uuid = UUID::gen();
+    const std::string payload(payloadSize, 'x');
+    std::vector<BSONObj> batch;
+    for (int i = 0; i < kOpsPerBatch; ++i) {
+        batch.push_back(BSON("ts" << Timestamp(1, i + 1) << "t" << 1LL << "v" << 2 << "op"
+                                  << "i"
+                                  << "ns"
+                                  << "test.coll"
+                                  << "ui" << uuid << "wall" << Date_t() << "o"
+                                  << BSON("_id" << i << "payload" << payload)));
+    }
+    CursorResponse response(NamespaceString("local.oplog.rs"), 1 /* cursorId */, std::move(batch));
+
+    OpMsg msg;
+    msg.body = response.toBSON(CursorResponse::ResponseType::SubsequentResponse);
+    return msg.serialize();
+}
+
+/**
+ * Measures one oplog batch going from a received reply message to OplogEntries ready for the
+ * applier: the cursor reply parsing done by DBClientCursor, OplogFetcher validation, the
+ * OplogBufferBlockingQueue and the OplogEntry parsing done by the OplogBatcher.
+ */
+void BM_OplogFetcherBatchToApplierEntries(benchmark::State& state) {
+    const auto reply = makeOplogBatchReply(state.range(0));
+    OplogBufferBlockingQueue buffer;
+    buffer.startup(nullptr);
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        auto opMsg = OpMsg::parseOwned(reply);
+        auto cursorResponse = uassertStatusOK(CursorResponse::parseFromBSON(opMsg.body));
+        auto documents = cursorResponse.releaseBatch();
+
+        auto info = uassertStatusOK(OplogFetcher::validateDocuments(
+            documents, false /* first */, Timestamp(), OplogFetcher::StartingPoint::kSkipFirstDoc));
+        bytes += info.networkDocumentBytes;
+        buffer.push(nullptr, documents.cbegin(), documents.cend());
+
+        BSONObj op;
+        while (buffer.peek(nullptr, &op)) {
+            benchmark::DoNotOptimize(OplogEntry(op));
+            invariant(buffer.tryPop(nullptr, &op));
+        }
+    }
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.iterations() * kOpsPerBatch);
+}
+
+BENCHMARK(BM_OplogFetcherBatchToApplierEntries)->Arg(16)->Arg(256)->Arg(4096);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
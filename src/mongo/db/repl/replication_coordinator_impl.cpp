@@ -205,22 +205,51 @@ StatusOrStatusWith<T> futureGetNoThrowWithDeadline(OperationContext* opCtx,
 
 }  // namespace
 
+boost::optional<ReplicationCoordinatorImpl::WaiterList::ReplicationCondition>
+ReplicationCoordinatorImpl::WaiterList::_getCondition(const Waiter& waiter) {
+    if (!waiter.writeConcern) {
+        return boost::none;
+    }
+    const auto& wc = *waiter.writeConcern;
+    return std::make_tuple(wc.wMode, wc.wNumNodes, wc.syncMode, wc.checkCondition);
+}
+
+void ReplicationCoordinatorImpl::WaiterList::_emplace_inlock(const OpTime& opTime,
+                                                             SharedWaiterHandle waiter) {
+    if (auto condition = _getCondition(*waiter)) {
+        ++_conditionCounts[*condition];
+    }
+    _waiters.emplace(opTime, std::move(waiter));
+}
+
+ReplicationCoordinatorImpl::WaiterList::WaiterMap::iterator
+ReplicationCoordinatorImpl::WaiterList::_erase_inlock(WaiterMap::iterator it) {
+    if (auto condition = _getCondition(*it->second)) {
+        auto countIt = _conditionCounts.find(*condition);
+        invariant(countIt != _conditionCounts.end());
+        if (--countIt->second == 0) {
+            _conditionCounts.erase(countIt);
+        }
+    }
+    return _waiters.erase(it);
+}
+
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(const OpTime& opTime,
                                                         SharedWaiterHandle waiter) {
-    _waiters.emplace(opTime, std::move(waiter));
+    _emplace_inlock(opTime, std::move(waiter));
 }
 
 SharedSemiFuture<void> ReplicationCoordinatorImpl::WaiterList::add_inlock(
     const OpTime& opTime, boost::optional<WriteConcernOptions> wc) {
     auto pf = makePromiseFuture<void>();
-    _waiters.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
+    _emplace_inlock(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
     return std::move(pf.future);
 }
 
 bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle waiter) {
     for (auto iter = _waiters.begin(); iter != _waiters.end(); iter++) {
         if (iter->second == waiter) {
-            _waiters.erase(iter);
+            _erase_inlock(iter);
             return true;
         }
     }
@@ -235,13 +264,44 @@ void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
         try {
             if (func(it->first, waiter)) {
                 waiter->promise.emplaceValue();
-                it = _waiters.erase(it);
+                it = _erase_inlock(it);
+            } else {
+                ++it;
+            }
+        } catch (const DBException& e) {
+            waiter->promise.setError(e.toStatus());
+            it = _erase_inlock(it);
+        }
+    }
+}
+
+template <typename Func>
+void ReplicationCoordinatorImpl::WaiterList::setValueIfMonotonic_inlock(
+    Func&& func, boost::optional<OpTime> opTime) {
+    std::vector<ReplicationCondition> unsatisfied;
+    for (auto it = _waiters.begin(); it != _waiters.end() && (!opTime || it->first <= *opTime);) {
+        if (unsatisfied.size() == _conditionCounts.size()) {
+            // No waiter left in the list can be satisfied.
+            break;
+        }
+        const auto waiter = it->second;
+        const auto condition = _getCondition(*waiter);
+        invariant(condition);
+        if (std::find(unsatisfied.begin(), unsatisfied.end(), *condition) != unsatisfied.end()) {
+            ++it;
+            continue;
+        }
+        try {
+            if (func(it->first, waiter)) {
+                it = _erase_inlock(it);
+                waiter->promise.emplaceValue();
             } else {
+                unsatisfied.push_back(*condition);
                 ++it;
             }
         } catch (const DBException& e) {
+            it = _erase_inlock(it);
             waiter->promise.setError(e.toStatus());
-            it = _waiters.erase(it);
         }
     }
 }
@@ -251,6 +311,7 @@ void ReplicationCoordinatorImpl::WaiterList::setValueAll_inlock() {
         waiter->promise.emplaceValue();
     }
     _waiters.clear();
+    _conditionCounts.clear();
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
@@ -259,6 +320,7 @@ void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
         waiter->promise.setError(status);
     }
     _waiters.clear();
+    _conditionCounts.clear();
 }
 
 namespace {
@@ -4239,7 +4301,9 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
-    _replicationWaiterList.setValueIf_inlock(
+    // Whether a write concern is satisfied at an opTime only depends on how far the members and
+    // the committed snapshot have replicated, so it is monotonic in the opTime.
+    _replicationWaiterList.setValueIfMonotonic_inlock(
         [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
             return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
@@ -31,6 +31,7 @@
 
 #include <map>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -659,14 +660,34 @@ private:
         // condition in func.
         template <typename Func>
         void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+        // Like setValueIf_inlock, for write concern waiters and a 'func' that is monotonic in the
+        // opTime: once it returns false for a waiter, it must also return false for every later
+        // waiter with the same replication condition. Those waiters are skipped without calling
+        // 'func', and the walk stops once every condition in the list has been unsatisfied, so
+        // only the satisfied waiters plus one waiter per condition are visited.
+        template <typename Func>
+        void setValueIfMonotonic_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
         // Signals all waiters from the list and fulfills promises with OK status.
         void setValueAll_inlock();
         // Signals all waiters from the list and fulfills promises with Error status.
         void setErrorAll_inlock(Status status);
 
     private:
+        using WaiterMap = std::multimap<OpTime, SharedWaiterHandle>;
+        // The parts of a write concern that decide whether it is satisfied at an opTime.
+        using ReplicationCondition = std::tuple<std::string,
+                                                int,
+                                                WriteConcernOptions::SyncMode,
+                                                WriteConcernOptions::CheckCondition>;
+
+        static boost::optional<ReplicationCondition> _getCondition(const Waiter& waiter);
+        void _emplace_inlock(const OpTime& opTime, SharedWaiterHandle waiter);
+        WaiterMap::iterator _erase_inlock(WaiterMap::iterator it);
+
         // Waiters sorted by OpTime.
-        std::multimap<OpTime, SharedWaiterHandle> _waiters;
+        WaiterMap _waiters;
+        // The number of write concern waiters in _waiters with each replication condition.
+        std::map<ReplicationCondition, size_t> _conditionCounts;
     };
 
     typedef std::vector<executor::TaskExecutor::CallbackHandle> HeartbeatHandles;
@@ -1106,6 +1106,85 @@ TEST_F(ReplCoordTest, NodeReturnsOkWhenAWriteConcernWithNoTimeoutHasBeenSatisfie
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, NodeWakesSatisfiedWaitersBehindWaitersWithUnsatisfiedWriteConcerns) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id" << 2)
+                                          << BSON("host"
+                                                  << "node4:12345"
+                                                  << "_id" << 3))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 2);
+    OpTimeWithTermOne time2(100, 3);
+    OpTimeWithTermOne time3(100, 4);
+
+    auto makeWriteConcern = [](int wNumNodes) {
+        WriteConcernOptions writeConcern;
+        writeConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+        writeConcern.wNumNodes = wNumNodes;
+        return writeConcern;
+    };
+
+    // Waiters with different write concerns, interleaved in opTime order.
+    ReplicationAwaiter threeNodesAtTime1(getReplCoord(), getServiceContext());
+    threeNodesAtTime1.setOpTime(time1);
+    threeNodesAtTime1.setWriteConcern(makeWriteConcern(3));
+    ReplicationAwaiter twoNodesAtTime1(getReplCoord(), getServiceContext());
+    twoNodesAtTime1.setOpTime(time1);
+    twoNodesAtTime1.setWriteConcern(makeWriteConcern(2));
+    ReplicationAwaiter fourNodesAtTime2(getReplCoord(), getServiceContext());
+    fourNodesAtTime2.setOpTime(time2);
+    fourNodesAtTime2.setWriteConcern(makeWriteConcern(4));
+    ReplicationAwaiter twoNodesAtTime2(getReplCoord(), getServiceContext());
+    twoNodesAtTime2.setOpTime(time2);
+    twoNodesAtTime2.setWriteConcern(makeWriteConcern(2));
+    ReplicationAwaiter twoNodesAtTime3(getReplCoord(), getServiceContext());
+    twoNodesAtTime3.setOpTime(time3);
+    twoNodesAtTime3.setWriteConcern(makeWriteConcern(2));
+
+    for (auto awaiter : {&threeNodesAtTime1,
+                         &twoNodesAtTime1,
+                         &fourNodesAtTime2,
+                         &twoNodesAtTime2,
+                         &twoNodesAtTime3}) {
+        awaiter->start();
+    }
+
+    // Two nodes have reached time2. The w:2 waiters up to time2 are woken even though the w:3 and
+    // w:4 waiters ahead of them in the list are not satisfied, and the w:2 waiter at time3 is not.
+    replCoordSetMyLastAppliedOpTime(time3, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time3, Date_t() + Seconds(100));
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time2));
+    ASSERT_OK(twoNodesAtTime1.getResult().status);
+    ASSERT_OK(twoNodesAtTime2.getResult().status);
+
+    // A third node at time1 satisfies only the w:3 waiter.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time1));
+    ASSERT_OK(threeNodesAtTime1.getResult().status);
+
+    // The remaining waiters were left unsatisfied by earlier updates but are woken once their
+    // write concerns are satisfied.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time3));
+    ASSERT_OK(twoNodesAtTime3.getResult().status);
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time2));
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 3, time2));
+    ASSERT_OK(fourNodesAtTime2.getResult().status);
+}
+
 TEST_F(ReplCoordTest, NodeReturnsWriteConcernFailedWhenAWriteConcernTimesOutBeforeBeingSatisified) {
     assertStartSuccess(BSON("_id"
                             << "mySet"
@@ -44,6 +44,7 @@
 #include "mongo/db/repl/oplog_applier_impl.h"
 #include "mongo/db/repl/oplog_buffer.h"
 #include "mongo/db/repl/oplog_interface_local.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_consistency_markers_impl.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/transaction_oplog_application.h"
@@ -113,10 +114,12 @@ public:
               "Completed oplog application for recovery",
               "numOpsApplied"_attr = _numOpsApplied,
               "numBatches"_attr = _numBatches,
-              "applyThroughOpTime"_attr = applyThroughOpTime);
+              "applyThroughOpTime"_attr = applyThroughOpTime,
+              "durationMillis"_attr = _timer.millis());
     }
 
 private:
+    Timer _timer;
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
 };
@@ -615,7 +618,11 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
 
     OplogApplier::BatchLimits batchLimits;
     batchLimits.bytes = getBatchLimitOplogBytes(opCtx, _storageInterface);
-    batchLimits.ops = getBatchLimitOplogEntries();
+    // Nothing reads from this node while recovery runs, so the batch boundaries only cost a
+    // writer pool barrier each and may be set larger than during steady state replication.
+    auto recoveryBatchLimitOps = replRecoveryBatchLimitOperations.load();
+    batchLimits.ops = recoveryBatchLimitOps > 0 ? std::size_t(recoveryBatchLimitOps)
+                                                : getBatchLimitOplogEntries();
 
     OpTime applyThroughOpTime;
     std::vector<OplogEntry> batch;
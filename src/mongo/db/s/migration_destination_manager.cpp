@@ -73,6 +73,7 @@
 #include "mongo/util/producer_consumer_queue.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -407,21 +408,28 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    std::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    std::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int numInserterThreads) {
+    invariant(numInserterThreads >= 1);
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    SingleProducerMultiConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = numInserterThreads;
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    SingleProducerMultiConsumerQueue<BSONObj> batches(options);
+
+    // The latest of the optimes written by the inserter threads. Waiting for it to replicate also
+    // waits for all the earlier writes of the other threads.
+    Mutex lastOpMutex = MONGO_MAKE_LATCH("MigrationDestinationManager::cloneDocumentsFromDonor");
     repl::OpTime lastOpApplied;
 
-    stdx::thread inserterThread{[&] {
+    auto insertBatches = [&] {
         Client::initKillableThread("chunkInserter", opCtx->getServiceContext());
 
         auto inserterOpCtx = Client::getCurrent()->makeOperationContext();
         auto consumerGuard = makeGuard([&] {
-            batches.closeConsumerEnd();
-            lastOpApplied = repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
+            auto lastOp = repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
+            stdx::lock_guard<Latch> lk(lastOpMutex);
+            lastOpApplied = std::max(lastOpApplied, lastOp);
         });
 
         try {
@@ -429,24 +437,39 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
                 auto nextBatch = batches.pop(inserterOpCtx.get());
                 auto arr = nextBatch["objects"].Obj();
                 if (arr.isEmpty()) {
+                    // This is the last batch, so wake up any other inserter waiting for one.
+                    batches.closeConsumerEnd();
                     return;
                 }
                 insertBatchFn(inserterOpCtx.get(), arr);
             }
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // Another inserter has either seen the last batch or failed and reported the error.
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueConsumed>&) {
+            // The fetching has stopped, either after the last batch or with an error that the main
+            // thread reports.
         } catch (...) {
+            batches.closeConsumerEnd();
             stdx::lock_guard<Client> lk(*opCtx->getClient());
             opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
             LOGV2(21999,
                   "Batch insertion failed {causedBy_exceptionToStatus}",
                   "causedBy_exceptionToStatus"_attr = causedBy(redact(exceptionToStatus())));
         }
-    }};
+    };
 
+    std::vector<stdx::thread> inserterThreads;
+    inserterThreads.reserve(numInserterThreads);
+    for (int i = 0; i < numInserterThreads; ++i) {
+        inserterThreads.emplace_back(insertBatches);
+    }
 
     {
         auto inserterThreadJoinGuard = makeGuard([&] {
             batches.closeProducerEnd();
-            inserterThread.join();
+            for (auto&& inserterThread : inserterThreads) {
+                inserterThread.join();
+            }
         });
 
         while (true) {
@@ -957,6 +980,9 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
             uassert(50748, "Migration aborted while copying documents", getState() != ABORT);
         };
 
+        // Measures the clone phase, for the statistics and to throttle the inserts.
+        Timer cloneTimer;
+
         auto insertBatchFn = [&](OperationContext* opCtx, BSONObj arr) {
             auto it = arr.begin();
             while (it != arr.end()) {
@@ -990,12 +1016,27 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
                         str::stream() << "Insert of " << insertOp.getDocuments()[i] << " failed.");
                 }
 
+                long long clonedBytes;
                 {
                     stdx::lock_guard<Latch> statsLock(_mutex);
                     _numCloned += batchNumCloned;
                     ShardingStatistics::get(opCtx).countDocsClonedOnRecipient.addAndFetch(
                         batchNumCloned);
+                    ShardingStatistics::get(opCtx).countBytesClonedOnRecipient.addAndFetch(
+                        batchClonedBytes);
                     _clonedBytes += batchClonedBytes;
+                    clonedBytes = _clonedBytes;
+                }
+
+                // Hold back this inserter until the bytes cloned so far, by every inserter, fit
+                // within the configured rate.
+                const long long maxBytesPerSec = migrateCloneMaxBytesPerSec.load();
+                if (maxBytesPerSec > 0) {
+                    const Milliseconds targetElapsed(clonedBytes * 1000 / maxBytesPerSec);
+                    const Milliseconds elapsed(cloneTimer.millis());
+                    if (elapsed < targetElapsed) {
+                        opCtx->sleepFor(targetElapsed - elapsed);
+                    }
                 }
                 if (_writeConcern.needToWaitForOtherNodes()) {
                     repl::ReplicationCoordinator::StatusAndDuration replStatus =
@@ -1036,7 +1077,10 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        lastOpApplied = cloneDocumentsFromDonor(
+            opCtx, insertBatchFn, fetchBatchFn, migrateCloneInserterThreads.load());
+        ShardingStatistics::get(opCtx).totalRecipientChunkCloneTimeMillis.addAndFetch(
+            cloneTimer.millis());
 
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
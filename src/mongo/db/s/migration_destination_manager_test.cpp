@@ -105,6 +105,42 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that every batch is inserted exactly once when several threads insert them.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithMultipleInserters) {
+    const int kNumBatches = 20;
+    int batchesFetched = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+        BSONArrayBuilder arrayBuilder(fetchBatchResultBuilder.subarrayStart("objects"));
+        if (batchesFetched < kNumBatches) {
+            arrayBuilder.append(BSON("_id" << batchesFetched));
+            ++batchesFetched;
+        }
+        arrayBuilder.done();
+        return fetchBatchResultBuilder.obj();
+    };
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<int> insertedIds;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        stdx::lock_guard<Latch> lk(mutex);
+        for (auto&& docToClone : docs) {
+            insertedIds.push_back(docToClone.Obj()["_id"].numberInt());
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 4 /* numInserterThreads */);
+
+    std::sort(insertedIds.begin(), insertedIds.end());
+    ASSERT_EQ(static_cast<size_t>(kNumBatches), insertedIds.size());
+    for (int i = 0; i < kNumBatches; ++i) {
+        ASSERT_EQ(i, insertedIds[i]);
+    }
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
@@ -53,9 +53,11 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/persistent_task_store.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/wait_for_majority_service.h"
 #include "mongo/db/service_context.h"
@@ -77,6 +79,9 @@ MONGO_FAIL_POINT_DEFINE(suspendRangeDeletion);
 MONGO_FAIL_POINT_DEFINE(throwWriteConflictExceptionInDeleteRange);
 MONGO_FAIL_POINT_DEFINE(throwInternalErrorInDeleteRange);
 
+// The initial back-off applied between batches once the majority commit point starts lagging
+const Milliseconds kRangeDeleterInitialThrottle(100);
+
 /**
  * Returns whether the currentCollection has the same UUID as the expectedCollectionUuid. Used to
  * ensure that the collection has not been dropped or dropped and recreated since the range was
@@ -255,6 +260,46 @@ auto withTemporaryOperationContext(Callable&& callable) {
     return callable(opCtx);
 }
 
+/**
+ * Returns how far behind this node's last applied write the majority commit point is, or
+ * boost::none if this node is not a member of a replica set.
+ */
+boost::optional<Milliseconds> getMajorityReplicationLag(OperationContext* opCtx) {
+    auto const replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+        return boost::none;
+    }
+
+    const auto lastApplied = replCoord->getMyLastAppliedOpTimeAndWallTime();
+    const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime();
+    if (lastApplied.opTime <= lastCommitted.opTime) {
+        return Milliseconds(0);
+    }
+
+    return std::max(Milliseconds(0), lastApplied.wallTime - lastCommitted.wallTime);
+}
+
+/**
+ * Returns how long to back off before deleting the next batch, given the back-off applied after the
+ * previous one. The back-off doubles for as long as the majority commit point lags by more than
+ * rangeDeleterMaxMajorityLagSecs and resets as soon as the secondaries have caught up.
+ */
+Milliseconds computeThrottle(OperationContext* opCtx, Milliseconds previousThrottle) {
+    const auto maxMajorityLagSecs = rangeDeleterMaxMajorityLagSecs.load();
+    if (maxMajorityLagSecs <= 0) {
+        return Milliseconds(0);
+    }
+
+    const auto lag = getMajorityReplicationLag(opCtx);
+    if (!lag || *lag <= Seconds(maxMajorityLagSecs)) {
+        return Milliseconds(0);
+    }
+
+    return std::min(previousThrottle == Milliseconds(0) ? kRangeDeleterInitialThrottle
+                                                        : previousThrottle * 2,
+                    Milliseconds(rangeDeleterMaxThrottleMS.load()));
+}
+
 void ensureRangeDeletionTaskStillExists(OperationContext* opCtx, const UUID& migrationId) {
     // While at this point we are guaranteed for our operation context to be killed if there is a
     // step-up or stepdown, it is still possible that a stepdown and a subsequent step-up happened
@@ -293,8 +338,11 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                           const boost::optional<UUID>& migrationId,
                                           int numDocsToRemovePerBatch,
                                           Milliseconds delayBetweenBatches) {
+    // The back-off applied after the previous batch, shared by all iterations of the loop
+    auto throttle = std::make_shared<Milliseconds>(0);
+
     return AsyncTry([=] {
-               return withTemporaryOperationContext([=](OperationContext* opCtx) {
+               auto numDeleted = withTemporaryOperationContext([=](OperationContext* opCtx) {
                    if (migrationId) {
                        ensureRangeDeletionTaskStillExists(opCtx, *migrationId);
                    }
@@ -321,8 +369,30 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                "collectionUuid"_attr = collectionUuid,
                                "range"_attr = range.toString());
 
+                   if (numDeleted > 0) {
+                       *throttle = computeThrottle(opCtx, *throttle);
+                   }
+
                    return numDeleted;
                });
+
+               if (numDeleted == 0 || *throttle == Milliseconds(0)) {
+                   return ExecutorFuture<int>(executor, numDeleted);
+               }
+
+               // Back off without holding any locks to let the secondaries catch up, since each
+               // deleted document is replicated as its own oplog entry
+               LOGV2_DEBUG(5100022,
+                           2,
+                           "Throttling range deletion because of replication lag",
+                           "namespace"_attr = nss,
+                           "collectionUUID"_attr = collectionUuid,
+                           "range"_attr = redact(range.toString()),
+                           "throttle"_attr = *throttle);
+               ShardingStatistics::get(getGlobalServiceContext())
+                   .countRangeDeleterBatchesThrottled.addAndFetch(1);
+
+               return sleepFor(executor, *throttle).then([numDeleted] { return numDeleted; });
            })
         .until([](StatusWith<int> swNumDeleted) {
             // Continue iterating until there are no more documents to delete, retrying on
@@ -37,11 +37,13 @@
 #include "mongo/db/s/range_deletion_task_gen.h"
 #include "mongo/db/s/range_deletion_util.h"
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
+#include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/wait_for_majority_service.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -689,6 +691,58 @@ TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRespectsDelayInBetweenBatches) {
     ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
 }
 
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeBacksOffWhileMajorityCommitPointLags) {
+    auto replCoord = checked_cast<repl::ReplicationCoordinatorMock*>(
+        repl::ReplicationCoordinator::get(getServiceContext()));
+
+    // The mock's majority commit point never advances, so it lags the last applied write
+    replCoord->setMyLastAppliedOpTimeAndWallTime(
+        {repl::OpTime(Timestamp(100, 1), 1), Date_t::now()});
+
+    const auto originalMaxMajorityLagSecs = rangeDeleterMaxMajorityLagSecs.load();
+    rangeDeleterMaxMajorityLagSecs.store(1);
+    ON_BLOCK_EXIT([&] { rangeDeleterMaxMajorityLagSecs.store(originalMaxMajorityLagSecs); });
+
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    const auto numDocsToInsert = 3;
+    const auto numDocsToRemovePerBatch = 1;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    const auto numThrottledBefore =
+        ShardingStatistics::get(operationContext()).countRangeDeleterBatchesThrottled.load();
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               boost::none,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete */,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    // A best-effort check that cleanup has not completed without advancing the clock.
+    sleepsecs(1);
+    ASSERT_FALSE(cleanupComplete.isReady());
+
+    while (!cleanupComplete.isReady()) {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(network());
+        network()->advanceTime(network()->now() + Milliseconds(10));
+    }
+
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
+    ASSERT_EQ(numThrottledBefore + numDocsToInsert,
+              ShardingStatistics::get(operationContext()).countRangeDeleterBatchesThrottled.load());
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRespectsOrphanCleanupDelay) {
     const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
     // More documents than the batch size.
@@ -59,9 +59,14 @@ void ShardingStatistics::report(BSONObjBuilder* builder) const {
                     totalCriticalSectionCommitTimeMillis.load());
     builder->append("totalCriticalSectionTimeMillis", totalCriticalSectionTimeMillis.load());
     builder->append("countDocsClonedOnRecipient", countDocsClonedOnRecipient.load());
+    builder->append("countBytesClonedOnRecipient", countBytesClonedOnRecipient.load());
+    builder->append("totalRecipientChunkCloneTimeMillis",
+                    totalRecipientChunkCloneTimeMillis.load());
     builder->append("countDocsClonedOnDonor", countDocsClonedOnDonor.load());
+    builder->append("countBytesClonedOnDonor", countBytesClonedOnDonor.load());
     builder->append("countRecipientMoveChunkStarted", countRecipientMoveChunkStarted.load());
     builder->append("countDocsDeletedOnDonor", countDocsDeletedOnDonor.load());
+    builder->append("countRangeDeleterBatchesThrottled", countRangeDeleterBatchesThrottled.load());
     builder->append("countDonorMoveChunkLockTimeout", countDonorMoveChunkLockTimeout.load());
     builder->append("countDonorMoveChunkAbortConflictingIndexOperation",
                     countDonorMoveChunkAbortConflictingIndexOperation.load());
@@ -61,14 +61,30 @@ struct ShardingStatistics {
     // recipient node.
     AtomicWord<long long> countDocsClonedOnRecipient{0};
 
+    // Cumulative, always-increasing counter of how many bytes of documents have been cloned on the
+    // recipient node.
+    AtomicWord<long long> countBytesClonedOnRecipient{0};
+
+    // Cumulative, always-increasing counter of how much time the clone phase took on the recipient
+    // node. Together with countBytesClonedOnRecipient it gives the aggregate clone bandwidth.
+    AtomicWord<long long> totalRecipientChunkCloneTimeMillis{0};
+
     // Cumulative, always-increasing counter of how many documents have been cloned on the donor
     // node.
     AtomicWord<long long> countDocsClonedOnDonor{0};
 
+    // Cumulative, always-increasing counter of how many bytes of documents have been cloned on the
+    // donor node.
+    AtomicWord<long long> countBytesClonedOnDonor{0};
+
     // Cumulative, always-increasing counter of how many documents have been deleted on the donor
     // node by the rangeDeleter.
     AtomicWord<long long> countDocsDeletedOnDonor{0};
 
+    // Cumulative, always-increasing counter of how many times the rangeDeleter backed off before
+    // its next batch because the majority commit point was lagging.
+    AtomicWord<long long> countRangeDeleterBatchesThrottled{0};
+
     // Cumulative, always-increasing counter of how many chunks this node started to receive
     // (whether the receiving succeeded or not)
     AtomicWord<long long> countRecipientMoveChunkStarted{0};
@@ -37,6 +37,7 @@
 #include "mongo/base/checked_cast.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/bson/util/bson_extract.h"
+#include "mongo/db/admission_control.h"
 #include "mongo/db/audit.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/impersonation_session.h"
@@ -1324,6 +1325,9 @@ DbResponse receivedCommands(OperationContext* opCtx,
                 }
             }
 
+            TicketHolderReleaser admission;
+            admitOperation(opCtx, *c, request, &admission);
+
             execCommandDatabase(opCtx, c, request, replyBuilder.get(), behaviors);
         } catch (const DBException& ex) {
             BSONObjBuilder metadataBob;
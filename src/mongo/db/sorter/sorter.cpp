@@ -48,8 +48,10 @@
 
 #include "mongo/db/sorter/sorter.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
 #include <snappy.h>
+#include <type_traits>
 #include <vector>
 
 #include "mongo/base/string_data.h"
@@ -80,6 +82,71 @@ uint32_t addDataToChecksum(const void* startOfData, size_t sizeOfData, uint32_t
     return newChecksum;
 }
 
+/**
+ * Appends 'value' to 'buf' using 7 bits per byte, with the high bit of each byte set if more bytes
+ * follow.
+ */
+void appendVarUInt(BufBuilder& buf, uint32_t value) {
+    while (value >= 0x80) {
+        buf.appendUChar(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buf.appendUChar(static_cast<unsigned char>(value));
+}
+
+uint32_t readVarUInt(BufReader& reader) {
+    uint32_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        uassert(5100012, "corrupt spill file: invalid key prefix length", shift < 32);
+        const auto byte = reader.read<uint8_t>();
+        value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+}
+
+/**
+ * Key types whose sorter serialization begins with bytes that differ even between keys sharing a
+ * long prefix, such as a length, may provide
+ *
+ *     void serializeForSorterPrefixCompressed(BufBuilder& buf) const;
+ *     static Key deserializeForSorterPrefixCompressed(const char* data,
+ *                                                     size_t size,
+ *                                                     const SorterDeserializeSettings& settings);
+ *
+ * to be used instead of serializeForSorter() and deserializeForSorter() when keys are spilled with
+ * SortOptions::prefixCompressKeys. The serialized key is always given back in full, so the format
+ * need not be self-delimiting.
+ */
+template <typename Key, typename = void>
+struct HasPrefixCompressedSorterFormat : std::false_type {};
+
+template <typename Key>
+struct HasPrefixCompressedSorterFormat<
+    Key,
+    std::void_t<decltype(&Key::serializeForSorterPrefixCompressed)>> : std::true_type {};
+
+template <typename Key>
+void serializeKeyForPrefixCompression(const Key& key, BufBuilder& buf) {
+    if constexpr (HasPrefixCompressedSorterFormat<Key>::value) {
+        key.serializeForSorterPrefixCompressed(buf);
+    } else {
+        key.serializeForSorter(buf);
+    }
+}
+
+template <typename Key, typename Settings>
+Key deserializeKeyForPrefixCompression(const std::string& serializedKey, const Settings& settings) {
+    if constexpr (HasPrefixCompressedSorterFormat<Key>::value) {
+        return Key::deserializeForSorterPrefixCompressed(
+            serializedKey.data(), serializedKey.size(), settings);
+    } else {
+        BufReader reader(serializedKey.data(), serializedKey.size());
+        return Key::deserializeForSorter(reader, settings);
+    }
+}
+
 }  // namespace
 
 namespace sorter {
@@ -172,8 +239,10 @@ public:
                  std::streampos fileStartOffset,
                  std::streampos fileEndOffset,
                  const Settings& settings,
-                 const uint32_t checksum)
+                 const uint32_t checksum,
+                 bool prefixCompressedKeys)
         : _settings(settings),
+          _prefixCompressedKeys(prefixCompressedKeys),
           _done(false),
           _fileName(fileName),
           _fileStartOffset(fileStartOffset),
@@ -227,6 +296,10 @@ public:
         verify(!_done);
         fillBufferIfNeeded();
 
+        if (_prefixCompressedKeys) {
+            return nextPrefixCompressed();
+        }
+
         const char* startOfNewData = static_cast<const char*>(_bufferReader->pos());
 
         // Note: calling read() on the _bufferReader buffer in the deserialize function advances the
@@ -247,6 +320,33 @@ public:
     }
 
 private:
+    /**
+     * Reads the next pair from a block written with prefix-compressed keys, restoring the key's
+     * serialized form from the previous key before deserializing it. The checksum covers the
+     * serialized key and the value, as on the writing side.
+     */
+    Data nextPrefixCompressed() {
+        const auto sharedPrefix = readVarUInt(*_bufferReader);
+        const auto suffixSize = readVarUInt(*_bufferReader);
+        uassert(5100013,
+                "corrupt spill file: key prefix is longer than previous key",
+                sharedPrefix <= _prevKey.size());
+        _prevKey.resize(sharedPrefix);
+        _prevKey.append(static_cast<const char*>(_bufferReader->skip(suffixSize)), suffixSize);
+        _afterReadChecksum =
+            addDataToChecksum(_prevKey.data(), _prevKey.size(), _afterReadChecksum);
+
+        auto first = deserializeKeyForPrefixCompression<Key>(_prevKey, _settings.first);
+
+        const char* startOfValue = static_cast<const char*>(_bufferReader->pos());
+        auto second = Value::deserializeForSorter(*_bufferReader, _settings.second);
+        const char* endOfValue = static_cast<const char*>(_bufferReader->pos());
+        _afterReadChecksum =
+            addDataToChecksum(startOfValue, endOfValue - startOfValue, _afterReadChecksum);
+
+        return Data(std::move(first), std::move(second));
+    }
+
     /**
      * Attempts to refill the _bufferReader if it is empty. Expects _done to be false.
      */
@@ -275,6 +375,9 @@ private:
         read(_buffer.get(), blockSize);
         uassert(16816, "file too short?", !_done);
 
+        // Each block's first key is stored in full.
+        _prevKey.clear();
+
         auto encryptionHooks = EncryptionHooks::get(getGlobalServiceContext());
         if (encryptionHooks->enabled()) {
             std::unique_ptr<char[]> out(new char[blockSize]);
@@ -343,8 +446,12 @@ private:
     }
 
     const Settings _settings;
+    const bool _prefixCompressedKeys;
     bool _done;
 
+    // Used only if '_prefixCompressedKeys' is set. The serialized form of the last key read.
+    std::string _prevKey;
+
     std::unique_ptr<char[]> _buffer;
     std::unique_ptr<BufReader> _bufferReader;
     std::string _fileName;            // File containing the sorted data range.
@@ -408,7 +515,9 @@ public:
         // file. Some systems will error closing the file if any file handles are still open.
         _current.reset();
         _heap.clear();
-        DESTRUCTOR_GUARD(boost::filesystem::remove(_itersSourceFileName));
+        if (!_itersSourceFileName.empty()) {
+            DESTRUCTOR_GUARD(boost::filesystem::remove(_itersSourceFileName));
+        }
     }
 
     void openSource() {}
@@ -512,6 +621,54 @@ private:
     std::string _itersSourceFileName;
 };
 
+/**
+ * Reduces the runs in 'iters', all spilled to 'fileName', to at most 'opts.maxSpillFanIn' runs.
+ * Each pass merges groups of at most 'opts.maxSpillFanIn' runs and appends the result to the end
+ * of the file as a single run. Returns the new end offset of the file.
+ */
+template <typename Key, typename Value, typename Comparator>
+std::streampos mergeSpills(std::vector<std::shared_ptr<SortIteratorInterface<Key, Value>>>* iters,
+                           const std::string& fileName,
+                           std::streampos fileEndOffset,
+                           const SortOptions& opts,
+                           const Comparator& comp,
+                           const typename SortedFileWriter<Key, Value>::Settings& settings) {
+    typedef SortIteratorInterface<Key, Value> Iterator;
+
+    const size_t fanIn = opts.maxSpillFanIn;
+    if (fanIn < 2) {
+        return fileEndOffset;
+    }
+
+    while (iters->size() > fanIn) {
+        std::vector<std::shared_ptr<Iterator>> mergedIters;
+        for (auto groupBegin = iters->begin(); groupBegin != iters->end();) {
+            auto groupEnd = groupBegin + std::min<size_t>(fanIn, iters->end() - groupBegin);
+            if (groupEnd - groupBegin == 1) {
+                mergedIters.push_back(*groupBegin);
+                groupBegin = groupEnd;
+                continue;
+            }
+
+            SortedFileWriter<Key, Value> writer(opts, fileName, fileEndOffset, settings);
+            {
+                // An empty file name leaves the spill file in place for the runs still to come.
+                MergeIterator<Key, Value, Comparator> mergeIt(
+                    std::vector<std::shared_ptr<Iterator>>(groupBegin, groupEnd), "", opts, comp);
+                while (mergeIt.more()) {
+                    auto data = mergeIt.next();
+                    writer.addAlreadySorted(data.first, data.second);
+                }
+            }
+            mergedIters.push_back(std::shared_ptr<Iterator>(writer.done()));
+            fileEndOffset = writer.getFileEndOffset();
+            groupBegin = groupEnd;
+        }
+        *iters = std::move(mergedIters);
+    }
+    return fileEndOffset;
+}
+
 template <typename Key, typename Value, typename Comparator>
 class NoLimitSorter : public Sorter<Key, Value> {
 public:
@@ -560,6 +717,8 @@ public:
         }
 
         spill();
+        _nextSortedFileWriterOffset = mergeSpills<Key, Value, Comparator>(
+            &_iters, _fileName, _nextSortedFileWriterOffset, _opts, _comp, _settings);
         Iterator* mergeIt = Iterator::merge(_iters, _fileName, _opts, _comp);
         _done = true;
         return mergeIt;
@@ -766,6 +925,8 @@ public:
         }
 
         spill();
+        _nextSortedFileWriterOffset = mergeSpills<Key, Value, Comparator>(
+            &_iters, _fileName, _nextSortedFileWriterOffset, _opts, _comp, _settings);
         Iterator* iterator = Iterator::merge(_iters, _fileName, _opts, _comp);
         _done = true;
         return iterator;
@@ -942,7 +1103,7 @@ SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts,
                                                const std::string& fileName,
                                                const std::streampos fileStartOffset,
                                                const Settings& settings)
-    : _settings(settings) {
+    : _settings(settings), _prefixCompressKeys(opts.prefixCompressKeys) {
 
     // This should be checked by consumers, but if we get here don't allow writes.
     uassert(
@@ -976,6 +1137,33 @@ SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts,
 template <typename Key, typename Value>
 void SortedFileWriter<Key, Value>::addAlreadySorted(const Key& key, const Value& val) {
 
+    if (_prefixCompressKeys) {
+        // Store only the part of the serialized key which differs from the previous key, preceded
+        // by the length of the prefix the two share.
+        _keyBuffer.reset();
+        serializeKeyForPrefixCompression(key, _keyBuffer);
+        const auto keySize = static_cast<size_t>(_keyBuffer.len());
+        const char* keyData = _keyBuffer.buf();
+        const auto sharedPrefix =
+            std::mismatch(keyData, keyData + std::min(keySize, _prevKey.size()), _prevKey.data())
+                .first -
+            keyData;
+        appendVarUInt(_buffer, sharedPrefix);
+        appendVarUInt(_buffer, keySize - sharedPrefix);
+        _buffer.appendBuf(keyData + sharedPrefix, keySize - sharedPrefix);
+        _checksum = addDataToChecksum(keyData, keySize, _checksum);
+        _prevKey.assign(keyData, keySize);
+
+        const int valuePos = _buffer.len();
+        val.serializeForSorter(_buffer);
+        _checksum =
+            addDataToChecksum(_buffer.buf() + valuePos, _buffer.len() - valuePos, _checksum);
+
+        if (_buffer.len() > 64 * 1024)
+            spill();
+        return;
+    }
+
     // Offset that points to the place in the buffer where a new data object will be stored.
     int _nextObjPos = _buffer.len();
 
@@ -1040,6 +1228,9 @@ void SortedFileWriter<Key, Value>::spill() {
     }
 
     _buffer.reset();
+
+    // Each block is decoded independently, so its first key must be stored in full.
+    _prevKey.clear();
 }
 
 template <typename Key, typename Value>
@@ -1057,7 +1248,7 @@ SortIteratorInterface<Key, Value>* SortedFileWriter<Key, Value>::done() {
     _file.close();
 
     return new sorter::FileIterator<Key, Value>(
-        _fileName, _fileStartOffset, _fileEndOffset, _settings, _checksum);
+        _fileName, _fileStartOffset, _fileEndOffset, _settings, _checksum, _prefixCompressKeys);
 }
 
 //
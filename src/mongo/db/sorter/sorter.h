@@ -107,7 +107,22 @@ struct SortOptions {
     // extSortAllowed is true.
     std::string tempDir;
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    // Whether keys spilled to disk are stored as the suffix which differs from the previous key in
+    // the same block. Worthwhile when sorted keys tend to share long prefixes, as index keys do.
+    // The Key type's deserializeForSorter() must not retain pointers into its input buffer.
+    bool prefixCompressKeys;
+
+    // The maximum number of spilled runs merged at once. When more runs than this were spilled,
+    // they are first merged in groups of this size back into the spill file, as many times as
+    // needed, so the final merge only holds this many files open. 0 indicates no bound.
+    size_t maxSpillFanIn;
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          prefixCompressKeys(false),
+          maxSpillFanIn(0) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -130,6 +145,16 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& PrefixCompressKeys(bool newPrefixCompressKeys = true) {
+        prefixCompressKeys = newPrefixCompressKeys;
+        return *this;
+    }
+
+    SortOptions& MaxSpillFanIn(size_t newMaxSpillFanIn) {
+        maxSpillFanIn = newMaxSpillFanIn;
+        return *this;
+    }
 };
 
 /**
@@ -281,10 +306,16 @@ private:
     void spill();
 
     const Settings _settings;
+    const bool _prefixCompressKeys;
     std::string _fileName;
     std::ofstream _file;
     BufBuilder _buffer;
 
+    // Used only if '_prefixCompressKeys' is set. Holds the serialized form of the key being added
+    // and of the previous key in the current block, respectively.
+    BufBuilder _keyBuffer;
+    std::string _prevKey;
+
     // Keeps track of the hash of all data objects spilled to disk. Passed to the FileIterator
     // to ensure data has not been corrupted after reading from disk.
     uint32_t _checksum = 0;
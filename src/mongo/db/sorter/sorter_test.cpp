@@ -309,6 +309,18 @@ public:
 
             ASSERT_TRUE(boost::filesystem::remove(fileName));
         }
+        {  // big, with prefix-compressed keys spanning several blocks
+            std::string fileName = opts.tempDir + "/" + nextFileName();
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(
+                SortOptions(opts).PrefixCompressKeys(), fileName, 0);
+            for (int i = 0; i < 1000 * 1000; i++)
+                sorter.addAlreadySorted(i, -i);
+
+            ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()),
+                                        make_shared<IntIterator>(0, 1000 * 1000));
+
+            ASSERT_TRUE(boost::filesystem::remove(fileName));
+        }
 
         ASSERT(boost::filesystem::is_empty(tempDir.path()));
     }
@@ -558,6 +570,23 @@ public:
 };
 
 
+template <bool Random = true>
+class LotsOfDataLittleMemoryPrefixCompressed : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return LotsOfDataLittleMemory<Random>::adjustSortOptions(opts).PrefixCompressKeys();
+    }
+};
+
+
+template <bool Random = true>
+class LotsOfDataLittleMemoryBoundedFanIn : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        // Spills at least 50 runs, so merging them 4 at a time takes several passes.
+        return LotsOfDataLittleMemory<Random>::adjustSortOptions(opts).MaxSpillFanIn(4);
+    }
+};
+
+
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     typedef LotsOfDataLittleMemory<Random> Parent;
@@ -599,6 +628,10 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataLittleMemoryPrefixCompressed</*random=*/false>>();
+        add<SorterTests::LotsOfDataLittleMemoryPrefixCompressed</*random=*/true>>();
+        add<SorterTests::LotsOfDataLittleMemoryBoundedFanIn</*random=*/false>>();
+        add<SorterTests::LotsOfDataLittleMemoryBoundedFanIn</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
@@ -156,6 +156,10 @@ void NetworkCounter::incrementNumSlowSSLOperations() {
     _numSlowSSLOperations.fetchAndAdd(1);
 }
 
+void NetworkCounter::incrementNumResumedEgressSSLSessions() {
+    _numResumedEgressSSLSessions.fetchAndAdd(1);
+}
+
 void NetworkCounter::acceptedTFOIngress() {
     _tfo.accepted.fetchAndAddRelaxed(1);
 }
@@ -167,6 +171,8 @@ void NetworkCounter::append(BSONObjBuilder& b) {
     b.append("physicalBytesOut", static_cast<long long>(_physicalBytesOut.loadRelaxed()));
     b.append("numSlowDNSOperations", static_cast<long long>(_numSlowDNSOperations.loadRelaxed()));
     b.append("numSlowSSLOperations", static_cast<long long>(_numSlowSSLOperations.loadRelaxed()));
+    b.append("numResumedEgressSSLSessions",
+             static_cast<long long>(_numResumedEgressSSLSessions.loadRelaxed()));
     b.append("numRequests", static_cast<long long>(_together.requests.loadRelaxed()));
 
     BSONObjBuilder tfo;
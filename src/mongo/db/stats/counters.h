@@ -168,6 +168,9 @@ public:
     // Increment the counter for the number of slow ssl handshake operations.
     void incrementNumSlowSSLOperations();
 
+    // Increment the counter for the number of outgoing TLS connections that resumed a session.
+    void incrementNumResumedEgressSSLSessions();
+
     // TFO Counters and Status;
     void acceptedTFOIngress();
 
@@ -203,6 +206,7 @@ private:
 
     CacheAligned<AtomicWord<long long>> _numSlowDNSOperations{0};
     CacheAligned<AtomicWord<long long>> _numSlowSSLOperations{0};
+    CacheAligned<AtomicWord<long long>> _numResumedEgressSSLSessions{0};
 
     struct TFO {
         // Counter of inbound connections at runtime.
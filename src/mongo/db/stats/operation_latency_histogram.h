@@ -59,6 +59,11 @@ public:
      */
     void append(bool includeHistograms, BSONObjBuilder* builder) const;
 
+    /**
+     * Adds the counts and latency totals of 'other' into this histogram.
+     */
+    void merge(const OperationLatencyHistogram& other);
+
 private:
     struct HistogramData {
         std::array<uint64_t, kMaxBuckets> buckets{};
@@ -77,6 +82,8 @@ private:
 
     void _incrementData(uint64_t latency, int bucket, HistogramData* data);
 
+    static void _mergeData(const HistogramData& from, HistogramData* into);
+
     HistogramData _reads, _writes, _commands, _transactions;
 };
 }  // namespace mongo
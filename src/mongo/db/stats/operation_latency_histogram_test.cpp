@@ -92,4 +92,25 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatency) {
         ASSERT_EQUALS(bucket["count"].Long(), (i < kMaxBuckets - 1) ? 3 : 2);
     }
 }
+
+TEST(OperationLatencyHistogram, MergeAddsCountsAndLatencies) {
+    OperationLatencyHistogram first, second;
+    first.increment(1, Command::ReadWriteType::kRead);
+    first.increment(5000, Command::ReadWriteType::kWrite);
+    second.increment(1, Command::ReadWriteType::kRead);
+    second.increment(20, Command::ReadWriteType::kCommand);
+    first.merge(second);
+
+    BSONObjBuilder outBuilder;
+    first.append(true, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out["reads"]["ops"].Long(), 2);
+    ASSERT_EQUALS(out["reads"]["latency"].Long(), 2);
+    ASSERT_EQUALS(out["reads"]["histogram"].Array().size(), 1U);
+    ASSERT_EQUALS(out["reads"]["histogram"].Array()[0]["count"].Long(), 2);
+    ASSERT_EQUALS(out["writes"]["ops"].Long(), 1);
+    ASSERT_EQUALS(out["writes"]["latency"].Long(), 5000);
+    ASSERT_EQUALS(out["commands"]["ops"].Long(), 1);
+    ASSERT_EQUALS(out["transactions"]["ops"].Long(), 0);
+}
 }  // namespace mongo
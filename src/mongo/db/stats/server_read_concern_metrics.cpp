@@ -82,6 +82,34 @@ void ServerReadConcernMetrics::recordReadConcern(const repl::ReadConcernArgs& re
     }
 }
 
+void ServerReadConcernMetrics::recordOpTimeWait(const repl::ReadConcernArgs& readConcernArgs,
+                                                long long waitMicros) {
+    switch (readConcernArgs.getLevel()) {
+        case repl::ReadConcernLevel::kLocalReadConcern:
+            _localOpTimeWaits.record(waitMicros);
+            break;
+
+        case repl::ReadConcernLevel::kMajorityReadConcern:
+            _majorityOpTimeWaits.record(waitMicros);
+            break;
+
+        case repl::ReadConcernLevel::kSnapshotReadConcern:
+            _snapshotOpTimeWaits.record(waitMicros);
+            break;
+
+        default:
+            // Other levels do not wait for an opTime to become readable.
+            break;
+    }
+}
+
+OpTimeWaitStats ServerReadConcernMetrics::OpTimeWaitCounters::toStats() const {
+    OpTimeWaitStats stats;
+    stats.setCount(count.load());
+    stats.setTotalMicros(totalMicros.load());
+    return stats;
+}
+
 void ServerReadConcernMetrics::updateStats(ReadConcernStats* stats, OperationContext* opCtx) {
     stats->setAvailable(_levelAvailableCount.load());
     stats->setLinearizable(_levelLinearizableCount.load());
@@ -89,6 +117,12 @@ void ServerReadConcernMetrics::updateStats(ReadConcernStats* stats, OperationCon
     stats->setMajority(_levelMajorityCount.load());
     stats->setSnapshot(_levelSnapshotCount.load());
     stats->setNone(_noLevelCount.load());
+
+    OpTimeWaitStatsByLevel opTimeWaits;
+    opTimeWaits.setLocal(_localOpTimeWaits.toStats());
+    opTimeWaits.setMajority(_majorityOpTimeWaits.toStats());
+    opTimeWaits.setSnapshot(_snapshotOpTimeWaits.toStats());
+    stats->setOpTimeWaits(std::move(opTimeWaits));
 }
 
 namespace {
@@ -54,18 +54,40 @@ public:
      */
     void recordReadConcern(const repl::ReadConcernArgs& readConcernArgs);
 
+    /**
+     * Records that an operation with 'readConcernArgs' spent 'waitMicros' waiting for its
+     * afterOpTime, afterClusterTime or atClusterTime to become readable.
+     */
+    void recordOpTimeWait(const repl::ReadConcernArgs& readConcernArgs, long long waitMicros);
+
     /**
      * Appends the accumulated stats to a readConcern stats object.
      */
     void updateStats(ReadConcernStats* stats, OperationContext* opCtx);
 
 private:
+    struct OpTimeWaitCounters {
+        void record(long long waitMicros) {
+            count.fetchAndAdd(1);
+            totalMicros.fetchAndAdd(waitMicros);
+        }
+
+        OpTimeWaitStats toStats() const;
+
+        AtomicWord<long long> count{0};
+        AtomicWord<long long> totalMicros{0};
+    };
+
     AtomicWord<unsigned long long> _levelAvailableCount{0};
     AtomicWord<unsigned long long> _levelLinearizableCount{0};
     AtomicWord<unsigned long long> _levelLocalCount{0};
     AtomicWord<unsigned long long> _levelMajorityCount{0};
     AtomicWord<unsigned long long> _levelSnapshotCount{0};
     AtomicWord<unsigned long long> _noLevelCount{0};
+
+    OpTimeWaitCounters _localOpTimeWaits;
+    OpTimeWaitCounters _majorityOpTimeWaits;
+    OpTimeWaitCounters _snapshotOpTimeWaits;
 };
 
 }  // namespace mongo
@@ -35,6 +35,7 @@
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -47,6 +48,8 @@ namespace {
 
 const auto getTop = ServiceContext::declareDecoration<Top>();
 
+AtomicWord<unsigned> nextGlobalHistogramPartition;
+
 }  // namespace
 
 Top::UsageData::UsageData(const UsageData& older, const UsageData& newer) {
@@ -197,21 +200,34 @@ void Top::appendLatencyStats(const NamespaceString& nss,
     builder->append("latencyStats", latencyStatsBuilder.obj());
 }
 
+Top::GlobalHistogramPartition& Top::_getGlobalHistogramPartition() {
+    // Each thread sticks to one partition, assigned round-robin the first time it records.
+    thread_local const unsigned partition =
+        nextGlobalHistogramPartition.fetchAndAdd(1) % kNumGlobalHistogramPartitions;
+    return _globalHistogramStats[partition];
+}
+
 void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
                                       uint64_t latency,
                                       Command::ReadWriteType readWriteType) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
+    auto& partition = _getGlobalHistogramPartition();
+    stdx::lock_guard<SimpleMutex> guard(partition.mutex);
+    _incrementHistogram(opCtx, latency, &partition.histogram, readWriteType);
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.append(includeHistograms, builder);
+    OperationLatencyHistogram merged;
+    for (auto& partition : _globalHistogramStats) {
+        stdx::lock_guard<SimpleMutex> guard(partition.mutex);
+        merged.merge(partition.histogram);
+    }
+    merged.append(includeHistograms, builder);
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
+    auto& partition = _getGlobalHistogramPartition();
+    stdx::lock_guard<SimpleMutex> guard(partition.mutex);
+    partition.histogram.increment(latency, Command::ReadWriteType::kTransaction);
 }
 
 void Top::_incrementHistogram(OperationContext* opCtx,
@@ -38,6 +38,7 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/string_map.h"
 
@@ -151,8 +152,24 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
+    /**
+     * The global latency histograms are updated by every operation, so rather than sharing '_lock'
+     * they are split into partitions, each updated by a subset of threads and merged on read.
+     */
+    struct GlobalHistogramPartition {
+        SimpleMutex mutex;
+        OperationLatencyHistogram histogram;
+
+        // Top is a ServiceContext decoration, which does not honor over-aligned types, so pad
+        // instead to keep neighbouring partitions off each other's cache lines.
+        char padding[stdx::hardware_destructive_interference_size];
+    };
+    static constexpr size_t kNumGlobalHistogramPartitions = 16;
+
+    GlobalHistogramPartition& _getGlobalHistogramPartition();
+
     mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
+    std::array<GlobalHistogramPartition, kNumGlobalHistogramPartitions> _globalHistogramStats;
     UsageMap _usage;
 };
 
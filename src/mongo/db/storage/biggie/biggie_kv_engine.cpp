@@ -37,6 +37,7 @@
 
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/snapshot_window_options.h"
+#include "mongo/db/storage/biggie/biggie_parameters_gen.h"
 #include "mongo/db/storage/biggie/biggie_recovery_unit.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
@@ -64,7 +65,14 @@ Status KVEngine::createRecordStore(OperationContext* opCtx,
 std::unique_ptr<mongo::RecordStore> KVEngine::makeTemporaryRecordStore(OperationContext* opCtx,
                                                                        StringData ident) {
     std::unique_ptr<mongo::RecordStore> recordStore =
-        std::make_unique<RecordStore>("", ident, false);
+        std::make_unique<RecordStore>("",
+                                      ident,
+                                      false /* isCapped */,
+                                      -1 /* cappedMaxSize */,
+                                      -1 /* cappedMaxDocs */,
+                                      nullptr /* cappedCallback */,
+                                      nullptr /* visibilityManager */,
+                                      gBiggieCompressRecords);
     _idents[ident.toString()] = true;
     return recordStore;
 };
@@ -87,7 +95,14 @@ std::unique_ptr<mongo::RecordStore> KVEngine::getRecordStore(OperationContext* o
             /*cappedCallback*/ nullptr,
             _visibilityManager.get());
     } else {
-        recordStore = std::make_unique<RecordStore>(ns, ident, options.capped);
+        recordStore = std::make_unique<RecordStore>(ns,
+                                                    ident,
+                                                    options.capped,
+                                                    -1 /* cappedMaxSize */,
+                                                    -1 /* cappedMaxDocs */,
+                                                    nullptr /* cappedCallback */,
+                                                    nullptr /* visibilityManager */,
+                                                    gBiggieCompressRecords);
     }
     _idents[ident.toString()] = true;
     return recordStore;
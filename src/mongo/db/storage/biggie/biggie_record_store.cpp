@@ -33,12 +33,15 @@
 
 #include "mongo/db/storage/biggie/biggie_record_store.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <snappy.h>
 #include <utility>
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/storage/biggie/biggie_parameters_gen.h"
 #include "mongo/db/storage/biggie/biggie_recovery_unit.h"
 #include "mongo/db/storage/biggie/biggie_visibility_manager.h"
 #include "mongo/db/storage/biggie/store.h"
@@ -77,7 +80,8 @@ RecordStore::RecordStore(StringData ns,
                          int64_t cappedMaxSize,
                          int64_t cappedMaxDocs,
                          CappedCallback* cappedCallback,
-                         VisibilityManager* visibilityManager)
+                         VisibilityManager* visibilityManager,
+                         bool compressRecords)
     : mongo::RecordStore(ns),
       _isCapped(isCapped),
       _cappedMaxSize(cappedMaxSize),
@@ -88,7 +92,8 @@ RecordStore::RecordStore(StringData ns,
       _postfix(createKey(_ident, std::numeric_limits<int64_t>::max())),
       _cappedCallback(cappedCallback),
       _isOplog(NamespaceString::oplog(ns)),
-      _visibilityManager(visibilityManager) {
+      _visibilityManager(visibilityManager),
+      _compressRecords(compressRecords && !isCapped) {
     if (_isCapped) {
         invariant(_cappedMaxSize > 0);
         invariant(_cappedMaxDocs == -1 || _cappedMaxDocs > 0);
@@ -135,7 +140,7 @@ bool RecordStore::findRecord(OperationContext* opCtx, const RecordId& loc, Recor
     if (it == workingCopy->end()) {
         return false;
     }
-    *rd = RecordData(it->second.c_str(), it->second.length());
+    *rd = _decodeRecord(it->second, _compressRecords);
     return true;
 }
 
@@ -143,7 +148,13 @@ void RecordStore::deleteRecord(OperationContext* opCtx, const RecordId& dl) {
     auto ru = RecoveryUnit::get(opCtx);
     StringStore* workingCopy(ru->getHead());
     SizeAdjuster adjuster(opCtx, this);
-    invariant(workingCopy->erase(createKey(_ident, dl.repr())));
+    std::string key = createKey(_ident, dl.repr());
+    if (_compressRecords) {
+        auto it = workingCopy->find(key);
+        invariant(it != workingCopy->end());
+        _noteRecordRemoved(it->second, &adjuster);
+    }
+    invariant(workingCopy->erase(key));
     ru->makeDirty();
 }
 
@@ -174,9 +185,9 @@ Status RecordStore::insertRecords(OperationContext* opCtx,
             } else {
                 thisRecordId = _nextRecordId();
             }
-            workingCopy->insert(
-                StringStore::value_type{createKey(_ident, thisRecordId),
-                                        std::string(record.data.data(), record.data.size())});
+            workingCopy->insert(StringStore::value_type{
+                createKey(_ident, thisRecordId),
+                _encodeRecord(record.data.data(), record.data.size(), &adjuster)});
             record.id = RecordId(thisRecordId);
         }
     }
@@ -195,7 +206,8 @@ Status RecordStore::updateRecord(OperationContext* opCtx,
         std::string key = createKey(_ident, oldLocation.repr());
         StringStore::const_iterator it = workingCopy->find(key);
         invariant(it != workingCopy->end());
-        workingCopy->update(StringStore::value_type{key, std::string(data, len)});
+        _noteRecordRemoved(it->second, &adjuster);
+        workingCopy->update(StringStore::value_type{key, _encodeRecord(data, len, &adjuster)});
     }
     _cappedDeleteAsNeeded(opCtx, workingCopy);
     RecoveryUnit::get(opCtx)->makeDirty();
@@ -223,8 +235,41 @@ std::unique_ptr<SeekableRecordCursor> RecordStore::getCursor(OperationContext* o
     return std::make_unique<ReverseCursor>(opCtx, *this, _visibilityManager);
 }
 
+std::vector<RecordId> RecordStore::getRangeBoundaries(OperationContext* opCtx,
+                                                      size_t numRanges) const {
+    std::vector<RecordId> boundaries;
+    const auto count = numRecords(opCtx);
+    if (numRanges <= 1 || count <= 0)
+        return boundaries;
+
+    // The records are all in memory, so split them exactly.
+    const size_t recordsPerRange = std::max<size_t>(count / numRanges, 1);
+    StringStore* workingCopy(RecoveryUnit::get(opCtx)->getHead());
+    StringStore::const_iterator end = workingCopy->upper_bound(_postfix);
+    size_t i = 0;
+    for (auto it = workingCopy->lower_bound(_prefix);
+         it != end && boundaries.size() < numRanges - 1;
+         ++it, ++i) {
+        if (i > 0 && i % recordsPerRange == 0)
+            boundaries.push_back(extractRecordId(it->first));
+    }
+    return boundaries;
+}
+
+std::unique_ptr<SeekableRecordCursor> RecordStore::getRangeCursor(OperationContext* opCtx,
+                                                                  const RecordId& start,
+                                                                  const RecordId& end) const {
+    return std::make_unique<Cursor>(opCtx, *this, _visibilityManager, start, end);
+}
+
 Status RecordStore::truncate(OperationContext* opCtx) {
     SizeAdjuster adjuster(opCtx, this);
+    if (_compressRecords) {
+        StringStore* workingCopy(RecoveryUnit::get(opCtx)->getHead());
+        StringStore::const_iterator end = workingCopy->upper_bound(_postfix);
+        for (auto it = workingCopy->lower_bound(_prefix); it != end; ++it)
+            _noteRecordRemoved(it->second, &adjuster);
+    }
     StatusWith<int64_t> s =
         truncateWithoutUpdatingCount(checked_cast<biggie::RecoveryUnit*>(opCtx->recoveryUnit()));
     if (!s.isOK())
@@ -333,6 +378,37 @@ boost::optional<RecordId> RecordStore::oplogStartHack(OperationContext* opCtx,
     return rid;
 }
 
+std::string RecordStore::_encodeRecord(const char* data, int len, SizeAdjuster* adjuster) const {
+    if (!_compressRecords)
+        return std::string(data, len);
+
+    std::string compressed;
+    snappy::Compress(data, len, &compressed);
+    adjuster->addCompressionSavings(len - static_cast<int64_t>(compressed.size()));
+    return compressed;
+}
+
+void RecordStore::_noteRecordRemoved(const std::string& value, SizeAdjuster* adjuster) const {
+    if (!_compressRecords)
+        return;
+
+    size_t uncompressedSize;
+    invariant(snappy::GetUncompressedLength(value.data(), value.size(), &uncompressedSize));
+    adjuster->addCompressionSavings(static_cast<int64_t>(value.size()) -
+                                    static_cast<int64_t>(uncompressedSize));
+}
+
+RecordData RecordStore::_decodeRecord(const std::string& value, bool compressed) {
+    if (!compressed)
+        return RecordData(value.c_str(), value.length());
+
+    size_t uncompressedSize;
+    invariant(snappy::GetUncompressedLength(value.data(), value.size(), &uncompressedSize));
+    auto buffer = SharedBuffer::allocate(uncompressedSize);
+    invariant(snappy::RawUncompress(value.data(), value.size(), buffer.get()));
+    return RecordData(std::move(buffer), uncompressedSize);
+}
+
 bool RecordStore::_cappedAndNeedDelete(OperationContext* opCtx, StringStore* workingCopy) {
     if (!_isCapped)
         return false;
@@ -384,13 +460,18 @@ void RecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx, StringStore* wo
 
 RecordStore::Cursor::Cursor(OperationContext* opCtx,
                             const RecordStore& rs,
-                            VisibilityManager* visibilityManager)
+                            VisibilityManager* visibilityManager,
+                            const RecordId& start,
+                            const RecordId& end)
     : opCtx(opCtx), _visibilityManager(visibilityManager) {
     _ident = rs._ident;
-    _prefix = rs._prefix;
-    _postfix = rs._postfix;
+    // Keys strictly between '_prefix' and '_postfix' belong to this cursor, so narrowing them to
+    // the requested range is all that is needed to bound it.
+    _prefix = start.isNull() ? rs._prefix : createKey(_ident, start.repr() - 1);
+    _postfix = end.isNull() ? rs._postfix : createKey(_ident, end.repr());
     _isCapped = rs._isCapped;
     _isOplog = rs._isOplog;
+    _compressRecords = rs._compressRecords;
 }
 
 boost::optional<Record> RecordStore::Cursor::next() {
@@ -398,7 +479,7 @@ boost::optional<Record> RecordStore::Cursor::next() {
     StringStore* workingCopy(RecoveryUnit::get(opCtx)->getHead());
     if (_needFirstSeek) {
         _needFirstSeek = false;
-        it = workingCopy->lower_bound(_prefix);
+        it = workingCopy->upper_bound(_prefix);
     } else if (it != workingCopy->end() && !_lastMoveWasRestore) {
         ++it;
     }
@@ -407,7 +488,7 @@ boost::optional<Record> RecordStore::Cursor::next() {
         _savedPosition = it->first;
         Record nextRecord;
         nextRecord.id = RecordId(extractRecordId(it->first));
-        nextRecord.data = RecordData(it->second.c_str(), it->second.length());
+        nextRecord.data = _decodeRecord(it->second, _compressRecords);
 
         if (_isOplog && nextRecord.id > _visibilityManager->getAllCommittedRecord())
             return boost::none;
@@ -431,7 +512,7 @@ boost::optional<Record> RecordStore::Cursor::seekExact(const RecordId& id) {
 
     _needFirstSeek = false;
     _savedPosition = it->first;
-    return Record{id, RecordData(it->second.c_str(), it->second.length())};
+    return Record{id, _decodeRecord(it->second, _compressRecords)};
 }
 
 // Positions are saved as we go.
@@ -471,6 +552,7 @@ RecordStore::ReverseCursor::ReverseCursor(OperationContext* opCtx,
     _postfix = rs._postfix;
     _isCapped = rs._isCapped;
     _isOplog = rs._isOplog;
+    _compressRecords = rs._compressRecords;
 }
 
 boost::optional<Record> RecordStore::ReverseCursor::next() {
@@ -488,7 +570,7 @@ boost::optional<Record> RecordStore::ReverseCursor::next() {
         _savedPosition = it->first;
         Record nextRecord;
         nextRecord.id = RecordId(extractRecordId(it->first));
-        nextRecord.data = RecordData(it->second.c_str(), it->second.length());
+        nextRecord.data = _decodeRecord(it->second, _compressRecords);
 
         if (_isOplog && nextRecord.id > _visibilityManager->getAllCommittedRecord())
             return boost::none;
@@ -513,7 +595,7 @@ boost::optional<Record> RecordStore::ReverseCursor::seekExact(const RecordId& id
 
     it = StringStore::const_reverse_iterator(++canFind);  // reverse iterator returns item 1 before
     _savedPosition = it->first;
-    return Record{id, RecordData(it->second.c_str(), it->second.length())};
+    return Record{id, _decodeRecord(it->second, _compressRecords)};
 }
 
 void RecordStore::ReverseCursor::save() {}
@@ -553,7 +635,7 @@ RecordStore::SizeAdjuster::SizeAdjuster(OperationContext* opCtx, RecordStore* rs
 
 RecordStore::SizeAdjuster::~SizeAdjuster() {
     int64_t deltaNumRecords = _workingCopy->size() - _origNumRecords;
-    int64_t deltaDataSize = _workingCopy->dataSize() - _origDataSize;
+    int64_t deltaDataSize = _workingCopy->dataSize() - _origDataSize + _compressionSavings;
     _rs->_numRecords.fetchAndAdd(deltaNumRecords);
     _rs->_dataSize.fetchAndAdd(deltaDataSize);
     RecoveryUnit::get(_opCtx)->onRollback([rs = _rs, deltaNumRecords, deltaDataSize]() {
@@ -54,7 +54,8 @@ public:
                          int64_t cappedMaxSize = -1,
                          int64_t cappedMaxDocs = -1,
                          CappedCallback* cappedCallback = nullptr,
-                         VisibilityManager* visibilityManager = nullptr);
+                         VisibilityManager* visibilityManager = nullptr,
+                         bool compressRecords = false);
     ~RecordStore() = default;
 
     virtual const char* name() const;
@@ -91,6 +92,13 @@ public:
     std::unique_ptr<SeekableRecordCursor> getCursor(OperationContext* opCtx,
                                                     bool forward) const final;
 
+    std::vector<RecordId> getRangeBoundaries(OperationContext* opCtx,
+                                             size_t numRanges) const final;
+
+    std::unique_ptr<SeekableRecordCursor> getRangeCursor(OperationContext* opCtx,
+                                                         const RecordId& start,
+                                                         const RecordId& end) const final;
+
     virtual Status truncate(OperationContext* opCtx);
     StatusWith<int64_t> truncateWithoutUpdatingCount(RecoveryUnit* ru);
 
@@ -111,6 +119,7 @@ public:
 
 private:
     friend class VisibilityManagerChange;
+    class SizeAdjuster;
 
     /**
      * This gets the next (guaranteed) unique record id.
@@ -119,6 +128,23 @@ private:
         return _highestRecordId.fetchAndAdd(1);
     }
 
+    /**
+     * Returns the value stored for 'data', which is compressed if '_compressRecords' is set, and
+     * adds the bytes saved by compressing it to 'adjuster'.
+     */
+    std::string _encodeRecord(const char* data, int len, SizeAdjuster* adjuster) const;
+
+    /**
+     * Notes the removal of the stored 'value' of a record in 'adjuster', so that the data size
+     * tracks the uncompressed size of the remaining records.
+     */
+    void _noteRecordRemoved(const std::string& value, SizeAdjuster* adjuster) const;
+
+    /**
+     * Returns the record data for a stored value, decompressing it if needed.
+     */
+    static RecordData _decodeRecord(const std::string& value, bool compressed);
+
     /**
      *  Two helper functions for deleting excess records in capped record stores.
      *  The caller should not have an active SizeAdjuster.
@@ -151,6 +177,10 @@ private:
     bool _isOplog;
     VisibilityManager* _visibilityManager;
 
+    // Whether values are stored compressed. Capped collections are never compressed, as their
+    // size limits apply to the bytes actually held.
+    const bool _compressRecords;
+
     /**
      * Automatically adjust the record count and data size based on the size in change of the
      * underlying radix store during the life time of the SizeAdjuster.
@@ -161,12 +191,21 @@ private:
         SizeAdjuster(OperationContext* opCtx, RecordStore* rs);
         ~SizeAdjuster();
 
+        /**
+         * Compressed records are held in fewer bytes than their data size, so changes to the
+         * radix store's data size are corrected by the bytes that compression saved.
+         */
+        void addCompressionSavings(int64_t bytes) {
+            _compressionSavings += bytes;
+        }
+
     private:
         OperationContext* const _opCtx;
         RecordStore* const _rs;
         const StringStore* _workingCopy;
         const int64_t _origNumRecords;
         const int64_t _origDataSize;
+        int64_t _compressionSavings = 0;
     };
 
     class Cursor final : public SeekableRecordCursor {
@@ -180,12 +219,16 @@ private:
         bool _lastMoveWasRestore = false;
         bool _isCapped;
         bool _isOplog;
+        bool _compressRecords;
         VisibilityManager* _visibilityManager;
 
     public:
+        // A null 'start' or 'end' leaves that side of the cursor's range unbounded.
         Cursor(OperationContext* opCtx,
                const RecordStore& rs,
-               VisibilityManager* visibilityManager);
+               VisibilityManager* visibilityManager,
+               const RecordId& start = RecordId(),
+               const RecordId& end = RecordId());
         boost::optional<Record> next() final;
         boost::optional<Record> seekExact(const RecordId& id) final override;
         void save() final;
@@ -209,6 +252,7 @@ private:
         bool _lastMoveWasRestore = false;
         bool _isCapped;
         bool _isOplog;
+        bool _compressRecords;
         VisibilityManager* _visibilityManager;
 
     public:
@@ -33,72 +33,78 @@
 
 #include <memory>
 
-#include "mongo/base/init.h"
-#include "mongo/db/storage/biggie/biggie_kv_engine.h"
-#include "mongo/db/storage/biggie/biggie_recovery_unit.h"
-#include "mongo/db/storage/biggie/store.h"
 #include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
 namespace biggie {
 namespace {
 
-class RecordStoreHarnessHelper final : public ::mongo::RecordStoreHarnessHelper {
-    KVEngine _kvEngine{};
-    VisibilityManager _visibilityManager;
+TEST(BiggieRecordStoreTest, CompressedRecordsRoundTrip) {
+    const auto harnessHelper = newRecordStoreHarnessHelper();
+    RecordStore rs("a.b",
+                   "ident"_sd,
+                   false /* isCapped */,
+                   -1 /* cappedMaxSize */,
+                   -1 /* cappedMaxDocs */,
+                   nullptr /* cappedCallback */,
+                   nullptr /* visibilityManager */,
+                   true /* compressRecords */);
 
-public:
-    RecordStoreHarnessHelper() {}
-
-    virtual std::unique_ptr<mongo::RecordStore> newNonCappedRecordStore() {
-        return newNonCappedRecordStore("a.b");
+    const std::string first(1000, 'a');
+    const std::string second(2000, 'b');
+    const std::string updated(500, 'c');
+    RecordId firstId, secondId;
+    {
+        auto opCtx = harnessHelper->newOperationContext();
+        WriteUnitOfWork wuow(opCtx.get());
+        firstId = unittest::assertGet(
+            rs.insertRecord(opCtx.get(), first.c_str(), first.size(), Timestamp()));
+        secondId = unittest::assertGet(
+            rs.insertRecord(opCtx.get(), second.c_str(), second.size(), Timestamp()));
+        wuow.commit();
     }
 
-    virtual std::unique_ptr<mongo::RecordStore> newNonCappedRecordStore(const std::string& ns) {
-        return std::make_unique<RecordStore>(ns,
-                                             "ident"_sd /* ident */,
-                                             false /* isCapped */,
-                                             -1 /* cappedMaxSize */,
-                                             -1 /* cappedMaxDocs */,
-                                             nullptr /* cappedCallback */,
-                                             nullptr /* visibilityManager */);
-    }
+    {
+        // Records read back uncompressed, and the data size counts their uncompressed size.
+        auto opCtx = harnessHelper->newOperationContext();
+        ASSERT_EQ(static_cast<long long>(first.size() + second.size()), rs.dataSize(opCtx.get()));
+        ASSERT_EQ(first, std::string(rs.dataFor(opCtx.get(), firstId).data(), first.size()));
 
-    virtual std::unique_ptr<mongo::RecordStore> newCappedRecordStore(int64_t cappedSizeBytes,
-                                                                     int64_t cappedMaxDocs) {
-        return newCappedRecordStore("a.b", cappedSizeBytes, cappedMaxDocs);
+        auto cursor = rs.getCursor(opCtx.get(), true);
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(firstId, record->id);
+        ASSERT_EQ(static_cast<int>(first.size()), record->data.size());
+        record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(second, std::string(record->data.data(), record->data.size()));
+        ASSERT_FALSE(cursor->next());
     }
 
-    virtual std::unique_ptr<mongo::RecordStore> newCappedRecordStore(const std::string& ns,
-                                                                     int64_t cappedSizeBytes,
-                                                                     int64_t cappedMaxDocs) final {
-        return std::make_unique<RecordStore>(ns,
-                                             "ident"_sd,
-                                             /*isCapped*/ true,
-                                             cappedSizeBytes,
-                                             cappedMaxDocs,
-                                             /*cappedCallback*/ nullptr,
-                                             &_visibilityManager);
+    {
+        auto opCtx = harnessHelper->newOperationContext();
+        WriteUnitOfWork wuow(opCtx.get());
+        ASSERT_OK(rs.updateRecord(opCtx.get(), firstId, updated.c_str(), updated.size()));
+        rs.deleteRecord(opCtx.get(), secondId);
+        wuow.commit();
     }
 
-    std::unique_ptr<mongo::RecoveryUnit> newRecoveryUnit() final {
-        return std::make_unique<RecoveryUnit>(&_kvEngine);
-    }
+    {
+        auto opCtx = harnessHelper->newOperationContext();
+        ASSERT_EQ(static_cast<long long>(updated.size()), rs.dataSize(opCtx.get()));
+        ASSERT_EQ(1, rs.numRecords(opCtx.get()));
+        RecordData data = rs.dataFor(opCtx.get(), firstId);
+        ASSERT_EQ(updated, std::string(data.data(), data.size()));
 
-    bool supportsDocLocking() final {
-        return true;
+        WriteUnitOfWork wuow(opCtx.get());
+        ASSERT_OK(rs.truncate(opCtx.get()));
+        wuow.commit();
+        ASSERT_EQ(0, rs.dataSize(opCtx.get()));
     }
-};
-
-std::unique_ptr<mongo::RecordStoreHarnessHelper> makeBiggieRecordStoreHarnessHelper() {
-    return std::make_unique<RecordStoreHarnessHelper>();
 }
 
-MONGO_INITIALIZER(RegisterRecordStoreHarnessFactory)(InitializerContext* const) {
-    mongo::registerRecordStoreHarnessHelperFactory(makeBiggieRecordStoreHarnessHelper);
-    return Status::OK();
-}
 }  // namespace
 }  // namespace biggie
 }  // namespace mongo
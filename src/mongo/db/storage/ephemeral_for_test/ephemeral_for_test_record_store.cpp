@@ -31,6 +31,7 @@
 
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_record_store.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/jsobj.h"
@@ -124,19 +125,25 @@ private:
 
 class EphemeralForTestRecordStore::Cursor final : public SeekableRecordCursor {
 public:
-    Cursor(OperationContext* opCtx, const EphemeralForTestRecordStore& rs)
-        : _records(rs._data->records), _isCapped(rs.isCapped()) {}
+    /**
+     * A null 'start' or 'end' leaves that side of the cursor's range unbounded.
+     */
+    Cursor(OperationContext* opCtx,
+           const EphemeralForTestRecordStore& rs,
+           const RecordId& start = RecordId(),
+           const RecordId& end = RecordId())
+        : _records(rs._data->records), _isCapped(rs.isCapped()), _start(start), _end(end) {}
 
     boost::optional<Record> next() final {
         if (_needFirstSeek) {
             _needFirstSeek = false;
-            _it = _records.begin();
+            _it = _start.isNull() ? _records.begin() : _records.lower_bound(_start);
         } else if (!_lastMoveWasRestore && _it != _records.end()) {
             ++_it;
         }
         _lastMoveWasRestore = false;
 
-        if (_it == _records.end())
+        if (_it == _records.end() || !inRange(_it->first))
             return {};
         return {{_it->first, _it->second.toRecordData()}};
     }
@@ -145,7 +152,7 @@ public:
         _lastMoveWasRestore = false;
         _needFirstSeek = false;
         _it = _records.find(id);
-        if (_it == _records.end())
+        if (_it == _records.end() || !inRange(id))
             return {};
         return {{_it->first, _it->second.toRecordData()}};
     }
@@ -176,6 +183,10 @@ public:
     void reattachToOperationContext(OperationContext* opCtx) final {}
 
 private:
+    bool inRange(const RecordId& id) const {
+        return id >= _start && (_end.isNull() || id < _end);
+    }
+
     Records::const_iterator _it;
     bool _needFirstSeek = true;
     bool _lastMoveWasRestore = false;
@@ -183,6 +194,8 @@ private:
 
     const EphemeralForTestRecordStore::Records& _records;
     const bool _isCapped;
+    const RecordId _start;
+    const RecordId _end;
 };
 
 class EphemeralForTestRecordStore::ReverseCursor final : public SeekableRecordCursor {
@@ -514,6 +527,30 @@ std::unique_ptr<SeekableRecordCursor> EphemeralForTestRecordStore::getCursor(
     return std::make_unique<ReverseCursor>(opCtx, *this);
 }
 
+std::vector<RecordId> EphemeralForTestRecordStore::getRangeBoundaries(OperationContext* opCtx,
+                                                                      size_t numRanges) const {
+    stdx::lock_guard<stdx::recursive_mutex> lock(_data->recordsMutex);
+    const auto& records = _data->records;
+    std::vector<RecordId> boundaries;
+    if (numRanges <= 1 || records.empty())
+        return boundaries;
+
+    // The records are all in memory, so split them exactly.
+    const size_t recordsPerRange = std::max<size_t>(records.size() / numRanges, 1);
+    size_t i = 0;
+    for (auto it = records.begin(); it != records.end() && boundaries.size() < numRanges - 1;
+         ++it, ++i) {
+        if (i > 0 && i % recordsPerRange == 0)
+            boundaries.push_back(it->first);
+    }
+    return boundaries;
+}
+
+std::unique_ptr<SeekableRecordCursor> EphemeralForTestRecordStore::getRangeCursor(
+    OperationContext* opCtx, const RecordId& start, const RecordId& end) const {
+    return std::make_unique<Cursor>(opCtx, *this, start, end);
+}
+
 Status EphemeralForTestRecordStore::truncate(OperationContext* opCtx) {
     // Unlike other changes, TruncateChange mutates _data on construction to perform the
     // truncate
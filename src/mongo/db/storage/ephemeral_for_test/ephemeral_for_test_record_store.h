@@ -87,6 +87,13 @@ public:
     std::unique_ptr<SeekableRecordCursor> getCursor(OperationContext* opCtx,
                                                     bool forward) const final;
 
+    std::vector<RecordId> getRangeBoundaries(OperationContext* opCtx,
+                                             size_t numRanges) const final;
+
+    std::unique_ptr<SeekableRecordCursor> getRangeCursor(OperationContext* opCtx,
+                                                         const RecordId& start,
+                                                         const RecordId& end) const final;
+
     virtual Status truncate(OperationContext* opCtx);
 
     virtual void cappedTruncateAfter(OperationContext* opCtx, RecordId end, bool inclusive);
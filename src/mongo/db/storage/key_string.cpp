@@ -2317,46 +2317,50 @@ void TypeBits::appendDecimalExponent(uint8_t storedExponentBits) {
         appendBit((storedExponentBits >> bitPos) & 1);
 }
 
-uint8_t TypeBits::Reader::readBit() {
+uint32_t TypeBits::Reader::readBits(uint8_t numBits) {
+    dassert(numBits > 0 && numBits <= 16);
     if (_typeBits._isAllZeros)
         return 0;
 
-    const uint32_t byte = _curBit / 8;
-    const uint8_t offsetInByte = _curBit % 8;
-    _curBit++;
+    const uint32_t firstByte = _curBit / 8;
+    const uint32_t lastByte = (_curBit + numBits - 1) / 8;
+    keyStringAssert(50615, "Invalid size byte(s).", lastByte < _typeBits.getDataBufferLen());
 
-    keyStringAssert(50615, "Invalid size byte(s).", byte < _typeBits.getDataBufferLen());
+    // The requested bits span at most three bytes. Gather them into one word, with the first bit
+    // to read in the lowest position.
+    const auto data = reinterpret_cast<const uint8_t*>(_typeBits.getDataBuffer());
+    uint32_t window = 0;
+    for (uint32_t byte = firstByte; byte <= lastByte; byte++)
+        window |= static_cast<uint32_t>(data[byte]) << (8 * (byte - firstByte));
+    window >>= _curBit % 8;
+    _curBit += numBits;
 
-    return (_typeBits.getDataBuffer()[byte] & (1 << offsetInByte)) ? 1 : 0;
+    // Bits were appended starting from the low bit of each byte, but the first one read is the
+    // high bit of the result.
+    uint32_t result = 0;
+    for (uint8_t bit = 0; bit < numBits; bit++)
+        result = (result << 1) | ((window >> bit) & 1);
+    return result;
 }
 
 uint8_t TypeBits::Reader::readZero() {
     uint8_t res = readNumeric();
 
     // For keyString v1, negative and decimal zeros require at least 3 more bits.
-    if (_typeBits.version != Version::V0 && res == kSpecialZeroPrefix) {
-        res = (res << 1) | readBit();
-        res = (res << 1) | readBit();
-        res = (res << 1) | readBit();
-    }
+    if (_typeBits.version != Version::V0 && res == kSpecialZeroPrefix)
+        res = (res << 3) | readBits(3);
     if (res == kV1NegativeDoubleZero || res == kV0NegativeDoubleZero)
         res = kNegativeDoubleZero;
     return res;
 }
 
 uint32_t TypeBits::Reader::readDecimalZero(uint8_t zeroType) {
-    uint32_t whichZero = zeroType - kDecimalZero0xxx;
-    for (int bitPos = 11; bitPos >= 0; bitPos--)
-        whichZero = (whichZero << 1) | readBit();
-
-    return whichZero;
+    const uint32_t whichZero = zeroType - kDecimalZero0xxx;
+    return (whichZero << 12) | readBits(12);
 }
 
 uint8_t TypeBits::Reader::readDecimalExponent() {
-    uint8_t exponentBits = 0;
-    for (int bitPos = kStoredDecimalExponentBits - 1; bitPos >= 0; bitPos--)
-        exponentBits = (exponentBits << 1) | readBit();
-    return exponentBits;
+    return readBits(kStoredDecimalExponentBits);
 }
 
 size_t getKeySize(const char* buffer, size_t len, Ordering ord, const TypeBits& typeBits) {
@@ -235,8 +235,7 @@ public:
             return readBit();
         }
         uint8_t readNumeric() {
-            uint8_t highBit = readBit();
-            return (highBit << 1) | readBit();
+            return readBits(2);
         }
         uint8_t readZero();
 
@@ -248,7 +247,13 @@ public:
         uint8_t readDecimalExponent();
 
     private:
-        uint8_t readBit();
+        uint8_t readBit() {
+            return readBits(1);
+        }
+
+        // Reads the next 'numBits' bits, at most 16, as a number whose high bit is the first bit
+        // read. Checks the buffer bounds once for the whole group rather than once per bit.
+        uint32_t readBits(uint8_t numBits);
 
         uint32_t _curBit;
         const TypeBits& _typeBits;
@@ -400,6 +405,37 @@ public:
         return deserialize(buf, settings.keyStringVersion);
     }
 
+    // Used by the Sorter when spilling prefix-compressed keys. Places the keystring size after the
+    // keystring and typebits, so that keys of differing lengths still share their leading bytes:
+    //   [keystring encoding][typebits encoding][keystring size]
+    void serializeForSorterPrefixCompressed(BufBuilder& buf) const {
+        buf.appendBuf(_buffer.get(), _bufSize);
+        buf.appendNum(_ksSize);
+    }
+
+    static Value deserializeForSorterPrefixCompressed(const char* data,
+                                                      size_t size,
+                                                      const SorterDeserializeSettings& settings) {
+        invariant(size >= sizeof(int32_t));
+        const size_t bufSize = size - sizeof(int32_t);
+        const int32_t sizeOfKeystring =
+            ConstDataView(data + bufSize).read<LittleEndian<int32_t>>();
+        invariant(sizeOfKeystring >= 0 && static_cast<size_t>(sizeOfKeystring) <= bufSize);
+
+        // Normalize the typebits the same way deserialize() does.
+        BufReader typeBitsReader(data + sizeOfKeystring, bufSize - sizeOfKeystring);
+        auto typeBits = TypeBits::fromBuffer(settings.keyStringVersion, &typeBitsReader);
+
+        BufBuilder newBuf;
+        newBuf.appendBuf(data, sizeOfKeystring);
+        if (typeBits.isAllZeros()) {
+            newBuf.appendChar(0);
+        } else {
+            newBuf.appendBuf(typeBits.getBuffer(), typeBits.getSize());
+        }
+        return {settings.keyStringVersion, sizeOfKeystring, newBuf.len(), newBuf.release()};
+    }
+
     int memUsageForSorter() const {
         // Use buffer capacity as a more accurate measure of memory usage.
         return sizeof(Value) + _buffer.capacity();
@@ -624,6 +624,36 @@ TEST_F(KeyStringBuilderTest, KeyStringGetValueCopyTest) {
     COMPARE_KS_BSON(data2, BSON("" << 1), ALL_ASCENDING);
 }
 
+TEST_F(KeyStringBuilderTest, KeyStringValuePrefixCompressedSorterRoundTrip) {
+    const KeyString::Value::SorterDeserializeSettings settings(version);
+    for (auto&& bson : {BSON("" << 1 << ""
+                                << "abc"),
+                        BSON("" << 1.0 << ""
+                                << "abcdefgh"),
+                        BSON("" << BSONNULL)}) {
+        KeyString::HeapBuilder ks(version, bson, ALL_ASCENDING, RecordId(7));
+        KeyString::Value value = ks.release();
+
+        BufBuilder buf;
+        value.serializeForSorterPrefixCompressed(buf);
+        KeyString::Value restored =
+            KeyString::Value::deserializeForSorterPrefixCompressed(buf.buf(), buf.len(), settings);
+
+        ASSERT_EQ(value.compare(restored), 0);
+        ASSERT_EQ(value.getSize(), restored.getSize());
+        COMPARE_KS_BSON(restored, bson, ALL_ASCENDING);
+    }
+
+    // Keys of different lengths keep their common leading bytes in this format.
+    KeyString::HeapBuilder shortKey(version, BSON("" << "abc"), ALL_ASCENDING);
+    KeyString::HeapBuilder longKey(version, BSON("" << "abcdefgh"), ALL_ASCENDING);
+    BufBuilder shortBuf;
+    BufBuilder longBuf;
+    shortKey.release().serializeForSorterPrefixCompressed(shortBuf);
+    longKey.release().serializeForSorterPrefixCompressed(longBuf);
+    ASSERT_EQ(memcmp(shortBuf.buf(), longBuf.buf(), 4), 0);
+}
+
 TEST_F(KeyStringBuilderTest, KeyStringBuilderAppendBsonElement) {
     // Test that appendBsonElement works.
     {
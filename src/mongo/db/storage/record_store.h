@@ -37,6 +37,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/record_data.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -109,6 +110,13 @@ public:
      */
     virtual boost::optional<Record> next() = 0;
 
+    /**
+     * Hints that the caller intends to read a long run of records with next(), so that the storage
+     * engine may read records past the cursor's position into its cache ahead of time. Ignored by
+     * storage engines and cursors which do not implement read-ahead.
+     */
+    virtual void setReadAheadHint() {}
+
     //
     // Saving and restoring state
     //
@@ -386,6 +394,59 @@ public:
         return {};
     }
 
+    /**
+     * Like getRandomCursor(), but informs the storage engine that the caller intends to read about
+     * 'expectedSampleSize' records. This allows an engine to return records spread evenly across
+     * the record store at the cost of strict independence between consecutive samples, for example
+     * by skipping through the record store's pages rather than repositioning from the root for
+     * every record. Returns a plain random cursor by default.
+     */
+    virtual std::unique_ptr<RecordCursor> getSamplingCursor(OperationContext* opCtx,
+                                                            size_t expectedSampleSize) const {
+        return getRandomCursor(opCtx);
+    }
+
+    /**
+     * Called by the write paths before they start a WriteUnitOfWork to write to this record store.
+     * A storage engine may return a positive delay to throttle writes to this collection, for
+     * instance while its cache holds too much dirty data. The caller waits for that long after
+     * releasing its locks, so that throttled writers do not hold up others.
+     */
+    virtual Milliseconds getWriteAdmissionDelay(OperationContext* opCtx) {
+        return Milliseconds(0);
+    }
+
+    /**
+     * Returns up to 'numRanges' - 1 RecordIds, in increasing order, which split this record store
+     * into ranges holding approximately equal numbers of records. The first range starts at the
+     * beginning of the record store, each boundary is the inclusive start of the next range and
+     * the last range extends to the end. Cursors from getRangeCursor() over consecutive ranges
+     * together return every record a single forward cursor would, which allows one record store to
+     * be scanned from multiple threads.
+     *
+     * The boundaries are an estimate and may be computed from a sample of the records. Returns {}
+     * if the record store is empty or does not support range cursors, in which case callers should
+     * scan it with a single cursor.
+     */
+    virtual std::vector<RecordId> getRangeBoundaries(OperationContext* opCtx,
+                                                     size_t numRanges) const {
+        return {};
+    }
+
+    /**
+     * Returns a forward cursor over the records whose RecordIds are in the range [start, end). A
+     * null 'start' or 'end' leaves that side of the range unbounded. Besides returning no records
+     * outside of the range from next() and seekExact(), the cursor behaves as one returned by
+     * getCursor().
+     *
+     * Returns {} if range cursors are not supported, as they may not be for capped collections.
+     */
+    virtual std::unique_ptr<SeekableRecordCursor> getRangeCursor(OperationContext* opCtx,
+                                                                 const RecordId& start,
+                                                                 const RecordId& end) const {
+        return {};
+    }
+
     // higher level
 
 
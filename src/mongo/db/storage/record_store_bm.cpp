@@ -0,0 +1,219 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/mutable/damage_vector.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/db/storage/write_unit_of_work.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Benchmarks for the RecordStore interface. They run against whichever storage engine registered
+ * its harness through registerRecordStoreHarnessHelperFactory(), so linking this file with an
+ * engine's record store harness yields a benchmark of that engine.
+ */
+
+const int kNumPreloadedRecords = 10 * 1000;
+
+// BM_RecordStoreInsert truncates the record store, untimed, once it holds this many records, so
+// that long runs measure inserts into a store of bounded size rather than an ever-growing one.
+const int kMaxInsertedRecords = 100 * 1000;
+
+class RecordStoreFixture {
+public:
+    explicit RecordStoreFixture(int valueSize)
+        : _harnessHelper(newRecordStoreHarnessHelper()),
+          _rs(_harnessHelper->newNonCappedRecordStore()),
+          _opCtx(_harnessHelper->newOperationContext()),
+          _value(valueSize, 'x') {}
+
+    void preload(int numRecords) {
+        WriteUnitOfWork wuow(opCtx());
+        for (int i = 0; i < numRecords; ++i) {
+            _ids.push_back(insert());
+        }
+        wuow.commit();
+    }
+
+    RecordId insert() {
+        auto swId = _rs->insertRecord(opCtx(), _value.c_str(), _value.size(), Timestamp());
+        invariant(swId.getStatus());
+        return swId.getValue();
+    }
+
+    OperationContext* opCtx() {
+        return _opCtx.get();
+    }
+
+    RecordStore* rs() {
+        return _rs.get();
+    }
+
+    const std::string& value() const {
+        return _value;
+    }
+
+    const std::vector<RecordId>& ids() const {
+        return _ids;
+    }
+
+private:
+    std::unique_ptr<RecordStoreHarnessHelper> _harnessHelper;
+    std::unique_ptr<RecordStore> _rs;
+    ServiceContext::UniqueOperationContext _opCtx;
+    std::string _value;
+    std::vector<RecordId> _ids;
+};
+
+void BM_RecordStoreInsert(benchmark::State& state) {
+    RecordStoreFixture fixture(state.range(0));
+    int numInserted = 0;
+    for (auto _ : state) {
+        if (numInserted == kMaxInsertedRecords) {
+            state.PauseTiming();
+            WriteUnitOfWork wuow(fixture.opCtx());
+            invariant(fixture.rs()->truncate(fixture.opCtx()));
+            wuow.commit();
+            numInserted = 0;
+            state.ResumeTiming();
+        }
+
+        WriteUnitOfWork wuow(fixture.opCtx());
+        benchmark::DoNotOptimize(fixture.insert());
+        wuow.commit();
+        ++numInserted;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Replaces whole records with values of the same size through updateRecord().
+ */
+void BM_RecordStoreUpdateRecord(benchmark::State& state) {
+    RecordStoreFixture fixture(state.range(0));
+    fixture.preload(kNumPreloadedRecords);
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& id = fixture.ids()[i++ % fixture.ids().size()];
+        WriteUnitOfWork wuow(fixture.opCtx());
+        invariant(fixture.rs()->updateRecord(
+            fixture.opCtx(), id, fixture.value().c_str(), fixture.value().size()));
+        wuow.commit();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Overwrites the first eight bytes of each record in place through updateWithDamages(). Engines
+ * that do not support damage updates skip this benchmark.
+ */
+void BM_RecordStoreUpdateWithDamages(benchmark::State& state) {
+    RecordStoreFixture fixture(state.range(0));
+    if (!fixture.rs()->updateWithDamagesSupported()) {
+        state.SkipWithError("updateWithDamages is not supported by this storage engine");
+        return;
+    }
+
+    fixture.preload(kNumPreloadedRecords);
+    const std::string damageSource(8, 'y');
+    const mutablebson::DamageVector damages{{0 /* sourceOffset */, 0 /* targetOffset */, 8}};
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& id = fixture.ids()[i++ % fixture.ids().size()];
+        WriteUnitOfWork wuow(fixture.opCtx());
+        const RecordData oldRec = fixture.rs()->dataFor(fixture.opCtx(), id);
+        auto swNewRec = fixture.rs()->updateWithDamages(
+            fixture.opCtx(), id, oldRec, damageSource.c_str(), damages);
+        invariant(swNewRec.getStatus());
+        wuow.commit();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RecordStorePointSeek(benchmark::State& state) {
+    RecordStoreFixture fixture(state.range(0));
+    fixture.preload(kNumPreloadedRecords);
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<size_t> dist(0, fixture.ids().size() - 1);
+    auto cursor = fixture.rs()->getCursor(fixture.opCtx());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cursor->seekExact(fixture.ids()[dist(gen)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RecordStoreRangeScan(benchmark::State& state) {
+    RecordStoreFixture fixture(state.range(0));
+    fixture.preload(kNumPreloadedRecords);
+    for (auto _ : state) {
+        auto cursor = fixture.rs()->getCursor(fixture.opCtx());
+        while (auto record = cursor->next()) {
+            benchmark::DoNotOptimize(record);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumPreloadedRecords);
+}
+
+void BM_RecordStoreCursorSaveRestore(benchmark::State& state) {
+    RecordStoreFixture fixture(state.range(0));
+    fixture.preload(kNumPreloadedRecords);
+    auto cursor = fixture.rs()->getCursor(fixture.opCtx());
+    for (auto _ : state) {
+        if (!cursor->next()) {
+            cursor = fixture.rs()->getCursor(fixture.opCtx());
+            continue;
+        }
+        cursor->save();
+        invariant(cursor->restore());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RecordStoreInsert)->RangeMultiplier(8)->Range(16, 16 * 1024);
+BENCHMARK(BM_RecordStoreUpdateRecord)->RangeMultiplier(8)->Range(16, 16 * 1024);
+BENCHMARK(BM_RecordStoreUpdateWithDamages)->RangeMultiplier(8)->Range(16, 16 * 1024);
+BENCHMARK(BM_RecordStorePointSeek)->RangeMultiplier(8)->Range(16, 16 * 1024);
+BENCHMARK(BM_RecordStoreRangeScan)->RangeMultiplier(8)->Range(16, 16 * 1024);
+BENCHMARK(BM_RecordStoreCursorSaveRestore)->RangeMultiplier(8)->Range(16, 16 * 1024);
+
+}  // namespace
+}  // namespace mongo
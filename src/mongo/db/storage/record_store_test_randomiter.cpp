@@ -124,6 +124,47 @@ TEST(RecordStoreTestHarness, GetRandomIteratorNonEmpty) {
     }
 }
 
+// Insert multiple records and sample them with a cursor told the expected sample size.
+TEST(RecordStoreTestHarness, GetSamplingIteratorNonEmpty) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const unsigned nToInsert = 5000;
+    set<RecordId> inserted;
+    for (unsigned i = 0; i < nToInsert; i++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        stringstream ss;
+        ss << "record " << i;
+        string data = ss.str();
+
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+        ASSERT_OK(res.getStatus());
+        inserted.insert(res.getValue());
+        uow.commit();
+    }
+
+    {
+        const unsigned nSamples = 100;
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto cursor = rs->getSamplingCursor(opCtx.get(), nSamples);
+        // returns NULL if random cursors are not supported
+        if (!cursor) {
+            return;
+        }
+
+        set<RecordId> sampled;
+        for (unsigned i = 0; i < nSamples; i++) {
+            auto record = cursor->next();
+            ASSERT(record);
+            ASSERT_EQ(1U, inserted.count(record->id));
+            sampled.insert(record->id);
+        }
+        ASSERT_GT(sampled.size(), 1U);
+    }
+}
+
 // Insert a single record. Create a random iterator pointing to that single record.
 // Then check we'll retrieve the record.
 TEST(RecordStoreTestHarness, GetRandomIteratorSingleton) {
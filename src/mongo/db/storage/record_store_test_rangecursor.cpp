@@ -0,0 +1,187 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_data.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+vector<RecordId> insertRecords(RecordStoreHarnessHelper* harnessHelper,
+                               RecordStore* rs,
+                               int nToInsert) {
+    vector<RecordId> locs;
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    for (int i = 0; i < nToInsert; i++) {
+        string data = str::stream() << "record " << i;
+
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+        ASSERT_OK(res.getStatus());
+        locs.push_back(res.getValue());
+        uow.commit();
+    }
+    return locs;
+}
+
+// Scanning every range returned by getRangeBoundaries() returns each record once, in order.
+TEST(RecordStoreTestHarness, RangeCursorsCoverRecordStore) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 1000;
+    const auto locs = insertRecords(harnessHelper.get(), rs.get(), nToInsert);
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    const size_t numRanges = 4;
+    auto boundaries = rs->getRangeBoundaries(opCtx.get(), numRanges);
+    // returns {} if range cursors are not supported
+    if (boundaries.empty()) {
+        return;
+    }
+    ASSERT_LT(boundaries.size(), numRanges);
+    for (size_t i = 1; i < boundaries.size(); i++) {
+        ASSERT_LT(boundaries[i - 1], boundaries[i]);
+    }
+
+    vector<RecordId> starts{RecordId()};
+    starts.insert(starts.end(), boundaries.begin(), boundaries.end());
+    vector<RecordId> ends(boundaries.begin(), boundaries.end());
+    ends.push_back(RecordId());
+
+    vector<RecordId> scanned;
+    for (size_t i = 0; i < starts.size(); i++) {
+        auto cursor = rs->getRangeCursor(opCtx.get(), starts[i], ends[i]);
+        ASSERT(cursor);
+        size_t recordsInRange = 0;
+        while (auto record = cursor->next()) {
+            ASSERT_GTE(record->id, starts[i]);
+            if (!ends[i].isNull()) {
+                ASSERT_LT(record->id, ends[i]);
+            }
+            scanned.push_back(record->id);
+            recordsInRange++;
+        }
+        ASSERT_GT(recordsInRange, 0U);
+    }
+    ASSERT(scanned == locs);
+}
+
+// A range cursor returns only records in [start, end), including across save and restore.
+TEST(RecordStoreTestHarness, RangeCursorIsBounded) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 30;
+    const auto locs = insertRecords(harnessHelper.get(), rs.get(), nToInsert);
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursor = rs->getRangeCursor(opCtx.get(), locs[10], locs[20]);
+    // returns NULL if range cursors are not supported
+    if (!cursor) {
+        return;
+    }
+
+    // Saving and restoring before the first call to next() keeps the start of the range.
+    cursor->save();
+    ASSERT_TRUE(cursor->restore());
+
+    for (int i = 10; i < 20; i++) {
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(locs[i], record->id);
+
+        cursor->save();
+        ASSERT_TRUE(cursor->restore());
+    }
+    ASSERT(!cursor->next());
+
+    ASSERT(!cursor->seekExact(locs[5]));
+    ASSERT(!cursor->seekExact(locs[20]));
+    auto record = cursor->seekExact(locs[15]);
+    ASSERT(record);
+    ASSERT_EQ(locs[15], record->id);
+}
+
+// The position of a cursor restored after saveUnpositioned() is unspecified, but a range cursor
+// still never returns records outside of its range.
+TEST(RecordStoreTestHarness, RangeCursorStaysInRangeAfterSaveUnpositioned) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 30;
+    const auto locs = insertRecords(harnessHelper.get(), rs.get(), nToInsert);
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursor = rs->getRangeCursor(opCtx.get(), locs[10], locs[20]);
+    // returns NULL if range cursors are not supported
+    if (!cursor) {
+        return;
+    }
+
+    auto assertRestOfScanInRange = [&] {
+        while (auto record = cursor->next()) {
+            ASSERT_GTE(record->id, locs[10]);
+            ASSERT_LT(record->id, locs[20]);
+        }
+    };
+
+    // Before the first call to next().
+    cursor->saveUnpositioned();
+    ASSERT_TRUE(cursor->restore());
+    assertRestOfScanInRange();
+
+    // Part way through the range.
+    auto record = cursor->seekExact(locs[15]);
+    ASSERT(record);
+    cursor->saveUnpositioned();
+    ASSERT_TRUE(cursor->restore());
+    assertRestOfScanInRange();
+
+    // After the end of the range.
+    cursor->saveUnpositioned();
+    ASSERT_TRUE(cursor->restore());
+    assertRestOfScanInRange();
+}
+
+}  // namespace
+}  // namespace mongo
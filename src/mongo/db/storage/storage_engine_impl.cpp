@@ -56,6 +56,7 @@
 #include "mongo/util/assert_util.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -86,6 +87,7 @@ StorageEngineImpl::StorageEngineImpl(KVEngine* engine, StorageEngineOptions opti
 }
 
 void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
+    Timer loadTimer;
     bool catalogExists = _engine->hasIdent(opCtx, catalogInfo);
     if (_options.forRepair && catalogExists) {
         auto repairObserver = StorageRepairObserver::get(getGlobalServiceContext());
@@ -130,6 +132,7 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
     _catalog.reset(new DurableCatalogImpl(
         _catalogRecordStore.get(), _options.directoryPerDB, _options.directoryForIndexes, this));
     _catalog->init(opCtx);
+    const auto catalogInitMillis = loadTimer.millis();
 
     // We populate 'identsKnownToStorageEngine' only if we are loading after an unclean shutdown or
     // doing repair.
@@ -192,6 +195,8 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
         }
     }
 
+    const auto readEntriesMillis = loadTimer.millis();
+
     KVPrefix maxSeenPrefix = KVPrefix::kNotPrefixed;
     for (DurableCatalog::Entry entry : catalogEntries) {
         if (loadingFromUncleanShutdownOrRepair) {
@@ -230,8 +235,8 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair);
-        auto maxPrefixForCollection = _catalog->getMetaData(opCtx, entry.catalogId).getMaxPrefix();
+        auto md = _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair);
+        auto maxPrefixForCollection = md.getMaxPrefix();
         maxSeenPrefix = std::max(maxSeenPrefix, maxPrefixForCollection);
 
         if (entry.nss.isOrphanCollection()) {
@@ -245,12 +250,19 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
     // Unset the unclean shutdown flag to avoid executing special behavior if this method is called
     // after startup.
     startingAfterUncleanShutdown(getGlobalServiceContext()) = false;
+
+    const auto totalMillis = loadTimer.millis();
+    LOGV2(5100027,
+          "Loaded the durable catalog",
+          "numCollections"_attr = catalogEntries.size(),
+          "catalogInitMillis"_attr = catalogInitMillis,
+          "readEntriesMillis"_attr = readEntriesMillis - catalogInitMillis,
+          "initCollectionsMillis"_attr = totalMillis - readEntriesMillis,
+          "totalMillis"_attr = totalMillis);
 }
 
-void StorageEngineImpl::_initCollection(OperationContext* opCtx,
-                                        RecordId catalogId,
-                                        const NamespaceString& nss,
-                                        bool forRepair) {
+BSONCollectionCatalogEntry::MetaData StorageEngineImpl::_initCollection(
+    OperationContext* opCtx, RecordId catalogId, const NamespaceString& nss, bool forRepair) {
     BSONCollectionCatalogEntry::MetaData md = _catalog->getMetaData(opCtx, catalogId);
     uassert(ErrorCodes::MustDowngrade,
             str::stream() << "Collection does not have UUID in KVCatalog. Collection: " << nss,
@@ -268,13 +280,14 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
         invariant(rs);
     }
 
-    auto uuid = _catalog->getCollectionOptions(opCtx, catalogId).uuid.get();
+    auto uuid = md.options.uuid.get();
 
     auto collectionFactory = Collection::Factory::get(getGlobalServiceContext());
     auto collection = collectionFactory->make(opCtx, nss, catalogId, uuid, std::move(rs));
 
     auto& collectionCatalog = CollectionCatalog::get(getGlobalServiceContext());
     collectionCatalog.registerCollection(uuid, &collection);
+    return md;
 }
 
 void StorageEngineImpl::closeCatalog(OperationContext* opCtx) {
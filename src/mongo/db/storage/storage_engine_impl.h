@@ -376,10 +376,15 @@ public:
 private:
     using CollIter = std::list<std::string>::iterator;
 
-    void _initCollection(OperationContext* opCtx,
-                         RecordId catalogId,
-                         const NamespaceString& nss,
-                         bool forRepair);
+    /**
+     * Opens the record store for the collection and registers it with the CollectionCatalog.
+     * Returns the catalog metadata read for the collection so that callers do not have to parse
+     * the catalog entry again.
+     */
+    BSONCollectionCatalogEntry::MetaData _initCollection(OperationContext* opCtx,
+                                                         RecordId catalogId,
+                                                         const NamespaceString& nss,
+                                                         bool forRepair);
 
     Status _dropCollectionsNoTimestamp(OperationContext* opCtx,
                                        std::vector<NamespaceString>& toDrop);
@@ -760,6 +760,7 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     }
 
     _sessionCache.reset(new WiredTigerSessionCache(this));
+    _writeAdmission = std::make_unique<WiredTigerWriteAdmission>(_sessionCache.get());
 
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
@@ -823,9 +824,71 @@ void WiredTigerKVEngine::startAsyncThreads() {
                 std::make_unique<WiredTigerCheckpointThread>(this, _sessionCache.get());
             _checkpointThread->go();
         }
+
+        ThreadPool::Options options;
+        options.poolName = "WTReadAhead";
+        options.minThreads = 0;
+        options.maxThreads = 4;
+        _readAheadPool = std::make_unique<ThreadPool>(options);
+        _readAheadPool->startup();
     }
 }
 
+void WiredTigerKVEngine::scheduleReadAhead(const std::string& uri,
+                                           std::shared_ptr<WiredTigerReadAheadState> state,
+                                           RecordId start,
+                                           int numRecords) {
+    invariant(state->inProgress.load());
+    if (!_readAheadPool) {
+        state->inProgress.store(false);
+        return;
+    }
+
+    _readAheadPool->schedule([this, uri, state, start, numRecords](Status status) {
+        ON_BLOCK_EXIT([&] { state->inProgress.store(false); });
+        if (!status.isOK()) {
+            return;
+        }
+
+        try {
+            auto session = _sessionCache->getSession();
+            WT_SESSION* s = session->getSession();
+
+            // Nothing read here is returned to anyone, so avoid the cost of a snapshot.
+            invariantWTOK(s->begin_transaction(s, "isolation=read-uncommitted"));
+            ON_BLOCK_EXIT([&] { invariantWTOK(s->rollback_transaction(s, nullptr)); });
+
+            WT_CURSOR* c = session->getNewCursor(uri, "");
+            ON_BLOCK_EXIT([&] { session->closeCursor(c); });
+
+            c->set_key(c, start.repr());
+            int cmp;
+            int ret = c->search_near(c, &cmp);
+            if (ret == 0 && cmp < 0)
+                ret = c->next(c);
+
+            int64_t key = 0;
+            for (int i = 0; ret == 0 && i < numRecords; i++) {
+                // Positioning on a record brings its page into the cache; getting the value also
+                // reads any overflow item holding it.
+                WT_ITEM value;
+                if (c->get_key(c, &key) != 0 || c->get_value(c, &value) != 0)
+                    break;
+                ret = c->next(c);
+            }
+            if (key > 0)
+                state->lastRecordIdRepr.store(key);
+        } catch (const DBException& ex) {
+            // The table may have been dropped since the read-ahead was scheduled.
+            LOGV2_DEBUG(5100014,
+                        2,
+                        "Read-ahead failed",
+                        "uri"_attr = uri,
+                        "error"_attr = ex.toStatus());
+        }
+    });
+}
+
 void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
     BSONObjBuilder bb(b.subobjStart("concurrentTransactions"));
     {
@@ -833,6 +896,9 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        bbb.append("queued", openWriteTransaction.queued());
+        bbb.append("totalTimeQueuedMicros",
+                   durationCount<Microseconds>(openWriteTransaction.totalTimeQueued()));
         bbb.done();
     }
     {
@@ -840,6 +906,9 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        bbb.append("queued", openReadTransaction.queued());
+        bbb.append("totalTimeQueuedMicros",
+                   durationCount<Microseconds>(openReadTransaction.totalTimeQueued()));
         bbb.done();
     }
     bb.done();
@@ -914,6 +983,11 @@ void WiredTigerKVEngine::cleanShutdown() {
         _checkpointThread->shutdown();
         LOGV2(22323, "Finished shutting down checkpoint thread");
     }
+    if (_readAheadPool) {
+        _readAheadPool->shutdown();
+        _readAheadPool->join();
+        _readAheadPool.reset();
+    }
     LOGV2_FOR_RECOVERY(23988,
                        2,
                        "Shutdown timestamps. StableTimestamp: {stableTimestamp_load} Initial data "
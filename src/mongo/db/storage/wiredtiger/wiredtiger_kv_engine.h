@@ -45,7 +45,9 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_write_admission.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/elapsed_tracker.h"
 
 namespace mongo {
@@ -57,6 +59,7 @@ class WiredTigerSessionCache;
 class WiredTigerSizeStorer;
 class WiredTigerEngineRuntimeConfigParameter;
 class WiredTigerMaxCacheOverflowSizeGBParameter;
+struct WiredTigerReadAheadState;
 
 struct WiredTigerFileVersion {
     enum class StartupVersion { IS_34, IS_36, IS_40, IS_42, IS_44 };
@@ -204,6 +207,17 @@ public:
 
     void cleanShutdown() override;
 
+    /**
+     * Reads up to 'numRecords' records from the record store table 'uri', starting at the first
+     * RecordId not less than 'start', into the cache on a background thread. Requires a table using
+     * the standard RecordId key format and 'state->inProgress' to be set; clears it when done.
+     * Read-ahead runs outside of any operation's snapshot and only serves to warm the cache.
+     */
+    void scheduleReadAhead(const std::string& uri,
+                           std::shared_ptr<WiredTigerReadAheadState> state,
+                           RecordId start,
+                           int numRecords);
+
     SnapshotManager* getSnapshotManager() const final {
         return &_sessionCache->snapshotManager();
     }
@@ -300,6 +314,10 @@ public:
         return _oplogManager.get();
     }
 
+    WiredTigerWriteAdmission* getWriteAdmission() const {
+        return _writeAdmission.get();
+    }
+
     static void appendGlobalStats(BSONObjBuilder& b);
 
     Timestamp getStableTimestamp() const override;
@@ -428,6 +446,9 @@ private:
     std::unique_ptr<WiredTigerSessionCache> _sessionCache;
     ClockSource* const _clockSource;
 
+    // Throttles writes to the collections filling the cache with dirty data.
+    std::unique_ptr<WiredTigerWriteAdmission> _writeAdmission;
+
     // Mutex to protect use of _oplogManagerCount by this instance of KV engine.
     mutable Mutex _oplogManagerMutex = MONGO_MAKE_LATCH("::_oplogManagerMutex");
     std::size_t _oplogManagerCount = 0;
@@ -456,6 +477,9 @@ private:
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
     std::unique_ptr<WiredTigerCheckpointThread> _checkpointThread;
 
+    // Runs the reads requested through scheduleReadAhead().
+    std::unique_ptr<ThreadPool> _readAheadPool;
+
     std::string _rsOptions;
     std::string _indexOptions;
 
@@ -33,6 +33,7 @@
 
 #include <cstring>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
@@ -41,6 +42,8 @@
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -118,6 +121,19 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     // Close transaction before we wait.
     opCtx->recoveryUnit()->abandonSnapshot();
 
+    Timer waitTimer;
+    auto recordWaitGuard = makeGuard([&] {
+        const long long micros = waitTimer.micros();
+        _visibilityWaits.fetchAndAdd(1);
+        _visibilityWaitTotalMicros.fetchAndAdd(micros);
+        size_t bucket = 0;
+        while (bucket < kVisibilityWaitBucketBoundsMicros.size() &&
+               micros >= kVisibilityWaitBucketBoundsMicros[bucket]) {
+            ++bucket;
+        }
+        _visibilityWaitBuckets[bucket].fetchAndAdd(1);
+    });
+
     stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
 
     // Prevent any scheduled journal flushes from being delayed and blocking this wait excessively.
@@ -254,6 +270,7 @@ void WiredTigerOplogManager::setOplogReadTimestamp(Timestamp ts) {
 
 void WiredTigerOplogManager::_setOplogReadTimestamp(WithLock, uint64_t newTimestamp) {
     _oplogReadTimestamp.store(newTimestamp);
+    _visibilityUpdates.fetchAndAdd(1);
     _opsBecameVisibleCV.notify_all();
     LOGV2_DEBUG(22374,
                 2,
@@ -261,6 +278,21 @@ void WiredTigerOplogManager::_setOplogReadTimestamp(WithLock, uint64_t newTimest
                 "Timestamp_newTimestamp"_attr = Timestamp(newTimestamp));
 }
 
+void WiredTigerOplogManager::appendVisibilityStats(BSONObjBuilder* builder) const {
+    BSONObjBuilder visibilityBuilder(builder->subobjStart("oplogVisibility"));
+    visibilityBuilder.append("updates", _visibilityUpdates.load());
+    visibilityBuilder.append("waits", _visibilityWaits.load());
+    visibilityBuilder.append("totalWaitMicros", _visibilityWaitTotalMicros.load());
+
+    BSONObjBuilder bucketsBuilder(visibilityBuilder.subobjStart("waitMicros"));
+    for (size_t i = 0; i < kVisibilityWaitBucketBoundsMicros.size(); ++i) {
+        bucketsBuilder.append(str::stream() << "lt" << kVisibilityWaitBucketBoundsMicros[i],
+                              _visibilityWaitBuckets[i].load());
+    }
+    bucketsBuilder.append(str::stream() << "ge" << kVisibilityWaitBucketBoundsMicros.back(),
+                          _visibilityWaitBuckets.back().load());
+}
+
 uint64_t WiredTigerOplogManager::fetchAllDurableValue(WT_CONNECTION* conn) {
     // Fetch the latest all_durable value from the storage engine. This value will be a timestamp
     // that has no holes (uncommitted transactions with lower timestamps) behind it.
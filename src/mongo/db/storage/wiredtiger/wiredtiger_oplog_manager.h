@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/thread.h"
@@ -37,6 +40,7 @@
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
 
@@ -88,6 +92,12 @@ public:
      */
     uint64_t fetchAllDurableValue(WT_CONNECTION* conn);
 
+    /**
+     * Appends counters describing how long operations waited in
+     * waitForAllEarlierOplogWritesToBeVisible() and how often the oplog read timestamp advanced.
+     */
+    void appendVisibilityStats(BSONObjBuilder* builder) const;
+
 private:
     void _oplogJournalThreadLoop(WiredTigerSessionCache* sessionCache,
                                  WiredTigerRecordStore* oplogRecordStore);
@@ -111,5 +121,16 @@ private:
     std::int64_t _opsWaitingForVisibility = 0;  // Guarded by oplogVisibilityStateMutex.
 
     AtomicWord<unsigned long long> _oplogReadTimestamp;
+
+    // Upper bounds, in microseconds, of the buckets of the visibility wait distribution. Waits
+    // longer than the last bound are counted in a final overflow bucket.
+    static constexpr std::array<long long, 4> kVisibilityWaitBucketBoundsMicros = {
+        1000, 10 * 1000, 100 * 1000, 1000 * 1000};
+
+    AtomicWord<long long> _visibilityWaits{0};
+    AtomicWord<long long> _visibilityWaitTotalMicros{0};
+    std::array<AtomicWord<long long>, kVisibilityWaitBucketBoundsMicros.size() + 1>
+        _visibilityWaitBuckets;
+    AtomicWord<long long> _visibilityUpdates{0};
 };
 }  // namespace mongo
@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_oplog_tail_cache.h"
+
+#include <cstring>
+
+namespace mongo {
+
+WiredTigerOplogTailCache::WiredTigerOplogTailCache(RecordId coveredFrom, long long maxBytes)
+    : _maxBytes(maxBytes),
+      _coveredFrom(coveredFrom),
+      _highestInserted(coveredFrom),
+      _coveredFromRepr(coveredFrom.repr()),
+      _highestInsertedRepr(coveredFrom.repr()) {}
+
+void WiredTigerOplogTailCache::insert(const Record* records, size_t nRecords) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (size_t i = 0; i < nRecords; i++) {
+        const auto& record = records[i];
+        if (record.id <= _coveredFrom) {
+            // Not needed to serve any reader the cache can answer for.
+            continue;
+        }
+
+        const int size = record.data.size();
+        auto data = SharedBuffer::allocate(size);
+        std::memcpy(data.get(), record.data.data(), size);
+        auto result = _entries.emplace(record.id, Entry{std::move(data), size});
+        invariant(result.second);
+        _bytes += size;
+        _highestInserted = std::max(_highestInserted, record.id);
+    }
+    _highestInsertedRepr.store(_highestInserted.repr());
+
+    while (_bytes > _maxBytes && !_entries.empty()) {
+        _evict(lk, _entries.begin());
+        _evicted.fetchAndAdd(1);
+    }
+}
+
+void WiredTigerOplogTailCache::commit(const std::vector<RecordId>& ids) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (const auto& id : ids) {
+        // The entry may have been evicted or invalidated while its transaction was running.
+        auto it = _entries.find(id);
+        if (it != _entries.end())
+            it->second.committed = true;
+    }
+}
+
+void WiredTigerOplogTailCache::abort(const std::vector<RecordId>& ids) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (const auto& id : ids) {
+        auto it = _entries.find(id);
+        if (it != _entries.end()) {
+            invariant(!it->second.committed);
+            _bytes -= it->second.size;
+            _entries.erase(it);
+        }
+    }
+}
+
+boost::optional<Record> WiredTigerOplogTailCache::next(const RecordId& lastReturned,
+                                                       std::int64_t visibleTs) {
+    // Every forward oplog cursor asks on every call to next(), so those the cache cannot answer
+    // for are turned away without touching anything shared by writers. A stale read here only
+    // sends the reader to the record store.
+    if (lastReturned.repr() < _coveredFromRepr.load() ||
+        lastReturned.repr() >= _highestInsertedRepr.load()) {
+        return boost::none;
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (lastReturned >= _coveredFrom) {
+            auto it = _entries.upper_bound(lastReturned);
+            if (it != _entries.end() && it->second.committed && it->first.repr() <= visibleTs) {
+                _hits.fetchAndAdd(1);
+                return Record{it->first, RecordData(it->second.data, it->second.size)};
+            }
+        }
+    }
+    _misses.fetchAndAdd(1);
+    return boost::none;
+}
+
+void WiredTigerOplogTailCache::truncateUpTo(const RecordId& lastRemoved) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    while (!_entries.empty() && _entries.begin()->first <= lastRemoved) {
+        _evict(lk, _entries.begin());
+    }
+    _setCoveredFrom(lk, std::max(_coveredFrom, lastRemoved));
+}
+
+void WiredTigerOplogTailCache::invalidate() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+    _bytes = 0;
+    _setCoveredFrom(lk, _highestInserted);
+    _invalidations.fetchAndAdd(1);
+}
+
+void WiredTigerOplogTailCache::appendStats(BSONObjBuilder* builder) const {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        builder->appendNumber("entries", static_cast<long long>(_entries.size()));
+        builder->appendNumber("bytes", _bytes);
+    }
+    builder->appendNumber("maxBytes", _maxBytes);
+    builder->appendNumber("hits", _hits.load());
+    builder->appendNumber("misses", _misses.load());
+    builder->appendNumber("evicted", _evicted.load());
+    builder->appendNumber("invalidations", _invalidations.load());
+}
+
+void WiredTigerOplogTailCache::_evict(WithLock lk, std::map<RecordId, Entry>::iterator it) {
+    _setCoveredFrom(lk, std::max(_coveredFrom, it->first));
+    _bytes -= it->second.size;
+    _entries.erase(it);
+}
+
+void WiredTigerOplogTailCache::_setCoveredFrom(WithLock, const RecordId& coveredFrom) {
+    _coveredFrom = coveredFrom;
+    _coveredFromRepr.store(coveredFrom.repr());
+}
+
+}  // namespace mongo
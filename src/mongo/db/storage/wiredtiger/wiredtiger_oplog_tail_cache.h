@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+
+/**
+ * Keeps copies of the most recently written oplog entries so that forward oplog cursors tailing
+ * the end of the oplog (oplog fetchers reading from this node, tailable cursors) can be served from
+ * shared immutable buffers instead of each positioning a WiredTiger cursor and reading the same
+ * entries again.
+ *
+ * Only readers bounded by the oplog visibility point are served. Readers of a majority committed
+ * snapshot, which includes change streams, have no visibility point and always read from the
+ * record store.
+ *
+ * Entries are added when they are inserted, before their transaction commits, and are only
+ * returned to readers once they have committed and are at or before the reader's oplog visibility
+ * point. Because every insert after construction passes through here, the cache knows that it
+ * holds every committed entry after the 'coveredFrom' point; a reader positioned at or after that
+ * point can take its next entry from the cache without missing one. Readers positioned before it,
+ * or whose next entry is not yet committed, fall back to the record store.
+ */
+class WiredTigerOplogTailCache {
+    WiredTigerOplogTailCache(const WiredTigerOplogTailCache&) = delete;
+    WiredTigerOplogTailCache& operator=(const WiredTigerOplogTailCache&) = delete;
+
+public:
+    /**
+     * 'coveredFrom' is the last entry in the oplog when the cache is created, or RecordId::min()
+     * if the oplog is empty. Oldest entries are evicted once the cache holds more than 'maxBytes'.
+     */
+    WiredTigerOplogTailCache(RecordId coveredFrom, long long maxBytes);
+
+    /**
+     * Adds the records being inserted by an uncommitted transaction. Exactly one of commit() or
+     * abort() must later be called with the same ids.
+     */
+    void insert(const Record* records, size_t nRecords);
+    void commit(const std::vector<RecordId>& ids);
+    void abort(const std::vector<RecordId>& ids);
+
+    /**
+     * Returns the first entry after 'lastReturned' if it can be served from the cache, that is,
+     * if the cache holds every entry after 'lastReturned' and the first of them has committed and
+     * is no later than 'visibleTs'. The returned record owns a reference to the cached buffer.
+     *
+     * Readers which the cache cannot answer for, because they are behind the covered range or
+     * already past every inserted entry, are turned away without taking the mutex.
+     */
+    boost::optional<Record> next(const RecordId& lastReturned, std::int64_t visibleTs);
+
+    /**
+     * Drops the entries up to and including 'lastRemoved' after the oplog was truncated there.
+     */
+    void truncateUpTo(const RecordId& lastRemoved);
+
+    /**
+     * Drops every entry. Used whenever existing oplog entries are modified or removed other than
+     * by truncating the oldest ones, after which only entries inserted later are served.
+     */
+    void invalidate();
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    struct Entry {
+        SharedBuffer data;
+        int size;
+        bool committed = false;
+    };
+
+    void _evict(WithLock, std::map<RecordId, Entry>::iterator it);
+
+    void _setCoveredFrom(WithLock, const RecordId& coveredFrom);
+
+    const long long _maxBytes;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerOplogTailCache::_mutex");
+    std::map<RecordId, Entry> _entries;
+    long long _bytes = 0;
+
+    // Every committed entry after this point is in '_entries'.
+    RecordId _coveredFrom;
+    RecordId _highestInserted;
+
+    // Copies of '_coveredFrom' and '_highestInserted' which next() reads without the mutex. They
+    // are only written with the mutex held.
+    AtomicWord<long long> _coveredFromRepr;
+    AtomicWord<long long> _highestInsertedRepr;
+
+    AtomicWord<long long> _hits{0};
+    AtomicWord<long long> _misses{0};
+    AtomicWord<long long> _evicted{0};
+    AtomicWord<long long> _invalidations{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_oplog_tail_cache.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class WiredTigerOplogTailCacheTest : public unittest::Test {
+protected:
+    void insert(WiredTigerOplogTailCache* cache, std::vector<RecordId> ids) {
+        std::vector<Record> records;
+        for (const auto& id : ids) {
+            records.push_back({id, RecordData(_data.objdata(), _data.objsize())});
+        }
+        cache->insert(records.data(), records.size());
+    }
+
+    const BSONObj _data = BSON("_id" << 1);
+};
+
+TEST_F(WiredTigerOplogTailCacheTest, ServesCommittedEntriesUpToVisibility) {
+    WiredTigerOplogTailCache cache(RecordId(10), 1024 * 1024);
+    insert(&cache, {RecordId(11), RecordId(12)});
+    ASSERT_FALSE(cache.next(RecordId(10), 12));
+
+    cache.commit({RecordId(11), RecordId(12)});
+    auto record = cache.next(RecordId(10), 11);
+    ASSERT(record);
+    ASSERT_EQ(RecordId(11), record->id);
+    ASSERT_BSONOBJ_EQ(_data, record->data.toBson());
+
+    // Entry 12 is committed but not yet visible to this reader.
+    ASSERT_FALSE(cache.next(RecordId(11), 11));
+    ASSERT_EQ(RecordId(12), cache.next(RecordId(11), 12)->id);
+    ASSERT_FALSE(cache.next(RecordId(12), 100));
+}
+
+TEST_F(WiredTigerOplogTailCacheTest, DoesNotSkipUncommittedHole) {
+    WiredTigerOplogTailCache cache(RecordId(10), 1024 * 1024);
+    insert(&cache, {RecordId(11)});
+    insert(&cache, {RecordId(12)});
+    cache.commit({RecordId(12)});
+
+    // Entry 11 has not committed, so the cache cannot tell the reader what follows 10.
+    ASSERT_FALSE(cache.next(RecordId(10), 12));
+
+    cache.abort({RecordId(11)});
+    ASSERT_EQ(RecordId(12), cache.next(RecordId(10), 12)->id);
+}
+
+TEST_F(WiredTigerOplogTailCacheTest, ReadersBeforeCoveredPointFallBack) {
+    WiredTigerOplogTailCache cache(RecordId(10), 1024 * 1024);
+    insert(&cache, {RecordId(11)});
+    cache.commit({RecordId(11)});
+    ASSERT_FALSE(cache.next(RecordId(9), 11));
+    ASSERT_EQ(RecordId(11), cache.next(RecordId(10), 11)->id);
+}
+
+TEST_F(WiredTigerOplogTailCacheTest, ReadersOutsideTheCachedRangeAreNotCountedAsMisses) {
+    WiredTigerOplogTailCache cache(RecordId(10), 1024 * 1024);
+    insert(&cache, {RecordId(11)});
+    cache.commit({RecordId(11)});
+
+    // Behind the covered point, and past the newest inserted entry.
+    ASSERT_FALSE(cache.next(RecordId(9), 11));
+    ASSERT_FALSE(cache.next(RecordId(11), 11));
+
+    // Inside the cached range, but not yet visible to this reader.
+    ASSERT_FALSE(cache.next(RecordId(10), 10));
+
+    BSONObjBuilder builder;
+    cache.appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(0, stats["hits"].numberLong());
+    ASSERT_EQ(1, stats["misses"].numberLong());
+}
+
+TEST_F(WiredTigerOplogTailCacheTest, EvictionAdvancesCoveredPoint) {
+    WiredTigerOplogTailCache cache(RecordId(10), 2 * _data.objsize());
+    insert(&cache, {RecordId(11), RecordId(12), RecordId(13)});
+    cache.commit({RecordId(11), RecordId(12), RecordId(13)});
+
+    ASSERT_FALSE(cache.next(RecordId(10), 13));
+    ASSERT_EQ(RecordId(12), cache.next(RecordId(11), 13)->id);
+    ASSERT_EQ(RecordId(13), cache.next(RecordId(12), 13)->id);
+}
+
+TEST_F(WiredTigerOplogTailCacheTest, TruncateAndInvalidate) {
+    WiredTigerOplogTailCache cache(RecordId(10), 1024 * 1024);
+    insert(&cache, {RecordId(11), RecordId(12)});
+    cache.commit({RecordId(11), RecordId(12)});
+
+    cache.truncateUpTo(RecordId(11));
+    ASSERT_FALSE(cache.next(RecordId(10), 12));
+    ASSERT_EQ(RecordId(12), cache.next(RecordId(11), 12)->id);
+
+    cache.invalidate();
+    ASSERT_FALSE(cache.next(RecordId(11), 12));
+
+    // Entries inserted after the invalidation are served again.
+    insert(&cache, {RecordId(13)});
+    cache.commit({RecordId(13)});
+    ASSERT_EQ(RecordId(13), cache.next(RecordId(12), 13)->id);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -38,6 +38,7 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/base/checked_cast.h"
@@ -58,6 +59,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -96,12 +98,33 @@ MONGO_STATIC_ASSERT(kCurrentRecordStoreVersion <= kMaximumRecordStoreVersion);
 
 const double kNumMSInHour = 1000 * 60 * 60;
 
+// Number of random samples taken per requested range when choosing range boundaries.
+const size_t kRangeBoundarySamplesPerRange = 20;
+
 void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
     StatusWith<BSONObj> appMetadata = WiredTigerUtil::getApplicationMetadata(opCtx, uri);
     fassert(39999, appMetadata);
 
     fassertNoTrace(39998, appMetadata.getValue().getIntField("oplogKeyExtractionVersion") == 1);
 }
+
+class OplogTailCacheInsertChange final : public RecoveryUnit::Change {
+public:
+    OplogTailCacheInsertChange(WiredTigerOplogTailCache* cache, std::vector<RecordId> ids)
+        : _cache(cache), _ids(std::move(ids)) {}
+
+    void commit(boost::optional<Timestamp>) final {
+        _cache->commit(_ids);
+    }
+
+    void rollback() final {
+        _cache->abort(_ids);
+    }
+
+private:
+    WiredTigerOplogTailCache* const _cache;
+    const std::vector<RecordId> _ids;
+};
 }  // namespace
 
 MONGO_FAIL_POINT_DEFINE(WTWriteConflictException);
@@ -910,6 +933,17 @@ void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
     if (_isOplog) {
         invariant(_kvEngine);
         _kvEngine->startOplogManager(opCtx, _uri, this);
+
+        const long long tailCacheBytes =
+            static_cast<long long>(gWiredTigerOplogTailCacheSizeMB) * 1024 * 1024;
+        if (tailCacheBytes > 0 && !storageGlobalParams.readOnly) {
+            // Nothing is written to the oplog before this point, so every entry inserted from now
+            // on goes through the cache.
+            auto reverseCursor = getCursor(opCtx, /*forward=*/false);
+            auto lastRecord = reverseCursor->next();
+            _oplogTailCache = std::make_unique<WiredTigerOplogTailCache>(
+                lastRecord ? lastRecord->id : RecordId::min(), tailCacheBytes);
+        }
     }
 }
 
@@ -1011,11 +1045,13 @@ bool WiredTigerRecordStore::findRecord(OperationContext* opCtx,
     }
     invariantWTOK(ret);
     *out = _getData(curwrap);
+    _noteRecordsRead(1);
     return true;
 }
 
 void WiredTigerRecordStore::deleteRecord(OperationContext* opCtx, const RecordId& id) {
     dassert(opCtx->lockState()->isWriteLocked());
+    _noteRecordsWritten(opCtx, 1);
 
     // Deletes should never occur on a capped collection because truncation uses
     // WT_SESSION::truncate().
@@ -1039,6 +1075,7 @@ void WiredTigerRecordStore::deleteRecord(OperationContext* opCtx, const RecordId
 
     _changeNumRecords(opCtx, -1);
     _increaseDataSize(opCtx, -old_length);
+    _noteBytesWrittenForAdmission(old_length);
 }
 
 bool WiredTigerRecordStore::cappedAndNeedDelete() const {
@@ -1389,6 +1426,10 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
             // Remove the stone after a successful truncation.
             _oplogStones->popOldestStone();
 
+            if (_oplogTailCache) {
+                _oplogTailCache->truncateUpTo(stone->lastRecord);
+            }
+
             // Stash the truncate point for next time to cleanly skip over tombstones, etc.
             _oplogStones->firstRecord = stone->lastRecord;
             _cappedFirstRecord = stone->lastRecord;
@@ -1424,6 +1465,7 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
                                              const Timestamp* timestamps,
                                              size_t nRecords) {
     dassert(opCtx->lockState()->isWriteLocked());
+    _noteRecordsWritten(opCtx, nRecords);
 
     // We are kind of cheating on capped collections since we write all of them at once ....
     // Simplest way out would be to just block vector writes for everything except oplog ?
@@ -1435,6 +1477,8 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     if (_isCapped && totalLength > _cappedMaxSize)
         return Status(ErrorCodes::BadValue, "object to insert exceeds cappedMaxSize");
 
+    _noteBytesWrittenForAdmission(totalLength);
+
     WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
     curwrap.assertInActiveTxn();
     WT_CURSOR* c = curwrap.get();
@@ -1484,6 +1528,19 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             return wtRCToStatus(ret, "WiredTigerRecordStore::insertRecord");
     }
 
+    if (_oplogTailCache) {
+        std::vector<RecordId> ids;
+        ids.reserve(nRecords);
+        for (size_t i = 0; i < nRecords; i++)
+            ids.push_back(records[i].id);
+
+        // The entries are cached before the transaction commits so that a reader never finds a
+        // committed entry that is missing from the cache.
+        _oplogTailCache->insert(records, nRecords);
+        opCtx->recoveryUnit()->registerChange(
+            std::make_unique<OplogTailCacheInsertChange>(_oplogTailCache.get(), std::move(ids)));
+    }
+
     _changeNumRecords(opCtx, nRecords);
     _increaseDataSize(opCtx, totalLength);
 
@@ -1569,6 +1626,12 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
                                            const char* data,
                                            int len) {
     dassert(opCtx->lockState()->isWriteLocked());
+    _noteRecordsWritten(opCtx, 1);
+    _noteBytesWrittenForAdmission(len);
+
+    if (_oplogTailCache) {
+        _oplogTailCache->invalidate();
+    }
 
     WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
     curwrap.assertInActiveTxn();
@@ -1643,17 +1706,25 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     const RecordData& oldRec,
     const char* damageSource,
     const mutablebson::DamageVector& damages) {
+    _noteRecordsWritten(opCtx, 1);
+
+    if (_oplogTailCache) {
+        _oplogTailCache->invalidate();
+    }
 
     const int nentries = damages.size();
     mutablebson::DamageVector::const_iterator where = damages.begin();
     const mutablebson::DamageVector::const_iterator end = damages.cend();
     std::vector<WT_MODIFY> entries(nentries);
+    long long damagedBytes = 0;
     for (u_int i = 0; where != end; ++i, ++where) {
         entries[i].data.data = damageSource + where->sourceOffset;
         entries[i].data.size = where->size;
         entries[i].offset = where->targetOffset;
         entries[i].size = where->size;
+        damagedBytes += where->size;
     }
+    _noteBytesWrittenForAdmission(damagedBytes);
 
     WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
     curwrap.assertInActiveTxn();
@@ -1679,6 +1750,59 @@ std::unique_ptr<RecordCursor> WiredTigerRecordStore::getRandomCursor(
     return getRandomCursorWithOptions(opCtx, extraConfig);
 }
 
+std::unique_ptr<RecordCursor> WiredTigerRecordStore::getSamplingCursor(
+    OperationContext* opCtx, size_t expectedSampleSize) const {
+    // With a sample size, WiredTiger divides the tree into that many chunks and walks forward
+    // through its leaf pages from one chunk to the next, instead of descending from the root to a
+    // random leaf for every record.
+    const std::string extraConfig = str::stream()
+        << "next_random_sample_size=" << std::max<size_t>(expectedSampleSize, 1);
+    return getRandomCursorWithOptions(opCtx, extraConfig);
+}
+
+std::vector<RecordId> WiredTigerRecordStore::getRangeBoundaries(OperationContext* opCtx,
+                                                                size_t numRanges) const {
+    std::vector<RecordId> boundaries;
+    if (numRanges <= 1 || _isCapped || numRecords(opCtx) <= 0)
+        return boundaries;
+
+    // Oversample the collection with a random cursor, sort the samples and use the ones at each
+    // range's expected left edge as its boundary. Informing the cursor of the number of samples
+    // allows it to account for skew in the tree shape.
+    const size_t numSamples = numRanges * kRangeBoundarySamplesPerRange;
+    const std::string extraConfig = str::stream() << "next_random_sample_size=" << numSamples;
+    auto cursor = getRandomCursorWithOptions(opCtx, extraConfig);
+    std::vector<RecordId> samples;
+    samples.reserve(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        auto record = cursor->next();
+        if (!record)
+            break;
+        samples.push_back(record->id);
+    }
+    std::sort(samples.begin(), samples.end());
+    samples.erase(std::unique(samples.begin(), samples.end()), samples.end());
+
+    for (size_t i = 1; i < numRanges && !samples.empty(); ++i) {
+        const auto& boundary = samples[i * samples.size() / numRanges];
+        if (boundaries.empty() || boundaries.back() < boundary)
+            boundaries.push_back(boundary);
+    }
+    return boundaries;
+}
+
+std::unique_ptr<SeekableRecordCursor> WiredTigerRecordStore::getRangeCursor(
+    OperationContext* opCtx, const RecordId& start, const RecordId& end) const {
+    // Repositioning after a yield relies on search_near(), which capped collections do not allow
+    // to land anywhere but the last returned record.
+    if (_isCapped)
+        return {};
+
+    auto cursor = getCursor(opCtx, true);
+    checked_cast<WiredTigerRecordStoreCursorBase*>(cursor.get())->setRange(start, end);
+    return cursor;
+}
+
 Status WiredTigerRecordStore::truncate(OperationContext* opCtx) {
     WiredTigerCursor startWrap(_uri, _tableId, true, opCtx);
     WT_CURSOR* start = startWrap.get();
@@ -1689,6 +1813,10 @@ Status WiredTigerRecordStore::truncate(OperationContext* opCtx) {
     }
     invariantWTOK(ret);
 
+    if (_oplogTailCache) {
+        _oplogTailCache->invalidate();
+    }
+
     WT_SESSION* session = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
     invariantWTOK(WT_OP_CHECK(session->truncate(session, nullptr, start, nullptr, nullptr)));
     _changeNumRecords(opCtx, -numRecords(opCtx));
@@ -1750,6 +1878,35 @@ void WiredTigerRecordStore::validate(OperationContext* opCtx,
     results->valid = false;
 }
 
+void WiredTigerRecordStore::_noteRecordsRead(long long numRecords) const {
+    if (numRecords <= 0)
+        return;
+    _recordsRead.fetchAndAdd(numRecords);
+    _lastReadMillis.store(Date_t::now().toMillisSinceEpoch());
+}
+
+void WiredTigerRecordStore::_noteRecordsWritten(OperationContext* opCtx, long long numRecords) {
+    WiredTigerRecoveryUnit::get(opCtx)->noteRecordsWritten(this, numRecords);
+}
+
+void WiredTigerRecordStore::addCommittedRecordsWritten(long long numRecords) {
+    _recordsWritten.fetchAndAdd(numRecords);
+    _lastWriteMillis.store(Date_t::now().toMillisSinceEpoch());
+}
+
+void WiredTigerRecordStore::_noteBytesWrittenForAdmission(long long numBytes) {
+    // Every write also writes the oplog, so counting it would only dilute each collection's share.
+    if (_isOplog || !_kvEngine)
+        return;
+    _kvEngine->getWriteAdmission()->noteBytesWritten(&_writeAdmissionState, numBytes);
+}
+
+Milliseconds WiredTigerRecordStore::getWriteAdmissionDelay(OperationContext* opCtx) {
+    if (_isOplog || !_kvEngine)
+        return Milliseconds(0);
+    return _kvEngine->getWriteAdmission()->admit(&_writeAdmissionState);
+}
+
 void WiredTigerRecordStore::appendCustomStats(OperationContext* opCtx,
                                               BSONObjBuilder* result,
                                               double scale) const {
@@ -1763,6 +1920,19 @@ void WiredTigerRecordStore::appendCustomStats(OperationContext* opCtx,
     WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSessionNoTxn();
     WT_SESSION* s = session->getSession();
     BSONObjBuilder bob(result->subobjStart(_engineName));
+    {
+        BSONObjBuilder access(bob.subobjStart("accessStats"));
+        access.appendNumber("recordsRead", _recordsRead.load());
+        access.appendNumber("recordsWritten", _recordsWritten.load());
+        if (auto lastRead = _lastReadMillis.load())
+            access.appendDate("lastRead", Date_t::fromMillisSinceEpoch(lastRead));
+        if (auto lastWrite = _lastWriteMillis.load())
+            access.appendDate("lastWrite", Date_t::fromMillisSinceEpoch(lastWrite));
+    }
+    if (_oplogTailCache) {
+        BSONObjBuilder tailCache(bob.subobjStart("oplogTailCache"));
+        _oplogTailCache->appendStats(&tailCache);
+    }
     {
         BSONObjBuilder metadata(bob.subobjStart("metadata"));
         Status status = WiredTigerUtil::getApplicationMetadata(opCtx, getURI(), &metadata);
@@ -1999,6 +2169,10 @@ void WiredTigerRecordStore::cappedTruncateAfter(OperationContext* opCtx,
         } while ((record = cursor->next()));
     }
 
+    if (_oplogTailCache) {
+        _oplogTailCache->invalidate();
+    }
+
     // Truncate the collection starting from the record located at 'firstRemovedId' to the end of
     // the collection.
     WriteUnitOfWork wuow(opCtx);
@@ -2079,11 +2253,25 @@ WiredTigerRecordStoreCursorBase::WiredTigerRecordStoreCursorBase(OperationContex
     _cursor.emplace(rs.getURI(), rs.tableId(), true, opCtx);
 }
 
+WiredTigerRecordStoreCursorBase::~WiredTigerRecordStoreCursorBase() {
+    _rs._noteRecordsRead(_recordsReadSinceSave);
+}
+
 boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     invariant(_hasRestored);
     if (_eof)
         return {};
 
+    if (auto record = _nextFromOplogTailCache())
+        return record;
+    if (_eof)
+        return {};
+
+    if (_needsReposition && !_repositionAfterOplogTailCache()) {
+        _eof = true;
+        return {};
+    }
+
     WT_CURSOR* c = _cursor->get();
 
     RecordId id;
@@ -2114,6 +2302,11 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
         return {};
     }
 
+    if (!_rangeEnd.isNull() && id >= _rangeEnd) {
+        _eof = true;
+        return {};
+    }
+
     if (_forward && _lastReturnedId >= id) {
         LOGV2(22406,
               "WTCursor::next -- c->next_key ( {id}) was not greater than _lastReturnedId "
@@ -2133,9 +2326,75 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     invariantWTOK(c->get_value(c, &value));
 
     _lastReturnedId = id;
+    _recordsReadSinceSave++;
+    if (_readAheadState)
+        _maybeReadAhead();
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+boost::optional<Record> WiredTigerRecordStoreCursorBase::_nextFromOplogTailCache() {
+    if (!_rs._oplogTailCache || !_forward || !_oplogVisibleTs || _skipNextAdvance ||
+        _lastReturnedId.isNull())
+        return {};
+
+    auto record = _rs._oplogTailCache->next(_lastReturnedId, *_oplogVisibleTs);
+    if (!record)
+        return {};
+
+    if (!_rangeEnd.isNull() && record->id >= _rangeEnd) {
+        _eof = true;
+        return {};
+    }
+
+    _needsReposition = true;
+    _lastReturnedId = record->id;
+    _recordsReadSinceSave++;
+    return record;
+}
+
+bool WiredTigerRecordStoreCursorBase::_repositionAfterOplogTailCache() {
+    _needsReposition = false;
+
+    WT_CURSOR* c = _cursor->get();
+    setKey(c, _lastReturnedId);
+    int cmp;
+    int ret = wiredTigerPrepareConflictRetry(_opCtx, [&] { return c->search_near(c, &cmp); });
+    if (ret == WT_NOTFOUND)
+        return false;
+    invariantWTOK(ret);
+
+    // Landing after '_lastReturnedId' means it was truncated since it was served from the cache;
+    // the record we landed on is the next one to return.
+    _skipNextAdvance = cmp > 0;
+    return true;
+}
+
+void WiredTigerRecordStoreCursorBase::setReadAheadHint() {
+    // Oplog readers must not see past the visibility point, and reverse scans are rare enough not
+    // to be worth it.
+    if (!_forward || _rs._isOplog || _rs._isEphemeral || !_rs._kvEngine || !supportsReadAhead())
+        return;
+    if (!_readAheadState) {
+        _readAheadState = std::make_shared<WiredTigerReadAheadState>();
+        // Short scans which end before this point do not read ahead.
+        _nextReadAheadAt = _recordsReturned + gWiredTigerCursorReadAheadRecords.load() / 2;
+    }
+}
+
+void WiredTigerRecordStoreCursorBase::_maybeReadAhead() {
+    if (++_recordsReturned < _nextReadAheadAt || _readAheadState->inProgress.load())
+        return;
+    const int readAheadRecords = gWiredTigerCursorReadAheadRecords.load();
+    if (readAheadRecords <= 0)
+        return;
+
+    _nextReadAheadAt = _recordsReturned + std::max(readAheadRecords / 2, 1);
+    const RecordId start(std::max<long long>(_lastReturnedId.repr() + 1,
+                                             _readAheadState->lastRecordIdRepr.load()));
+    _readAheadState->inProgress.store(true);
+    _rs._kvEngine->scheduleReadAhead(_rs.getURI(), _readAheadState, start, readAheadRecords);
+}
+
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
     invariant(_hasRestored);
     if (_oplogVisibleTs && id.repr() > *_oplogVisibleTs) {
@@ -2143,7 +2402,13 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
         return {};
     }
 
+    if (id < _rangeStart || (!_rangeEnd.isNull() && id >= _rangeEnd)) {
+        _eof = true;
+        return {};
+    }
+
     _skipNextAdvance = false;
+    _needsReposition = false;
     WT_CURSOR* c = _cursor->get();
     setKey(c, id);
     // Nothing after the next line can throw WCEs.
@@ -2160,11 +2425,14 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
 
     _lastReturnedId = id;
     _eof = false;
+    _recordsReadSinceSave++;
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
 
 void WiredTigerRecordStoreCursorBase::save() {
+    _rs._noteRecordsRead(_recordsReadSinceSave);
+    _recordsReadSinceSave = 0;
     try {
         if (_cursor)
             _cursor->reset();
@@ -2181,6 +2449,21 @@ void WiredTigerRecordStoreCursorBase::saveUnpositioned() {
     _lastReturnedId = RecordId();
 }
 
+void WiredTigerRecordStoreCursorBase::setRange(const RecordId& start, const RecordId& end) {
+    invariant(_forward);
+    invariant(_lastReturnedId.isNull());
+    invariant(!_rs._isCapped);
+    _rangeStart = start;
+    _rangeEnd = end;
+    if (start.isNull())
+        return;
+
+    // Position the cursor as though it had just returned the record preceding 'start'. next(),
+    // save() and restore() then continue from there without treating the range specially.
+    _lastReturnedId = RecordId(start.repr() - 1);
+    invariant(restore());
+}
+
 bool WiredTigerRecordStoreCursorBase::restore() {
     if (_rs._isOplog && _forward) {
         auto wtRu = WiredTigerRecoveryUnit::get(_opCtx);
@@ -2194,6 +2477,7 @@ bool WiredTigerRecordStoreCursorBase::restore() {
     // This will ensure an active session exists, so any restored cursors will bind to it
     invariant(WiredTigerRecoveryUnit::get(_opCtx)->getSession() == _cursor->getSession());
     _skipNextAdvance = false;
+    _needsReposition = false;
     _hasRestored = true;
 
     // If we've hit EOF, then this iterator is done and need not be restored.
@@ -2201,8 +2485,13 @@ bool WiredTigerRecordStoreCursorBase::restore() {
         return true;
 
     if (_lastReturnedId.isNull()) {
-        initCursorToBeginning();
-        return true;
+        if (_rangeStart.isNull()) {
+            initCursorToBeginning();
+            return true;
+        }
+        // An unpositioned range cursor starts over from the beginning of its range, as after
+        // setRange().
+        _lastReturnedId = RecordId(_rangeStart.repr() - 1);
     }
 
     WT_CURSOR* c = _cursor->get();
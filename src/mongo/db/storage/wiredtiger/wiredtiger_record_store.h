@@ -40,8 +40,10 @@
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_oplog_tail_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_write_admission.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
@@ -167,9 +169,21 @@ public:
 
     std::unique_ptr<RecordCursor> getRandomCursor(OperationContext* opCtx) const final;
 
+    std::unique_ptr<RecordCursor> getSamplingCursor(OperationContext* opCtx,
+                                                    size_t expectedSampleSize) const final;
+
     virtual std::unique_ptr<RecordCursor> getRandomCursorWithOptions(
         OperationContext* opCtx, StringData extraConfig) const = 0;
 
+    std::vector<RecordId> getRangeBoundaries(OperationContext* opCtx,
+                                             size_t numRanges) const final;
+
+    std::unique_ptr<SeekableRecordCursor> getRangeCursor(OperationContext* opCtx,
+                                                         const RecordId& start,
+                                                         const RecordId& end) const final;
+
+    Milliseconds getWriteAdmissionDelay(OperationContext* opCtx) final;
+
     virtual Status truncate(OperationContext* opCtx);
 
     virtual bool compactSupported() const {
@@ -266,6 +280,11 @@ public:
 
     void notifyCappedWaitersIfNeeded();
 
+    /**
+     * Adds records written by a committed unit of work to this record store's access statistics.
+     */
+    void addCommittedRecordsWritten(long long numRecords);
+
     class OplogStones;
 
     // Exposed only for testing.
@@ -377,6 +396,24 @@ private:
     mutable Mutex _initNextIdMutex = MONGO_MAKE_LATCH("WiredTigerRecordStore::_initNextIdMutex");
     AtomicWord<long long> _nextIdNum{0};
 
+    // Counts of records read and written since startup, and when that last happened, so that
+    // rarely accessed collections can be told apart from busy ones. Cursors count the records they
+    // return locally and add them here in save() or on destruction, which keeps long scans from
+    // contending on these counters. Writes are tallied by the recovery unit and added here once
+    // per unit of work when it commits.
+    mutable AtomicWord<long long> _recordsRead{0};
+    mutable AtomicWord<long long> _lastReadMillis{0};
+    AtomicWord<long long> _recordsWritten{0};
+    AtomicWord<long long> _lastWriteMillis{0};
+
+    void _noteRecordsRead(long long numRecords) const;
+    void _noteRecordsWritten(OperationContext* opCtx, long long numRecords);
+
+    // Reports bytes written to this collection to the write admission controller.
+    void _noteBytesWrittenForAdmission(long long numBytes);
+
+    WiredTigerWriteAdmission::CollectionState _writeAdmissionState;
+
     WiredTigerSizeStorer* _sizeStorer;  // not owned, can be NULL
     std::shared_ptr<WiredTigerSizeStorer::SizeInfo> _sizeInfo;
     bool _tracksSizeAdjustments;
@@ -385,6 +422,10 @@ private:
     // Non-null if this record store is underlying the active oplog.
     std::shared_ptr<OplogStones> _oplogStones;
 
+    // Non-null if this record store is underlying the active oplog and
+    // 'wiredTigerOplogTailCacheSizeMB' is set.
+    std::unique_ptr<WiredTigerOplogTailCache> _oplogTailCache;
+
     AtomicWord<int64_t>
         _totalTimeTruncating;            // Cumulative amount of time spent truncating the oplog.
     AtomicWord<int64_t> _truncateCount;  // Cumulative number of truncates of the oplog.
@@ -435,12 +476,27 @@ private:
     KVPrefix _prefix;
 };
 
+/**
+ * State shared between a cursor that reads ahead and the background reads done on its behalf by
+ * WiredTigerKVEngine::scheduleReadAhead().
+ */
+struct WiredTigerReadAheadState {
+    // Whether a read-ahead is scheduled or running. Cursors wait for it to finish before scheduling
+    // the next one.
+    AtomicWord<bool> inProgress{false};
+
+    // The repr of the last RecordId a finished read-ahead reached.
+    AtomicWord<long long> lastRecordIdRepr{0};
+};
+
 class WiredTigerRecordStoreCursorBase : public SeekableRecordCursor {
 public:
     WiredTigerRecordStoreCursorBase(OperationContext* opCtx,
                                     const WiredTigerRecordStore& rs,
                                     bool forward);
 
+    ~WiredTigerRecordStoreCursorBase();
+
     boost::optional<Record> next();
 
     boost::optional<Record> seekExact(const RecordId& id);
@@ -455,6 +511,14 @@ public:
 
     void reattachToOperationContext(OperationContext* opCtx);
 
+    /**
+     * Restricts this forward cursor to the RecordIds in [start, end). A null 'start' or 'end'
+     * leaves that side of the range unbounded. Must be called before the cursor is first used.
+     */
+    void setRange(const RecordId& start, const RecordId& end);
+
+    void setReadAheadHint() override;
+
 protected:
     virtual RecordId getKey(WT_CURSOR* cursor) const = 0;
 
@@ -474,18 +538,60 @@ protected:
      */
     virtual void initCursorToBeginning() = 0;
 
+    /**
+     * Whether records can be read ahead of this cursor. Read-ahead is done with a separate cursor
+     * which only knows how to position itself in tables keyed by RecordId alone.
+     */
+    virtual bool supportsReadAhead() const {
+        return false;
+    }
+
     const WiredTigerRecordStore& _rs;
     OperationContext* _opCtx;
     const bool _forward;
     bool _skipNextAdvance = false;
+    // Set when next() returned records from the oplog tail cache without moving '_cursor', which
+    // must then be positioned at '_lastReturnedId' before it is advanced.
+    bool _needsReposition = false;
     boost::optional<WiredTigerCursor> _cursor;
     bool _eof = false;
     RecordId _lastReturnedId;  // If null, need to seek to first/last record.
     bool _hasRestored = true;
 
+    // Set by setRange(). Records outside of [_rangeStart, _rangeEnd) are never returned; a null
+    // '_rangeEnd' means the range is unbounded above.
+    RecordId _rangeStart;
+    RecordId _rangeEnd;
+
 private:
     bool isVisible(const RecordId& id);
 
+    /**
+     * Returns the record after '_lastReturnedId' from the oplog tail cache, if it can be served
+     * from there. Sets '_eof' instead if that record is past '_rangeEnd'.
+     */
+    boost::optional<Record> _nextFromOplogTailCache();
+
+    /**
+     * Positions '_cursor' where next() expects it after records were served from the oplog tail
+     * cache. Returns false if the oplog is now empty.
+     */
+    bool _repositionAfterOplogTailCache();
+
+    /**
+     * Called for each record returned by next() once setReadAheadHint() has enabled read-ahead.
+     * Schedules the next read-ahead when the cursor has consumed half of the previous one's
+     * records.
+     */
+    void _maybeReadAhead();
+
+    // Records returned since the count was last added to the record store's access statistics.
+    long long _recordsReadSinceSave = 0;
+
+    std::shared_ptr<WiredTigerReadAheadState> _readAheadState;
+    long long _recordsReturned = 0;
+    long long _nextReadAheadAt = 0;
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
@@ -515,6 +621,10 @@ protected:
     virtual bool hasWrongPrefix(WT_CURSOR* cursor, RecordId* id) const override;
 
     virtual void initCursorToBeginning(){};
+
+    bool supportsReadAhead() const override {
+        return true;
+    }
 };
 
 class WiredTigerRecordStorePrefixedCursor final : public WiredTigerRecordStoreCursorBase {
@@ -374,6 +374,70 @@ TEST(WiredTigerRecordStoreTest, AppendCustomStatsMetadata) {
     ASSERT_EQUALS(creationStringElement.type(), String);
 }
 
+TEST(WiredTigerRecordStoreTest, AppendCustomStatsAccessStats) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore("a.b"));
+
+    auto getAccessStats = [&] {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        BSONObjBuilder builder;
+        rs->appendCustomStats(opCtx.get(), &builder, 1.0);
+        BSONObj customStats = builder.obj();
+        BSONElement accessStatsElement =
+            customStats.getObjectField(kWiredTigerEngineName).getField("accessStats");
+        ASSERT_TRUE(accessStatsElement.isABSONObj());
+        return accessStatsElement.Obj().getOwned();
+    };
+
+    BSONObj accessStats = getAccessStats();
+    ASSERT_EQUALS(0, accessStats.getField("recordsRead").numberLong());
+    ASSERT_EQUALS(0, accessStats.getField("recordsWritten").numberLong());
+    ASSERT_FALSE(accessStats.hasField("lastRead"));
+    ASSERT_FALSE(accessStats.hasField("lastWrite"));
+
+    const int nToInsert = 3;
+    RecordId lastId;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < nToInsert; i++) {
+            StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "a", 2, Timestamp());
+            ASSERT_OK(res.getStatus());
+            lastId = res.getValue();
+        }
+        uow.commit();
+    }
+
+    accessStats = getAccessStats();
+    ASSERT_EQUALS(nToInsert, accessStats.getField("recordsWritten").numberLong());
+    ASSERT_EQUALS(Date, accessStats.getField("lastWrite").type());
+    ASSERT_FALSE(accessStats.hasField("lastRead"));
+
+    {
+        // Writes which are rolled back are not counted.
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->insertRecord(opCtx.get(), "a", 2, Timestamp()).getStatus());
+    }
+
+    accessStats = getAccessStats();
+    ASSERT_EQUALS(nToInsert, accessStats.getField("recordsWritten").numberLong());
+
+    {
+        // A full scan counts each record returned, and a point lookup counts one more.
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto cursor = rs->getCursor(opCtx.get());
+        while (cursor->next()) {
+        }
+        RecordData data;
+        ASSERT_TRUE(rs->findRecord(opCtx.get(), lastId, &data));
+    }
+
+    accessStats = getAccessStats();
+    ASSERT_EQUALS(nToInsert + 1, accessStats.getField("recordsRead").numberLong());
+    ASSERT_EQUALS(Date, accessStats.getField("lastRead").type());
+}
+
 TEST(WiredTigerRecordStoreTest, CappedCursorYieldFirst) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("a.b", 10000, 50));
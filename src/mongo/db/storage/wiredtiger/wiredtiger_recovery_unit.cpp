@@ -33,11 +33,14 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
@@ -298,6 +301,44 @@ boost::optional<int64_t> WiredTigerRecoveryUnit::getOplogVisibilityTs() {
     return _oplogVisibleTs;
 }
 
+void WiredTigerRecoveryUnit::noteRecordsWritten(WiredTigerRecordStore* rs, long long numRecords) {
+    if (!_inUnitOfWork()) {
+        rs->addCommittedRecordsWritten(numRecords);
+        return;
+    }
+
+    if (_recordsWritten.empty()) {
+        class RecordsWrittenChange final : public Change {
+        public:
+            explicit RecordsWrittenChange(WiredTigerRecoveryUnit* ru) : _ru(ru) {}
+
+            void commit(boost::optional<Timestamp>) final {
+                for (auto&& [recordStore, count] : _ru->_recordsWritten) {
+                    recordStore->addCommittedRecordsWritten(count);
+                }
+                _ru->_recordsWritten.clear();
+            }
+
+            void rollback() final {
+                _ru->_recordsWritten.clear();
+            }
+
+        private:
+            WiredTigerRecoveryUnit* const _ru;
+        };
+        registerChange(std::make_unique<RecordsWrittenChange>(this));
+    }
+
+    auto it = std::find_if(_recordsWritten.begin(), _recordsWritten.end(), [&](const auto& entry) {
+        return entry.first == rs;
+    });
+    if (it == _recordsWritten.end()) {
+        _recordsWritten.emplace_back(rs, numRecords);
+    } else {
+        it->second += numRecords;
+    }
+}
+
 WiredTigerSession* WiredTigerRecoveryUnit::getSession() {
     if (!_isActive()) {
         _txnOpen();
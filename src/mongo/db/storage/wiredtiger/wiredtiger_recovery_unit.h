@@ -52,6 +52,7 @@ using RoundUpPreparedTimestamps = WiredTigerBeginTxnBlock::RoundUpPreparedTimest
 using RoundUpReadTimestamp = WiredTigerBeginTxnBlock::RoundUpReadTimestamp;
 
 class BSONObjBuilder;
+class WiredTigerRecordStore;
 
 class WiredTigerOperationStats final : public StorageStats {
 public:
@@ -196,6 +197,13 @@ public:
 
     boost::optional<int64_t> getOplogVisibilityTs();
 
+    /**
+     * Counts records written to 'rs' by the current unit of work. The total for each record store
+     * is added to its access statistics once, when the unit of work commits, and is discarded if it
+     * aborts.
+     */
+    void noteRecordsWritten(WiredTigerRecordStore* rs, long long numRecords);
+
     static WiredTigerRecoveryUnit* get(OperationContext* opCtx) {
         return checked_cast<WiredTigerRecoveryUnit*>(opCtx->recoveryUnit());
     }
@@ -261,6 +269,10 @@ private:
     std::unique_ptr<Timer> _timer;
     bool _isOplogReader = false;
     boost::optional<int64_t> _oplogVisibleTs = boost::none;
+
+    // Records written by the current unit of work, per record store. Rarely more than a couple of
+    // entries: the collection written to and the oplog.
+    std::vector<std::pair<WiredTigerRecordStore*, long long>> _recordsWritten;
 };
 
 }  // namespace mongo
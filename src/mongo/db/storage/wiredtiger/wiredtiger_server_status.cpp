@@ -80,8 +80,17 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
 
     WiredTigerKVEngine::appendGlobalStats(bob);
 
+    WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->appendShardStats(&bob);
+    WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->appendJournalFlushStats(&bob);
+    _engine->getOplogManager()->appendVisibilityStats(&bob);
+
     WiredTigerUtil::appendSnapshotWindowSettings(_engine, session, &bob);
 
+    {
+        BSONObjBuilder writeAdmission(bob.subobjStart("writeAdmission"));
+        _engine->getWriteAdmission()->appendStats(&writeAdmission);
+    }
+
     return bob.obj();
 }
 
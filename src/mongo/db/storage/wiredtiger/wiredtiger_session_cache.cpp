@@ -36,6 +36,7 @@
 #include <memory>
 
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
 #include "mongo/db/repl/repl_settings.h"
@@ -45,7 +46,9 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -53,6 +56,19 @@ const std::string kWTRepairMsg =
     "Please read the documentation for starting MongoDB with --repair here: "
     "http://dochub.mongodb.org/core/repair";
 
+namespace {
+
+// Assigns each thread, on first use, a fixed position amongst the shards of a session cache, so
+// that threads are spread evenly across shards.
+AtomicWord<unsigned> nextThreadShardIndex{0};
+thread_local const unsigned threadShardIndex = nextThreadShardIndex.fetchAndAdd(1);
+
+size_t numSessionCacheShards() {
+    return std::max<size_t>(1, ProcessInfo::getNumAvailableCores());
+}
+
+}  // namespace
+
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch),
       _cursorEpoch(cursorEpoch),
@@ -211,6 +227,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _numShards(numSessionCacheShards()),
+      _shards(std::make_unique<CacheAligned<SessionCacheShard>[]>(_numShards)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -218,6 +236,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _numShards(numSessionCacheShards()),
+      _shards(std::make_unique<CacheAligned<SessionCacheShard>[]>(_numShards)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -317,6 +337,8 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         return;
     }
 
+    _journalFlushWaiters.fetchAndAddRelaxed(1);
+
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
@@ -324,6 +346,7 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
     uint32_t current = _lastSyncTime.loadRelaxed();  // synchronized with writes through mutex
     if (current != start) {
         // Someone else synced already since we read lastSyncTime, so we're done!
+        _journalFlushWaitersSharingFlush.fetchAndAddRelaxed(1);
         return;
     }
     _lastSyncTime.store(current + 1);
@@ -352,7 +375,10 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
 
     // Use the journal when available, or a checkpoint otherwise.
     if (_engine && _engine->isDurable()) {
+        Timer flushTimer;
         invariantWTOK(_waitUntilDurableSession->log_flush(_waitUntilDurableSession, "sync=on"));
+        _journalFlushes.fetchAndAddRelaxed(1);
+        _journalFlushTotalMicros.fetchAndAddRelaxed(flushTimer.micros());
         LOGV2_DEBUG(22419, 4, "flushed journal");
     } else {
         auto checkpointLock = _engine->getCheckpointLock(opCtx);
@@ -384,10 +410,29 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 }
 
 
+size_t WiredTigerSessionCache::_shardIndexForCurrentThread() const {
+    return threadShardIndex % _numShards;
+}
+
+WiredTigerSession* WiredTigerSessionCache::_popSession(SessionCacheShard& shard) {
+    stdx::lock_guard<Latch> lock(shard.lock);
+    if (shard.sessions.empty()) {
+        return nullptr;
+    }
+    // Get the most recently used session so that if we discard sessions, we're discarding older
+    // ones
+    WiredTigerSession* cachedSession = shard.sessions.back();
+    shard.sessions.pop_back();
+    shard.numIdle.store(shard.sessions.size());
+    return cachedSession;
+}
+
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (size_t s = 0; s < _numShards; ++s) {
+        stdx::lock_guard<Latch> lock(_shards[s].lock);
+        for (auto&& session : _shards[s].sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -395,15 +440,44 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (size_t s = 0; s < _numShards; ++s) {
+        stdx::lock_guard<Latch> lock(_shards[s].lock);
+        for (auto&& session : _shards[s].sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (size_t s = 0; s < _numShards; ++s) {
+        stdx::lock_guard<Latch> lock(_shards[s].lock);
+        count += _shards[s].sessions.size();
+    }
+    return count;
+}
+
+void WiredTigerSessionCache::appendShardStats(BSONObjBuilder* builder) {
+    BSONObjBuilder sessionCacheBuilder(builder->subobjStart("sessionCache"));
+    long long totalIdle = 0;
+    {
+        BSONArrayBuilder perShard(sessionCacheBuilder.subarrayStart("idleSessionsPerShard"));
+        for (size_t s = 0; s < _numShards; ++s) {
+            const auto numIdle = static_cast<long long>(_shards[s].numIdle.load());
+            perShard.append(numIdle);
+            totalIdle += numIdle;
+        }
+    }
+    sessionCacheBuilder.append("idleSessions", totalIdle);
+    sessionCacheBuilder.append("crossShardSteals", _sessionSteals.load());
+}
+
+void WiredTigerSessionCache::appendJournalFlushStats(BSONObjBuilder* builder) {
+    BSONObjBuilder journalFlushBuilder(builder->subobjStart("journalFlush"));
+    journalFlushBuilder.append("waiters", _journalFlushWaiters.load());
+    journalFlushBuilder.append("waitersSharingFlush", _journalFlushWaitersSharingFlush.load());
+    journalFlushBuilder.append("flushes", _journalFlushes.load());
+    journalFlushBuilder.append("totalFlushMicros", _journalFlushTotalMicros.load());
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -413,34 +487,41 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     }
 
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (size_t s = 0; s < _numShards; ++s) {
+        auto& shard = _shards[s];
+        stdx::lock_guard<Latch> lock(shard.lock);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = shard.sessions.begin(); it != shard.sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = shard.sessions.erase(it);
                 delete (session);
             } else {
                 ++it;
             }
         }
+        shard.numIdle.store(shard.sessions.size());
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. This happens before
+    // any shard is emptied, so that a session released concurrently either lands in a shard before
+    // it is emptied, or sees the new epoch under that shard's lock and is freed directly.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
-    }
+    for (size_t s = 0; s < _numShards; ++s) {
+        SessionCache swap;
+        {
+            stdx::lock_guard<Latch> lock(_shards[s].lock);
+            _shards[s].sessions.swap(swap);
+            _shards[s].numIdle.store(0);
+        }
 
-    for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
-        delete (*i);
+        for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
+            delete (*i);
+        }
     }
 }
 
@@ -453,19 +534,24 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
-            // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
-            // Reset the idle time
-            cachedSession->setIdleExpireTime(Date_t::min());
-            return UniqueWiredTigerSession(cachedSession);
+    const size_t ownIndex = _shardIndexForCurrentThread();
+    WiredTigerSession* cachedSession = _popSession(_shards[ownIndex]);
+
+    // If the thread's own shard is empty, steal an idle session from another one, starting with
+    // the next shard over so that stealing threads do not all converge on the first.
+    for (size_t i = 1; !cachedSession && i < _numShards; ++i) {
+        auto& shard = _shards[(ownIndex + i) % _numShards];
+        if (shard.numIdle.load() > 0 && (cachedSession = _popSession(shard))) {
+            _sessionSteals.addAndFetch(1);
         }
     }
 
+    if (cachedSession) {
+        // Reset the idle time
+        cachedSession->setIdleExpireTime(Date_t::min());
+        return UniqueWiredTigerSession(cachedSession);
+    }
+
     // Outside of the cache partition lock, but on release will be put back on the cache
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
@@ -521,10 +607,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& shard = _shards[_shardIndexForCurrentThread()];
+        stdx::lock_guard<Latch> lock(shard.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            shard.sessions.push_back(session);
+            shard.numIdle.store(shard.sessions.size());
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
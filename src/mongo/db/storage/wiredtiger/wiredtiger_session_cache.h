@@ -30,7 +30,9 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
@@ -39,9 +41,11 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -204,6 +208,10 @@ private:
 /**
  *  This cache implements a shared pool of WiredTiger sessions with the goal to amortize the
  *  cost of session creation and destruction over multiple uses.
+ *
+ *  Idle sessions are spread over one shard per available core, each with its own mutex. A thread
+ *  always returns sessions to, and first looks for them in, the same shard; only when that shard is
+ *  empty does it steal a session from another one.
  */
 class WiredTigerSessionCache {
 public:
@@ -257,6 +265,18 @@ public:
      */
     size_t getIdleSessionsCount();
 
+    /**
+     * Appends the number of idle sessions in each shard of the cache and the number of sessions
+     * taken from a shard other than the requesting thread's own.
+     */
+    void appendShardStats(BSONObjBuilder* builder);
+
+    /**
+     * Appends how many waitUntilDurable() callers were made durable by journal flushes, how many
+     * of them shared a flush started by another caller, and how long the flushes took.
+     */
+    void appendJournalFlushStats(BSONObjBuilder* builder);
+
     /**
      * Closes all cached sessions whose idle expiration time has been reached.
      */
@@ -373,9 +393,33 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    struct SessionCacheShard {
+        Mutex lock = MONGO_MAKE_LATCH("WiredTigerSessionCache::SessionCacheShard::lock");
+        SessionCache sessions;
+
+        // Mirrors 'sessions.size()' so that other threads can skip an empty shard without taking
+        // its lock. Only written while holding 'lock'.
+        AtomicWord<size_t> numIdle{0};
+    };
+
+    /**
+     * Returns the index of the shard which the calling thread releases sessions to and first takes
+     * them from.
+     */
+    size_t _shardIndexForCurrentThread() const;
+
+    /**
+     * Pops the most recently released session from 'shard', or returns nullptr if it is empty.
+     */
+    static WiredTigerSession* _popSession(SessionCacheShard& shard);
+
+    const size_t _numShards;
+    std::unique_ptr<CacheAligned<SessionCacheShard>[]> _shards;
+
+    // Number of sessions taken from a shard other than the requesting thread's own.
+    AtomicWord<long long> _sessionSteals{0};
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
@@ -387,6 +431,12 @@ private:
     AtomicWord<unsigned> _lastSyncTime;
     Mutex _lastSyncMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_lastSyncMutex");
 
+    // Statistics for the journal flushes done by waitUntilDurable, see appendJournalFlushStats().
+    AtomicWord<long long> _journalFlushWaiters{0};
+    AtomicWord<long long> _journalFlushWaitersSharingFlush{0};
+    AtomicWord<long long> _journalFlushes{0};
+    AtomicWord<long long> _journalFlushTotalMicros{0};
+
     // Mutex and cond var for waiting on prepare commit or abort.
     Mutex _prepareCommittedOrAbortedMutex =
         MONGO_MAKE_LATCH("WiredTigerSessionCache::_prepareCommittedOrAbortedMutex");
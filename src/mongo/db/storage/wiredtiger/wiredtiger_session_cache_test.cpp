@@ -29,14 +29,19 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/system_clock_source.h"
 
 namespace mongo {
@@ -89,6 +94,24 @@ private:
     WiredTigerSessionCache _sessionCache;
 };
 
+namespace {
+
+BSONObj sessionCacheStats(WiredTigerSessionCache* sessionCache) {
+    BSONObjBuilder builder;
+    sessionCache->appendShardStats(&builder);
+    return builder.obj()["sessionCache"].Obj().getOwned();
+}
+
+std::vector<long long> idleSessionsPerShard(WiredTigerSessionCache* sessionCache) {
+    std::vector<long long> perShard;
+    for (auto&& numIdle : sessionCacheStats(sessionCache)["idleSessionsPerShard"].Obj()) {
+        perShard.push_back(numIdle.numberLong());
+    }
+    return perShard;
+}
+
+}  // namespace
+
 TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     WiredTigerSessionCacheHarnessHelper harnessHelper("");
     WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
@@ -113,4 +136,80 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, SessionsReleasedByAnotherThreadCanBeStolen) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Release a session from each of several threads, which places them in different shards if
+    // there is more than one.
+    const size_t numThreads = 4;
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back([sessionCache] { sessionCache->getSession(); });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numThreads);
+
+    // This thread can reuse every idle session even though it released none of them itself.
+    std::vector<UniqueWiredTigerSession> sessions;
+    for (size_t i = 0; i < numThreads; ++i) {
+        sessions.push_back(sessionCache->getSession());
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numThreads - i - 1);
+    }
+
+    auto stats = sessionCacheStats(sessionCache);
+    ASSERT_EQUALS(stats["idleSessions"].numberLong(), 0);
+    ASSERT_EQUALS(stats["idleSessionsPerShard"].Obj().nFields(),
+                  static_cast<int>(std::max<size_t>(1, ProcessInfo::getNumAvailableCores())));
+
+    // closeAll() reaches sessions in every shard.
+    sessions.clear();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numThreads);
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, TakingASessionFromAnotherShardCountsAsASteal) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    if (idleSessionsPerShard(sessionCache).size() < 2) {
+        // With a single shard every session is taken from the requesting thread's own shard.
+        return;
+    }
+
+    // Find this thread's own shard by releasing a session into the empty cache, then hold on to
+    // that session so that the shard stays empty.
+    sessionCache->getSession();
+    const auto initialPerShard = idleSessionsPerShard(sessionCache);
+    const size_t ownShard =
+        std::find(initialPerShard.begin(), initialPerShard.end(), 1) - initialPerShard.begin();
+    ASSERT_LT(ownShard, initialPerShard.size());
+    std::vector<UniqueWiredTigerSession> sessions;
+    sessions.push_back(sessionCache->getSession());
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    // Release sessions from new threads until one lands in another shard. Threads are assigned
+    // shards round-robin, so this normally takes a single thread. A session which lands in this
+    // thread's own shard is taken back out, which is not a steal.
+    bool releasedElsewhere = false;
+    for (size_t i = 0; i < 10 * initialPerShard.size() && !releasedElsewhere; ++i) {
+        stdx::thread([sessionCache] { sessionCache->getSession(); }).join();
+        if (idleSessionsPerShard(sessionCache)[ownShard] > 0) {
+            sessions.push_back(sessionCache->getSession());
+        } else {
+            releasedElsewhere = true;
+        }
+    }
+    ASSERT(releasedElsewhere);
+    ASSERT_EQUALS(sessionCacheStats(sessionCache)["crossShardSteals"].numberLong(), 0);
+
+    // This thread's shard is empty, so the idle session is stolen from the other shard.
+    sessions.push_back(sessionCache->getSession());
+    auto stats = sessionCacheStats(sessionCache);
+    ASSERT_EQUALS(stats["crossShardSteals"].numberLong(), 1);
+    ASSERT_EQUALS(stats["idleSessions"].numberLong(), 0);
+}
+
 }  // namespace mongo
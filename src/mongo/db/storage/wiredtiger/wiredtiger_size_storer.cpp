@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <wiredtiger.h>
 
 #include "mongo/bson/bsonobj.h"
@@ -74,8 +75,9 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
         return;
 
     // Ordering is important: as the entry may be flushed concurrently, set the dirty flag last.
-    stdx::lock_guard<Latch> lk(_bufferMutex);
-    auto& entry = _buffer[uri];
+    auto& shard = _getShard(uri);
+    stdx::lock_guard<Latch> lk(shard.mutex);
+    auto& entry = shard.buffer[uri];
     // During rollback it is possible to get a new SizeInfo. In that case clear the dirty flag,
     // so the SizeInfo can be destructed without triggering the dirty check invariant.
     if (entry && entry.get() != sizeInfo.get())
@@ -96,9 +98,10 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
 std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(StringData uri) const {
     {
         // Check if we can satisfy the read from the buffer.
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        Buffer::const_iterator it = _buffer.find(uri);
-        if (it != _buffer.end())
+        auto& shard = _getShard(uri);
+        stdx::lock_guard<Latch> bufferLock(shard.mutex);
+        Buffer::const_iterator it = shard.buffer.find(uri);
+        if (it != shard.buffer.end())
             return it->second;
     }
 
@@ -131,59 +134,87 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
-    Buffer buffer;
-    {
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        _buffer.swap(buffer);
+    // Take the dirty entries out of the buffer one shard at a time, so that concurrent stores and
+    // loads wait for at most one shard to be swapped out.
+    FlushEntries entries;
+    for (auto& shard : _bufferShards) {
+        Buffer buffer;
+        {
+            stdx::lock_guard<Latch> bufferLock(shard.mutex);
+            shard.buffer.swap(buffer);
+        }
+        for (auto& it : buffer)
+            entries.emplace_back(it.first, std::move(it.second));
     }
 
-    if (buffer.empty())
+    if (entries.empty())
         return;  // Nothing to do.
 
     Timer t;
-    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
-    {
-        // On failure, place entries back into the map, unless a newer value already exists.
-        ON_BLOCK_EXIT([this, &buffer]() {
-            this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
-            }
-        });
-
-        WT_SESSION* session = _session.getSession();
-        WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
-
-        for (auto it = buffer.begin(); it != buffer.end(); ++it) {
-
-            // Ordering is important here: when the store method checks if the SizeInfo
-            // is dirty and it returns true, the current values of numRecords and dataSize must
-            // still be written back. So, the required order is to clear the dirty flag first.
-            SizeInfo& sizeInfo = *it->second;
-            sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
-
-            auto& uri = it->first;
-            LOGV2_DEBUG(22425,
-                        2,
-                        "WiredTigerSizeStorer::flush {uri} -> {data}",
-                        "uri"_attr = uri,
-                        "data"_attr = redact(data));
-            WiredTigerItem key(uri.c_str(), uri.size());
-            WiredTigerItem value(data.objdata(), data.objsize());
-            _cursor->set_key(_cursor, key.Get());
-            _cursor->set_value(_cursor, value.Get());
-            invariantWTOK(_cursor->insert(_cursor));
+    size_t numFlushed = 0;
+
+    // On failure, place the unwritten entries back into the buffer, unless a newer value already
+    // exists.
+    ON_BLOCK_EXIT([&] {
+        for (size_t i = numFlushed; i < entries.size(); ++i) {
+            auto& shard = _getShard(entries[i].first);
+            stdx::lock_guard<Latch> bufferLock(shard.mutex);
+            shard.buffer.try_emplace(entries[i].first, entries[i].second);
         }
-        txnOpen.done();
-        invariantWTOK(session->commit_transaction(session, nullptr));
-        buffer.clear();
+    });
+
+    while (numFlushed < entries.size()) {
+        const size_t batchEnd = std::min(entries.size(), numFlushed + kMaxEntriesPerFlushBatch);
+        // Syncing the last transaction to disk also makes the ones committed before it durable.
+        _flushBatch(entries, numFlushed, batchEnd, syncToDisk && batchEnd == entries.size());
+        numFlushed = batchEnd;
     }
 
     auto micros = t.micros();
-    LOGV2_DEBUG(22426, 2, "WiredTigerSizeStorer flush took {micros} µs", "micros"_attr = micros);
+    LOGV2_DEBUG(22426,
+                2,
+                "WiredTigerSizeStorer flush of {numEntries} entries took {micros} µs",
+                "numEntries"_attr = entries.size(),
+                "micros"_attr = micros);
+}
+
+WiredTigerSizeStorer::BufferShard& WiredTigerSizeStorer::_getShard(StringData uri) const {
+    // Use the high bits of the hash, as the low bits also select slots within the shard's map.
+    return _bufferShards[(StringMapHasher{}(uri) >> 32) % kNumBufferShards];
+}
+
+void WiredTigerSizeStorer::_flushBatch(const FlushEntries& entries,
+                                       size_t begin,
+                                       size_t end,
+                                       bool syncToDisk) {
+    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+    ON_BLOCK_EXIT([this] { _cursor->reset(_cursor); });
+
+    WT_SESSION* session = _session.getSession();
+    WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
+
+    for (size_t i = begin; i < end; ++i) {
+        // Ordering is important here: when the store method checks if the SizeInfo
+        // is dirty and it returns true, the current values of numRecords and dataSize must
+        // still be written back. So, the required order is to clear the dirty flag first.
+        SizeInfo& sizeInfo = *entries[i].second;
+        sizeInfo._dirty.store(false);
+        BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
+                                         << sizeInfo.dataSize.load());
+
+        auto& uri = entries[i].first;
+        LOGV2_DEBUG(22425,
+                    2,
+                    "WiredTigerSizeStorer::flush {uri} -> {data}",
+                    "uri"_attr = uri,
+                    "data"_attr = redact(data));
+        WiredTigerItem key(uri.c_str(), uri.size());
+        WiredTigerItem value(data.objdata(), data.objsize());
+        _cursor->set_key(_cursor, key.Get());
+        _cursor->set_value(_cursor, value.Get());
+        invariantWTOK(_cursor->insert(_cursor));
+    }
+    txnOpen.done();
+    invariantWTOK(session->commit_transaction(session, nullptr));
 }
 }  // namespace mongo
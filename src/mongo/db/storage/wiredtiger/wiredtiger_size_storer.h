@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <array>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <wiredtiger.h>
 
@@ -90,21 +93,39 @@ public:
     std::shared_ptr<SizeInfo> load(StringData uri) const;
 
     /**
-     * Writes all changes to the underlying table.
+     * Writes all changes to the underlying table. Changes are written in transactions of a bounded
+     * number of entries, so that neither the buffer nor the cursor is held for the entire flush.
      */
     void flush(bool syncToDisk);
 
 private:
+    // The buffer is split into independently locked shards, so that stores and loads for
+    // different collections rarely wait for each other or for a flush taking entries out.
+    static constexpr size_t kNumBufferShards = 16;
+    static constexpr size_t kMaxEntriesPerFlushBatch = 1000;
+
+    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
+    using FlushEntries = std::vector<std::pair<std::string, std::shared_ptr<SizeInfo>>>;
+
+    struct BufferShard {
+        // Guards buffer.
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSizeStorer::BufferShard::mutex");
+        Buffer buffer;
+    };
+
+    BufferShard& _getShard(StringData uri) const;
+
+    /**
+     * Writes entries [begin, end) in one transaction.
+     */
+    void _flushBatch(const FlushEntries& entries, size_t begin, size_t end, bool syncToDisk);
+
     const WiredTigerSession _session;
     const bool _readOnly;
-    // Guards _cursor. Acquire *before* _bufferMutex.
+    // Guards _cursor. Acquire *before* any buffer shard mutex.
     mutable Mutex _cursorMutex = MONGO_MAKE_LATCH("WiredTigerSessionStorer::_cursorMutex");
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
-    using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
-
-    mutable Mutex _bufferMutex =
-        MONGO_MAKE_LATCH("WiredTigerSessionStorer::_bufferMutex");  // Guards _buffer
-    Buffer _buffer;
+    mutable std::array<BufferShard, kNumBufferShards> _bufferShards;
 };
 }  // namespace mongo
@@ -300,6 +300,28 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     rs.reset(nullptr);  // this has to be deleted before ss
 }
 
+TEST(WiredTigerRecordStoreTest, SizeStorerFlushesInBatches) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    string sizeStorerUri = WiredTigerKVEngine::kTableUriPrefix + "sizeStorer";
+    WiredTigerSizeStorer ss(harnessHelper->conn(), sizeStorerUri);
+
+    // Store more entries than fit in a single flush transaction.
+    const int N = 2500;
+    std::vector<std::shared_ptr<WiredTigerSizeStorer::SizeInfo>> sizeInfos;
+    for (int i = 0; i < N; i++) {
+        sizeInfos.push_back(std::make_shared<WiredTigerSizeStorer::SizeInfo>(i, 10 * i));
+        ss.store(str::stream() << "table:collection-" << i, sizeInfos.back());
+    }
+    ss.flush(true);
+
+    WiredTigerSizeStorer ss2(harnessHelper->conn(), sizeStorerUri);
+    for (int i = 0; i < N; i++) {
+        auto info = ss2.load(str::stream() << "table:collection-" << i);
+        ASSERT_EQUALS(i, info->numRecords.load());
+        ASSERT_EQUALS(10 * i, info->dataSize.load());
+    }
+}
+
 class SizeStorerUpdateTest : public mongo::unittest::Test {
 private:
     virtual void setUp() {
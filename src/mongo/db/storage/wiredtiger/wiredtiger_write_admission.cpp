@@ -0,0 +1,192 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_write_admission.h"
+
+#include <algorithm>
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+
+constexpr Milliseconds WiredTigerWriteAdmission::kSampleInterval;
+
+WiredTigerWriteAdmission::WiredTigerWriteAdmission(WiredTigerSessionCache* sessionCache)
+    : _sessionCache(sessionCache) {}
+
+bool WiredTigerWriteAdmission::isEnabled() {
+    return gWiredTigerWriteAdmissionDirtyTriggerPercent.load() > 0;
+}
+
+void WiredTigerWriteAdmission::noteBytesWritten(CollectionState* coll, long long bytes) {
+    if (!isEnabled())
+        return;
+
+    {
+        stdx::lock_guard<Latch> lk(coll->_mutex);
+        // Reading the counts rolls them forward to the current interval.
+        _collectionBytesLastInterval(coll);
+        coll->_bytesThisInterval += bytes;
+    }
+    _bytesThisInterval.fetchAndAdd(bytes);
+}
+
+Milliseconds WiredTigerWriteAdmission::admit(CollectionState* coll) {
+    if (!isEnabled())
+        return Milliseconds(0);
+
+    _maybeSample();
+
+    Milliseconds delay = getDelay(coll);
+    if (delay <= Milliseconds(0))
+        return Milliseconds(0);
+
+    _numThrottledWrites.fetchAndAdd(1);
+    _totalDelayMillis.fetchAndAdd(durationCount<Milliseconds>(delay));
+    return delay;
+}
+
+Milliseconds WiredTigerWriteAdmission::getDelay(CollectionState* coll) {
+    const int delayMillis = _delayMillis.load();
+    if (delayMillis == 0)
+        return Milliseconds(0);
+
+    const long long totalBytes = _bytesLastInterval.load();
+    if (totalBytes <= 0)
+        return Milliseconds(0);
+
+    long long collBytes;
+    {
+        stdx::lock_guard<Latch> lk(coll->_mutex);
+        collBytes = _collectionBytesLastInterval(coll);
+    }
+
+    const double sharePercent = 100.0 * collBytes / totalBytes;
+    if (sharePercent < gWiredTigerWriteAdmissionCollectionSharePercent.load())
+        return Milliseconds(0);
+
+    return Milliseconds(delayMillis);
+}
+
+void WiredTigerWriteAdmission::recordSample(double dirtyPercent, long long appThreadEvictions) {
+    const long long appThreadEvictionsLastInterval =
+        _lastAppThreadEvictions < 0 ? 0 : appThreadEvictions - _lastAppThreadEvictions;
+    _lastAppThreadEvictions = appThreadEvictions;
+
+    // Delays grow with how far the dirty share of the cache is past the trigger, and are at their
+    // longest once application threads have been drafted into evicting pages.
+    const int trigger = gWiredTigerWriteAdmissionDirtyTriggerPercent.load();
+    int delayMillis = 0;
+    if (trigger > 0 && dirtyPercent >= trigger) {
+        double severity = std::min(1.0, (dirtyPercent - trigger) / trigger);
+        if (appThreadEvictionsLastInterval > 0)
+            severity = 1.0;
+        const int maxDelayMillis = gWiredTigerWriteAdmissionMaxDelayMillis.load();
+        delayMillis = std::max(1, static_cast<int>(maxDelayMillis * severity));
+    }
+
+    const int prevDelayMillis = _delayMillis.swap(delayMillis);
+    if ((prevDelayMillis == 0) != (delayMillis == 0)) {
+        LOGV2_DEBUG(5100015,
+                    1,
+                    "WiredTiger write admission throttling changed",
+                    "throttling"_attr = delayMillis != 0,
+                    "dirtyCachePercent"_attr = dirtyPercent,
+                    "appThreadEvictions"_attr = appThreadEvictionsLastInterval);
+    }
+
+    _dirtyPercent.store(dirtyPercent);
+    _appThreadEvictionsLastInterval.store(appThreadEvictionsLastInterval);
+    _bytesLastInterval.store(_bytesThisInterval.swap(0));
+    _interval.fetchAndAdd(1);
+    _numSamples.fetchAndAdd(1);
+}
+
+void WiredTigerWriteAdmission::appendStats(BSONObjBuilder* builder) const {
+    builder->append("enabled", isEnabled());
+    builder->append("throttling", _delayMillis.load() != 0);
+    builder->append("delayMillis", _delayMillis.load());
+    builder->append("dirtyCachePercent", _dirtyPercent.load());
+    builder->append("appThreadEvictionsLastInterval", _appThreadEvictionsLastInterval.load());
+    builder->append("bytesWrittenLastInterval", _bytesLastInterval.load());
+    builder->append("samples", _numSamples.load());
+    builder->append("throttledWrites", _numThrottledWrites.load());
+    builder->append("totalDelayMillis", _totalDelayMillis.load());
+}
+
+void WiredTigerWriteAdmission::_maybeSample() {
+    if (!_sessionCache)
+        return;
+
+    stdx::unique_lock<Latch> lk(_sampleMutex, stdx::try_to_lock);
+    if (!lk.owns_lock())
+        return;
+
+    const Date_t now = Date_t::now();
+    if (now - _lastSampleTime < kSampleInterval)
+        return;
+    _lastSampleTime = now;
+
+    auto session = _sessionCache->getSession();
+    auto getStat = [&](int key) {
+        return WiredTigerUtil::getStatisticsValue(
+            session->getSession(), "statistics:", "statistics=(fast)", key);
+    };
+    auto dirtyBytes = getStat(WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    auto maxBytes = getStat(WT_STAT_CONN_CACHE_BYTES_MAX);
+    auto appThreadEvictions = getStat(WT_STAT_CONN_CACHE_EVICTION_APP);
+    if (!dirtyBytes.isOK() || !maxBytes.isOK() || !appThreadEvictions.isOK() ||
+        maxBytes.getValue() <= 0) {
+        return;
+    }
+
+    recordSample(100.0 * dirtyBytes.getValue() / maxBytes.getValue(),
+                 appThreadEvictions.getValue());
+}
+
+long long WiredTigerWriteAdmission::_collectionBytesLastInterval(CollectionState* coll) {
+    const long long interval = _interval.load();
+    if (coll->_interval != interval) {
+        coll->_bytesLastInterval =
+            coll->_interval == interval - 1 ? coll->_bytesThisInterval : 0;
+        coll->_bytesThisInterval = 0;
+        coll->_interval = interval;
+    }
+    return coll->_bytesLastInterval;
+}
+
+}  // namespace mongo
@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class WiredTigerSessionCache;
+
+/**
+ * Throttles writes to the collections that are filling the WiredTiger cache with dirty data. Once
+ * the share of the cache that is dirty reaches 'wiredTigerWriteAdmissionDirtyTriggerPercent',
+ * writes to a collection which accounted for at least
+ * 'wiredTigerWriteAdmissionCollectionSharePercent' of the bytes written in the last sampling
+ * interval are delayed before they begin. Collections writing less than that are admitted
+ * immediately, so that a single bulk load is slowed down before eviction stalls every writer.
+ *
+ * Cache statistics are sampled at most once per interval by whichever writer first notices the
+ * last sample is stale, so no thread is dedicated to sampling.
+ */
+class WiredTigerWriteAdmission {
+    WiredTigerWriteAdmission(const WiredTigerWriteAdmission&) = delete;
+    WiredTigerWriteAdmission& operator=(const WiredTigerWriteAdmission&) = delete;
+
+public:
+    static constexpr Milliseconds kSampleInterval{1000};
+
+    /**
+     * The bytes written to one collection in the current and the previous sampling interval. Each
+     * record store owns one of these and reports its writes through noteBytesWritten().
+     */
+    class CollectionState {
+    private:
+        friend WiredTigerWriteAdmission;
+
+        Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerWriteAdmission::CollectionState::_mutex");
+        long long _interval = 0;
+        long long _bytesThisInterval = 0;
+        long long _bytesLastInterval = 0;
+    };
+
+    /**
+     * 'sessionCache' is used to sample cache statistics and may be null when samples are only
+     * provided through recordSample(), as in tests.
+     */
+    explicit WiredTigerWriteAdmission(WiredTigerSessionCache* sessionCache);
+
+    static bool isEnabled();
+
+    void noteBytesWritten(CollectionState* coll, long long bytes);
+
+    /**
+     * Returns how long a write to 'coll' which is about to start should be delayed, and counts it
+     * as throttled if the delay is positive. Takes a new sample first if one is due. The caller
+     * performs the wait, before it starts its WriteUnitOfWork and without holding locks.
+     */
+    Milliseconds admit(CollectionState* coll);
+
+    /**
+     * Returns how long a write to 'coll' would be delayed, based on the last sample.
+     */
+    Milliseconds getDelay(CollectionState* coll);
+
+    /**
+     * Records a sample of the cache statistics and starts a new sampling interval.
+     * 'appThreadEvictions' is the cumulative number of pages evicted by application threads.
+     */
+    void recordSample(double dirtyPercent, long long appThreadEvictions);
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    void _maybeSample();
+
+    long long _collectionBytesLastInterval(CollectionState* coll);
+
+    WiredTigerSessionCache* const _sessionCache;
+
+    // Serializes sampling. Writers that find it held skip sampling rather than wait.
+    Mutex _sampleMutex = MONGO_MAKE_LATCH("WiredTigerWriteAdmission::_sampleMutex");
+    Date_t _lastSampleTime;
+    long long _lastAppThreadEvictions = -1;
+
+    AtomicWord<long long> _interval{0};
+    AtomicWord<long long> _bytesThisInterval{0};
+    AtomicWord<long long> _bytesLastInterval{0};
+
+    // The results of the last sample, also surfaced in server status. A zero delay means the cache
+    // is not under pressure and no writes are throttled.
+    AtomicWord<double> _dirtyPercent{0.0};
+    AtomicWord<long long> _appThreadEvictionsLastInterval{0};
+    AtomicWord<int> _delayMillis{0};
+
+    AtomicWord<long long> _numSamples{0};
+    AtomicWord<long long> _numThrottledWrites{0};
+    AtomicWord<long long> _totalDelayMillis{0};
+};
+
+}  // namespace mongo
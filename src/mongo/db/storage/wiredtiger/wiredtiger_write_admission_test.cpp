@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_write_admission.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class WiredTigerWriteAdmissionTest : public unittest::Test {
+public:
+    void setUp() override {
+        _origTrigger = gWiredTigerWriteAdmissionDirtyTriggerPercent.load();
+        _origShare = gWiredTigerWriteAdmissionCollectionSharePercent.load();
+        _origMaxDelay = gWiredTigerWriteAdmissionMaxDelayMillis.load();
+        gWiredTigerWriteAdmissionDirtyTriggerPercent.store(20);
+        gWiredTigerWriteAdmissionCollectionSharePercent.store(50);
+        gWiredTigerWriteAdmissionMaxDelayMillis.store(100);
+    }
+
+    void tearDown() override {
+        gWiredTigerWriteAdmissionDirtyTriggerPercent.store(_origTrigger);
+        gWiredTigerWriteAdmissionCollectionSharePercent.store(_origShare);
+        gWiredTigerWriteAdmissionMaxDelayMillis.store(_origMaxDelay);
+    }
+
+protected:
+    WiredTigerWriteAdmission _admission{nullptr};
+    WiredTigerWriteAdmission::CollectionState _bulk;
+    WiredTigerWriteAdmission::CollectionState _oltp;
+
+private:
+    int _origTrigger;
+    int _origShare;
+    int _origMaxDelay;
+};
+
+TEST_F(WiredTigerWriteAdmissionTest, OnlyCollectionsWritingMostAreThrottled) {
+    _admission.noteBytesWritten(&_bulk, 900);
+    _admission.noteBytesWritten(&_oltp, 100);
+    _admission.recordSample(30.0, 0);
+
+    ASSERT_GT(_admission.getDelay(&_bulk), Milliseconds(0));
+    ASSERT_EQ(_admission.getDelay(&_oltp), Milliseconds(0));
+}
+
+TEST_F(WiredTigerWriteAdmissionTest, NoThrottlingBelowDirtyTrigger) {
+    _admission.noteBytesWritten(&_bulk, 900);
+    _admission.noteBytesWritten(&_oltp, 100);
+    _admission.recordSample(19.0, 0);
+
+    ASSERT_EQ(_admission.getDelay(&_bulk), Milliseconds(0));
+    ASSERT_EQ(_admission.getDelay(&_oltp), Milliseconds(0));
+}
+
+TEST_F(WiredTigerWriteAdmissionTest, DelayGrowsWithDirtyCache) {
+    _admission.noteBytesWritten(&_bulk, 1000);
+    _admission.recordSample(25.0, 0);
+    Milliseconds lowPressureDelay = _admission.getDelay(&_bulk);
+
+    _admission.noteBytesWritten(&_bulk, 1000);
+    _admission.recordSample(35.0, 0);
+    Milliseconds highPressureDelay = _admission.getDelay(&_bulk);
+
+    ASSERT_GT(lowPressureDelay, Milliseconds(0));
+    ASSERT_GT(highPressureDelay, lowPressureDelay);
+    ASSERT_LTE(highPressureDelay, Milliseconds(100));
+}
+
+TEST_F(WiredTigerWriteAdmissionTest, ApplicationThreadEvictionsUseMaximumDelay) {
+    _admission.recordSample(10.0, 5);
+
+    _admission.noteBytesWritten(&_bulk, 1000);
+    _admission.recordSample(21.0, 8);
+    ASSERT_EQ(_admission.getDelay(&_bulk), Milliseconds(100));
+}
+
+TEST_F(WiredTigerWriteAdmissionTest, OnlyTheLastIntervalCounts) {
+    _admission.noteBytesWritten(&_bulk, 1000);
+    _admission.recordSample(30.0, 0);
+    ASSERT_GT(_admission.getDelay(&_bulk), Milliseconds(0));
+
+    // The bulk collection stopped writing, so it no longer accounts for the dirty data.
+    _admission.noteBytesWritten(&_oltp, 100);
+    _admission.recordSample(30.0, 0);
+    ASSERT_EQ(_admission.getDelay(&_bulk), Milliseconds(0));
+    ASSERT_GT(_admission.getDelay(&_oltp), Milliseconds(0));
+}
+
+TEST_F(WiredTigerWriteAdmissionTest, DisabledByZeroTrigger) {
+    gWiredTigerWriteAdmissionDirtyTriggerPercent.store(0);
+    _admission.noteBytesWritten(&_bulk, 1000);
+    _admission.recordSample(90.0, 0);
+    ASSERT_EQ(_admission.getDelay(&_bulk), Milliseconds(0));
+
+    BSONObjBuilder builder;
+    _admission.appendStats(&builder);
+    BSONObj stats = builder.obj();
+    ASSERT_FALSE(stats["enabled"].trueValue());
+    ASSERT_FALSE(stats["throttling"].trueValue());
+    ASSERT_EQ(1, stats["samples"].numberLong());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -780,6 +780,9 @@ void TransactionParticipant::TxnResources::release(OperationContext* opCtx) {
         }
     });
 
+    // The stashed locker starts a new statement, which reports only its own ticket queueing time.
+    _locker->resetTimeQueuedForTicket();
+
     // Restore locks if they are yielded.
     if (_lockSnapshot) {
         invariant(!_locker->isLocked());
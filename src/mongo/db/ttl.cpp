@@ -311,9 +311,14 @@ private:
         auto canonicalQuery = CanonicalQuery::canonicalize(opCtx, std::move(qr));
         invariant(canonicalQuery.getStatus());
 
+        // When the deletes are limited, have the delete stage return each deleted document so that
+        // they can be counted as the plan runs.
+        const long long deleteLimit = ttlMonitorDeleteLimitPerIndex.load();
+
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
         params->canonicalQuery = canonicalQuery.getValue().get();
+        params->returnDeleted = deleteLimit > 0;
 
         auto exec =
             InternalPlanner::deleteWithIndexScan(opCtx,
@@ -326,7 +331,8 @@ private:
                                                  PlanExecutor::YIELD_AUTO,
                                                  direction);
 
-        Status result = exec->executePlan();
+        Status result = deleteLimit > 0 ? executeDeleteWithLimit(exec.get(), deleteLimit)
+                                        : exec->executePlan();
         if (!result.isOK()) {
             LOGV2_ERROR(22543,
                         "ttl query execution for index {idx} failed with status: {result}",
@@ -340,6 +346,26 @@ private:
         LOGV2_DEBUG(22536, 1, "deleted: {numDeleted}", "numDeleted"_attr = numDeleted);
     }
 
+    /**
+     * Runs the delete plan 'exec' until it reaches EOF or has deleted 'deleteLimit' documents. The
+     * delete stage of 'exec' must return the documents it deletes.
+     */
+    static Status executeDeleteWithLimit(PlanExecutor* exec, long long deleteLimit) {
+        BSONObj deletedDoc;
+        long long numDeleted = 0;
+        while (numDeleted < deleteLimit) {
+            auto state = exec->getNext(&deletedDoc, nullptr);
+            if (PlanExecutor::IS_EOF == state) {
+                break;
+            }
+            if (PlanExecutor::FAILURE == state) {
+                return exec->getMemberObjectStatus(deletedDoc);
+            }
+            ++numDeleted;
+        }
+        return Status::OK();
+    }
+
     ServiceContext* _serviceContext;
 };
 
@@ -446,6 +446,69 @@ TEST_F(QueryStageCachedPlan, EntriesAreNotDeactivatedWhenInactiveEntriesDisabled
     ASSERT_EQ(cache->get(*shapeCq).state, PlanCache::CacheEntryState::kPresentActive);
 }
 
+TEST_F(QueryStageCachedPlan, DeactivatesEntryWhenExecutionIsMoreExpensiveThanCached) {
+    internalQueryCacheExecutionDeactivationRatio.store(100.0);
+    ON_BLOCK_EXIT([] { internalQueryCacheExecutionDeactivationRatio.store(0.0); });
+
+    AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+    Collection* collection = ctx.getCollection();
+    ASSERT(collection);
+
+    // Create an active cache entry with a works value of 1.
+    const auto noResultsCq =
+        canonicalQueryFromFilterObj(opCtx(), nss, fromjson("{a: {$gte: 11}, b: {$gte: 11}}"));
+    forceReplanning(collection, noResultsCq.get());
+    forceReplanning(collection, noResultsCq.get());
+    PlanCache* cache = CollectionQueryInfo::get(collection).getPlanCache();
+    ASSERT_EQ(cache->get(*noResultsCq).state, PlanCache::CacheEntryState::kPresentActive);
+
+    // A query of the same shape whose trial period ends after its first result.
+    auto qr = std::make_unique<QueryRequest>(nss);
+    qr->setFilter(fromjson("{a: {$gte: 0}, b: {$gte: 0}}"));
+    qr->setLimit(1);
+    auto cq = assertGet(CanonicalQuery::canonicalize(opCtx(), std::move(qr)));
+
+    QueryPlannerParams plannerParams;
+    fillOutPlannerParams(&_opCtx, collection, cq.get(), &plannerParams);
+
+    // The child produces a result quickly enough to pass the trial period, but then takes far
+    // more works than the cached plan suggested.
+    const size_t decisionWorks = 1;
+    auto mockChild = std::make_unique<QueuedDataStage>(_expCtx.get(), &_ws);
+    WorkingSetID id = _ws.allocate();
+    WorkingSetMember* member = _ws.get(id);
+    member->doc = {SnapshotId(), Document{BSON("_id" << 0 << "a" << 0 << "b" << 1)}};
+    member->transitionToOwnedObj();
+    mockChild->pushBack(id);
+    for (size_t i = 0; i < 200; ++i) {
+        mockChild->pushBack(PlanStage::NEED_TIME);
+    }
+
+    CachedPlanStage cachedPlanStage(_expCtx.get(),
+                                    collection,
+                                    &_ws,
+                                    cq.get(),
+                                    plannerParams,
+                                    decisionWorks,
+                                    std::move(mockChild));
+
+    PlanYieldPolicy yieldPolicy(PlanExecutor::NO_YIELD,
+                                _opCtx.getServiceContext()->getFastClockSource());
+    ASSERT_OK(cachedPlanStage.pickBestPlan(&yieldPolicy));
+    ASSERT_EQ(cache->get(*cq).state, PlanCache::CacheEntryState::kPresentActive);
+
+    PlanStage::StageState state = PlanStage::NEED_TIME;
+    while (state != PlanStage::IS_EOF) {
+        WorkingSetID out = WorkingSet::INVALID_ID;
+        state = cachedPlanStage.work(&out);
+        ASSERT_NE(state, PlanStage::FAILURE);
+    }
+
+    // The entry is deactivated without the cached plan being replaced by this query.
+    ASSERT_EQ(cache->get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(assertGet(cache->getEntry(*cq))->works, 1U);
+}
+
 TEST_F(QueryStageCachedPlan, ThrowsOnYieldRecoveryWhenIndexIsDroppedBeforePlanSelection) {
     // Create an index which we will drop later on.
     BSONObj keyPattern = BSON("c" << 1);
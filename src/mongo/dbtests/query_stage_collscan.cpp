@@ -425,4 +425,57 @@ TEST_F(QueryStageCollectionScanTest, QueryTestCollscanResumeAfterRecordIdSeekFai
     ASSERT_EQUALS(PlanStage::FAILURE, ps->work(&id));
 }
 
+// Verify that draining a filtered scan through workBatch() returns the same documents, in the same
+// order, as the one-at-a-time interface.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanWorkBatchMatchesWork) {
+    AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+    auto collection = ctx.getCollection();
+
+    CollectionScanParams params;
+    params.direction = CollectionScanParams::FORWARD;
+    ASSERT_TRUE(CollectionScan(_expCtx.get(), collection, params, nullptr, nullptr)
+                    .supportsBatchExecution());
+
+    StatusWithMatchExpression statusWithMatcher =
+        MatchExpressionParser::parse(BSON("foo" << BSON("$lt" << 25)), _expCtx);
+    ASSERT_OK(statusWithMatcher.getStatus());
+    unique_ptr<MatchExpression> filterExpr = std::move(statusWithMatcher.getValue());
+
+    WorkingSet ws;
+    CollectionScan scan(_expCtx.get(), collection, params, &ws, filterExpr.get());
+
+    const size_t kBatchSize = 8;
+    int count = 0;
+    while (!scan.isEOF()) {
+        std::vector<WorkingSetID> results;
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state = scan.workBatch(kBatchSize, &results, &id);
+        ASSERT_LTE(results.size(), kBatchSize);
+        ASSERT_EQUALS(PlanStage::ADVANCED == state, !results.empty());
+        for (auto&& result : results) {
+            WorkingSetMember* member = ws.get(result);
+            ASSERT_EQUALS(count, member->doc.value()["foo"].getInt());
+            ws.free(result);
+            ++count;
+        }
+    }
+    ASSERT_EQUALS(25, count);
+
+    auto stats = scan.getStats();
+    ASSERT_GT(stats->common.batches, 0U);
+    ASSERT_EQUALS(kBatchSize, stats->common.maxBatchSize);
+    ASSERT_EQUALS(25U, stats->common.advanced);
+}
+
+// Tailable scans need per-record handling and are never driven in native batch mode.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanTailableDoesNotSupportBatchExecution) {
+    AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+
+    CollectionScanParams params;
+    params.direction = CollectionScanParams::FORWARD;
+    params.tailable = true;
+    ASSERT_FALSE(CollectionScan(_expCtx.get(), ctx.getCollection(), params, nullptr, nullptr)
+                     .supportsBatchExecution());
+}
+
 }  // namespace query_stage_collection_scan
@@ -521,6 +521,53 @@ TEST_F(QueryStageMultiPlanTest, MPSExplainAllPlans) {
     }
 }
 
+// Test that the trial period ends once a plan fills the first batch, when configured to do so.
+TEST_F(QueryStageMultiPlanTest, MPSTrialPeriodStopsAtFirstBatch) {
+    internalQueryPlanEvaluationStopAtFirstBatch.store(true);
+    ON_BLOCK_EXIT([] { internalQueryPlanEvaluationStopAtFirstBatch.store(false); });
+
+    // Insert a document to create the collection.
+    insert(BSON("x" << 1));
+
+    const int nDocs = 500;
+    const int batchSize = 10;
+
+    auto ws = std::make_unique<WorkingSet>();
+    auto firstPlan = std::make_unique<QueuedDataStage>(_expCtx.get(), ws.get());
+    auto secondPlan = std::make_unique<QueuedDataStage>(_expCtx.get(), ws.get());
+
+    for (int i = 0; i < nDocs; ++i) {
+        addMember(firstPlan.get(), ws.get(), BSON("x" << 1));
+
+        // Make the second plan slower by inserting a NEED_TIME between every result.
+        addMember(secondPlan.get(), ws.get(), BSON("x" << 1));
+        secondPlan->pushBack(PlanStage::NEED_TIME);
+    }
+
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+
+    auto qr = std::make_unique<QueryRequest>(nss);
+    qr->setFilter(BSON("x" << 1));
+    qr->setBatchSize(batchSize);
+    auto cq = uassertStatusOK(CanonicalQuery::canonicalize(opCtx(), std::move(qr)));
+    ASSERT_EQ(MultiPlanStage::getTrialPeriodNumToReturn(*cq), static_cast<size_t>(batchSize));
+
+    unique_ptr<MultiPlanStage> mps =
+        std::make_unique<MultiPlanStage>(_expCtx.get(), ctx.getCollection(), cq.get());
+    mps->addPlan(std::make_unique<QuerySolution>(), std::move(firstPlan), ws.get());
+    mps->addPlan(std::make_unique<QuerySolution>(), std::move(secondPlan), ws.get());
+
+    auto exec = uassertStatusOK(PlanExecutor::make(
+        _opCtx.get(), std::move(ws), std::move(mps), ctx.getCollection(), PlanExecutor::NO_YIELD));
+
+    auto root = static_cast<MultiPlanStage*>(exec->getRootStage());
+    ASSERT_TRUE(root->bestPlanChosen());
+    ASSERT_EQ(root->bestPlanIdx(), 0);
+
+    auto winnerStats = root->getChildren()[0]->getStats();
+    ASSERT_EQ(winnerStats->common.advanced, static_cast<size_t>(batchSize));
+}
+
 // Test that the plan summary only includes stats from the winning plan.
 //
 // This is a regression test for SERVER-20111.
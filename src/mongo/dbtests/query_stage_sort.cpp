@@ -126,6 +126,7 @@ public:
                                                      limit(),
                                                      maxMemoryUsageBytes(),
                                                      false,  // addSortKeyMetadata
+                                                     false,  // discardFetchedDocuments
                                                      std::move(keyGenStage));
 
         // The PlanExecutor will be automatically registered on construction due to the auto
@@ -167,6 +168,7 @@ public:
                                                             limit(),
                                                             maxMemoryUsageBytes(),
                                                             false,  // addSortKeyMetadata
+                                                            discardFetchedDocuments(),
                                                             std::move(keyGenStage));
 
         auto fetchStage = std::make_unique<FetchStage>(
@@ -222,6 +224,12 @@ public:
         return 0;
     };
 
+    // Returns whether the sort stage used by sortAndCheck() keeps only the record ids of its input,
+    // leaving the fetch above it to retrieve the documents again.
+    virtual bool discardFetchedDocuments() const {
+        return false;
+    }
+
     uint64_t maxMemoryUsageBytes() const {
         return internalQueryMaxBlockingSortMemoryUsageBytes.load();
     }
@@ -288,7 +296,7 @@ public:
     }
 };
 
-// Sort in descreasing order with limit applied
+// Sort in decreasing order with limit applied
 template <int LIMIT>
 class QueryStageSortDecWithLimit : public QueryStageSortDec {
 public:
@@ -297,6 +305,15 @@ public:
     }
 };
 
+// Sort in decreasing order with limit applied, with the sort holding only record ids
+template <int LIMIT>
+class QueryStageSortDecWithLimitDiscardingDocuments : public QueryStageSortDecWithLimit<LIMIT> {
+public:
+    bool discardFetchedDocuments() const override {
+        return true;
+    }
+};
+
 // Sort a big bunch of objects.
 class QueryStageSortExt : public QueryStageSortTestBase {
 public:
@@ -583,6 +600,7 @@ public:
                                                             0u,
                                                             maxMemoryUsageBytes(),
                                                             false,  // addSortKeyMetadata
+                                                            false,  // discardFetchedDocuments
                                                             std::move(keyGenStage));
 
         auto fetchStage = std::make_unique<FetchStage>(
@@ -610,6 +628,7 @@ public:
         add<QueryStageSortDecWithLimit<10>>();
         // and a special case for limit == 1
         add<QueryStageSortDecWithLimit<1>>();
+        add<QueryStageSortDecWithLimitDiscardingDocuments<10>>();
         add<QueryStageSortExt>();
         add<QueryStageSortMutationInvalidation>();
         add<QueryStageSortDeletionInvalidation>();
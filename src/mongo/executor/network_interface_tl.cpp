@@ -299,6 +299,13 @@ void NetworkInterfaceTL::CommandStateBase::setTimer() {
                                 << connDuration << ", timeout was set to " << requestOnAny.timeout);
     }
 
+    if (timer) {
+        // The deadline belongs to the command, so the timer armed for an earlier hedged request or
+        // exhaust reply already covers this one. Re-arming it would only churn the reactor's timer
+        // queue.
+        return;
+    }
+
     // TODO reform with SERVER-41459
     timer = interface->_reactor->makeTimer();
     timer->waitUntil(deadline, baton).getAsync([this, anchor = shared_from_this()](Status status) {
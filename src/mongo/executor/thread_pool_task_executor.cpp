@@ -33,6 +33,7 @@
 
 #include "mongo/executor/thread_pool_task_executor.h"
 
+#include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 #include <iterator>
 #include <utility>
@@ -579,7 +580,8 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
                                                      const WorkQueue::iterator& end,
                                                      stdx::unique_lock<Latch> lk) {
     dassert(fromQueue != &_poolInProgressQueue);
-    std::vector<std::shared_ptr<CallbackState>> todo(begin, end);
+    // Almost every caller schedules a single callback, which shouldn't cost an allocation here.
+    boost::container::small_vector<std::shared_ptr<CallbackState>, 1> todo(begin, end);
     _poolInProgressQueue.splice(_poolInProgressQueue.end(), *fromQueue, begin, end);
 
     lk.unlock();
@@ -612,7 +614,7 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
                 });
             });
         } else {
-            _pool->schedule([this, cbState](auto status) {
+            _pool->schedule([this, cbState](auto status) mutable {
                 if (ErrorCodes::isCancelationError(status.code())) {
                     stdx::lock_guard<Latch> lk(_mutex);
 
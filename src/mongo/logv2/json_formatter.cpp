@@ -33,6 +33,7 @@
 #include <boost/log/attributes/value_extraction.hpp>
 #include <boost/log/expressions/message.hpp>
 #include <boost/log/utility/formatting_ostream.hpp>
+#include <boost/optional.hpp>
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
@@ -159,11 +160,11 @@ struct JSONValueExtractor {
     }
 
     BSONObj truncated() {
-        return _truncated.done();
+        return _truncated ? _truncated->done() : BSONObj();
     }
 
     BSONObj truncatedSizes() {
-        return _truncatedSizes.done();
+        return _truncatedSizes ? _truncatedSizes->done() : BSONObj();
     }
 
 private:
@@ -191,7 +192,7 @@ private:
             auto truncatedEnd =
                 str::UTF8SafeTruncation(_buffer.begin() + before, _buffer.end(), _attributeMaxSize);
             if (truncatedEnd != _buffer.end()) {
-                BSONObjBuilder truncationInfo = _truncated.subobjStart(name);
+                BSONObjBuilder truncationInfo = truncatedBuilder().subobjStart(name);
                 truncationInfo.append("type"_sd, typeName(BSONType::String));
                 truncationInfo.append("size"_sd, static_cast<int64_t>(_buffer.size() - before));
                 truncationInfo.done();
@@ -213,14 +214,24 @@ private:
 
     void addTruncationReport(StringData name, const BSONObj& truncated, int64_t objsize) {
         if (!truncated.isEmpty()) {
-            _truncated.append(name, truncated);
-            _truncatedSizes.append(name, objsize);
+            truncatedBuilder().append(name, truncated);
+            if (!_truncatedSizes)
+                _truncatedSizes.emplace();
+            _truncatedSizes->append(name, objsize);
         }
     }
 
+    BSONObjBuilder& truncatedBuilder() {
+        if (!_truncated)
+            _truncated.emplace();
+        return *_truncated;
+    }
+
     fmt::memory_buffer& _buffer;
-    BSONObjBuilder _truncated;
-    BSONObjBuilder _truncatedSizes;
+    // Only created when an attribute is actually truncated, so that formatting a log line does not
+    // allocate two builder buffers that almost always end up empty.
+    boost::optional<BSONObjBuilder> _truncated;
+    boost::optional<BSONObjBuilder> _truncatedSizes;
     StringData _separator = ""_sd;
     size_t _attributeMaxSize;
 };
@@ -49,6 +49,9 @@ struct OpMsg {
     static constexpr uint32_t kMoreToCome = 1 << 1;
     static constexpr uint32_t kExhaustSupported = 1 << 16;
 
+    // Size of the checksum, which trails the message if the kChecksumPresent flag is set
+    static constexpr int kCrc32Size = 4;
+
     /**
      * Returns the unvalidated flags for the given message if it is an OP_MSG message.
      * Returns 0 for other message kinds since they are the equivalent of no flags set.
@@ -293,6 +296,10 @@ private:
     void skipHeaderAndFlags() {
         _buf.skip(sizeof(MSGHEADER::Layout));  // This is filled in by finish().
         _buf.appendNum(uint32_t(0));           // flags (currently always 0).
+
+        // Keep room for a checksum at the end of the buffer, so that OpMsg::appendChecksum() never
+        // has to reallocate (and copy) the finished message.
+        _buf.reserveBytes(OpMsg::kCrc32Size);
     }
 
     // When adding members, remember to update reset().
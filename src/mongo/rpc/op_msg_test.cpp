@@ -935,6 +935,18 @@ TEST(OpMsgTest, ChecksumResizesMessage) {
     OpMsg::parse(msg);
 }
 
+TEST(OpMsgTest, ChecksumDoesNotResizeBuiltMessage) {
+    OpMsgBuilder builder;
+    builder.setBody(fromjson("{ping: 1}"));
+    auto msg = builder.finish();
+
+    // OpMsgBuilder reserves room for the checksum, so appending it doesn't reallocate.
+    const auto data = msg.buf();
+    OpMsg::appendChecksum(&msg);
+    ASSERT_EQ(static_cast<const void*>(msg.buf()), static_cast<const void*>(data));
+    OpMsg::parse(msg);
+}
+
 TEST(OpMsgTest, EmptyMessageWithChecksumFlag) {
     // Checks that an empty message that would normally be invalid because it's
     // missing a body, is invalid because a checksum was specified in the flag
@@ -540,6 +540,113 @@ void CatalogCache::purgeAllDatabases() {
     _collectionsByDb.clear();
 }
 
+Status CatalogCache::warmUp(OperationContext* opCtx, int maxConcurrentRefreshes) {
+    invariant(maxConcurrentRefreshes > 0);
+
+    Timer t;
+    _stats.numCollectionsToWarmUp.store(0);
+    _stats.countCollectionsWarmedUp.store(0);
+    _stats.warmUpTimeMillis.store(-1);
+    ON_BLOCK_EXIT([&] { _stats.warmUpTimeMillis.store(t.millis()); });
+
+    try {
+        const auto catalogClient = Grid::get(opCtx)->catalogClient();
+        const auto databases =
+            uassertStatusOK(
+                catalogClient->getAllDBs(opCtx, repl::ReadConcernLevel::kMajorityReadConcern))
+                .value;
+        const auto collections = uassertStatusOK(
+            catalogClient->getCollections(opCtx, nullptr /* all databases */, nullptr));
+
+        StringMap<CollectionInfoMap> collectionEntriesByDb;
+        for (const auto& coll : collections) {
+            if (coll.getDropped()) {
+                continue;
+            }
+            collectionEntriesByDb[coll.getNs().db()][coll.getNs().ns()] =
+                std::make_shared<CollectionRoutingInfoEntry>();
+        }
+
+        std::vector<NamespaceString> nssToRefresh;
+        {
+            stdx::lock_guard<Latch> lg(_mutex);
+
+            // Seed the databases, which are not cached yet, along with their sharded collections
+            // in the same way getDatabase() does, but without a round-trip per database.
+            for (const auto& db : databases) {
+                auto& dbEntry = _databases[db.getName()];
+                if (dbEntry) {
+                    continue;
+                }
+
+                dbEntry = std::make_shared<DatabaseInfoEntry>();
+                dbEntry->needsRefresh = false;
+                dbEntry->dbt = db;
+                dbEntry->mustLoadShardedCollections = false;
+                _collectionsByDb[db.getName()] = std::move(collectionEntriesByDb[db.getName()]);
+            }
+
+            for (const auto& dbEntry : _collectionsByDb) {
+                for (const auto& collEntry : dbEntry.second) {
+                    if (collEntry.second->needsRefresh) {
+                        nssToRefresh.emplace_back(collEntry.first);
+                    }
+                }
+            }
+        }
+
+        LOGV2(5100023,
+              "Warming up the routing table cache",
+              "numCollections"_attr = nssToRefresh.size(),
+              "maxConcurrentRefreshes"_attr = maxConcurrentRefreshes);
+        _stats.numCollectionsToWarmUp.store(nssToRefresh.size());
+
+        for (auto it = nssToRefresh.begin(); it != nssToRefresh.end();) {
+            std::vector<std::shared_ptr<Notification<Status>>> refreshNotifications;
+            {
+                stdx::lock_guard<Latch> lg(_mutex);
+
+                for (; it != nssToRefresh.end() &&
+                     refreshNotifications.size() < size_t(maxConcurrentRefreshes);
+                     ++it) {
+                    const auto itDb = _collectionsByDb.find(it->db());
+                    if (itDb == _collectionsByDb.end()) {
+                        continue;
+                    }
+
+                    const auto itColl = itDb->second.find(it->ns());
+                    if (itColl == itDb->second.end() || !itColl->second->needsRefresh) {
+                        continue;
+                    }
+
+                    // Join any refresh which is already in progress for this collection
+                    auto& collEntry = itColl->second;
+                    if (!collEntry->refreshCompletionNotification) {
+                        collEntry->refreshCompletionNotification =
+                            std::make_shared<Notification<Status>>();
+                        _scheduleCollectionRefresh(lg, collEntry, *it, 1);
+                    }
+                    refreshNotifications.push_back(collEntry->refreshCompletionNotification);
+                }
+            }
+
+            // Wait on the notifications outside of the mutex
+            for (const auto& refreshNotification : refreshNotifications) {
+                uassertStatusOK(refreshNotification->get(opCtx));
+                _stats.countCollectionsWarmedUp.addAndFetch(1);
+            }
+        }
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+
+    LOGV2(5100024,
+          "Finished warming up the routing table cache",
+          "numCollections"_attr = _stats.countCollectionsWarmedUp.load(),
+          "duration"_attr = Milliseconds(t.millis()));
+    return Status::OK();
+}
+
 void CatalogCache::report(BSONObjBuilder* builder) const {
     BSONObjBuilder cacheStatsBuilder(builder->subobjStart("catalogCache"));
 
@@ -865,6 +972,10 @@ void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
     builder->append("countFullRefreshesStarted", countFullRefreshesStarted.load());
 
     builder->append("countFailedRefreshes", countFailedRefreshes.load());
+
+    builder->append("numCollectionsToWarmUp", numCollectionsToWarmUp.load());
+    builder->append("countCollectionsWarmedUp", countCollectionsWarmedUp.load());
+    builder->append("warmUpTimeMillis", warmUpTimeMillis.load());
 }
 
 CachedDatabaseInfo::CachedDatabaseInfo(DatabaseType dbt, std::shared_ptr<Shard> primaryShard)
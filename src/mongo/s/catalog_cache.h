@@ -293,6 +293,16 @@ public:
      */
     void purgeAllDatabases();
 
+    /**
+     * Blocking method, which loads the routing information for all the sharded collections in the
+     * cluster, refreshing up to 'maxConcurrentRefreshes' of them in parallel. The databases and the
+     * set of sharded collections are each loaded with a single query against the config server.
+     * Entries which are already cached are not reloaded.
+     *
+     * Returns the first error encountered, in which case some collections may not have been loaded.
+     */
+    Status warmUp(OperationContext* opCtx, int maxConcurrentRefreshes);
+
     /**
      * Reports statistics about the catalog cache to be used by serverStatus
      */
@@ -464,6 +474,14 @@ private:
         // for whatever reason
         AtomicWord<long long> countFailedRefreshes{0};
 
+        // Tracks how many collections the last warm-up is going to load, and how many of them have
+        // been loaded so far
+        AtomicWord<long long> numCollectionsToWarmUp{0};
+        AtomicWord<long long> countCollectionsWarmedUp{0};
+
+        // How long the last warm-up took to complete, or -1 while a warm-up is running
+        AtomicWord<long long> warmUpTimeMillis{0};
+
         /**
          * Reports the accumulated statistics for serverStatus.
          */
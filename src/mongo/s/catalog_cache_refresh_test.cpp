@@ -125,6 +125,58 @@ TEST_F(CatalogCacheRefreshTest, FullLoad) {
     ASSERT_EQ(4, cm->numChunks());
 }
 
+TEST_F(CatalogCacheRefreshTest, WarmUpLoadsShardedCollectionsWithBatchedCatalogQueries) {
+    const OID epoch = OID::gen();
+    const ShardKeyPattern shardKeyPattern(BSON("_id" << 1));
+
+    auto future = launchAsync([this] {
+        auto client = getServiceContext()->makeClient("Test");
+        return Grid::get(getServiceContext())->catalogCache()->warmUp(operationContext(), 4);
+    });
+
+    // A single query for all the databases and one for all the sharded collections
+    expectGetDatabase();
+    expectGetCollection(epoch, shardKeyPattern);
+
+    // Followed by the refresh of the collection itself
+    expectGetCollection(epoch, shardKeyPattern);
+    expectFindSendBSONObjVector(kConfigHostAndPort, [&]() {
+        ChunkVersion version(1, 0, epoch);
+
+        ChunkType chunk1(kNss,
+                         {shardKeyPattern.getKeyPattern().globalMin(), BSON("_id" << 0)},
+                         version,
+                         {"0"});
+        chunk1.setName(OID::gen());
+        version.incMinor();
+
+        ChunkType chunk2(kNss,
+                         {BSON("_id" << 0), shardKeyPattern.getKeyPattern().globalMax()},
+                         version,
+                         {"1"});
+        chunk2.setName(OID::gen());
+
+        return std::vector<BSONObj>{chunk1.toConfigBSON(), chunk2.toConfigBSON()};
+    }());
+
+    ASSERT_OK(future.default_timed_get());
+
+    // The routing info is now served from the cache without contacting the config server
+    auto routingInfo =
+        uassertStatusOK(Grid::get(getServiceContext())
+                            ->catalogCache()
+                            ->getCollectionRoutingInfo(operationContext(), kNss));
+    ASSERT(routingInfo.cm());
+    ASSERT_EQ(2, routingInfo.cm()->numChunks());
+
+    BSONObjBuilder builder;
+    Grid::get(getServiceContext())->catalogCache()->report(&builder);
+    const auto stats = builder.obj()["catalogCache"].Obj();
+    ASSERT_EQ(1, stats["numCollectionsToWarmUp"].numberLong());
+    ASSERT_EQ(1, stats["countCollectionsWarmedUp"].numberLong());
+    ASSERT_GTE(stats["warmUpTimeMillis"].numberLong(), 0);
+}
+
 TEST_F(CatalogCacheRefreshTest, NoLoadIfShardNotMarkedStaleInOperationContext) {
     const ShardKeyPattern shardKeyPattern(BSON("_id" << 1));
     auto initialRoutingInfo(
@@ -60,6 +60,22 @@ void checkAllElementsAreOfType(BSONType type, const BSONObj& o) {
     }
 }
 
+void checkChunksAdjoin(const ChunkInfo& left, const ChunkInfo& right) {
+    if (SimpleBSONObjComparator::kInstance.evaluate(left.getMax() == right.getMin()))
+        return;
+
+    if (SimpleBSONObjComparator::kInstance.evaluate(left.getMax() < right.getMin()))
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << "Gap exists in the routing table between chunks "
+                                << left.getRange().toString() << " and "
+                                << right.getRange().toString());
+    else
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << "Overlap exists in the routing table between chunks "
+                                << left.getRange().toString() << " and "
+                                << right.getRange().toString());
+}
+
 std::string extractKeyStringInternal(const BSONObj& shardKeyValue, Ordering ordering) {
     BSONObjBuilder strippedKeyValue;
     for (const auto& elem : shardKeyValue) {
@@ -72,6 +88,137 @@ std::string extractKeyStringInternal(const BSONObj& shardKeyValue, Ordering orde
 
 }  // namespace
 
+ChunkInfoMap::const_iterator& ChunkInfoMap::const_iterator::operator++() {
+    if (++_pos == _map->_blocks[_block]->size()) {
+        ++_block;
+        _pos = 0;
+    }
+    return *this;
+}
+
+ChunkInfoMap::const_iterator& ChunkInfoMap::const_iterator::operator--() {
+    if (_pos == 0) {
+        --_block;
+        _pos = _map->_blocks[_block]->size() - 1;
+    } else {
+        --_pos;
+    }
+    return *this;
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::lower_bound(const key_type& key) const {
+    auto blockIt = std::partition_point(_blocks.begin(), _blocks.end(), [&](const auto& block) {
+        return block->back().first < key;
+    });
+    if (blockIt == _blocks.end())
+        return end();
+
+    const auto& block = **blockIt;
+    auto it = std::partition_point(
+        block.begin(), block.end(), [&](const value_type& entry) { return entry.first < key; });
+    return {this, size_t(blockIt - _blocks.begin()), size_t(it - block.begin())};
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::upper_bound(const key_type& key) const {
+    auto blockIt = std::partition_point(_blocks.begin(), _blocks.end(), [&](const auto& block) {
+        return !(key < block->back().first);
+    });
+    if (blockIt == _blocks.end())
+        return end();
+
+    const auto& block = **blockIt;
+    auto it = std::partition_point(
+        block.begin(), block.end(), [&](const value_type& entry) { return !(key < entry.first); });
+    return {this, size_t(blockIt - _blocks.begin()), size_t(it - block.begin())};
+}
+
+const ChunkInfoMap::mapped_type& ChunkInfoMap::at(const key_type& key) const {
+    auto it = lower_bound(key);
+    invariant(it != end() && it->first == key);
+    return it->second;
+}
+
+void ChunkInfoMap::replaceRange(const_iterator first, const_iterator last, value_type entry) {
+    if (_blocks.empty()) {
+        invariant(first == end() && last == end());
+        _blocks.push_back(std::make_shared<Block>());
+        _blocks.back()->push_back(std::move(entry));
+        _size = 1;
+        return;
+    }
+
+    // Inserting at the end appends to the last block.
+    size_t firstBlock = first._block;
+    size_t firstPos = first._pos;
+    if (firstBlock == _blocks.size()) {
+        firstBlock--;
+        firstPos = _blocks[firstBlock]->size();
+    }
+
+    size_t numRemoved = 0;
+    if (last._block == firstBlock) {
+        auto& block = _mutableBlock(firstBlock);
+        numRemoved = last._pos - firstPos;
+        block.erase(block.begin() + firstPos, block.begin() + last._pos);
+        block.insert(block.begin() + firstPos, std::move(entry));
+    } else {
+        auto& block = _mutableBlock(firstBlock);
+        numRemoved = block.size() - firstPos;
+        block.erase(block.begin() + firstPos, block.end());
+        block.push_back(std::move(entry));
+
+        for (size_t i = firstBlock + 1; i < last._block; i++) {
+            numRemoved += _blocks[i]->size();
+        }
+        if (last._block < _blocks.size() && last._pos > 0) {
+            auto& lastBlock = _mutableBlock(last._block);
+            numRemoved += last._pos;
+            lastBlock.erase(lastBlock.begin(), lastBlock.begin() + last._pos);
+        }
+        _blocks.erase(_blocks.begin() + firstBlock + 1, _blocks.begin() + last._block);
+    }
+
+    _size = _size + 1 - numRemoved;
+    _rebalance(firstBlock);
+}
+
+ChunkInfoMap::Block& ChunkInfoMap::_mutableBlock(size_t i) {
+    // Blocks only become shared by copying the map which references them, so a block which only
+    // this map references cannot be in use anywhere else and is modified in place.
+    if (_blocks[i].use_count() != 1) {
+        _blocks[i] = std::make_shared<Block>(*_blocks[i]);
+    }
+    return *_blocks[i];
+}
+
+void ChunkInfoMap::_rebalance(size_t i) {
+    auto& block = *_blocks[i];
+    if (block.size() > kMaxBlockSize) {
+        const auto mid = block.begin() + block.size() / 2;
+        auto tail = std::make_shared<Block>(std::make_move_iterator(mid),
+                                            std::make_move_iterator(block.end()));
+        block.erase(mid, block.end());
+        _blocks.insert(_blocks.begin() + i + 1, std::move(tail));
+        return;
+    }
+
+    if (i + 1 < _blocks.size() && block.size() + _blocks[i + 1]->size() <= kMinBlockSize) {
+        const auto& next = *_blocks[i + 1];
+        block.insert(block.end(), next.begin(), next.end());
+        _blocks.erase(_blocks.begin() + i + 1);
+    }
+
+    // Block 'i' is only referenced by this map, since the caller modified it, so its entries can
+    // be moved. The previous block may still be shared and is copied first if it is.
+    if (i > 0 && _blocks[i - 1]->size() + block.size() <= kMinBlockSize) {
+        auto& prev = _mutableBlock(i - 1);
+        prev.insert(prev.end(),
+                    std::make_move_iterator(block.begin()),
+                    std::make_move_iterator(block.end()));
+        _blocks.erase(_blocks.begin() + i);
+    }
+}
+
 ShardVersionTargetingInfo::ShardVersionTargetingInfo(const OID& epoch)
     : shardVersion(0, 0, epoch) {}
 
@@ -81,7 +228,8 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
                                          std::unique_ptr<CollatorInterface> defaultCollator,
                                          bool unique,
                                          ChunkInfoMap chunkMap,
-                                         ChunkVersion collectionVersion)
+                                         ChunkVersion collectionVersion,
+                                         ShardVersionMap shardVersions)
     : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
       _nss(std::move(nss)),
       _uuid(uuid),
@@ -91,7 +239,7 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
       _unique(unique),
       _chunkMap(std::move(chunkMap)),
       _collectionVersion(collectionVersion),
-      _shardVersions(_constructShardVersionMap()) {}
+      _shardVersions(std::move(shardVersions)) {}
 
 void RoutingTableHistory::setShardStale(const ShardId& shardId) {
     if (gEnableFinerGrainedCatalogCacheRefresh) {
@@ -131,6 +279,35 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj
     return Chunk(*(it->second), _clusterTime);
 }
 
+std::vector<boost::optional<Chunk>> ChunkManager::findIntersectingChunksWithSimpleCollation(
+    const std::vector<BSONObj>& shardKeys) const {
+    const auto& chunkMap = _rt->getChunkMap();
+
+    std::vector<std::pair<std::string, size_t>> sortedKeys;
+    sortedKeys.reserve(shardKeys.size());
+    for (size_t i = 0; i < shardKeys.size(); i++) {
+        sortedKeys.emplace_back(_rt->_extractKeyString(shardKeys[i]), i);
+    }
+    std::sort(sortedKeys.begin(), sortedKeys.end());
+
+    std::vector<boost::optional<Chunk>> chunks(shardKeys.size());
+    auto it = chunkMap.end();
+    bool itContainsPreviousKey = false;
+    for (const auto& [keyString, index] : sortedKeys) {
+        // A key sorting between the previous key and the max of the chunk containing the previous
+        // key belongs to the same chunk.
+        if (!itContainsPreviousKey || !(keyString < it->first)) {
+            it = chunkMap.upper_bound(keyString);
+            itContainsPreviousKey =
+                it != chunkMap.end() && it->second->containsKey(shardKeys[index]);
+            if (!itContainsPreviousKey)
+                continue;
+        }
+        chunks[index].emplace(*it->second, _clusterTime);
+    }
+    return chunks;
+}
+
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
@@ -465,16 +642,17 @@ std::string RoutingTableHistory::toString() const {
     return sb.str();
 }
 
-ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
-    const OID& epoch = _collectionVersion.epoch();
+ShardVersionMap RoutingTableHistory::_constructShardVersionMap(
+    const ChunkInfoMap& chunkMap, const ChunkVersion& collectionVersion) const {
+    const OID& epoch = collectionVersion.epoch();
 
     ShardVersionMap shardVersions;
-    ChunkInfoMap::const_iterator current = _chunkMap.cbegin();
+    ChunkInfoMap::const_iterator current = chunkMap.cbegin();
 
     boost::optional<BSONObj> firstMin = boost::none;
     boost::optional<BSONObj> lastMax = boost::none;
 
-    while (current != _chunkMap.cend()) {
+    while (current != chunkMap.cend()) {
         const auto& firstChunkInRange = current->second;
         const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
 
@@ -488,7 +666,7 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
 
         current =
             std::find_if(current,
-                         _chunkMap.cend(),
+                         chunkMap.cend(),
                          [&currentRangeShardId,
                           &maxShardVersion](const ChunkInfoMap::value_type& chunkMapEntry) {
                              const auto& currentChunk = chunkMapEntry.second;
@@ -513,13 +691,13 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
                 uasserted(ErrorCodes::ConflictingOperationInProgress,
                           str::stream()
                               << "Gap exists in the routing table between chunks "
-                              << _chunkMap.at(_extractKeyString(*lastMax))->getRange().toString()
+                              << chunkMap.at(_extractKeyString(*lastMax))->getRange().toString()
                               << " and " << rangeLast->second->getRange().toString());
             else
                 uasserted(ErrorCodes::ConflictingOperationInProgress,
                           str::stream()
                               << "Overlap exists in the routing table between chunks "
-                              << _chunkMap.at(_extractKeyString(*lastMax))->getRange().toString()
+                              << chunkMap.at(_extractKeyString(*lastMax))->getRange().toString()
                               << " and " << rangeLast->second->getRange().toString());
         }
 
@@ -533,7 +711,7 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
         invariant(maxShardVersion.isSet());
     }
 
-    if (!_chunkMap.empty()) {
+    if (!chunkMap.empty()) {
         invariant(!shardVersions.empty());
         invariant(firstMin.is_initialized());
         invariant(lastMax.is_initialized());
@@ -545,6 +723,23 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
     return shardVersions;
 }
 
+void RoutingTableHistory::_checkContinuity(const ChunkInfoMap& chunkMap,
+                                           ChunkInfoMap::const_iterator it) const {
+    const auto& chunk = *it->second;
+    if (it == chunkMap.begin()) {
+        checkAllElementsAreOfType(MinKey, chunk.getMin());
+    } else {
+        checkChunksAdjoin(*std::prev(it)->second, chunk);
+    }
+
+    const auto next = std::next(it);
+    if (next == chunkMap.end()) {
+        checkAllElementsAreOfType(MaxKey, chunk.getMax());
+    } else {
+        checkChunksAdjoin(chunk, *next->second);
+    }
+}
+
 std::string RoutingTableHistory::_extractKeyString(const BSONObj& shardKeyValue) const {
     return extractKeyStringInternal(shardKeyValue, _shardKeyOrdering);
 }
@@ -563,7 +758,8 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeNew(
                                std::move(defaultCollator),
                                std::move(unique),
                                {},
-                               {0, 0, epoch})
+                               {0, 0, epoch},
+                               {})
         .makeUpdated(chunks);
 }
 
@@ -573,6 +769,21 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
     const auto startingCollectionVersion = getVersion();
     auto chunkMap = _chunkMap;
 
+    // The shard versions are maintained along with the chunk map. Every changed chunk has a
+    // version at least as high as any existing chunk, so it becomes the max version of the shard
+    // which receives it. A shard only needs its max version to be recomputed if it loses the chunk
+    // with its max version and receives no newer chunk.
+    struct ShardMaxVersion {
+        ChunkVersion version;
+        bool removed;
+    };
+    std::map<ShardId, ShardMaxVersion> shardMaxVersions;
+    for (const auto& [shardId, targetingInfo] : _shardVersions) {
+        shardMaxVersions.emplace(shardId, ShardMaxVersion{targetingInfo.shardVersion, false});
+    }
+    std::vector<std::string> changedChunkKeys;
+    changedChunkKeys.reserve(changedChunks.size());
+
     ChunkVersion collectionVersion = startingCollectionVersion;
     for (const auto& chunk : changedChunks) {
         const auto& chunkVersion = chunk.getVersion();
@@ -621,11 +832,27 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
             newChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
         }
 
-        // Erase all chunks from the map, which overlap the chunk we got from the persistent store
-        chunkMap.erase(low, high);
+        for (auto it = low; it != high; ++it) {
+            const auto& removedChunk = it->second;
+            auto shardIt = shardMaxVersions.find(removedChunk->getShardIdAt(boost::none));
+            if (shardIt != shardMaxVersions.end() &&
+                removedChunk->getLastmod() == shardIt->second.version) {
+                shardIt->second.removed = true;
+            }
+        }
 
-        // Insert only the chunk itself
-        chunkMap.insert(std::make_pair(chunkMaxKeyString, newChunk));
+        auto& shardMaxVersion =
+            shardMaxVersions
+                .emplace(newChunk->getShardIdAt(boost::none),
+                         ShardMaxVersion{ChunkVersion(0, 0, chunkVersion.epoch()), false})
+                .first->second;
+        shardMaxVersion.version = chunkVersion;
+        shardMaxVersion.removed = false;
+
+        // Replace all chunks in the map which overlap the chunk we got from the persistent store
+        // with the chunk itself
+        chunkMap.replaceRange(low, high, std::make_pair(chunkMaxKeyString, newChunk));
+        changedChunkKeys.push_back(chunkMaxKeyString);
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
@@ -640,6 +867,28 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         return shared_from_this();
     }
 
+    const bool needsFullRebuild =
+        std::any_of(shardMaxVersions.begin(), shardMaxVersions.end(), [](const auto& entry) {
+            return entry.second.removed;
+        });
+
+    ShardVersionMap shardVersions;
+    if (needsFullRebuild) {
+        shardVersions = _constructShardVersionMap(chunkMap, collectionVersion);
+    } else {
+        // Gaps and overlaps can only appear next to a chunk which was changed.
+        for (const auto& key : changedChunkKeys) {
+            auto it = chunkMap.lower_bound(key);
+            if (it != chunkMap.end() && it->first == key)
+                _checkContinuity(chunkMap, it);
+        }
+
+        for (const auto& [shardId, shardMaxVersion] : shardMaxVersions) {
+            shardVersions.emplace(shardId, collectionVersion.epoch())
+                .first->second.shardVersion = shardMaxVersion.version;
+        }
+    }
+
     return std::shared_ptr<RoutingTableHistory>(
         new RoutingTableHistory(_nss,
                                 _uuid,
@@ -647,7 +896,8 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
                                 CollatorInterface::cloneCollator(getDefaultCollator()),
                                 isUnique(),
                                 std::move(chunkMap),
-                                collectionVersion));
+                                collectionVersion,
+                                std::move(shardVersions)));
 }
 
 }  // namespace mongo
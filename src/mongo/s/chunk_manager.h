@@ -49,8 +49,128 @@ struct QuerySolutionNode;
 class OperationContext;
 class ChunkManager;
 
-// Ordered map from the max for each chunk to an entry describing the chunk
-using ChunkInfoMap = std::map<std::string, std::shared_ptr<ChunkInfo>>;
+/**
+ * Ordered map from the max for each chunk to an entry describing the chunk.
+ *
+ * The entries are kept in fixed-size blocks which are shared between copies of the map. A copy
+ * only copies the list of blocks, and modifying it copies just the blocks that are modified, so
+ * that a routing table refresh costs in proportion to the number of chunks which changed rather
+ * than to the number of chunks in the collection.
+ */
+class ChunkInfoMap {
+public:
+    using key_type = std::string;
+    using mapped_type = std::shared_ptr<ChunkInfo>;
+    using value_type = std::pair<key_type, mapped_type>;
+    using size_type = size_t;
+
+    // Blocks which grow beyond kMaxBlockSize entries are split in two, and adjacent blocks which
+    // together have no more than kMinBlockSize entries are merged.
+    static constexpr size_t kMaxBlockSize = 256;
+    static constexpr size_t kMinBlockSize = kMaxBlockSize / 2;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ChunkInfoMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return (*_map->_blocks[_block])[_pos];
+        }
+        pointer operator->() const {
+            return &**this;
+        }
+
+        const_iterator& operator++();
+        const_iterator operator++(int) {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+        const_iterator& operator--();
+        const_iterator operator--(int) {
+            auto old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _block == other._block && _pos == other._pos;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkInfoMap;
+
+        const_iterator(const ChunkInfoMap* map, size_t block, size_t pos)
+            : _map(map), _block(block), _pos(pos) {}
+
+        // Either points to an entry, or is end() with '_block' equal to the number of blocks.
+        const ChunkInfoMap* _map = nullptr;
+        size_t _block = 0;
+        size_t _pos = 0;
+    };
+    using iterator = const_iterator;
+
+    const_iterator begin() const {
+        return {this, 0, 0};
+    }
+    const_iterator end() const {
+        return {this, _blocks.size(), 0};
+    }
+    const_iterator cbegin() const {
+        return begin();
+    }
+    const_iterator cend() const {
+        return end();
+    }
+
+    size_t size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    const_iterator lower_bound(const key_type& key) const;
+    const_iterator upper_bound(const key_type& key) const;
+
+    /**
+     * Returns the chunk whose max is 'key', which must exist.
+     */
+    const mapped_type& at(const key_type& key) const;
+
+    /**
+     * Replaces the entries in ['first', 'last') with 'entry', which must sort after every entry
+     * before 'first' and before 'last'. Invalidates all iterators.
+     */
+    void replaceRange(const_iterator first, const_iterator last, value_type entry);
+
+private:
+    using Block = std::vector<value_type>;
+
+    /**
+     * Returns block 'i', copying it first if it is shared with another map.
+     */
+    Block& _mutableBlock(size_t i);
+
+    /**
+     * Splits block 'i' if it has grown too large, or merges it with the following and then the
+     * preceding block while their combined size stays small. Block 'i' must not be shared.
+     */
+    void _rebalance(size_t i);
+
+    // Never contains an empty block.
+    std::vector<std::shared_ptr<Block>> _blocks;
+    size_t _size = 0;
+};
 
 struct ShardVersionTargetingInfo {
     // Indicates whether the shard is stale and thus needs a catalog cache refresh. Is false by
@@ -186,12 +306,21 @@ private:
                         std::unique_ptr<CollatorInterface> defaultCollator,
                         bool unique,
                         ChunkInfoMap chunkMap,
-                        ChunkVersion collectionVersion);
+                        ChunkVersion collectionVersion,
+                        ShardVersionMap shardVersions);
 
     /**
-     * Does a single pass over the chunkMap and constructs the ShardVersionMap object.
+     * Does a single pass over 'chunkMap' and constructs the ShardVersionMap object, checking that
+     * the chunks cover the whole shard key space.
      */
-    ShardVersionMap _constructShardVersionMap() const;
+    ShardVersionMap _constructShardVersionMap(const ChunkInfoMap& chunkMap,
+                                              const ChunkVersion& collectionVersion) const;
+
+    /**
+     * Checks that the chunk at 'it' in 'chunkMap' adjoins its neighbours, and that it starts at
+     * MinKey or ends at MaxKey if it is the first or the last chunk.
+     */
+    void _checkContinuity(const ChunkInfoMap& chunkMap, ChunkInfoMap::const_iterator it) const;
 
     std::string _extractKeyString(const BSONObj& shardKeyValue) const;
 
@@ -366,6 +495,15 @@ public:
         return findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
     }
 
+    /**
+     * Same as findIntersectingChunkWithSimpleCollation for each of 'shardKeys', but looks the keys
+     * up in shard key order so that keys which fall into the same chunk as the previous key reuse
+     * that chunk instead of searching the chunk map again. Returns, in the order of 'shardKeys',
+     * the chunk containing each key or boost::none if no chunk contains it.
+     */
+    std::vector<boost::optional<Chunk>> findIntersectingChunksWithSimpleCollation(
+        const std::vector<BSONObj>& shardKeys) const;
+
     /**
      * Finds the shard id of the shard that owns the chunk minKey belongs to, assuming the simple
      * collation because shard keys do not support non-simple collations.
@@ -124,6 +124,39 @@ void BM_IncrementalRefreshOfPessimalBalancedDistribution(benchmark::State& state
 
 BENCHMARK(BM_IncrementalRefreshOfPessimalBalancedDistribution)->Args({2, 50000});
 
+/**
+ * Refreshes a routing table of state.range(1) chunks in which state.range(2) chunks, spread evenly
+ * through the key space, moved between shards.
+ */
+void BM_IncrementalRefreshWithChangedChunks(benchmark::State& state) {
+    const int nShards = state.range(0);
+    const int nChunks = state.range(1);
+    const int nChanged = state.range(2);
+    auto cm = makeChunkManagerWithOptimalBalancedDistribution(nShards, nChunks);
+
+    auto postMoveVersion = cm->getChunkManager()->getVersion();
+    const auto collName = NamespaceString(cm->getChunkManager()->getns());
+    std::vector<ChunkType> newChunks;
+    for (int i = 0; i < nChanged; i++) {
+        postMoveVersion.incMajor();
+        const int chunk = int(int64_t(i) * nChunks / nChanged);
+        newChunks.emplace_back(collName,
+                               getRangeForChunk(chunk, nChunks),
+                               postMoveVersion,
+                               ShardId(str::stream() << "shard" << (i % nShards)));
+    }
+
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(runIncrementalUpdate(*cm, newChunks));
+    }
+}
+
+BENCHMARK(BM_IncrementalRefreshWithChangedChunks)
+    ->Args({10, 50000, 2})
+    ->Args({10, 1000000, 2})
+    ->Args({10, 1000000, 100})
+    ->Args({10, 1000000, 10000});
+
 template <typename ShardSelectorFn>
 auto BM_FullBuildOfChunkManager(benchmark::State& state, ShardSelectorFn selectShard) {
     const int nShards = state.range(0);
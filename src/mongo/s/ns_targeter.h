@@ -103,6 +103,31 @@ public:
     virtual StatusWith<ShardEndpoint> targetInsert(OperationContext* opCtx,
                                                    const BSONObj& doc) const = 0;
 
+    /**
+     * Returns the result of targetInsert() for each of 'docs', in the same order. Targeters which
+     * can target a group of documents more cheaply than one at a time override this.
+     *
+     * If targetInsert() would throw for one of the documents, returns the results for the
+     * documents before it, or throws if it is the first one.
+     */
+    virtual std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+        std::vector<StatusWith<ShardEndpoint>> endpoints;
+        endpoints.reserve(docs.size());
+        for (const auto& doc : docs) {
+            if (endpoints.empty()) {
+                endpoints.push_back(targetInsert(opCtx, doc));
+                continue;
+            }
+            try {
+                endpoints.push_back(targetInsert(opCtx, doc));
+            } catch (const DBException&) {
+                break;
+            }
+        }
+        return endpoints;
+    }
+
     /**
      * Returns a vector of ShardEndpoints for a potentially multi-shard update.
      *
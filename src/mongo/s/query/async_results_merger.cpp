@@ -41,6 +41,7 @@
 #include "mongo/db/query/killcursors_request.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
+#include "mongo/s/query/async_results_merger_params_gen.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -82,6 +83,15 @@ int compareSortKeys(BSONObj leftSortKey, BSONObj rightSortKey, BSONObj sortKeyPa
     return leftSortKey.woCompare(rightSortKey, sortKeyPattern, rules);
 }
 
+/**
+ * Encodes 'sortKey' as a KeyString whose byte-wise order matches the order defined by
+ * compareSortKeys() for the sort key pattern described by 'ordering'.
+ */
+KeyString::Value encodeSortKey(const BSONObj& sortKey, Ordering ordering) {
+    KeyString::HeapBuilder builder(KeyString::Version::kLatestVersion, sortKey, ordering);
+    return builder.release();
+}
+
 }  // namespace
 
 AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
@@ -94,13 +104,16 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
     }
 
+    if (_params.getSort() &&
+        static_cast<size_t>(_params.getSort()->nFields()) <= Ordering::kMaxCompoundIndexKeys) {
+        _sortKeyOrdering = Ordering::make(*_params.getSort());
+    }
+
     size_t remoteIndex = 0;
     for (const auto& remote : _params.getRemotes()) {
         _remotes.emplace_back(remote.getHostAndPort(),
@@ -194,6 +207,7 @@ void AsyncResultsMerger::addNewShardCursors(std::vector<RemoteCursor>&& newCurso
                               remote.getCursorResponse().getPartialResultsReturned());
         _addBatchToBuffer(lk, newIndex, remote.getCursorResponse());
     }
+    _mergeTreeNeedsRebuild = true;
 }
 
 bool AsyncResultsMerger::partialResultsReturned() const {
@@ -276,12 +290,12 @@ bool AsyncResultsMerger::_readySorted(WithLock lk) {
 }
 
 bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
-    if (_mergeQueue.empty()) {
+    auto smallestRemote = _getSmallestRemote(lk);
+    if (!smallestRemote) {
         return false;
     }
 
-    auto smallestRemote = _mergeQueue.top();
-    auto smallestResult = _remotes[smallestRemote].docBuffer.front();
+    auto smallestResult = _remotes[*smallestRemote].docBuffer.front();
     auto keyWeWantToReturn =
         extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
     // We should always have a minPromisedSortKey from every shard in the sorted tailable case.
@@ -324,29 +338,31 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
-    if (_mergeQueue.empty()) {
+    auto smallestRemoteOpt = _getSmallestRemote(lk);
+    if (!smallestRemoteOpt) {
         return {};
     }
 
-    size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
-
-    invariant(!_remotes[smallestRemote].docBuffer.empty());
-    invariant(_remotes[smallestRemote].status.isOK());
+    const size_t smallestRemote = *smallestRemoteOpt;
+    auto& remote = _remotes[smallestRemote];
+    invariant(remote.status.isOK());
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
-    _remotes[smallestRemote].docBuffer.pop();
-
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
+    ClusterQueryResult front = remote.docBuffer.front();
+    remote.docBuffer.pop();
+    remote.bufferedBytes -= front.getResult()->objsize();
+    _totalBufferedBytes -= front.getResult()->objsize();
+    if (_sortKeyOrdering) {
+        remote.sortKeyBuffer.pop();
     }
 
+    // Let the next result from 'smallestRemote', if there is one, compete for the next spot.
+    _replayMergeTree(lk, smallestRemote);
+    _prefetchIfBelowWatermark(lk, smallestRemote);
+
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
     if (_tailableMode == TailableModeEnum::kTailableAndAwaitData) {
         _highWaterMark =
@@ -356,7 +372,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     return front;
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock lk) {
     size_t remotesAttempted = 0;
     while (remotesAttempted < _remotes.size()) {
         // It is illegal to call this method if there is an error received from any shard.
@@ -365,6 +381,8 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
         if (_remotes[_gettingFromRemote].hasNext()) {
             ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
             _remotes[_gettingFromRemote].docBuffer.pop();
+            _remotes[_gettingFromRemote].bufferedBytes -= front.getResult()->objsize();
+            _totalBufferedBytes -= front.getResult()->objsize();
 
             if (_tailableMode == TailableModeEnum::kTailable &&
                 !_remotes[_gettingFromRemote].hasNext()) {
@@ -374,6 +392,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
                 _eofNext = true;
             }
 
+            _prefetchIfBelowWatermark(lk, _gettingFromRemote);
             return front;
         }
 
@@ -617,6 +636,11 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        std::queue<KeyString::Value> emptySortKeyBuffer;
+        std::swap(remote.sortKeyBuffer, emptySortKeyBuffer);
+        _totalBufferedBytes -= remote.bufferedBytes;
+        remote.bufferedBytes = 0;
+        _mergeTreeNeedsRebuild = true;
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -664,6 +688,9 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
         // Be careful only to do this when '_opCtx' is non-null, since it is illegal to schedule a
         // remote command on a user's behalf without a non-null OperationContext.
         remote.status = _askForNextBatch(lk, remoteIndex);
+    } else {
+        // Keep reading ahead while this remote's buffer is still below the watermark.
+        _prefetchIfBelowWatermark(lk, remoteIndex);
     }
 }
 
@@ -672,6 +699,12 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
     _updateRemoteMetadata(lk, remoteIndex, response);
+
+    // A remote that gains its first buffered result has to be entered into the merge.
+    if (_params.getSort() && !remote.hasNext() && !response.getBatch().empty()) {
+        _mergeTreeNeedsRebuild = true;
+    }
+
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
         if (_params.getSort()) {
@@ -691,17 +724,105 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
             }
         }
 
+        if (_sortKeyOrdering) {
+            remote.sortKeyBuffer.push(encodeSortKey(
+                extractSortKey(obj, _params.getCompareWholeSortKey()), *_sortKeyOrdering));
+        }
+
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
+        remote.bufferedBytes += obj.objsize();
+        _totalBufferedBytes += obj.objsize();
         ++remote.fetchedCount;
     }
+    return true;
+}
 
-    // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
-    if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+bool AsyncResultsMerger::_mergeLess(WithLock, size_t lhs, size_t rhs) const {
+    const auto& leftRemote = _remotes[lhs];
+    const auto& rightRemote = _remotes[rhs];
+    if (!leftRemote.hasNext() || !rightRemote.hasNext()) {
+        return leftRemote.hasNext() || (!rightRemote.hasNext() && lhs < rhs);
+    }
+
+    int cmp;
+    if (_sortKeyOrdering) {
+        cmp = leftRemote.sortKeyBuffer.front().compare(rightRemote.sortKeyBuffer.front());
+    } else {
+        const bool compareWholeSortKey = _params.getCompareWholeSortKey();
+        cmp = compareSortKeys(
+            extractSortKey(*leftRemote.docBuffer.front().getResult(), compareWholeSortKey),
+            extractSortKey(*rightRemote.docBuffer.front().getResult(), compareWholeSortKey),
+            *_params.getSort());
+    }
+    return cmp < 0 || (cmp == 0 && lhs < rhs);
+}
+
+boost::optional<size_t> AsyncResultsMerger::_getSmallestRemote(WithLock lk) {
+    if (_mergeTreeNeedsRebuild) {
+        _rebuildMergeTree(lk);
+    }
+    if (_remotes.empty() || !_remotes[_mergeTree[0]].hasNext()) {
+        return boost::none;
+    }
+    return _mergeTree[0];
+}
+
+void AsyncResultsMerger::_rebuildMergeTree(WithLock lk) {
+    _mergeTreeNeedsRebuild = false;
+    const size_t numRemotes = _remotes.size();
+    _mergeTree.assign(std::max(numRemotes, size_t{1}), 0);
+    if (numRemotes <= 1) {
+        return;
+    }
+
+    // Play the tournament bottom-up, recording the winner of every match in 'winners' and its
+    // loser in the tree. The leaves occupy positions [numRemotes, 2 * numRemotes).
+    std::vector<size_t> winners(2 * numRemotes);
+    for (size_t i = 0; i < numRemotes; ++i) {
+        winners[numRemotes + i] = i;
+    }
+    for (size_t pos = numRemotes - 1; pos >= 1; --pos) {
+        const size_t left = winners[2 * pos];
+        const size_t right = winners[2 * pos + 1];
+        const bool leftWins = _mergeLess(lk, left, right);
+        winners[pos] = leftWins ? left : right;
+        _mergeTree[pos] = leftWins ? right : left;
+    }
+    _mergeTree[0] = winners[1];
+}
+
+void AsyncResultsMerger::_replayMergeTree(WithLock lk, size_t remoteIndex) {
+    if (_mergeTreeNeedsRebuild) {
+        return;
+    }
+    invariant(_mergeTree[0] == remoteIndex);
+
+    // Only the matches along the winner's path can change their outcome, so each comparison is
+    // against the loser stored at the next node up.
+    size_t winner = remoteIndex;
+    for (size_t pos = (_remotes.size() + remoteIndex) / 2; pos >= 1; pos /= 2) {
+        if (_mergeLess(lk, _mergeTree[pos], winner)) {
+            std::swap(_mergeTree[pos], winner);
+        }
+    }
+    _mergeTree[0] = winner;
+}
+
+void AsyncResultsMerger::_prefetchIfBelowWatermark(WithLock lk, size_t remoteIndex) {
+    const long long watermark = internalQueryAsyncResultsMergerPrefetchBytes.load();
+    auto& remote = _remotes[remoteIndex];
+    if (watermark <= 0 || _tailableMode != TailableModeEnum::kNormal || !remote.hasNext() ||
+        remote.exhausted() || remote.cbHandle.isValid() || _lifecycleState != kAlive || !_opCtx) {
+        return;
+    }
+
+    const long long budget = internalQueryAsyncResultsMergerPrefetchMaxBufferedBytes.load();
+    if (remote.bufferedBytes < static_cast<size_t>(watermark) &&
+        _totalBufferedBytes < static_cast<size_t>(budget)) {
+        // Any error is stored on the remote and reported by the next call to ready().
+        remote.status = _askForNextBatch(lk, remoteIndex);
     }
-    return true;
 }
 
 void AsyncResultsMerger::_signalCurrentEventIfReady(WithLock lk) {
@@ -811,19 +932,6 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
     return cursorId == 0;
 }
 
-//
-// AsyncResultsMerger::MergingComparator
-//
-
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
-
-    return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
-                           extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
-}
-
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
     const MinSortKeyRemoteIdPair& lhs, const MinSortKeyRemoteIdPair& rhs) const {
     auto sortKeyComp = compareSortKeys(lhs.first, rhs.first, _sort);
@@ -35,7 +35,9 @@
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
@@ -88,8 +90,8 @@ public:
      * the hosts on which they exist in _remotes.
      *
      * Additionally copies each remote's first batch of results, if one exists, into that remote's
-     * docBuffer. If a sort is specified in the ClusterClientCursorParams, places the remotes with
-     * buffered results onto _mergeQueue.
+     * docBuffer. If a sort is specified in the ClusterClientCursorParams, the remotes with buffered
+     * results take part in the merge performed by _mergeTree.
      *
      * The TaskExecutor* must remain valid for the lifetime of the ARM.
      *
@@ -305,6 +307,13 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // When merging with a sort whose pattern can be described by an Ordering, holds the
+        // KeyString encoding of the sort key of each entry in 'docBuffer', in the same order.
+        std::queue<KeyString::Value> sortKeyBuffer;
+
+        // The total BSON size of the documents in 'docBuffer'.
+        size_t bufferedBytes = 0;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -317,26 +326,6 @@ private:
         long long fetchedCount = 0;
     };
 
-    class MergingComparator {
-    public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes,
-                          const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
-
-        bool operator()(const size_t& lhs, const size_t& rhs);
-
-    private:
-        const std::vector<RemoteCursorData>& _remotes;
-
-        const BSONObj _sort;
-
-        // When '_compareWholeSortKey' is true, $sortKey is a scalar value, rather than an object.
-        // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
-        // be {$sortKey: 1}.
-        const bool _compareWholeSortKey;
-    };
-
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
 
     class PromisedMinSortKeyComparator {
@@ -390,6 +379,34 @@ private:
     ClusterQueryResult _nextReadySorted(WithLock);
     ClusterQueryResult _nextReadyUnsorted(WithLock);
 
+    //
+    // Helpers for the sorted merge.
+    //
+
+    /**
+     * Returns true if the next buffered result of the remote at 'lhs' sorts strictly before the
+     * one of the remote at 'rhs'. A remote without buffered results sorts after every remote that
+     * has one; ties are broken by remote index so that the merge order is deterministic.
+     */
+    bool _mergeLess(WithLock, size_t lhs, size_t rhs) const;
+
+    /**
+     * Returns the index of the remote holding the smallest buffered result, or boost::none if no
+     * remote has a buffered result. Rebuilds '_mergeTree' first if it has been invalidated.
+     */
+    boost::optional<size_t> _getSmallestRemote(WithLock);
+
+    /**
+     * Rebuilds '_mergeTree' from scratch by playing a full tournament between all the remotes.
+     */
+    void _rebuildMergeTree(WithLock);
+
+    /**
+     * Replays the matches on the path from the leaf of 'remoteIndex' to the root of '_mergeTree'.
+     * Must only be called after the front of the buffer of the current winner has changed.
+     */
+    void _replayMergeTree(WithLock, size_t remoteIndex);
+
     using CbData = executor::TaskExecutor::RemoteCommandCallbackArgs;
     using CbResponse = executor::TaskExecutor::ResponseStatus;
 
@@ -448,6 +465,15 @@ private:
      */
     Status _scheduleGetMores(WithLock);
 
+    /**
+     * If read-ahead is enabled, schedules a getMore on the given remote while it still has
+     * buffered results, provided that they amount to less than
+     * internalQueryAsyncResultsMergerPrefetchBytes and that the results buffered across all
+     * remotes are within internalQueryAsyncResultsMergerPrefetchMaxBufferedBytes. Remotes without
+     * buffered results are left to _scheduleGetMores().
+     */
+    void _prefetchIfBelowWatermark(WithLock, size_t remoteIndex);
+
     /**
      * Schedules a killCursors command to be run on all remote hosts that have open cursors.
      */
@@ -469,9 +495,23 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // The sum of 'bufferedBytes' over all of '_remotes'.
+    size_t _totalBufferedBytes = 0;
+
+    // Loser tree over '_remotes' used to merge the buffered results when there is a sort. Leaf i
+    // (which is implicit) is the remote at index i and sits at position '_remotes.size() + i';
+    // internal node p has children 2p and 2p + 1 and holds the loser of the match played there.
+    // Position 0 holds the overall winner, i.e. the remote with the next document to return.
+    std::vector<size_t> _mergeTree;
+
+    // Set when a remote gains or loses its buffered results other than by the winner's buffer
+    // being popped, in which case the tree is rebuilt before it is next consulted.
+    bool _mergeTreeNeedsRebuild = true;
+
+    // The Ordering for the sort key pattern, used to encode sort keys as KeyStrings so that the
+    // merge compares them with memcmp. Unset if there is no sort or if the pattern has too many
+    // fields to be described by an Ordering, in which case BSON sort keys are compared instead.
+    boost::optional<Ordering> _sortKeyOrdering;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
@@ -40,10 +40,12 @@
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/executor/task_executor.h"
+#include "mongo/s/query/async_results_merger_params_gen.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/query/results_merger_test_fixture.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -443,6 +445,151 @@ TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortedMergeReentersRemoteAfterItsBufferRunsEmpty) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: 1, b: -1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: {'': 1, '': 2}}"),
+                                   fromjson("{$sortKey: {'': 4, '': 1}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: {'': 1, '': 3}}"),
+                                   fromjson("{$sortKey: {'': 3, '': 0}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 0, batch2)));
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: {'': 5, '': 0}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[2], kTestShardHosts[2], CursorResponse(kTestNss, 0, batch3)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1, '': 3}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1, '': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 3, '': 0}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 4, '': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    // The first shard has run out of buffered results but its cursor is still open.
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+
+    // Numeric sort keys of different types must still be merged by value.
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch4 = {fromjson("{$sortKey: {'': 4.5, '': 1}}"),
+                                   fromjson("{$sortKey: {'': NumberLong(6), '': 1}}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch4);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(arm->remotesExhausted());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 4.5, '': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 5, '': 0}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': NumberLong(6), '': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, SortedMergePrefetchesBelowWatermark) {
+    internalQueryAsyncResultsMergerPrefetchBytes.store(1024 * 1024);
+    ON_BLOCK_EXIT([] { internalQueryAsyncResultsMergerPrefetchBytes.store(0); });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: {'': 1}}"),
+                                   fromjson("{$sortKey: {'': 3}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: {'': 2}}"),
+                                   fromjson("{$sortKey: {'': 4}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, batch2)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // Nothing is fetched until a buffer falls below the watermark.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    // Popping a result from the first shard leaves it below the watermark, so its next batch is
+    // requested while it still has a buffered result.
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    auto firstRequest = GetMoreRequest::parseFromBSON("anydbname", getNthPendingRequest(0).cmdObj);
+    ASSERT_OK(firstRequest.getStatus());
+    ASSERT_EQ(firstRequest.getValue().cursorid, 5LL);
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: {'': 5}}")};
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), batch3));
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    auto secondRequest = GetMoreRequest::parseFromBSON("anydbname", getNthPendingRequest(0).cmdObj);
+    ASSERT_OK(secondRequest.getStatus());
+    ASSERT_EQ(secondRequest.getValue().cursorid, 6LL);
+    std::vector<BSONObj> batch4 = {fromjson("{$sortKey: {'': 6}}")};
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), batch4));
+
+    // Both cursors are exhausted, so no further getMores are scheduled.
+    ASSERT_TRUE(arm->remotesExhausted());
+    for (int expected = 3; expected <= 6; ++expected) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON(AsyncResultsMerger::kSortKeyField << BSON("" << expected)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_FALSE(networkHasReadyRequests());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, UnsortedReadAheadStopsAtMemoryBudget) {
+    const long long docSize = BSON("_id" << 1).objsize();
+    internalQueryAsyncResultsMergerPrefetchBytes.store(1024 * 1024);
+    internalQueryAsyncResultsMergerPrefetchMaxBufferedBytes.store(3 * docSize);
+    ON_BLOCK_EXIT([] {
+        internalQueryAsyncResultsMergerPrefetchBytes.store(0);
+        internalQueryAsyncResultsMergerPrefetchMaxBufferedBytes.store(64 * 1024 * 1024);
+    });
+
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{_id: 1}"), fromjson("{_id: 2}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, batch1)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors));
+
+    // Returning the first result leaves room in the budget, so the next batch is read ahead.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1}"), *unittest::assertGet(arm->nextReady()).getResult());
+    std::vector<BSONObj> batch2 = {fromjson("{_id: 3}"), fromjson("{_id: 4}")};
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(5), batch2));
+
+    // Three results are now buffered, which fills the budget.
+    ASSERT_FALSE(networkHasReadyRequests());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2}"), *unittest::assertGet(arm->nextReady()).getResult());
+    std::vector<BSONObj> batch3 = {fromjson("{_id: 5}")};
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), batch3));
+
+    ASSERT_TRUE(arm->remotesExhausted());
+    for (int expected = 3; expected <= 5; ++expected) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("_id" << expected),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_FALSE(networkHasReadyRequests());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
@@ -318,5 +318,130 @@ TEST_F(RoutingTableHistoryTestThreeInitialChunks,
                               expectedBytesInChunksNotSplit);
 }
 
+/**
+ * Test fixture for tests that need a routing table with enough chunks to span many of the blocks
+ * in which ChunkInfoMap stores them.
+ */
+class RoutingTableHistoryTestManyChunks : public unittest::Test {
+public:
+    static constexpr int kNumChunks = 1000;
+
+    void setUp() override {
+        _epoch = OID::gen();
+        std::vector<ChunkType> chunks;
+        for (int i = 0; i < kNumChunks; i++) {
+            ChunkVersion version{uint32_t(i + 1), 0, _epoch};
+            chunks.emplace_back(kNss, getRange(i), version, getShard(i % 3));
+        }
+        _rt = RoutingTableHistory::makeNew(
+            kNss, UUID::gen(), _shardKeyPattern, nullptr, false, _epoch, chunks);
+    }
+
+    static ChunkRange getRange(int i) {
+        return {i == 0 ? BSON("a" << MINKEY) : BSON("a" << i * 10),
+                i == kNumChunks - 1 ? BSON("a" << MAXKEY) : BSON("a" << (i + 1) * 10)};
+    }
+
+    static ShardId getShard(int i) {
+        return ShardId(str::stream() << "shard" << i);
+    }
+
+    /**
+     * Checks that 'rt' has the same chunks and shard versions as a routing table built from
+     * scratch out of its chunks.
+     */
+    void assertMatchesFullBuild(const std::shared_ptr<RoutingTableHistory>& rt) {
+        std::vector<ChunkType> chunks;
+        for (const auto& entry : rt->getChunkMap()) {
+            const auto& chunk = *entry.second;
+            chunks.emplace_back(
+                kNss, chunk.getRange(), chunk.getLastmod(), chunk.getShardIdAt(boost::none));
+        }
+        std::sort(chunks.begin(), chunks.end(), [](const ChunkType& a, const ChunkType& b) {
+            return a.getVersion().isOlderThan(b.getVersion());
+        });
+        auto fullBuild = RoutingTableHistory::makeNew(
+            kNss, UUID::gen(), _shardKeyPattern, nullptr, false, _epoch, chunks);
+
+        ASSERT_EQ(fullBuild->getChunkMap().size(), rt->getChunkMap().size());
+        ASSERT_EQ(fullBuild->getVersion(), rt->getVersion());
+        ASSERT_EQ(fullBuild->getNShardsOwningChunks(), rt->getNShardsOwningChunks());
+        for (int i = 0; i < 4; i++) {
+            ASSERT_EQ(fullBuild->getVersion(getShard(i)), rt->getVersion(getShard(i)));
+        }
+    }
+
+protected:
+    OID _epoch;
+    const KeyPattern _shardKeyPattern{BSON("a" << 1)};
+    std::shared_ptr<RoutingTableHistory> _rt;
+};
+
+TEST_F(RoutingTableHistoryTestManyChunks, IncrementalUpdatesMatchFullBuild) {
+    auto version = _rt->getVersion();
+    auto rt = _rt;
+
+    // Move a chunk to a new shard and bump a chunk left on the donor.
+    std::vector<ChunkType> moves;
+    version.incMajor();
+    moves.emplace_back(kNss, getRange(500), version, getShard(3));
+    version.incMinor();
+    moves.emplace_back(kNss, getRange(503), version, getShard(500 % 3));
+    rt = rt->makeUpdated(moves);
+    assertMatchesFullBuild(rt);
+    ASSERT_EQ(4, rt->getNShardsOwningChunks());
+
+    // Split a chunk in three.
+    std::vector<ChunkType> splits;
+    for (int i = 0; i < 3; i++) {
+        version.incMinor();
+        splits.emplace_back(kNss,
+                            ChunkRange{BSON("a" << 2000 + (i == 0 ? 0 : 3 * i)),
+                                       BSON("a" << (i == 2 ? 2010 : 2000 + 3 * (i + 1)))},
+                            version,
+                            getShard(200 % 3));
+    }
+    rt = rt->makeUpdated(splits);
+    assertMatchesFullBuild(rt);
+    ASSERT_EQ(size_t(kNumChunks + 2), rt->getChunkMap().size());
+
+    // Merge chunks spanning several blocks, including the moved and the split ones.
+    version.incMinor();
+    rt = rt->makeUpdated(
+        {ChunkType(kNss, {BSON("a" << 1000), BSON("a" << 8000)}, version, getShard(2))});
+    assertMatchesFullBuild(rt);
+    ASSERT_EQ(3, rt->getNShardsOwningChunks());
+    ASSERT_EQ(size_t(kNumChunks + 2 - 701), rt->getChunkMap().size());
+
+    // The original routing table is not affected by the updates.
+    ASSERT_EQ(size_t(kNumChunks), _rt->getChunkMap().size());
+    assertMatchesFullBuild(_rt);
+}
+
+TEST_F(RoutingTableHistoryTestManyChunks, ShardLosingLastChunkIsRemoved) {
+    auto version = _rt->getVersion();
+
+    std::vector<ChunkType> moves;
+    version.incMajor();
+    moves.emplace_back(kNss, getRange(400), version, getShard(3));
+    auto rt = _rt->makeUpdated(moves);
+    ASSERT_EQ(4, rt->getNShardsOwningChunks());
+
+    version.incMajor();
+    rt = rt->makeUpdated({ChunkType(kNss, getRange(400), version, getShard(0))});
+    ASSERT_EQ(3, rt->getNShardsOwningChunks());
+    assertMatchesFullBuild(rt);
+}
+
+TEST_F(RoutingTableHistoryTestManyChunks, OverlappingChunkIsRejected) {
+    auto version = _rt->getVersion();
+    version.incMajor();
+    ASSERT_THROWS_CODE(
+        _rt->makeUpdated(
+            {ChunkType(kNss, {BSON("a" << 5005), BSON("a" << 5015)}, version, getShard(0))}),
+        DBException,
+        ErrorCodes::ConflictingOperationInProgress);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -278,27 +278,8 @@ Status preCacheMongosRoutingInfo(OperationContext* opCtx) {
         return Status::OK();
     }
 
-    auto grid = Grid::get(opCtx);
-
-    auto shardingCatalogClient = grid->catalogClient();
-    auto result =
-        shardingCatalogClient->getAllDBs(opCtx, repl::ReadConcernLevel::kMajorityReadConcern);
-
-    if (!result.isOK()) {
-        return result.getStatus();
-    }
-
-    auto cache = grid->catalogCache();
-    for (auto& db : result.getValue().value) {
-        for (auto& coll : shardingCatalogClient->getAllShardedCollectionsForDb(
-                 opCtx, db.getName(), repl::ReadConcernLevel::kMajorityReadConcern)) {
-            auto resp = cache->getShardedCollectionRoutingInfoWithRefresh(opCtx, coll);
-            if (!resp.isOK()) {
-                return resp.getStatus();
-            }
-        }
-    }
-    return Status::OK();
+    return Grid::get(opCtx)->catalogCache()->warmUp(opCtx,
+                                                    gLoadRoutingTableOnStartupConcurrency);
 }
 
 Status preWarmConnectionPool(OperationContext* opCtx) {
@@ -214,9 +214,23 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
 
     const size_t minConns = gParameters.minConnections.load();
     const size_t maxConns = gParameters.maxConnections.load();
+    const size_t requestsPerConnection = gParameters.requestsPerConnection.load();
+    const auto targetHold = Milliseconds{gParameters.targetHoldMS.load()};
 
     // Update the target for just the pool first
-    poolData.target = stats.requests + stats.active;
+    poolData.target =
+        stats.active + (stats.requests + requestsPerConnection - 1) / requestsPerConnection;
+
+    if (targetHold > Milliseconds{0}) {
+        // Hold on to the peak demand seen within the hold window
+        const auto now = Date_t::now();
+        if (poolData.target >= poolData.peakDemand ||
+            now - poolData.peakDemandTime > targetHold) {
+            poolData.peakDemand = poolData.target;
+            poolData.peakDemandTime = now;
+        }
+        poolData.target = poolData.peakDemand;
+    }
 
     if (poolData.target < minConns) {
         poolData.target = minConns;
@@ -59,6 +59,13 @@ namespace mongo {
  * When the MatchingStrategy is kMatchBusiestNode, it operates like kMatchPrimaryNode, but any pool
  * can be responsible for increasing the targetConnections of each member of its set.
  *
+ * Regardless of the MatchingStrategy, each pool targets one connection per checked out connection
+ * plus one for every requestsPerConnection queued requests. Raising requestsPerConnection above one
+ * makes bursts of requests wait for connections to be returned to the pool, rather than opening a
+ * new connection for each of them. If targetHoldMS is set, a pool keeps targeting the highest
+ * number of connections it needed during that window, so that connections opened for a burst of
+ * requests are still there for the next one instead of being reopened all at once.
+ *
  * Note that, in essence, there are three outside elements that can mutate the state of this class:
  * * The ReplicaSetChangeNotifier can notify the listener which updates the host groups
  * * The ServerParameters can update the Parameters which will used in the next update
@@ -82,6 +89,8 @@ public:
         AtomicWord<int> minConnections;
         AtomicWord<int> maxConnections;
         AtomicWord<int> maxConnecting;
+        AtomicWord<int> requestsPerConnection;
+        AtomicWord<int> targetHoldMS;
 
         AtomicWord<int> hostTimeoutMS;
         AtomicWord<int> pendingTimeoutMS;
@@ -177,6 +186,10 @@ private:
         // The number of connections the host should maintain
         size_t target = 0;
 
+        // The highest number of connections the host needed since peakDemandTime
+        size_t peakDemand = 0;
+        Date_t peakDemandTime;
+
         // This host is able to shutdown
         bool isAbleToShutdown = false;
     };
@@ -68,6 +68,9 @@ struct WriteErrorDetailComp {
 const int kEstUpdateOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 const int kEstDeleteOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 
+// The number of documents in the first group of inserts targeted together for an ordered batch.
+const size_t kOrderedInsertTargetingGroupSize = 16;
+
 /**
  * Returns a new write concern that has the copy of every field from the original
  * document but with a w set to 1. This is intended for upgrading { w: 0 } write
@@ -305,6 +308,15 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // Inserts are targeted a group at a time, so that the targeter can share work between the
+    // documents. An ordered batch stops at the first write which needs another endpoint, so it
+    // starts with a small group and doubles it each time a group is used up, which bounds the
+    // number of documents targeted but not sent in this round.
+    const bool isInsert = _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert;
+    std::vector<StatusWith<ShardEndpoint>> insertEndpoints;
+    size_t insertEndpointsBegin = 0;
+    size_t insertGroupSize = ordered ? kOrderedInsertTargetingGroupSize : numWriteOps;
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -312,6 +324,16 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         if (writeOp.getWriteState() != WriteOpState_Ready)
             continue;
 
+        if (isInsert && i >= insertEndpointsBegin + insertEndpoints.size()) {
+            std::vector<BSONObj> docs;
+            for (size_t j = i; j < numWriteOps && docs.size() < insertGroupSize; ++j) {
+                docs.push_back(_writeOps[j].getWriteItem().getDocument());
+            }
+            insertEndpoints = targeter.targetInserts(_opCtx, docs);
+            insertEndpointsBegin = i;
+            insertGroupSize *= 2;
+        }
+
         //
         // Get TargetedWrites from the targeter for the write operation
         //
@@ -320,7 +342,11 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         OwnedPointerVector<TargetedWrite> writesOwned;
         vector<TargetedWrite*>& writes = writesOwned.mutableVector();
 
-        Status targetStatus = writeOp.targetWrites(_opCtx, targeter, &writes);
+        Status targetStatus =
+            writeOp.targetWrites(_opCtx,
+                                 targeter,
+                                 &writes,
+                                 isInsert ? &insertEndpoints[i - insertEndpointsBegin] : nullptr);
 
         if (!targetStatus.isOK()) {
             WriteErrorDetail targetError;
@@ -416,6 +416,51 @@ StatusWith<ShardEndpoint> ChunkManagerTargeter::targetInsert(OperationContext* o
     return Status::OK();
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    if (!_routingInfo->cm()) {
+        return NSTargeter::targetInserts(opCtx, docs);
+    }
+
+    const auto& cm = *_routingInfo->cm();
+    std::vector<BSONObj> shardKeys;
+    shardKeys.reserve(docs.size());
+    for (const auto& doc : docs) {
+        auto shardKey = cm.getShardKeyPattern().extractShardKeyFromDoc(doc);
+        if (shardKey.isEmpty()) {
+            // Stop before this document, so that it fails when it is targeted on its own, as it
+            // would in targetInsert().
+            uassert(ErrorCodes::ShardKeyNotFound,
+                    "Shard key cannot contain array values or array descendants.",
+                    !shardKeys.empty());
+            break;
+        }
+        shardKeys.push_back(std::move(shardKey));
+    }
+
+    auto chunks = cm.findIntersectingChunksWithSimpleCollation(shardKeys);
+
+    std::vector<StatusWith<ShardEndpoint>> endpoints;
+    endpoints.reserve(shardKeys.size());
+    boost::optional<ShardEndpoint> lastEndpoint;
+    for (size_t i = 0; i < shardKeys.size(); i++) {
+        if (!chunks[i]) {
+            endpoints.push_back(Status(ErrorCodes::ShardKeyNotFound,
+                                       str::stream() << "Cannot target single shard using key "
+                                                     << shardKeys[i] << " for namespace "
+                                                     << cm.getns()));
+            continue;
+        }
+
+        const auto& shardId = chunks[i]->getShardId();
+        if (!lastEndpoint || lastEndpoint->shardName != shardId) {
+            lastEndpoint.emplace(shardId, cm.getVersion(shardId));
+        }
+        endpoints.push_back(*lastEndpoint);
+    }
+    return endpoints;
+}
+
 StatusWith<std::vector<ShardEndpoint>> ChunkManagerTargeter::targetUpdate(
     OperationContext* opCtx, const write_ops::UpdateOpEntry& updateDoc) const {
     // If the update is replacement-style:
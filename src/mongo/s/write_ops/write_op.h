@@ -118,10 +118,15 @@ public:
      *
      * Returns !OK if the targeting process itself fails
      *             (no TargetedWrites will be added, state unchanged)
+     *
+     * If this is an insert which has already been targeted, for instance through
+     * NSTargeter::targetInserts(), 'insertEndpoint' holds the result and the targeter is not
+     * consulted again.
      */
     Status targetWrites(OperationContext* opCtx,
                         const NSTargeter& targeter,
-                        std::vector<TargetedWrite*>* targetedWrites);
+                        std::vector<TargetedWrite*>* targetedWrites,
+                        const StatusWith<ShardEndpoint>* insertEndpoint = nullptr);
 
     /**
      * Returns the number of child writes that were last targeted.
@@ -542,6 +542,45 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertWithRangePrefixHashedShardKey) {
                        ErrorCodes::ShardKeyNotFound);
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsMatchesTargetInsert) {
+    std::vector<BSONObj> splitPoints = {
+        BSON("a" << BSONNULL), BSON("a" << -100), BSON("a" << 0), BSON("a" << 100)};
+    auto cmTargeter = prepare(BSON("a" << 1), splitPoints);
+
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; i++) {
+        docs.push_back(BSON("a" << (i * 37 % 400) - 200));
+    }
+    docs.push_back(BSONObj());
+    docs.push_back(BSON("a" << MINKEY));
+
+    auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQ(docs.size(), endpoints.size());
+    for (size_t i = 0; i < docs.size(); i++) {
+        auto expected = cmTargeter.targetInsert(operationContext(), docs[i]);
+        ASSERT_OK(expected.getStatus());
+        ASSERT_OK(endpoints[i].getStatus());
+        ASSERT_EQUALS(expected.getValue().shardName, endpoints[i].getValue().shardName);
+        ASSERT_EQUALS(expected.getValue().shardVersion, endpoints[i].getValue().shardVersion);
+    }
+}
+
+TEST_F(ChunkManagerTargeterTest, TargetInsertsStopsBeforeArrayShardKey) {
+    std::vector<BSONObj> splitPoints = {BSON("a" << 0)};
+    auto cmTargeter = prepare(BSON("a" << 1), splitPoints);
+
+    std::vector<BSONObj> docs = {BSON("a" << -1), BSON("a" << 1), fromjson("{a: [1, 2]}")};
+    auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQ(2U, endpoints.size());
+    ASSERT_EQUALS(endpoints[0].getValue().shardName, "0");
+    ASSERT_EQUALS(endpoints[1].getValue().shardName, "1");
+
+    ASSERT_THROWS_CODE(
+        cmTargeter.targetInserts(operationContext(), {docs.begin() + 2, docs.end()}),
+        DBException,
+        ErrorCodes::ShardKeyNotFound);
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetInsertsWithVaryingHashedPrefixAndConstantRangedSuffix) {
     // Create 4 chunks and 4 shards such that shardId '0' has chunk [MinKey, -2^62), '1' has chunk
     // [-2^62, 0), '2' has chunk ['0', 2^62) and '3' has chunk [2^62, MaxKey).
@@ -298,13 +298,15 @@ ScriptingFunction Scope::createFunction(const char* code) {
         }
     }
 
-    FunctionCacheMap::iterator i = _cachedFunctions.find(code);
+    // Measure the source once; a raw 'const char*' key would be strlen'd on every comparison.
+    const StringData source(code);
+    FunctionCacheMap::iterator i = _cachedFunctions.find(source);
     if (i != _cachedFunctions.end())
         return i->second;
 
     // Get a function number, so the cache can be utilized to lookup the source on an exception
     ScriptingFunction functionNumber = _createFunction(code);
-    _cachedFunctions[code] = functionNumber;
+    _cachedFunctions.emplace(source.toString(), functionNumber);
     return functionNumber;
 }
 
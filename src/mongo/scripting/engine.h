@@ -37,7 +37,8 @@
 namespace mongo {
 typedef unsigned long long ScriptingFunction;
 typedef BSONObj (*NativeFunction)(const BSONObj& args, void* data);
-typedef std::map<std::string, ScriptingFunction> FunctionCacheMap;
+// Uses a transparent comparator so that lookups by StringData do not copy the function source.
+typedef std::map<std::string, ScriptingFunction, std::less<>> FunctionCacheMap;
 
 class DBClientBase;
 class OperationContext;
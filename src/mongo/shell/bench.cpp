@@ -33,6 +33,7 @@
 
 #include "mongo/shell/bench.h"
 
+#include <cmath>
 #include <pcrecpp.h>
 
 #include "mongo/base/shim.h"
@@ -331,6 +332,25 @@ BenchRunEventCounter::BenchRunEventCounter() = default;
 void BenchRunEventCounter::updateFrom(const BenchRunEventCounter& other) {
     _numEvents += other._numEvents;
     _totalTimeMicros += other._totalTimeMicros;
+    for (size_t i = 0; i < kNumLatencyBuckets; ++i) {
+        _latencyBuckets[i] += other._latencyBuckets[i];
+    }
+}
+
+long long BenchRunEventCounter::getLatencyPercentileMicros(double percentile) const {
+    if (_numEvents == 0) {
+        return 0;
+    }
+
+    const auto target = static_cast<long long>(std::ceil(_numEvents * percentile / 100.0));
+    long long seen = 0;
+    for (size_t i = 0; i < kNumLatencyBuckets; ++i) {
+        seen += _latencyBuckets[i];
+        if (seen >= target) {
+            return static_cast<long long>((1ULL << i) - 1);
+        }
+    }
+    return std::numeric_limits<long long>::max();
 }
 
 void BenchRunStats::updateFrom(const BenchRunStats& other) {
@@ -1523,6 +1543,24 @@ BSONObj BenchRunner::finish(BenchRunner* runner) {
     appendAverageMicrosIfAvailable("queryLatencyAverageMicros", stats.queryCounter);
     appendAverageMicrosIfAvailable("commandsLatencyAverageMicros", stats.commandCounter);
 
+    const auto appendPercentilesIfAvailable = [&buf](StringData name,
+                                                     const BenchRunEventCounter& counter) {
+        if (counter.getNumEvents() > 0) {
+            BSONObjBuilder percentiles(buf.subobjStart(name));
+            percentiles.append("p50", counter.getLatencyPercentileMicros(50));
+            percentiles.append("p95", counter.getLatencyPercentileMicros(95));
+            percentiles.append("p99", counter.getLatencyPercentileMicros(99));
+            percentiles.append("p999", counter.getLatencyPercentileMicros(99.9));
+        }
+    };
+
+    appendPercentilesIfAvailable("findOneLatencyPercentilesMicros", stats.findOneCounter);
+    appendPercentilesIfAvailable("insertLatencyPercentilesMicros", stats.insertCounter);
+    appendPercentilesIfAvailable("deleteLatencyPercentilesMicros", stats.deleteCounter);
+    appendPercentilesIfAvailable("updateLatencyPercentilesMicros", stats.updateCounter);
+    appendPercentilesIfAvailable("queryLatencyPercentilesMicros", stats.queryCounter);
+    appendPercentilesIfAvailable("commandsLatencyPercentilesMicros", stats.commandCounter);
+
     buf.append("totalOps", static_cast<long long>(stats.opCount));
 
     const auto appendPerSec = [&buf, runner](StringData name, double total) {
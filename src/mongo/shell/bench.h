@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <string>
 
@@ -37,6 +38,7 @@
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/ops/write_ops_parsers.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/bits.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/thread.h"
@@ -279,6 +281,7 @@ public:
         }
         ++_numEvents;
         _totalTimeMicros += timeMicros;
+        ++_latencyBuckets[_bucketFor(timeMicros)];
     }
 
     /**
@@ -295,9 +298,27 @@ public:
         return _numEvents;
     }
 
+    /**
+     * Returns an upper bound, in microseconds, on the latency below which 'percentile' (in the
+     * range (0, 100]) of the observed events fall. Latencies are kept in power-of-two buckets, so
+     * the bound is within a factor of two of the exact value. Returns 0 if no events were observed.
+     */
+    long long getLatencyPercentileMicros(double percentile) const;
+
 private:
+    static constexpr size_t kNumLatencyBuckets = 64;
+
+    // Bucket 0 holds zero-microsecond events, bucket i holds events in [2^(i-1), 2^i).
+    static size_t _bucketFor(long long timeMicros) {
+        if (timeMicros <= 0) {
+            return 0;
+        }
+        return kNumLatencyBuckets - countLeadingZeros64(timeMicros);
+    }
+
     long long _totalTimeMicros{0};
     long long _numEvents{0};
+    std::array<long long, kNumLatencyBuckets> _latencyBuckets{};
 };
 
 /**
@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/shell/bench.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+long long percentileOfSingleEvent(long long timeMicros, double percentile) {
+    BenchRunEventCounter counter;
+    counter.countOne(timeMicros);
+    return counter.getLatencyPercentileMicros(percentile);
+}
+
+TEST(BenchRunEventCounterTest, PercentileOfNoEventsIsZero) {
+    BenchRunEventCounter counter;
+    ASSERT_EQ(0, counter.getLatencyPercentileMicros(50));
+    ASSERT_EQ(0, counter.getLatencyPercentileMicros(99.9));
+}
+
+TEST(BenchRunEventCounterTest, PercentileIsTheUpperBoundOfThePowerOfTwoBucket) {
+    ASSERT_EQ(0, percentileOfSingleEvent(0, 50));
+    ASSERT_EQ(1, percentileOfSingleEvent(1, 50));
+    ASSERT_EQ(3, percentileOfSingleEvent(2, 50));
+    ASSERT_EQ(3, percentileOfSingleEvent(3, 50));
+    ASSERT_EQ(7, percentileOfSingleEvent(4, 50));
+    ASSERT_EQ(1023, percentileOfSingleEvent(1023, 50));
+    ASSERT_EQ(2047, percentileOfSingleEvent(1024, 50));
+    ASSERT_EQ(std::numeric_limits<long long>::max(),
+              percentileOfSingleEvent(std::numeric_limits<long long>::max(), 50));
+}
+
+TEST(BenchRunEventCounterTest, PercentileSelectsTheBucketHoldingTheTargetEvent) {
+    BenchRunEventCounter counter;
+    for (int i = 0; i < 990; ++i) {
+        counter.countOne(10);
+    }
+    for (int i = 0; i < 10; ++i) {
+        counter.countOne(1000);
+    }
+
+    ASSERT_EQ(15, counter.getLatencyPercentileMicros(50));
+    ASSERT_EQ(15, counter.getLatencyPercentileMicros(99));
+    ASSERT_EQ(1023, counter.getLatencyPercentileMicros(99.9));
+    ASSERT_EQ(1023, counter.getLatencyPercentileMicros(100));
+}
+
+TEST(BenchRunEventCounterTest, UpdateFromMergesLatencyBuckets) {
+    BenchRunEventCounter fast;
+    fast.countOne(10);
+    BenchRunEventCounter slow;
+    slow.countOne(1000);
+
+    fast.updateFrom(slow);
+    ASSERT_EQ(2, fast.getNumEvents());
+    ASSERT_EQ(15, fast.getLatencyPercentileMicros(50));
+    ASSERT_EQ(1023, fast.getLatencyPercentileMicros(100));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,8 @@
 
 #include "mongo/transport/message_compressor_manager.h"
 
+#include <algorithm>
+
 #include "mongo/base/data_range_cursor.h"
 #include "mongo/base/data_type_endian.h"
 #include "mongo/bson/bsonobj.h"
@@ -72,6 +74,9 @@ struct CompressionHeader {
     }
 };
 
+// Compressed messages whose buffer would waste at least this much are shrunk to fit.
+constexpr size_t kMinSlackToShrinkBytes = 16 * 1024;
+
 const transport::Session::Decoration<MessageCompressorManager> getForSession =
     transport::Session::declareDecoration<MessageCompressorManager>();
 }  // namespace
@@ -134,7 +139,16 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
         return sws.getStatus();
 
     auto realCompressedSize = sws.getValue();
-    outMessage.setLen(realCompressedSize + CompressionHeader::size() + MsgData::MsgDataHeaderSize);
+    const size_t compressedMessageSize =
+        realCompressedSize + CompressionHeader::size() + MsgData::MsgDataHeaderSize;
+    outMessage.setLen(compressedMessageSize);
+
+    // The buffer was sized for the compressor's worst case, which for compressible payloads is
+    // far more than what was actually written. Give the slack back rather than holding on to it
+    // for as long as the message is queued for sending.
+    if (bufferSize - compressedMessageSize >= kMinSlackToShrinkBytes) {
+        outputMessageBuffer.realloc(compressedMessageSize);
+    }
 
     return {Message(outputMessageBuffer)};
 }
@@ -209,8 +223,21 @@ void MessageCompressorManager::clientBegin(BSONObjBuilder* output) {
     if (compressorList.size() == 0)
         return;
 
+    std::vector<std::string> offered;
+    for (const auto& e : _preferred) {
+        if (std::find(compressorList.begin(), compressorList.end(), e) != compressorList.end() &&
+            std::find(offered.begin(), offered.end(), e) == offered.end()) {
+            offered.push_back(e);
+        }
+    }
+    for (const auto& e : compressorList) {
+        if (std::find(offered.begin(), offered.end(), e) == offered.end()) {
+            offered.push_back(e);
+        }
+    }
+
     BSONArrayBuilder sub(output->subarrayStart("compression"));
-    for (const auto e : _registry->getCompressorNames()) {
+    for (const auto& e : offered) {
         LOGV2_DEBUG(22929, 3, "Offering {e} compressor to server", "e"_attr = e);
         sub.append(e);
     }
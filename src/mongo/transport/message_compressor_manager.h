@@ -33,6 +33,7 @@
 #include "mongo/transport/message_compressor_base.h"
 #include "mongo/transport/session.h"
 
+#include <string>
 #include <vector>
 
 namespace mongo {
@@ -68,6 +69,17 @@ public:
      */
     void clientBegin(BSONObjBuilder* output);
 
+    /*
+     * Sets the compressors a client offers first in clientBegin, in order of preference. The
+     * other compressors in _registry->getCompressorNames() are still offered after them; names
+     * that are not registered are skipped. Because the server compresses its replies with the
+     * first compressor the client offered, this chooses the compressor for a connection without
+     * changing the process-wide compressor list.
+     */
+    void setPreferredCompressors(std::vector<std::string> names) {
+        _preferred = std::move(names);
+    }
+
     /*
      * Called by a client that has received an isMaster response (received after calling
      * clientBegin) and wants to finish negotiating compression.
@@ -128,6 +140,7 @@ public:
 
 private:
     std::vector<MessageCompressorBase*> _negotiated;
+    std::vector<std::string> _preferred;
     MessageCompressorRegistry* _registry;
 };
 
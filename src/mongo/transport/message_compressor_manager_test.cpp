@@ -220,6 +220,34 @@ TEST(MessageCompressorManager, FullNormalCompression) {
     clientManager.clientFinish(serverObj);
 }
 
+TEST(MessageCompressorManager, PreferredCompressorIsOfferedFirst) {
+    MessageCompressorRegistry registry;
+    registry.setSupportedCompressors({"snappy", "zlib", "zstd"});
+    registry.registerImplementation(std::make_unique<SnappyMessageCompressor>());
+    registry.registerImplementation(std::make_unique<ZlibMessageCompressor>());
+    registry.registerImplementation(std::make_unique<ZstdMessageCompressor>());
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+
+    MessageCompressorManager clientManager(&registry);
+    MessageCompressorManager serverManager(&registry);
+    clientManager.setPreferredCompressors({"fakecompressor", "zstd"});
+
+    BSONObjBuilder clientOutput;
+    clientManager.clientBegin(&clientOutput);
+    auto clientObj = clientOutput.done();
+    checkNegotiationResult(clientObj, {"zstd", "snappy", "zlib"});
+
+    BSONObjBuilder serverOutput;
+    serverManager.serverNegotiate(clientObj, &serverOutput);
+    auto serverObj = serverOutput.done();
+    clientManager.clientFinish(serverObj);
+
+    MessageCompressorId compressorId;
+    auto toSend = assertOk(clientManager.compressMessage(buildMessage(), nullptr));
+    assertOk(serverManager.decompressMessage(toSend, &compressorId));
+    ASSERT_EQ(compressorId, registry.getCompressor("zstd")->getId());
+}
+
 TEST(NoopMessageCompressor, Fidelity) {
     auto testMessage = buildMessage();
     checkFidelity(testMessage, std::make_unique<NoopMessageCompressor>());
@@ -252,6 +280,36 @@ TEST(ZstdMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(MessageCompressorManager, CompressedMessageBufferIsShrunkToFit) {
+    MessageCompressorRegistry registry;
+    auto compressor = std::make_unique<SnappyMessageCompressor>();
+    const auto compressorId = compressor->getId();
+    registry.setSupportedCompressors({compressor->getName()});
+    registry.registerImplementation(std::move(compressor));
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+    MessageCompressorManager manager(&registry);
+
+    // A large and very compressible payload.
+    const size_t dataSize = 1024 * 1024;
+    const auto bufferSize = MsgData::MsgDataHeaderSize + dataSize;
+    auto buf = SharedBuffer::allocate(bufferSize);
+    MsgData::View testView(buf.get());
+    testView.setId(123456);
+    testView.setResponseToMsgId(654321);
+    testView.setOperation(dbQuery);
+    testView.setLen(bufferSize);
+    memset(testView.data(), 'x', dataSize);
+    const Message original{buf};
+
+    auto compressed = assertOk(manager.compressMessage(original, &compressorId));
+    ASSERT_EQ(compressed.operation(), dbCompressed);
+    ASSERT_EQ(compressed.sharedBuffer().capacity(), static_cast<size_t>(compressed.size()));
+
+    auto decompressed = assertOk(manager.decompressMessage(compressed));
+    ASSERT_EQ(decompressed.size(), original.size());
+    ASSERT_EQ(memcmp(decompressed.singleData().data(), testView.data(), dataSize), 0);
+}
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
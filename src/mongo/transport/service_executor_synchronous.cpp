@@ -33,12 +33,19 @@
 
 #include "mongo/transport/service_executor_synchronous.h"
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/transport/service_entry_point_utils.h"
 #include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/service_executor_task_names.h"
+#include "mongo/util/errno_util.h"
 #include "mongo/util/processinfo.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace transport {
@@ -57,6 +64,24 @@ ServiceExecutorSynchronous::ServiceExecutorSynchronous(ServiceContext* ctx) {}
 Status ServiceExecutorSynchronous::start() {
     _numHardwareCores = static_cast<size_t>(ProcessInfo::getNumAvailableCores());
 
+#ifdef __linux__
+    if (synchronousServiceExecutorPinThreadsToCores) {
+        cpu_set_t allowedCpus;
+        CPU_ZERO(&allowedCpus);
+        if (sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) != 0) {
+            return {ErrorCodes::InternalError,
+                    str::stream() << "Failed to get the CPU affinity of the process: "
+                                  << errnoWithDescription()};
+        }
+
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowedCpus)) {
+                _cpusToPinTo.push_back(cpu);
+            }
+        }
+    }
+#endif
+
     _stillRunning.store(true);
 
     return Status::OK();
@@ -117,6 +142,7 @@ Status ServiceExecutorSynchronous::schedule(Task task,
 
     Status status = launchServiceWorkerThread([this, task = std::move(task)] {
         _numRunningWorkerThreads.addAndFetch(1);
+        _pinCurrentThreadToNextCore();
 
         _localWorkQueue.emplace_back(std::move(task));
         while (!_localWorkQueue.empty() && _stillRunning.loadRelaxed()) {
@@ -133,6 +159,28 @@ Status ServiceExecutorSynchronous::schedule(Task task,
     return status;
 }
 
+void ServiceExecutorSynchronous::_pinCurrentThreadToNextCore() {
+#ifdef __linux__
+    if (_cpusToPinTo.empty()) {
+        return;
+    }
+
+    const auto cpu = _cpusToPinTo[_nextCpuToPinTo.fetchAndAdd(1) % _cpusToPinTo.size()];
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    if (int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus)) {
+        // Pinning is only a performance hint, so carry on running the connection unpinned
+        LOGV2_DEBUG(5100025,
+                    1,
+                    "Failed to pin worker thread to CPU",
+                    "cpu"_attr = cpu,
+                    "error"_attr = errnoWithDescription(err));
+    }
+#endif
+}
+
 void ServiceExecutorSynchronous::appendStats(BSONObjBuilder* bob) const {
     *bob << kExecutorLabel << kExecutorName << kThreadsRunning
          << static_cast<int>(_numRunningWorkerThreads.loadRelaxed());
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <deque>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/platform/atomic_word.h"
@@ -45,6 +46,12 @@ namespace transport {
 /**
  * The passthrough service executor emulates a thread per connection.
  * Each connection has its own worker thread where jobs get scheduled.
+ *
+ * If synchronousServiceExecutorPinThreadsToCores is set, each worker thread is bound to one of the
+ * CPUs the process is allowed to run on, assigned round-robin as connections arrive, so that all
+ * the work of a connection stays on a single core. Threads started by a pinned worker thread
+ * inherit its affinity, so background threads lazily spawned while serving a request stay on that
+ * core.
  */
 class ServiceExecutorSynchronous final : public ServiceExecutor {
 public:
@@ -61,6 +68,13 @@ public:
     void appendStats(BSONObjBuilder* bob) const override;
 
 private:
+    /**
+     * Binds the calling worker thread to the next CPU in round-robin order. Does nothing if thread
+     * pinning is disabled or not supported on this platform. The binding lasts for the lifetime of
+     * the thread and is inherited by every thread it creates.
+     */
+    void _pinCurrentThreadToNextCore();
+
     static thread_local std::deque<Task> _localWorkQueue;
     static thread_local int _localRecursionDepth;
     static thread_local int64_t _localThreadIdleCounter;
@@ -73,6 +87,10 @@ private:
 
     AtomicWord<size_t> _numRunningWorkerThreads{0};
     size_t _numHardwareCores{0};
+
+    // The CPUs worker threads get pinned to, empty if thread pinning is disabled
+    std::vector<int> _cpusToPinTo;
+    AtomicWord<size_t> _nextCpuToPinTo{0};
 };
 
 }  // namespace transport
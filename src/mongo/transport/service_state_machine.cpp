@@ -517,8 +517,13 @@ void ServiceStateMachine::_processMessage(ThreadGuard guard) {
         _state.store(State::Source);
         _inMessage.reset();
         _inExhaust = false;
+
+        // There is no response to send, so there is nothing to unwind before sourcing the next
+        // message. Clients that pipeline many fire-and-forget (moreToCome) requests are then
+        // served in a tight loop on this thread, subject to the executor's recursion limit.
         return _scheduleNextWithGuard(std::move(guard),
-                                      ServiceExecutor::kDeferredTask,
+                                      ServiceExecutor::kDeferredTask |
+                                          ServiceExecutor::kMayRecurse,
                                       transport::ServiceExecutorTaskName::kSSMSourceMessage);
     }
 }
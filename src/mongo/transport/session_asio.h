@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <utility>
 
 #include "mongo/base/system_error.h"
@@ -252,6 +253,7 @@ protected:
 
         _sslSocket.emplace(
             std::move(_socket), *_tl->_egressSSLContext, removeFQDNRoot(target.host()));
+        getSSLManager()->setupEgressSessionResumption(_sslSocket->native_handle(), target);
         lk.unlock();
 
         auto doHandshake = [&] {
@@ -265,6 +267,11 @@ protected:
         };
         return doHandshake().then([this, target, reactor] {
             _ranHandshake = true;
+#if MONGO_CONFIG_SSL_PROVIDER == MONGO_CONFIG_SSL_PROVIDER_OPENSSL
+            if (SSL_session_reused(_sslSocket->native_handle())) {
+                networkCounter.incrementNumResumedEgressSSLSessions();
+            }
+#endif
 
             return getSSLManager()
                 ->parseAndValidatePeerCertificate(_sslSocket->native_handle(),
@@ -375,17 +382,17 @@ private:
     }
 
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
-        static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
-
-        auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
-        auto ptr = headerBuffer.get();
-        return read(asio::buffer(ptr, kHeaderSize), baton)
-            .then([headerBuffer = std::move(headerBuffer), this, baton]() mutable {
-                if (checkForHTTPRequest(asio::buffer(headerBuffer.get(), kHeaderSize))) {
+        // The header is read into storage owned by the session, so that each message only costs a
+        // single allocation sized to fit it entirely. There is never more than one outstanding
+        // sourceMessage() per session, so the storage cannot be overwritten while in use.
+        auto headerBuffer = _headerBuffer.data();
+        return read(asio::buffer(headerBuffer, kHeaderSize), baton)
+            .then([headerBuffer, this, baton]() mutable {
+                if (checkForHTTPRequest(asio::buffer(headerBuffer, kHeaderSize))) {
                     return sendHTTPResponse(baton);
                 }
 
-                const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
+                const auto msgLen = size_t(MSGHEADER::View(headerBuffer).getMessageLength());
                 if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
                     StringBuilder sb;
                     sb << "recv(): message msgLen " << msgLen << " is invalid. "
@@ -405,11 +412,13 @@ private:
                     if (_isIngressSession) {
                         networkCounter.hitPhysicalIn(msgLen);
                     }
-                    return Future<Message>::makeReady(Message(std::move(headerBuffer)));
+                    auto buffer = SharedBuffer::allocate(kHeaderSize);
+                    memcpy(buffer.get(), headerBuffer, kHeaderSize);
+                    return Future<Message>::makeReady(Message(std::move(buffer)));
                 }
 
                 auto buffer = SharedBuffer::allocate(msgLen);
-                memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
+                memcpy(buffer.get(), headerBuffer, kHeaderSize);
 
                 MsgData::View msgView(buffer.get());
                 return read(asio::buffer(msgView.data(), msgView.dataLen()), baton)
@@ -748,6 +757,10 @@ private:
 
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
+
+    // Holds the header of the message currently being sourced
+    static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+    std::array<char, kHeaderSize> _headerBuffer;
 };
 
 }  // namespace transport
@@ -35,6 +35,7 @@
 #include "mongo/util/fast_clock_source_factory.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/system_clock_source.h"
+#include "mongo/util/system_tick_source.h"
 
 namespace mongo {
 namespace {
@@ -76,5 +77,18 @@ BENCHMARK(BM_ClockNow)
     ->Arg(1)
     ->Arg(10);
 
+/**
+ * Benchmark calls to getTicks() on the system tick source, for comparison with BM_ClockNow. Each
+ * timed section, such as a plan stage's work() call, pays for two of these.
+ */
+void BM_TickSourceGetTicks(benchmark::State& state) {
+    TickSource* tickSource = SystemTickSource::get();
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(tickSource->getTicks());
+    }
+}
+
+BENCHMARK(BM_TickSourceGetTicks)->ThreadRange(1, ProcessInfo::getNumAvailableCores());
+
 }  // namespace
 }  // namespace mongo
@@ -37,8 +37,41 @@
 
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
+namespace {
+
+/**
+ * Accounts for a caller waiting on a TicketHolder for the lifetime of this object.
+ */
+class QueuedWaiter {
+public:
+    QueuedWaiter(AtomicWord<int>& queued, AtomicWord<long long>& totalTimeQueuedMicros)
+        : _queued(queued), _totalTimeQueuedMicros(totalTimeQueuedMicros) {
+        _queued.fetchAndAdd(1);
+    }
+
+    ~QueuedWaiter() {
+        _totalTimeQueuedMicros.fetchAndAdd(_timer.micros());
+        _queued.subtractAndFetch(1);
+    }
+
+private:
+    AtomicWord<int>& _queued;
+    AtomicWord<long long>& _totalTimeQueuedMicros;
+    Timer _timer;
+};
+
+}  // namespace
+
+int TicketHolder::queued() const {
+    return _queued.load();
+}
+
+Microseconds TicketHolder::totalTimeQueued() const {
+    return Microseconds(_totalTimeQueuedMicros.load());
+}
 
 #if defined(__linux__)
 namespace {
@@ -100,6 +133,7 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
         return true;
     }
 
+    QueuedWaiter waiter(_queued, _totalTimeQueuedMicros);
     const Milliseconds intervalMs(500);
     struct timespec ts;
 
@@ -187,7 +221,11 @@ bool TicketHolder::tryAcquire() {
 
 void TicketHolder::waitForTicket(OperationContext* opCtx) {
     stdx::unique_lock<Latch> lk(_mutex);
+    if (_tryAcquire()) {
+        return;
+    }
 
+    QueuedWaiter waiter(_queued, _totalTimeQueuedMicros);
     if (opCtx) {
         opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
     } else {
@@ -197,7 +235,11 @@ void TicketHolder::waitForTicket(OperationContext* opCtx) {
 
 bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     stdx::unique_lock<Latch> lk(_mutex);
+    if (_tryAcquire()) {
+        return true;
+    }
 
+    QueuedWaiter waiter(_queued, _totalTimeQueuedMicros);
     if (opCtx) {
         return opCtx->waitForConditionOrInterruptUntil(
             _newTicket, lk, until, [this] { return _tryAcquire(); });
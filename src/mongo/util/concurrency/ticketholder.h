@@ -82,7 +82,21 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns the number of callers currently waiting for a ticket to become available.
+     */
+    int queued() const;
+
+    /**
+     * Returns the cumulative time callers have spent waiting for a ticket, counting only the
+     * acquisitions which could not be satisfied immediately.
+     */
+    Microseconds totalTimeQueued() const;
+
 private:
+    AtomicWord<int> _queued{0};
+    AtomicWord<long long> _totalTimeQueuedMicros{0};
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
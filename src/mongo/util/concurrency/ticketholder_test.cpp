@@ -32,8 +32,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
 
 namespace {
 using namespace mongo;
@@ -72,4 +74,30 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+TEST(TicketholderTest, QueuedWaitersAreCounted) {
+    TicketHolder holder(1);
+    ASSERT_EQ(holder.queued(), 0);
+    ASSERT_EQ(holder.totalTimeQueued(), Microseconds(0));
+
+    // An acquisition which succeeds immediately does not count as queued.
+    holder.waitForTicket();
+    ASSERT_EQ(holder.queued(), 0);
+    ASSERT_EQ(holder.totalTimeQueued(), Microseconds(0));
+
+    stdx::thread waiter([&] {
+        holder.waitForTicket();
+        holder.release();
+    });
+
+    while (holder.queued() == 0) {
+        sleepmillis(1);
+    }
+    sleepmillis(10);
+    holder.release();
+    waiter.join();
+
+    ASSERT_EQ(holder.queued(), 0);
+    ASSERT_GT(holder.totalTimeQueued(), Microseconds(0));
+}
 }  // namespace
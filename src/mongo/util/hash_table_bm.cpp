@@ -58,6 +58,14 @@ using AbslFlatHashMapString = absl::flat_hash_map<std::string, bool>;
 using AbslNodeHashMapInt = absl::node_hash_map<uint32_t, bool>;
 using AbslNodeHashMapString = absl::node_hash_map<std::string, bool>;
 
+// Models the per-group state of a $group stage: one heap-allocated, reference-counted accumulator
+// per accumulated field.
+using GroupRow = std::vector<std::shared_ptr<uint64_t>>;
+
+using StdUnorderedGroupRow = std::unordered_map<uint32_t, GroupRow>;  // NOLINT
+using AbslFlatHashMapGroupRow = absl::flat_hash_map<uint32_t, GroupRow>;
+using AbslNodeHashMapGroupRow = absl::node_hash_map<uint32_t, GroupRow>;
+
 template <typename>
 struct IsAbslHashMap : std::false_type {};
 
@@ -236,6 +244,46 @@ void BM_Insert(benchmark::State& state) {
         state);
 }
 
+/**
+ * Looks up or inserts the row for each key, as $group does for every input document, and updates
+ * its accumulators. Keys are drawn from a range a tenth of the size of the input so that most
+ * lookups hit an existing row.
+ */
+template <class Container>
+void BM_GroupAccumulate(benchmark::State& state) {
+    constexpr size_t kAccumulatorsPerRow = 3;
+    const int num = state.range(0);
+
+    std::vector<uint32_t> keys;
+    UniformDistribution<kDefaultSeed> gen;
+    for (int i = num; i; --i) {
+        keys.push_back(gen.template generate<uint32_t>() % std::max(1, num / 10));
+    }
+
+    int i = 0;
+    Container container;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        auto& row = container[keys[i++]];
+        if (row.empty()) {
+            for (size_t j = 0; j < kAccumulatorsPerRow; ++j) {
+                row.push_back(std::make_shared<uint64_t>(0));
+            }
+        }
+        for (auto&& accumulator : row) {
+            ++*accumulator;
+        }
+        if (i == num) {
+            i = 0;
+
+            Container swap_container;
+            std::swap(container, swap_container);
+        }
+    }
+
+    state.counters["size"] = state.range(0);
+}
+
 template <uint32_t Start = 0>
 static void Range(benchmark::internal::Benchmark* b) {
     uint32_t n0 = Start, n1 = kMaxContainerSize;
@@ -279,5 +327,10 @@ BENCHMARK_TEMPLATE(BM_Insert, StdUnorderedString)->Apply(Range<1>);
 BENCHMARK_TEMPLATE(BM_Insert, AbslFlatHashMapString)->Apply(Range<1>);
 BENCHMARK_TEMPLATE(BM_Insert, AbslNodeHashMapString)->Apply(Range<1>);
 
+// $group-style row tests
+BENCHMARK_TEMPLATE(BM_GroupAccumulate, StdUnorderedGroupRow)->Apply(Range<1>);
+BENCHMARK_TEMPLATE(BM_GroupAccumulate, AbslFlatHashMapGroupRow)->Apply(Range<1>);
+BENCHMARK_TEMPLATE(BM_GroupAccumulate, AbslNodeHashMapGroupRow)->Apply(Range<1>);
+
 }  // namespace
 }  // namespace mongo
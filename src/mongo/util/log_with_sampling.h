@@ -49,9 +49,11 @@ inline std::pair<bool, bool> shouldLogSlowOpWithSampling(OperationContext* opCtx
     const bool componentHasTargetLogVerbosity =
         shouldLog(logComponent, logv2::LogSeverity::Debug(1));
 
-    const auto client = opCtx->getClient();
-    const bool shouldSample =
-        client->getPrng().nextCanonicalDouble() < serverGlobalParams.sampleRate;
+    // A draw from the client's PRNG can only decide the outcome when the sample rate is strictly
+    // between 0 and 1, so avoid it for the default rate of 1, which applies to every operation.
+    const auto sampleRate = serverGlobalParams.sampleRate;
+    const bool shouldSample = sampleRate >= 1.0 ||
+        (sampleRate > 0.0 && opCtx->getClient()->getPrng().nextCanonicalDouble() < sampleRate);
 
     // Log the transaction if we should sample and its duration is greater than or equal to the
     // slowMS command threshold.
@@ -275,6 +275,14 @@ public:
      * SSL_CTX obect.
      */
     virtual Status stapleOCSPResponse(SSLContextType context) = 0;
+
+    /**
+     * Offers the TLS session of an earlier connection to 'remoteHost' to an outgoing connection
+     * which is about to handshake, and remembers the sessions issued to it for later connections.
+     * Only done by OpenSSL, and only if tlsEgressSessionResumption is set.
+     */
+    virtual void setupEgressSessionResumption(SSLConnectionType conn,
+                                              const HostAndPort& remoteHost) {}
 };
 
 // Access SSL functions through this instance.
@@ -50,6 +50,7 @@
 #include "mongo/config.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/debug_util.h"
@@ -57,6 +58,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/cidr.h"
 #include "mongo/util/net/dh_openssl.h"
+#include "mongo/util/net/hostandport.h"
 #include "mongo/util/net/ocsp/ocsp_manager.h"
 #include "mongo/util/net/private/ssl_expiration.h"
 #include "mongo/util/net/socket_exception.h"
@@ -422,6 +424,31 @@ static const int BUFFER_SIZE = 8 * 1024;
 
 using UniqueX509 = std::unique_ptr<X509, OpenSSLDeleter<decltype(X509_free), ::X509_free>>;
 
+using UniqueSSLSession =
+    std::unique_ptr<SSL_SESSION, OpenSSLDeleter<decltype(::SSL_SESSION_free), ::SSL_SESSION_free>>;
+
+class SSLManagerOpenSSL;
+
+/**
+ * Attached to outgoing connections set up for session resumption, so that new sessions can be
+ * filed under the host they were issued by.
+ */
+struct EgressSessionTarget {
+    SSLManagerOpenSSL* manager;
+    HostAndPort remoteHost;
+};
+
+void freeEgressSessionTarget(
+    void* parent, void* ptr, CRYPTO_EX_DATA* ad, int idx, long argl, void* argp) {
+    delete static_cast<EgressSessionTarget*>(ptr);
+}
+
+int egressSessionTargetIndex() {
+    static const int index =
+        SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, &freeEgressSessionTarget);
+    return index;
+}
+
 using UniqueOpenSSLStringStack =
     std::unique_ptr<STACK_OF(OPENSSL_STRING),
                     OpenSSLDeleter<decltype(X509_email_free), ::X509_email_free>>;
@@ -1005,6 +1032,8 @@ public:
      */
     Status stapleOCSPResponse(SSL_CTX* context) final;
 
+    void setupEgressSessionResumption(SSL* conn, const HostAndPort& remoteHost) final;
+
     const SSLConfiguration& getSSLConfiguration() const final {
         return _sslConfiguration;
     }
@@ -1033,6 +1062,16 @@ private:
     Mutex _staplingMutex = MONGO_MAKE_LATCH("OCSPStaplingJobRunner::_mutex");
     PeriodicRunner::JobAnchor _ocspStaplingAnchor;
 
+    // The most recent TLS session issued to an outgoing connection, by remote host
+    Mutex _egressSessionsMutex = MONGO_MAKE_LATCH("SSLManagerOpenSSL::_egressSessionsMutex");
+    stdx::unordered_map<HostAndPort, UniqueSSLSession> _egressSessions;
+
+    /**
+     * Called by OpenSSL whenever an outgoing connection is issued a new session. Returns 1 when
+     * taking ownership of 'session'.
+     */
+    static int _newEgressSessionCallback(SSL* ssl, SSL_SESSION* session);
+
     /** Password caching helper class.
      * Objects of this type will remember the config provided password they had access to at
      * construction.
@@ -1797,6 +1836,37 @@ Status SSLManagerOpenSSL::stapleOCSPResponse(SSL_CTX* context) {
 }
 #endif
 
+void SSLManagerOpenSSL::setupEgressSessionResumption(SSL* conn, const HostAndPort& remoteHost) {
+    if (!tlsEgressSessionResumption) {
+        return;
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_egressSessionsMutex);
+        auto it = _egressSessions.find(remoteHost);
+        if (it != _egressSessions.end()) {
+            // SSL_set_session() takes its own reference to the session.
+            ::SSL_set_session(conn, it->second.get());
+        }
+    }
+
+    ::SSL_set_ex_data(conn, egressSessionTargetIndex(), new EgressSessionTarget{this, remoteHost});
+}
+
+int SSLManagerOpenSSL::_newEgressSessionCallback(SSL* ssl, SSL_SESSION* session) {
+    auto target =
+        static_cast<EgressSessionTarget*>(::SSL_get_ex_data(ssl, egressSessionTargetIndex()));
+    if (!target) {
+        // This connection was not set up for session resumption.
+        return 0;
+    }
+
+    auto manager = target->manager;
+    stdx::lock_guard<Latch> lk(manager->_egressSessionsMutex);
+    manager->_egressSessions[target->remoteHost] = UniqueSSLSession(session);
+    return 1;
+}
+
 Status SSLManagerOpenSSL::initSSLContext(SSL_CTX* context,
                                          const SSLParams& params,
                                          ConnectionDirection direction) {
@@ -1851,6 +1921,14 @@ Status SSLManagerOpenSSL::initSSLContext(SSL_CTX* context,
                                     << getSSLErrorMessage(ERR_get_error()));
     }
 
+    if (direction == ConnectionDirection::kOutgoing && tlsEgressSessionResumption) {
+        // Sessions are kept by setupEgressSessionResumption() and _newEgressSessionCallback(),
+        // since OpenSSL's internal cache is only ever looked up by servers.
+        ::SSL_CTX_set_session_cache_mode(context,
+                                         SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        ::SSL_CTX_sess_set_new_cb(context, &SSLManagerOpenSSL::_newEgressSessionCallback);
+    }
+
     if (direction == ConnectionDirection::kOutgoing && params.tlsWithholdClientCertificate) {
         // Do not send a client certificate if they have been suppressed.
 
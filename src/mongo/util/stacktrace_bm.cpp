@@ -102,6 +102,23 @@ void BM_Print(benchmark::State& state) {
 }
 BENCHMARK(BM_Print)->Range(1, 100);
 
+// Capturing addresses without symbolizing them is the per-sample cost a sampling profiler pays.
+void BM_RawBacktrace(benchmark::State& state) {
+    size_t items = 0;
+    RecursionParam param;
+    std::array<void*, 100> addrs;
+    param.n = state.range(0);
+    param.f = [&] {
+        benchmark::DoNotOptimize(rawBacktrace(addrs.data(), addrs.size()));
+        items += param.n;
+    };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(recursionTest(param));
+    }
+    state.SetItemsProcessed(items);
+}
+BENCHMARK(BM_RawBacktrace)->Range(1, 100);
+
 #if defined(MONGO_CONFIG_USE_LIBUNWIND)
 void BM_CursorSteps(benchmark::State& state) {
     size_t items = 0;